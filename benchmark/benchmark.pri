@@ -0,0 +1,22 @@
+# Shared by the QBENCHMARK suites. They are not test cases, so `make check`
+# leaves them alone; `make bench` runs them instead and writes the results
+# as QtTest XML to BENCHMARK_RESULTS_DIR. Options for QtTest, e.g.
+# "-median 5", can be passed in BENCHMARK_ARGS.
+
+QT = core testlib
+CONFIG += console
+CONFIG -= app_bundle
+
+INCLUDEPATH += \
+    $${TOP_SRCDIR}/src \
+    $${TOP_SRCDIR}/src/lib \
+    $${TOP_SRCDIR}/src/lib/logic
+
+isEmpty(BENCHMARK_RESULTS_DIR): BENCHMARK_RESULTS_DIR = $${TOP_BUILDDIR}/benchmark/results
+
+QMAKE_EXTRA_TARGETS += bench
+bench.target = bench
+bench.depends = $$TARGET
+bench.commands = \
+    $(MKDIR) $$BENCHMARK_RESULTS_DIR && \
+    ./$$TARGET $(BENCHMARK_ARGS) -o -,txt -o $$BENCHMARK_RESULTS_DIR/$${TARGET}.xml,xml
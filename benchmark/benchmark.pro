@@ -1,16 +1,29 @@
-include(../config.pri)
+TEMPLATE = subdirs
+CONFIG += ordered
+SUBDIRS = \
+    keystroke \
+    languageswitch \
+    bm_cjkadapters \
+    bm_languagefeatures \
+    bm_spellchecker \
+    bm_text \
+    bm_wordengine \
+    bm_wordribbon \
 
-TOP_BUILDDIR = $${OUT_PWD}/..
-TEMPLATE = app
-TARGET = ubuntu-keyboard-benchmark
-target.path = $$INSTALL_BIN
+# `make bench` runs all benchmarks and collects their results in
+# BENCHMARK_RESULTS_DIR, see benchmark.pri.
+QMAKE_EXTRA_TARGETS += bench
+bench.target = bench
+bench.CONFIG = recursive
 
-INCLUDEPATH += ../src/lib
-LIBS += $${TOP_BUILDDIR}/$${UBUNTU_KEYBOARD_LIB}
-PRE_TARGETDEPS += $${TOP_BUILDDIR}/$${UBUNTU_KEYBOARD_LIB}
-SOURCES += main.cpp
+# `make perfgate` runs them several times and compares the results with
+# baseline.json, see perfgate.py. The baseline has to be recorded on the
+# machine that runs the gate first, with PERFGATE_ARGS=--update; until
+# then the gate fails.
+QMAKE_EXTRA_TARGETS += perfgate
+perfgate.target = perfgate
+perfgate.commands = $$PWD/perfgate.py --build-dir $$OUT_PWD/.. $(PERFGATE_ARGS)
 
-QT += core quick
-INSTALLS += target
-
-include(../word-prediction.pri)
+OTHER_FILES += \
+    baseline.json \
+    perfgate.py
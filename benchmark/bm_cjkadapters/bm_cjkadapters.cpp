@@ -0,0 +1,135 @@
+/*
+ * Copyright (C) 2016 Canonical, Ltd.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this list
+ * of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice, this list
+ * of conditions and the following disclaimer in the documentation and/or other materials
+ * provided with the distribution.
+ * Neither the name of Nokia Corporation nor the names of its contributors may be
+ * used to endorse or promote products derived from this software without specific
+ * prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL
+ * THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#include "pinyinadapter.h"
+#include "chewingadapter.h"
+#include "anthyadapter.h"
+
+#include <QtCore>
+#include <QtTest>
+
+namespace {
+
+//! The preedits while \a reading is typed key by key.
+QStringList keystrokes(const QString &reading)
+{
+    QStringList preedits;
+    for (int i = 1; i <= reading.length(); ++i) {
+        preedits.append(reading.left(i));
+    }
+    return preedits;
+}
+
+} // unnamed namespace
+
+//! Each adapter gets the preedit after every keystroke, as from the
+//! keyboard. Keys and readings are those that the keyboard's layouts
+//! produce.
+class BenchmarkCjkAdapters
+    : public QObject
+{
+    Q_OBJECT
+
+private:
+    Q_SLOT void initTestCase()
+    {
+        // Learning stores must not touch the user's data
+        QStandardPaths::setTestModeEnabled(true);
+    }
+
+    Q_SLOT void benchmarkPinyinParse_data()
+    {
+        QTest::addColumn<QString>("reading");
+
+        QTest::newRow("word") << "nihao";
+        QTest::newRow("phrase") << "womenyiqiqukanshu";
+    }
+
+    Q_SLOT void benchmarkPinyinParse()
+    {
+        QFETCH(QString, reading);
+
+        PinyinAdapter adapter;
+        const QStringList preedits(keystrokes(reading));
+
+        QBENCHMARK {
+            Q_FOREACH(const QString &preedit, preedits) {
+                adapter.parse(preedit);
+            }
+            adapter.reset();
+        }
+    }
+
+    Q_SLOT void benchmarkChewingParse_data()
+    {
+        QTest::addColumn<QString>("reading");
+
+        // Keys of the standard layout for 你好 and 我們去看
+        QTest::newRow("word") << "su3cl3";
+        QTest::newRow("phrase") << "ji3ap6fm4d04";
+    }
+
+    Q_SLOT void benchmarkChewingParse()
+    {
+        QFETCH(QString, reading);
+
+        ChewingAdapter adapter;
+        const QStringList preedits(keystrokes(reading));
+
+        QBENCHMARK {
+            Q_FOREACH(const QString &preedit, preedits) {
+                adapter.parse(preedit);
+            }
+            adapter.reset();
+        }
+    }
+
+    Q_SLOT void benchmarkAnthyParse_data()
+    {
+        QTest::addColumn<QString>("reading");
+
+        QTest::newRow("word") << QString::fromUtf8("こんにちは");
+        QTest::newRow("phrase") << QString::fromUtf8("わたしはほんをよみます");
+    }
+
+    Q_SLOT void benchmarkAnthyParse()
+    {
+        QFETCH(QString, reading);
+
+        AnthyAdapter adapter;
+        const QStringList preedits(keystrokes(reading));
+
+        QBENCHMARK {
+            Q_FOREACH(const QString &preedit, preedits) {
+                adapter.parse(preedit);
+            }
+        }
+    }
+};
+
+QTEST_MAIN(BenchmarkCjkAdapters)
+#include "bm_cjkadapters.moc"
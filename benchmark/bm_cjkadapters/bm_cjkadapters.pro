@@ -0,0 +1,34 @@
+TOP_BUILDDIR = $${OUT_PWD}/../..
+TOP_SRCDIR = $$PWD/../..
+
+include($${TOP_SRCDIR}/config.pri)
+
+TARGET = bm_cjkadapters
+include(../benchmark.pri)
+
+PLUGINS_DIR = $${TOP_SRCDIR}/plugins
+
+PINYIN_DATA_DIR = "$$system(pkg-config --variable pkgdatadir libpinyin)/data"
+DEFINES += PINYIN_DATA_DIR=\\\"$${PINYIN_DATA_DIR}\\\"
+
+INCLUDEPATH += \
+    $${PLUGINS_DIR}/pinyin/src \
+    $${PLUGINS_DIR}/chewing/src \
+    $${PLUGINS_DIR}/ja/src
+
+HEADERS += \
+    $${PLUGINS_DIR}/pinyin/src/pinyinadapter.h \
+    $${PLUGINS_DIR}/chewing/src/chewingadapter.h \
+    $${PLUGINS_DIR}/ja/src/anthyadapter.h \
+    $${TOP_SRCDIR}/src/lib/logic/learningstore.h
+
+SOURCES += \
+    bm_cjkadapters.cpp \
+    $${PLUGINS_DIR}/pinyin/src/pinyinadapter.cpp \
+    $${PLUGINS_DIR}/chewing/src/chewingadapter.cpp \
+    $${PLUGINS_DIR}/ja/src/anthyadapter.cpp \
+    $${TOP_SRCDIR}/src/lib/logic/learningstore.cpp
+
+CONFIG += link_pkgconfig
+PKGCONFIG += glib-2.0 libpinyin chewing
+LIBS += -lanthy -lanthydic
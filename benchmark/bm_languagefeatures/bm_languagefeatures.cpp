@@ -0,0 +1,128 @@
+/*
+ * Copyright (C) 2016 Canonical, Ltd.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this list
+ * of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice, this list
+ * of conditions and the following disclaimer in the documentation and/or other materials
+ * provided with the distribution.
+ * Neither the name of Nokia Corporation nor the names of its contributors may be
+ * used to endorse or promote products derived from this software without specific
+ * prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL
+ * THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#include "westernlanguagefeatures.h"
+#include "chineselanguagefeatures.h"
+#include "chewinglanguagefeatures.h"
+#include "japaneselanguagefeatures.h"
+#include "koreanlanguagefeatures.h"
+#include "emojilanguagefeatures.h"
+
+#include <QtCore>
+#include <QtTest>
+
+class BenchmarkLanguageFeatures
+    : public QObject
+{
+    Q_OBJECT
+
+private:
+    QMap<QString, AbstractLanguageFeatures *> m_features;
+
+    //! One row per language features class and typical text.
+    void addRows()
+    {
+        QTest::addColumn<QString>("features");
+        QTest::addColumn<QString>("text");
+
+        QTest::newRow("western word") << "western" << "Hello world";
+        QTest::newRow("western separator") << "western" << "Hello world, ";
+        QTest::newRow("western sentence end") << "western" << "Hello world. ";
+        QTest::newRow("chinese") << "chinese" << QString::fromUtf8("你好，");
+        QTest::newRow("chewing") << "chewing" << QString::fromUtf8("你好。");
+        QTest::newRow("japanese") << "japanese" << QString::fromUtf8("こんにちは。");
+        QTest::newRow("korean") << "korean" << QString::fromUtf8("안녕하세요. ");
+        QTest::newRow("emoji") << "emoji" << QString::fromUtf8("\xf0\x9f\x99\x82");
+    }
+
+    Q_SLOT void initTestCase()
+    {
+        m_features.insert("western", new WesternLanguageFeatures(this));
+        m_features.insert("chinese", new ChineseLanguageFeatures(this));
+        m_features.insert("chewing", new ChewingLanguageFeatures(this));
+        m_features.insert("japanese", new JapaneseLanguageFeatures(this));
+        m_features.insert("korean", new KoreanLanguageFeatures(this));
+        m_features.insert("emoji", new EmojiLanguageFeatures(this));
+    }
+
+    Q_SLOT void benchmarkIsSeparator_data()
+    {
+        addRows();
+    }
+
+    Q_SLOT void benchmarkIsSeparator()
+    {
+        QFETCH(QString, features);
+        QFETCH(QString, text);
+
+        const AbstractLanguageFeatures *const languageFeatures(m_features.value(features));
+        bool result = false;
+        QBENCHMARK {
+            result ^= languageFeatures->isSeparator(text);
+        }
+        Q_UNUSED(result);
+    }
+
+    Q_SLOT void benchmarkIsSymbol_data()
+    {
+        addRows();
+    }
+
+    Q_SLOT void benchmarkIsSymbol()
+    {
+        QFETCH(QString, features);
+        QFETCH(QString, text);
+
+        const AbstractLanguageFeatures *const languageFeatures(m_features.value(features));
+        bool result = false;
+        QBENCHMARK {
+            result ^= languageFeatures->isSymbol(text);
+        }
+        Q_UNUSED(result);
+    }
+
+    Q_SLOT void benchmarkActivateAutoCaps_data()
+    {
+        addRows();
+    }
+
+    Q_SLOT void benchmarkActivateAutoCaps()
+    {
+        QFETCH(QString, features);
+        QFETCH(QString, text);
+
+        const AbstractLanguageFeatures *const languageFeatures(m_features.value(features));
+        bool result = false;
+        QBENCHMARK {
+            result ^= languageFeatures->activateAutoCaps(text);
+        }
+        Q_UNUSED(result);
+    }
+};
+
+QTEST_MAIN(BenchmarkLanguageFeatures)
+#include "bm_languagefeatures.moc"
@@ -0,0 +1,34 @@
+TOP_BUILDDIR = $${OUT_PWD}/../..
+TOP_SRCDIR = $$PWD/../..
+
+include($${TOP_SRCDIR}/config.pri)
+
+TARGET = bm_languagefeatures
+include(../benchmark.pri)
+
+PLUGINS_DIR = $${TOP_SRCDIR}/plugins
+
+INCLUDEPATH += \
+    $${PLUGINS_DIR}/westernsupport \
+    $${PLUGINS_DIR}/pinyin/src \
+    $${PLUGINS_DIR}/chewing/src \
+    $${PLUGINS_DIR}/ja/src \
+    $${PLUGINS_DIR}/ko/src \
+    $${PLUGINS_DIR}/emoji/src
+
+HEADERS += \
+    $${PLUGINS_DIR}/westernsupport/westernlanguagefeatures.h \
+    $${PLUGINS_DIR}/pinyin/src/chineselanguagefeatures.h \
+    $${PLUGINS_DIR}/chewing/src/chewinglanguagefeatures.h \
+    $${PLUGINS_DIR}/ja/src/japaneselanguagefeatures.h \
+    $${PLUGINS_DIR}/ko/src/koreanlanguagefeatures.h \
+    $${PLUGINS_DIR}/emoji/src/emojilanguagefeatures.h
+
+SOURCES += \
+    bm_languagefeatures.cpp \
+    $${PLUGINS_DIR}/westernsupport/westernlanguagefeatures.cpp \
+    $${PLUGINS_DIR}/pinyin/src/chineselanguagefeatures.cpp \
+    $${PLUGINS_DIR}/chewing/src/chewinglanguagefeatures.cpp \
+    $${PLUGINS_DIR}/ja/src/japaneselanguagefeatures.cpp \
+    $${PLUGINS_DIR}/ko/src/koreanlanguagefeatures.cpp \
+    $${PLUGINS_DIR}/emoji/src/emojilanguagefeatures.cpp
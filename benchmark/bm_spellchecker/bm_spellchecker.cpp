@@ -0,0 +1,132 @@
+/*
+ * Copyright (C) 2016 Canonical, Ltd.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this list
+ * of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice, this list
+ * of conditions and the following disclaimer in the documentation and/or other materials
+ * provided with the distribution.
+ * Neither the name of Nokia Corporation nor the names of its contributors may be
+ * used to endorse or promote products derived from this software without specific
+ * prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL
+ * THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#include "spellchecker.h"
+
+#include <QtCore>
+#include <QtTest>
+
+class BenchmarkSpellChecker
+    : public QObject
+{
+    Q_OBJECT
+
+private:
+    QTemporaryDir m_dir;
+    SpellChecker *m_spellChecker;
+
+    //! Writes a hunspell dictionary with every word of the corpus.
+    void writeDictionary(const QString &affFile, const QString &dicFile)
+    {
+        QFile corpus(BENCHMARK_CORPUS);
+        QVERIFY(corpus.open(QIODevice::ReadOnly | QIODevice::Text));
+
+        QSet<QString> words;
+        const QRegExp nonLetters("[^\\w']+");
+        Q_FOREACH(const QString &word, QString::fromUtf8(corpus.readAll()).split(nonLetters, QString::SkipEmptyParts)) {
+            words.insert(word.toLower());
+        }
+
+        QFile aff(affFile);
+        QVERIFY(aff.open(QIODevice::WriteOnly | QIODevice::Text));
+        aff.write("SET UTF-8\nTRY esianrtolcdugmphbyfvkwzESIANRTOLCDUGMPHBYFVKWZ'\n");
+
+        QFile dic(dicFile);
+        QVERIFY(dic.open(QIODevice::WriteOnly | QIODevice::Text));
+        QTextStream out(&dic);
+        out.setCodec("UTF-8");
+        out << words.size() << '\n';
+        Q_FOREACH(const QString &word, words) {
+            out << word << '\n';
+        }
+    }
+
+    Q_SLOT void initTestCase()
+    {
+        QStandardPaths::setTestModeEnabled(true);
+        QVERIFY(m_dir.isValid());
+
+        const QString affFile(m_dir.path() + "/en_US.aff");
+        const QString dicFile(m_dir.path() + "/en_US.dic");
+        writeDictionary(affFile, dicFile);
+
+        m_spellChecker = new SpellChecker(m_dir.path() + "/userwords.txt");
+        m_spellChecker->setDictionary("en", affFile, dicFile);
+        QVERIFY(m_spellChecker->setLanguage("en"));
+        QVERIFY(m_spellChecker->setEnabled(true));
+    }
+
+    Q_SLOT void cleanupTestCase()
+    {
+        delete m_spellChecker;
+    }
+
+    void addWords()
+    {
+        QTest::addColumn<QString>("word");
+
+        QTest::newRow("correct") << "beautiful";
+        QTest::newRow("typo") << "beuatiful";
+        QTest::newRow("short") << "teh";
+        QTest::newRow("unknown") << "qwertzuiop";
+    }
+
+    Q_SLOT void benchmarkSpell_data()
+    {
+        addWords();
+    }
+
+    Q_SLOT void benchmarkSpell()
+    {
+        QFETCH(QString, word);
+
+        bool correct = false;
+        QBENCHMARK {
+            correct ^= m_spellChecker->spell(word);
+        }
+        Q_UNUSED(correct);
+    }
+
+    Q_SLOT void benchmarkSuggest_data()
+    {
+        addWords();
+    }
+
+    Q_SLOT void benchmarkSuggest()
+    {
+        QFETCH(QString, word);
+
+        int count = 0;
+        QBENCHMARK {
+            count += m_spellChecker->suggest(word, 5).size();
+        }
+        Q_UNUSED(count);
+    }
+};
+
+QTEST_MAIN(BenchmarkSpellChecker)
+#include "bm_spellchecker.moc"
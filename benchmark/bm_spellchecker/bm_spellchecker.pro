@@ -0,0 +1,22 @@
+TOP_BUILDDIR = $${OUT_PWD}/../..
+TOP_SRCDIR = $$PWD/../..
+
+include($${TOP_SRCDIR}/config.pri)
+
+TARGET = bm_spellchecker
+include(../benchmark.pri)
+
+# The dictionary is built from the corpus of the English plugin, so the
+# results do not depend on the dictionaries installed.
+DEFINES += BENCHMARK_CORPUS=\\\"$${TOP_SRCDIR}/plugins/en/src/the_picture_of_dorian_gray.txt\\\"
+
+INCLUDEPATH += $${TOP_SRCDIR}/plugins/westernsupport
+
+LIBS += -L$${TOP_BUILDDIR}/plugins/plugins -lwesternsupport
+PRE_TARGETDEPS += $${TOP_BUILDDIR}/plugins/plugins/$$maliitStaticLib(westernsupport)
+
+CONFIG += link_pkgconfig
+PKGCONFIG += hunspell
+
+SOURCES += \
+    bm_spellchecker.cpp
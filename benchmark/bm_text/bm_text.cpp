@@ -0,0 +1,159 @@
+/*
+ * Copyright (C) 2016 Canonical, Ltd.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this list
+ * of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice, this list
+ * of conditions and the following disclaimer in the documentation and/or other materials
+ * provided with the distribution.
+ * Neither the name of Nokia Corporation nor the names of its contributors may be
+ * used to endorse or promote products derived from this software without specific
+ * prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL
+ * THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#include "models/text.h"
+
+#include <QtCore>
+#include <QtTest>
+
+namespace MaliitKeyboard {
+namespace {
+
+const char *const Paragraph =
+    "The artist is the creator of beautiful things. To reveal art and "
+    "conceal the artist is art's aim.\nThe critic is he who can translate "
+    "into another manner or a new material his impression of beautiful "
+    "things. ";
+
+QString surroundingText(int length)
+{
+    QString text;
+    while (text.length() < length) {
+        text += QString::fromLatin1(Paragraph);
+    }
+    text.truncate(length);
+    return text;
+}
+
+} // unnamed namespace
+
+class BenchmarkText
+    : public QObject
+{
+    Q_OBJECT
+
+private:
+    void addLengths()
+    {
+        QTest::addColumn<int>("length");
+
+        QTest::newRow("short") << 100;
+        QTest::newRow("message") << 1000;
+        QTest::newRow("document") << 10000;
+    }
+
+    Q_SLOT void benchmarkTypeWord()
+    {
+        Model::Text text;
+        const QString word("beautiful");
+
+        QBENCHMARK {
+            Q_FOREACH(const QChar &c, word) {
+                text.appendToPreedit(c);
+            }
+            while (text.removeFromPreedit(1)) {}
+        }
+    }
+
+    Q_SLOT void benchmarkSetSurroundingKeystroke_data()
+    {
+        addLengths();
+    }
+
+    //! The surrounding text grows by a character per keystroke.
+    Q_SLOT void benchmarkSetSurroundingKeystroke()
+    {
+        QFETCH(int, length);
+
+        Model::Text text;
+        const QString before(surroundingText(length));
+        const QString after(before + QLatin1Char('x'));
+        text.setSurrounding(before);
+
+        QBENCHMARK {
+            text.setSurrounding(after);
+            text.setSurrounding(before);
+        }
+    }
+
+    Q_SLOT void benchmarkSetSurroundingReplaced_data()
+    {
+        addLengths();
+    }
+
+    //! The editor switched to different text.
+    Q_SLOT void benchmarkSetSurroundingReplaced()
+    {
+        QFETCH(int, length);
+
+        Model::Text text;
+        const QString surrounding(surroundingText(length));
+        const QString other(QLatin1Char('>') + surrounding);
+
+        QBENCHMARK {
+            text.setSurrounding(surrounding);
+            text.setSurrounding(other);
+        }
+    }
+
+    Q_SLOT void benchmarkBoundaries_data()
+    {
+        addLengths();
+    }
+
+    Q_SLOT void benchmarkBoundaries()
+    {
+        QFETCH(int, length);
+
+        Model::Text text;
+        text.setSurrounding(surroundingText(length));
+        text.setSurroundingOffset(length);
+
+        int result = 0;
+        QBENCHMARK {
+            result += text.lastWord().length();
+            result += text.sentenceStart();
+            result += text.lineStart();
+        }
+        QVERIFY(result > 0);
+    }
+
+    Q_SLOT void benchmarkCommitPreedit()
+    {
+        Model::Text text;
+
+        QBENCHMARK {
+            text.setPreedit("beautiful");
+            text.commitPreedit();
+        }
+    }
+};
+
+} // namespace MaliitKeyboard
+
+QTEST_MAIN(MaliitKeyboard::BenchmarkText)
+#include "bm_text.moc"
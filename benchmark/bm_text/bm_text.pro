@@ -0,0 +1,13 @@
+TOP_BUILDDIR = $${OUT_PWD}/../..
+TOP_SRCDIR = $$PWD/../..
+
+include($${TOP_SRCDIR}/config.pri)
+
+TARGET = bm_text
+include(../benchmark.pri)
+
+QMAKE_LFLAGS_RPATH=$${TOP_BUILDDIR}/src/plugin
+LIBS += -L$${TOP_BUILDDIR}/src/plugin -lubuntu-keyboard-plugin
+
+SOURCES += \
+    bm_text.cpp
@@ -0,0 +1,69 @@
+/*
+ * Copyright (C) 2016 Canonical, Ltd.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this list
+ * of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice, this list
+ * of conditions and the following disclaimer in the documentation and/or other materials
+ * provided with the distribution.
+ * Neither the name of Nokia Corporation nor the names of its contributors may be
+ * used to endorse or promote products derived from this software without specific
+ * prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL
+ * THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#include "logic/wordengine.h"
+
+#include <QtCore>
+#include <QtTest>
+
+namespace MaliitKeyboard {
+
+class BenchmarkWordEngine
+    : public QObject
+{
+    Q_OBJECT
+
+private:
+    Q_SLOT void benchmarkSimilarWords_data()
+    {
+        QTest::addColumn<QString>("word");
+        QTest::addColumn<QString>("prediction");
+
+        QTest::newRow("same") << "beauti" << "beautiful";
+        QTest::newRow("typo") << "beuati" << "beautiful";
+        QTest::newRow("different") << "thing" << "creator";
+        QTest::newRow("long") << "impressionistical" << "impressionistically";
+    }
+
+    //! Called for the first two candidates of every word that is typed.
+    Q_SLOT void benchmarkSimilarWords()
+    {
+        QFETCH(QString, word);
+        QFETCH(QString, prediction);
+
+        bool similar = false;
+        QBENCHMARK {
+            similar ^= Logic::WordEngine::similarWords(word, prediction);
+        }
+        Q_UNUSED(similar);
+    }
+};
+
+} // namespace MaliitKeyboard
+
+QTEST_MAIN(MaliitKeyboard::BenchmarkWordEngine)
+#include "bm_wordengine.moc"
@@ -0,0 +1,89 @@
+/*
+ * Copyright (C) 2016 Canonical, Ltd.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this list
+ * of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice, this list
+ * of conditions and the following disclaimer in the documentation and/or other materials
+ * provided with the distribution.
+ * Neither the name of Nokia Corporation nor the names of its contributors may be
+ * used to endorse or promote products derived from this software without specific
+ * prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL
+ * THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#include "models/wordribbon.h"
+
+#include <QtCore>
+#include <QtTest>
+
+namespace MaliitKeyboard {
+namespace {
+
+WordCandidateList candidateList(int count)
+{
+    WordCandidateList candidates;
+    candidates.append(WordCandidate(WordCandidate::SourceUser, "beauti"));
+    for (int i = 1; i < count; ++i) {
+        candidates.append(WordCandidate(WordCandidate::SourcePrediction,
+                                        QString("beautiful%1").arg(i)));
+    }
+    return candidates;
+}
+
+} // unnamed namespace
+
+class BenchmarkWordRibbon
+    : public QObject
+{
+    Q_OBJECT
+
+private:
+    Q_SLOT void benchmarkCandidatesChanged_data()
+    {
+        QTest::addColumn<int>("count");
+
+        // A page of predictions, a full first page and several pages
+        QTest::newRow("few") << 3;
+        QTest::newRow("page") << 10;
+        QTest::newRow("pages") << 50;
+    }
+
+    //! Also reads back every word, as the ribbon's ListView does.
+    Q_SLOT void benchmarkCandidatesChanged()
+    {
+        QFETCH(int, count);
+
+        WordRibbon ribbon;
+        const WordCandidateList candidates(candidateList(count));
+        const WordCandidateList next(candidateList(count - 1));
+
+        int rows = 0;
+        QBENCHMARK {
+            ribbon.onWordCandidatesChanged(candidates);
+            for (int i = 0; i < ribbon.rowCount(); ++i) {
+                rows += ribbon.data(ribbon.index(i), WordRibbon::WordRole).toString().isEmpty() ? 0 : 1;
+            }
+            ribbon.onWordCandidatesChanged(next);
+        }
+        QVERIFY(rows > 0);
+    }
+};
+
+} // namespace MaliitKeyboard
+
+QTEST_MAIN(MaliitKeyboard::BenchmarkWordRibbon)
+#include "bm_wordribbon.moc"
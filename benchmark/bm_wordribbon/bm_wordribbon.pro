@@ -0,0 +1,15 @@
+TOP_BUILDDIR = $${OUT_PWD}/../..
+TOP_SRCDIR = $$PWD/../..
+
+include($${TOP_SRCDIR}/config.pri)
+
+TARGET = bm_wordribbon
+include(../benchmark.pri)
+
+QT += gui
+
+QMAKE_LFLAGS_RPATH=$${TOP_BUILDDIR}/src/plugin
+LIBS += -L$${TOP_BUILDDIR}/src/plugin -lubuntu-keyboard-plugin
+
+SOURCES += \
+    bm_wordribbon.cpp
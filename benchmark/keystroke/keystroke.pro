@@ -0,0 +1,37 @@
+TOP_BUILDDIR = $${OUT_PWD}/../..
+TOP_SRCDIR = $$PWD/../..
+
+include($${TOP_SRCDIR}/config.pri)
+
+TEMPLATE = app
+TARGET = ubuntu-keyboard-keystroke-benchmark
+
+# The stand-in host of the unit tests takes the place of maliit-server.
+CONFIG += maliit-plugins
+INCLUDEPATH += $${TOP_SRCDIR}/src/lib $${TOP_SRCDIR}/src $${TOP_SRCDIR}/tests/unittests/common
+LIBS += \
+    $${TOP_BUILDDIR}/tests/unittests/common/$$maliitStaticLib(tests-common) \
+    $${TOP_BUILDDIR}/$${UBUNTU_KEYBOARD_PLUGIN_LIB} \
+    $${TOP_BUILDDIR}/$${UBUNTU_KEYBOARD_VIEW_LIB} \
+    $${TOP_BUILDDIR}/$${UBUNTU_KEYBOARD_LIB} \
+    -lgsettings-qt
+PRE_TARGETDEPS += \
+    $${TOP_BUILDDIR}/tests/unittests/common/$$maliitStaticLib(tests-common) \
+    $${TOP_BUILDDIR}/$${UBUNTU_KEYBOARD_PLUGIN_LIB} \
+    $${TOP_BUILDDIR}/$${UBUNTU_KEYBOARD_VIEW_LIB} \
+    $${TOP_BUILDDIR}/$${UBUNTU_KEYBOARD_LIB}
+HEADERS += allocationcounter.h
+SOURCES += main.cpp allocationcounter.c
+
+QT += core gui widgets quick qml
+
+include($${TOP_SRCDIR}/word-prediction.pri)
+
+isEmpty(BENCHMARK_RESULTS_DIR): BENCHMARK_RESULTS_DIR = $${TOP_BUILDDIR}/benchmark/results
+
+QMAKE_EXTRA_TARGETS += bench
+bench.target = bench
+bench.depends = $$TARGET
+bench.commands = \
+    $(MKDIR) $$BENCHMARK_RESULTS_DIR && \
+    ./$$TARGET --json $$BENCHMARK_RESULTS_DIR/keystroke.json
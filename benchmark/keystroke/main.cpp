@@ -0,0 +1,309 @@
+/*
+ * Copyright (C) 2016 Canonical, Ltd.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this list
+ * of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice, this list
+ * of conditions and the following disclaimer in the documentation and/or other materials
+ * provided with the distribution.
+ * Neither the name of Nokia Corporation nor the names of its contributors may be
+ * used to endorse or promote products derived from this software without specific
+ * prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL
+ * THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#include "plugin/inputmethod.h"
+#include "models/wordcandidate.h"
+#include "inputmethodhostprobe.h"
+#include "allocationcounter.h"
+
+#include <QApplication>
+#include <QCommandLineParser>
+#include <QElapsedTimer>
+#include <QEventLoop>
+#include <QFile>
+#include <QGSettings/QGSettings>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QQmlContext>
+#include <QQuickView>
+#include <QtMath>
+#include <QTimer>
+
+#include <cstdio>
+
+//! Times keystrokes the way the keys of the keyboard send them: through
+//! the event handler, the editor and the word engine, until the word
+//! ribbon has the candidates for the new preedit. Also counts the memory
+//! allocations made meanwhile, by all threads. The first time the text is
+//! typed warms up the word engine and is not counted.
+
+using namespace MaliitKeyboard;
+
+namespace {
+
+const char *const DefaultText = "the artist is the creator of beautiful things ";
+
+//! Host that asks for predictions in a plain text field.
+class BenchmarkHost
+    : public InputMethodHostProbe
+{
+public:
+    int contentType(bool &valid) { valid = true; return Maliit::FreeTextContentType; }
+    bool predictionEnabled(bool &valid) { valid = true; return true; }
+};
+
+double msecs(const QElapsedTimer &timer)
+{
+    return timer.nsecsElapsed() / 1000000.0;
+}
+
+//! Nearest rank percentile of sorted \a values.
+double percentile(const QList<double> &values, int percent)
+{
+    if (values.isEmpty()) {
+        return -1;
+    }
+
+    const int rank = qCeil(values.size() * percent / 100.0);
+    return values.at(qBound(0, rank - 1, values.size() - 1));
+}
+
+bool verbose = false;
+
+void messageHandler(QtMsgType type, const QMessageLogContext &context, const QString &message)
+{
+    Q_UNUSED(context)
+
+    // The keyboard logs every keystroke, which would bury the results.
+    if (type != QtDebugMsg || verbose) {
+        fprintf(stderr, "%s\n", qPrintable(message));
+    }
+}
+
+} // unnamed namespace
+
+//! Waits for the first non-empty list of candidates from the word engine.
+//! WordEngine::fetchCandidates() synchronously re-emits the previous
+//! candidates while the key is dispatched, so only lists arriving after
+//! reset() count.
+class CandidateWatcher
+    : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit CandidateWatcher(QObject *wordEngine)
+        : m_arrived(false)
+    {
+        connect(wordEngine, SIGNAL(candidatesChanged(WordCandidateList)),
+                this, SLOT(onCandidatesChanged(WordCandidateList)));
+    }
+
+    void reset()
+    {
+        m_arrived = false;
+    }
+
+    bool wait(int timeout)
+    {
+        QTimer timer;
+        timer.setSingleShot(true);
+        connect(&timer, SIGNAL(timeout()), &m_loop, SLOT(quit()));
+        timer.start(timeout);
+
+        if (!m_arrived) {
+            m_loop.exec();
+        }
+
+        return m_arrived;
+    }
+
+private:
+    Q_SLOT void onCandidatesChanged(const WordCandidateList &candidates)
+    {
+        if (!candidates.isEmpty()) {
+            m_arrived = true;
+            m_loop.quit();
+        }
+    }
+
+    bool m_arrived;
+    QEventLoop m_loop;
+};
+
+int main(int argc,
+         char ** argv)
+{
+    // Keep the keystrokes away from the user's settings.
+    if (qgetenv("GSETTINGS_BACKEND").isEmpty()) {
+        qputenv("GSETTINGS_BACKEND", "memory");
+    }
+    if (qgetenv("QT_QPA_PLATFORM").isEmpty()) {
+        qputenv("QT_QPA_PLATFORM", "offscreen");
+    }
+
+    QApplication app(argc, argv);
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Times keystrokes and counts their allocations.");
+    parser.addHelpOption();
+    QCommandLineOption roundsOption("rounds", "Times the text is typed, after warming up.", "count", "5");
+    QCommandLineOption languageOption("language", "Language to type in.", "language", "en");
+    QCommandLineOption textOption("text", "Text to type, spaces included.", "text", DefaultText);
+    QCommandLineOption timeoutOption("timeout", "Longest wait for candidates, in ms.", "ms", "1000");
+    QCommandLineOption pluginPathOption("plugin-path", "Additional directory with language plugins.", "path");
+    QCommandLineOption jsonOption("json", "Also write the results to file as JSON.", "file");
+    QCommandLineOption verboseOption("verbose", "Show the keyboard's debug output.");
+    parser.addOption(roundsOption);
+    parser.addOption(languageOption);
+    parser.addOption(textOption);
+    parser.addOption(timeoutOption);
+    parser.addOption(pluginPathOption);
+    parser.addOption(jsonOption);
+    parser.addOption(verboseOption);
+    parser.process(app);
+
+    verbose = parser.isSet(verboseOption);
+    qInstallMessageHandler(messageHandler);
+
+    const int rounds = qMax(1, parser.value(roundsOption).toInt());
+    const int timeout = parser.value(timeoutOption).toInt();
+    const QString language(parser.value(languageOption));
+    const QString text(parser.value(textOption));
+
+    QGSettings settings("com.canonical.keyboard.maliit", "/com/canonical/keyboard/maliit/");
+    settings.set("pluginPaths", parser.values(pluginPathOption));
+    settings.set("enabledLanguages", QStringList(language));
+    settings.set("activeLanguage", language);
+    settings.set("predictiveText", true);
+    settings.set("spellChecking", true);
+    settings.set("autoCapitalization", false);
+
+    BenchmarkHost host;
+    InputMethod inputMethod(&host);
+    inputMethod.show();
+
+    QObject *wordEngine = 0;
+    QObject *eventHandler = 0;
+    Q_FOREACH(QWindow *window, QGuiApplication::allWindows()) {
+        if (QQuickView *view = qobject_cast<QQuickView *>(window)) {
+            wordEngine = view->rootContext()->contextProperty("maliit_word_engine").value<QObject *>();
+            eventHandler = view->rootContext()->contextProperty("maliit_event_handler").value<QObject *>();
+        }
+    }
+
+    if (!wordEngine || !eventHandler) {
+        fprintf(stderr, "No word engine or event handler found\n");
+        return 1;
+    }
+
+    CandidateWatcher watcher(wordEngine);
+    const bool predicting = wordEngine->property("enabled").toBool();
+
+    QList<double> latencies;
+    QList<double> allocations;
+    int timeouts = 0;
+
+    for (int round = 0; round <= rounds; ++round) {
+        Q_FOREACH(const QChar &character, text) {
+            const bool space = character.isSpace();
+            const QString label(space ? QString() : QString(character));
+            const QString action(space ? "space" : "");
+
+            const long allocationsBefore = allocationCount();
+            QElapsedTimer timer;
+            timer.start();
+
+            // The space key only sends a release
+            if (!space) {
+                QMetaObject::invokeMethod(eventHandler, "onKeyPressed",
+                                          Q_ARG(QString, label), Q_ARG(QString, action));
+            }
+            QMetaObject::invokeMethod(eventHandler, "onKeyReleased",
+                                      Q_ARG(QString, label), Q_ARG(QString, action));
+
+            // The engine answers from its worker thread, through the event
+            // loop, so whatever was emitted until here is stale
+            watcher.reset();
+
+            if (predicting && !space) {
+                if (!watcher.wait(timeout)) {
+                    ++timeouts;
+                }
+            } else {
+                app.processEvents();
+            }
+
+            const double latency = msecs(timer);
+            const long allocated = allocationCount() - allocationsBefore;
+
+            if (round > 0) {
+                latencies.append(latency);
+                allocations.append(allocated);
+            }
+        }
+    }
+
+    qSort(latencies);
+    qSort(allocations);
+
+    QJsonObject latency;
+    latency["p50"] = percentile(latencies, 50);
+    latency["p90"] = percentile(latencies, 90);
+    latency["p99"] = percentile(latencies, 99);
+    latency["max"] = latencies.isEmpty() ? -1 : latencies.last();
+
+    double allocationSum = 0;
+    Q_FOREACH(double count, allocations) {
+        allocationSum += count;
+    }
+
+    // Negative when allocations cannot be counted on this platform
+    QJsonObject allocation;
+    allocation["median"] = allocationCount() < 0 ? -1 : percentile(allocations, 50);
+    allocation["mean"] = allocationCount() < 0 || allocations.isEmpty() ? -1 : allocationSum / allocations.size();
+
+    printf("%d keystrokes in %s, %d without candidates in time\n",
+           latencies.size(), qPrintable(language), timeouts);
+    printf("latency    p50 %.2f ms, p90 %.2f ms, p99 %.2f ms, max %.2f ms\n",
+           latency["p50"].toDouble(), latency["p90"].toDouble(),
+           latency["p99"].toDouble(), latency["max"].toDouble());
+    printf("allocations per keystroke median %.0f, mean %.1f\n",
+           allocation["median"].toDouble(), allocation["mean"].toDouble());
+
+    if (parser.isSet(jsonOption)) {
+        QJsonObject root;
+        root["benchmark"] = QString("keystroke");
+        root["language"] = language;
+        root["rounds"] = rounds;
+        root["keystrokes"] = latencies.size();
+        root["timeouts"] = timeouts;
+        root["latency_ms"] = latency;
+        root["allocations"] = allocation;
+
+        QFile file(parser.value(jsonOption));
+        if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+            fprintf(stderr, "Cannot write %s\n", qPrintable(file.fileName()));
+            return 1;
+        }
+        file.write(QJsonDocument(root).toJson());
+    }
+
+    return 0;
+}
+
+#include "main.moc"
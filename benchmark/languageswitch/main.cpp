@@ -0,0 +1,397 @@
+// -*- mode: C++; c-basic-offset: 4; indent-tabs-mode: nil; c-file-offsets: ((innamespace . 0)); -*-
+/*
+ * This file is part of Maliit Plugins
+ *
+ * Copyright (C) 2011 Nokia Corporation and/or its subsidiary(-ies). All rights reserved.
+ *
+ * Contact: Mohammad Anwari <Mohammad.Anwari@nokia.com>
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this list
+ * of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice, this list
+ * of conditions and the following disclaimer in the documentation and/or other materials
+ * provided with the distribution.
+ * Neither the name of Nokia Corporation nor the names of its contributors may be
+ * used to endorse or promote products derived from this software without specific
+ * prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL
+ * THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+
+#include "plugin/inputmethod.h"
+#include "models/wordcandidate.h"
+#include "inputmethodhostprobe.h"
+
+#include <QApplication>
+#include <QCommandLineParser>
+#include <QDir>
+#include <QElapsedTimer>
+#include <QEventLoop>
+#include <QFile>
+#include <QGSettings/QGSettings>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QQmlContext>
+#include <QQuickView>
+#include <QTimer>
+
+#include <cstdio>
+
+//! Times a language switch the way the keyboard goes through it:
+//! InputMethod::setActiveLanguage, loading the language plugin in the word
+//! engine, initializing its dictionaries and the first candidates for a
+//! word typed right after the switch. Every language plugin found is
+//! visited in turn, the first visit counting as cold and the following
+//! rounds as warm. The keyboard starts on a language that is not measured,
+//! so that every first visit is a real switch.
+
+using namespace MaliitKeyboard;
+
+namespace {
+
+//! Host that asks for predictions in a plain text field.
+class BenchmarkHost
+    : public InputMethodHostProbe
+{
+public:
+    int contentType(bool &valid) { valid = true; return Maliit::FreeTextContentType; }
+    bool predictionEnabled(bool &valid) { valid = true; return true; }
+};
+
+struct Sample
+{
+    Sample()
+        : switchMsecs(0)
+        , candidatesMsecs(-1)
+        , rssDeltaKb(0)
+    {}
+
+    //! -1 if the language was not switched to.
+    double switchMsecs;
+    //! -1 if the language has no word engine or nothing came in.
+    double candidatesMsecs;
+    qint64 rssDeltaKb;
+};
+
+qint64 residentKb()
+{
+    QFile status("/proc/self/status");
+    if (!status.open(QIODevice::ReadOnly | QIODevice::Text)) {
+        return 0;
+    }
+
+    Q_FOREACH(const QByteArray &line, status.readAll().split('\n')) {
+        if (line.startsWith("VmRSS:")) {
+            return line.mid(6).trimmed().split(' ').first().toLongLong();
+        }
+    }
+
+    return 0;
+}
+
+double msecs(const QElapsedTimer &timer)
+{
+    return timer.nsecsElapsed() / 1000000.0;
+}
+
+//! Languages are found the same way InputMethod::onLanguageChanged looks
+//! for their plugins.
+QStringList findLanguages(const QStringList &pluginPaths)
+{
+    QStringList languages;
+
+    Q_FOREACH(const QString &pluginPath, pluginPaths) {
+        Q_FOREACH(const QString &language, QDir(pluginPath).entryList(QDir::Dirs | QDir::NoDotAndDotDot, QDir::Name)) {
+            const QString plugin(pluginPath + QDir::separator() + language + QDir::separator()
+                                 + "lib" + language + "plugin.so");
+            if (!languages.contains(language) && QFile::exists(plugin)) {
+                languages.append(language);
+            }
+        }
+    }
+
+    return languages;
+}
+
+//! Something each engine has candidates for.
+QString sampleWord(const QString &language)
+{
+    if (language == "ja") {
+        return QString::fromUtf8("か");
+    } else if (language == "zh-hans") {
+        return "ni";
+    } else if (language == "zh-hant") {
+        return QString::fromUtf8("ㄋ");
+    }
+
+    return "the";
+}
+
+double median(QList<double> values)
+{
+    if (values.isEmpty()) {
+        return -1;
+    }
+
+    qSort(values);
+    const int middle = values.size() / 2;
+    return values.size() % 2 ? values.at(middle) : (values.at(middle - 1) + values.at(middle)) / 2;
+}
+
+QJsonObject toJson(const Sample &sample)
+{
+    QJsonObject object;
+    object["switch_ms"] = sample.switchMsecs;
+    object["first_candidates_ms"] = sample.candidatesMsecs;
+    object["rss_delta_kb"] = sample.rssDeltaKb;
+    return object;
+}
+
+bool verbose = false;
+
+void messageHandler(QtMsgType type, const QMessageLogContext &context, const QString &message)
+{
+    Q_UNUSED(context)
+
+    // The keyboard is chatty about every switch, which would bury the results.
+    if (type != QtDebugMsg || verbose) {
+        fprintf(stderr, "%s\n", qPrintable(message));
+    }
+}
+
+} // unnamed namespace
+
+//! Waits for the first non-empty list of candidates from the word engine.
+class CandidateWatcher
+    : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit CandidateWatcher(QObject *wordEngine)
+        : m_arrived(false)
+    {
+        connect(wordEngine, SIGNAL(candidatesChanged(WordCandidateList)),
+                this, SLOT(onCandidatesChanged(WordCandidateList)));
+    }
+
+    bool wait(int timeout)
+    {
+        m_arrived = false;
+
+        QTimer timer;
+        timer.setSingleShot(true);
+        connect(&timer, SIGNAL(timeout()), &m_loop, SLOT(quit()));
+        timer.start(timeout);
+
+        if (!m_arrived) {
+            m_loop.exec();
+        }
+
+        return m_arrived;
+    }
+
+private:
+    Q_SLOT void onCandidatesChanged(const WordCandidateList &candidates)
+    {
+        if (!candidates.isEmpty()) {
+            m_arrived = true;
+            m_loop.quit();
+        }
+    }
+
+    bool m_arrived;
+    QEventLoop m_loop;
+};
+
+int main(int argc,
+         char ** argv)
+{
+    // Keep the switches away from the user's settings.
+    if (qgetenv("GSETTINGS_BACKEND").isEmpty()) {
+        qputenv("GSETTINGS_BACKEND", "memory");
+    }
+    if (qgetenv("QT_QPA_PLATFORM").isEmpty()) {
+        qputenv("QT_QPA_PLATFORM", "offscreen");
+    }
+
+    QApplication app(argc, argv);
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Times switching between the installed keyboard languages.");
+    parser.addHelpOption();
+    QCommandLineOption roundsOption("rounds", "Warm rounds through all languages.", "count", "3");
+    QCommandLineOption timeoutOption("timeout", "Longest wait for candidates, in ms.", "ms", "10000");
+    QCommandLineOption pluginPathOption("plugin-path", "Additional directory with language plugins.", "path");
+    QCommandLineOption jsonOption("json", "Also write the results to file as JSON.", "file");
+    QCommandLineOption verboseOption("verbose", "Show the keyboard's debug output.");
+    parser.addOption(roundsOption);
+    parser.addOption(timeoutOption);
+    parser.addOption(pluginPathOption);
+    parser.addOption(jsonOption);
+    parser.addOption(verboseOption);
+    parser.addPositionalArgument("languages", "Languages to switch between, all found by default.", "[language...]");
+    parser.process(app);
+
+    verbose = parser.isSet(verboseOption);
+    qInstallMessageHandler(messageHandler);
+
+    const int rounds = qMax(0, parser.value(roundsOption).toInt());
+    const int timeout = parser.value(timeoutOption).toInt();
+
+    QStringList pluginPaths;
+    const QString prefix(qgetenv("KEYBOARD_PREFIX_PATH"));
+    pluginPaths.append((prefix.isEmpty() ? QString() : prefix + QDir::separator())
+                       + QString(UBUNTU_KEYBOARD_DATA_DIR) + QDir::separator() + "lib");
+    pluginPaths.append(parser.values(pluginPathOption));
+
+    const QStringList installedLanguages(findLanguages(pluginPaths));
+    QStringList languages(parser.positionalArguments());
+    if (languages.isEmpty()) {
+        languages = installedLanguages;
+    }
+
+    // no sense in benchmarking one language - nothing would be switched
+    if (languages.size() < 2) {
+        fprintf(stderr, "Need at least two languages, found: %s\n", qPrintable(languages.join(" ")));
+        return 1;
+    }
+
+    // The language the keyboard comes up with is loaded before anything is
+    // timed, so if possible start with one that is not measured. Otherwise
+    // the first visit of the last language is no switch at all.
+    QString startLanguage(languages.last());
+    Q_FOREACH(const QString &language, installedLanguages) {
+        if (!languages.contains(language)) {
+            startLanguage = language;
+            break;
+        }
+    }
+
+    QStringList enabledLanguages(languages);
+    if (!enabledLanguages.contains(startLanguage)) {
+        enabledLanguages.prepend(startLanguage);
+    }
+
+    QGSettings settings("com.canonical.keyboard.maliit", "/com/canonical/keyboard/maliit/");
+    settings.set("pluginPaths", parser.values(pluginPathOption));
+    settings.set("enabledLanguages", enabledLanguages);
+    settings.set("activeLanguage", startLanguage);
+    settings.set("predictiveText", true);
+    settings.set("spellChecking", true);
+
+    BenchmarkHost host;
+    InputMethod inputMethod(&host);
+    inputMethod.show();
+
+    QObject *wordEngine = 0;
+    Q_FOREACH(QWindow *window, QGuiApplication::allWindows()) {
+        if (QQuickView *view = qobject_cast<QQuickView *>(window)) {
+            wordEngine = view->rootContext()->contextProperty("maliit_word_engine").value<QObject *>();
+        }
+    }
+
+    if (!wordEngine) {
+        fprintf(stderr, "No word engine found\n");
+        return 1;
+    }
+
+    CandidateWatcher watcher(wordEngine);
+    QMap<QString, Sample> cold;
+    QMap<QString, QList<Sample> > warm;
+
+    for (int round = 0; round <= rounds; ++round) {
+        Q_FOREACH(const QString &language, languages) {
+            Sample sample;
+
+            if (round == 0 && language == startLanguage) {
+                sample.switchMsecs = -1;
+                cold[language] = sample;
+                continue;
+            }
+
+            const qint64 rssBefore = residentKb();
+
+            QElapsedTimer timer;
+            timer.start();
+            inputMethod.setActiveLanguage(language);
+            sample.switchMsecs = msecs(timer);
+
+            if (wordEngine->property("enabled").toBool()) {
+                inputMethod.replacePreedit(sampleWord(language));
+                if (watcher.wait(timeout)) {
+                    sample.candidatesMsecs = msecs(timer);
+                }
+            }
+
+            sample.rssDeltaKb = residentKb() - rssBefore;
+
+            if (round == 0) {
+                cold[language] = sample;
+            } else {
+                warm[language].append(sample);
+            }
+        }
+    }
+
+    printf("%-10s %12s %12s %10s %12s %12s %10s\n", "language",
+           "cold switch", "cold cand.", "cold RSS", "warm switch", "warm cand.", "warm RSS");
+
+    QJsonObject results;
+    Q_FOREACH(const QString &language, languages) {
+        QList<double> switches;
+        QList<double> candidates;
+        QList<double> rss;
+        Q_FOREACH(const Sample &sample, warm.value(language)) {
+            switches.append(sample.switchMsecs);
+            candidates.append(sample.candidatesMsecs);
+            rss.append(sample.rssDeltaKb);
+        }
+
+        Sample warmMedian;
+        warmMedian.switchMsecs = median(switches);
+        warmMedian.candidatesMsecs = median(candidates);
+        warmMedian.rssDeltaKb = median(rss);
+
+        const Sample &coldSample(cold[language]);
+        printf("%-10s %9.1f ms %9.1f ms %7lld kB %9.1f ms %9.1f ms %7lld kB\n", qPrintable(language),
+               coldSample.switchMsecs, coldSample.candidatesMsecs, coldSample.rssDeltaKb,
+               warmMedian.switchMsecs, warmMedian.candidatesMsecs, warmMedian.rssDeltaKb);
+
+        QJsonObject result;
+        result["cold"] = toJson(coldSample);
+        result["warm"] = toJson(warmMedian);
+        results[language] = result;
+    }
+
+    if (parser.isSet(jsonOption)) {
+        QJsonObject root;
+        root["benchmark"] = QString("language-switch");
+        root["rounds"] = rounds;
+        root["languages"] = results;
+
+        QFile file(parser.value(jsonOption));
+        if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+            fprintf(stderr, "Cannot write %s\n", qPrintable(file.fileName()));
+            return 1;
+        }
+        file.write(QJsonDocument(root).toJson());
+    }
+
+    return 0;
+}
+
+#include "main.moc"
@@ -0,0 +1,362 @@
+#!/usr/bin/python3
+#
+# Runs the keyboard's benchmarks several times and compares the median of
+# every metric with the baseline in benchmark/baseline.json.
+#
+# A metric regresses when its median grows by more than its tolerance plus
+# three times the larger median absolute deviation (MAD) of the baseline
+# and the new runs. The tolerance is a fraction of the baseline median.
+# The MAD term keeps noisy machines from failing the gate. Changes below
+# the resolution of the metric's unit, e.g. 1 ms, are never regressions.
+# Lower is better for all metrics: times and allocation counts.
+#
+# Timings only compare on the machine the baseline was recorded on, which
+# --update stores along with the metrics. The baseline in the tree has no
+# metrics, so the gate fails until one is recorded with --update on the
+# machine that runs it.
+#
+# Metrics:
+#   bm_<suite>/<function>[/<row>]       QBENCHMARK results, per iteration
+#   keystroke/latency_p50_ms etc.       per keystroke, until candidates
+#   keystroke/allocations_median etc.   per keystroke, all threads
+#   language-switch/<lang>/<cold|warm>/<switch_ms|first_candidates_ms>
+#   startup/<span>, startup/total       startup trace of the keyboard
+#
+# Everything runs offline. The keyboard is driven through the stand-in
+# host of tests/unittests/common, with in-memory GSettings and the
+# offscreen platform. The keyboard looks for its QML and language plugins
+# in the install prefix. Pass --prefix to use a staged install instead,
+# e.g. one from `make install INSTALL_ROOT=/tmp/stage`.
+#
+#   ./perfgate.py --build-dir ../build           exit 1 on regressions, 2
+#                                                without a baseline
+#   ./perfgate.py --build-dir ../build --update  record the baseline
+
+import argparse
+import fnmatch
+import glob
+import json
+import os
+import platform
+import subprocess
+import sys
+import tempfile
+import xml.etree.ElementTree as ElementTree
+
+BASELINE = os.path.join(os.path.dirname(os.path.abspath(__file__)),
+                        "baseline.json")
+DEFAULT_RUNS = 5
+DEFAULT_TOLERANCE = 0.2
+DEFAULT_LANGUAGES = ["en", "de"]
+# Deviations of noise allowed on top of the tolerance.
+MAD_FACTOR = 3
+# Longest run of a single benchmark, in seconds.
+TIMEOUT = 600
+
+# Smallest change of each unit that is told apart from timer jitter. Can
+# be overridden per unit with "resolutions" in the baseline.
+RESOLUTIONS = {
+    "ms": 1.0,
+    "ns": 100.0,
+    "ticks": 1000.0,
+    "allocations": 1.0,
+}
+
+UNITS = {
+    "WalltimeMilliseconds": "ms",
+    "WalltimeNanoseconds": "ns",
+    "CPUTicks": "ticks",
+    "InstructionReads": "instructions",
+    "Events": "events",
+}
+
+
+class GateError(Exception):
+    pass
+
+
+def median(values):
+    values = sorted(values)
+    middle = len(values) // 2
+    if len(values) % 2:
+        return values[middle]
+    return (values[middle - 1] + values[middle]) / 2.0
+
+
+def mad(values):
+    centre = median(values)
+    return median([abs(value - centre) for value in values])
+
+
+def environment(args):
+    env = dict(os.environ)
+    env["GSETTINGS_BACKEND"] = "memory"
+    env["QT_QPA_PLATFORM"] = "offscreen"
+    if args.prefix:
+        env["KEYBOARD_PREFIX_PATH"] = args.prefix
+    libraries = [os.path.join(args.build_dir, "src", "plugin")]
+    if env.get("LD_LIBRARY_PATH"):
+        libraries.append(env["LD_LIBRARY_PATH"])
+    env["LD_LIBRARY_PATH"] = os.pathsep.join(libraries)
+    return env
+
+
+def run(command, env):
+    try:
+        subprocess.run(command, env=env, check=True, timeout=TIMEOUT,
+                       stdout=subprocess.DEVNULL, stderr=subprocess.PIPE)
+    except OSError as error:
+        raise GateError("%s: %s" % (command[0], error))
+    except subprocess.CalledProcessError as error:
+        output = error.stderr.decode(errors="replace")
+        raise GateError("%s failed:\n%s" % (" ".join(command), output))
+    except subprocess.TimeoutExpired:
+        raise GateError("%s timed out" % " ".join(command))
+
+
+def executable(args, directory, name):
+    path = os.path.join(args.build_dir, "benchmark", directory, name)
+    if not os.access(path, os.X_OK):
+        raise GateError("%s is not built; the benchmarks are left out with "
+                        "CONFIG+=nobenchmarks" % path)
+    return path
+
+
+def qbenchmark_metrics(args, env, scratch):
+    metrics = {}
+    suites = sorted(path for path in glob.glob(os.path.join(
+        args.build_dir, "benchmark", "bm_*")) if os.path.isdir(path))
+    if not suites:
+        raise GateError("no QBENCHMARK suites below %s/benchmark" %
+                        args.build_dir)
+
+    for suite in suites:
+        name = os.path.basename(suite)
+        results = os.path.join(scratch, name + ".xml")
+        run([executable(args, name, name), "-o", results + ",xml"], env)
+
+        for function in ElementTree.parse(results).iter("TestFunction"):
+            for result in function.iter("BenchmarkResult"):
+                key = "%s/%s" % (name, function.get("name"))
+                if result.get("tag"):
+                    key += "/" + result.get("tag")
+                # Already per iteration, "iterations" only tells how many
+                # were averaged.
+                metrics[key] = (float(result.get("value")),
+                                UNITS.get(result.get("metric"),
+                                          result.get("metric")))
+    return metrics
+
+
+def keystroke_metrics(args, env, scratch):
+    results = os.path.join(scratch, "keystroke.json")
+    run([executable(args, "keystroke", "ubuntu-keyboard-keystroke-benchmark"),
+         "--language", args.languages[0], "--json", results], env)
+
+    with open(results) as f:
+        data = json.load(f)
+
+    metrics = {}
+    for percentile in ("p50", "p90", "p99"):
+        metrics["keystroke/latency_%s_ms" % percentile] = (
+            data["latency_ms"][percentile], "ms")
+    for statistic in ("median", "mean"):
+        # Negative where allocations cannot be counted
+        if data["allocations"][statistic] >= 0:
+            metrics["keystroke/allocations_%s" % statistic] = (
+                data["allocations"][statistic], "allocations")
+    return metrics
+
+
+def language_switch_metrics(args, env, scratch):
+    results = os.path.join(scratch, "language-switch.json")
+    trace = os.path.join(scratch, "startup-trace.json")
+    env = dict(env, UBUNTU_KEYBOARD_STARTUP_TRACE=trace)
+    run([executable(args, "languageswitch", "ubuntu-keyboard-benchmark"),
+         "--json", results] + args.languages, env)
+
+    with open(results) as f:
+        data = json.load(f)
+
+    metrics = {}
+    for language, result in data["languages"].items():
+        for temperature in ("cold", "warm"):
+            for name in ("switch_ms", "first_candidates_ms"):
+                value = result[temperature][name]
+                # -1 when the language has no word engine
+                if value >= 0:
+                    key = "language-switch/%s/%s/%s" % (language, temperature,
+                                                        name)
+                    metrics[key] = (value, "ms")
+
+    if os.path.exists(trace):
+        with open(trace) as f:
+            events = json.load(f)["traceEvents"]
+        spans = {}
+        for event in events:
+            spans[event["name"]] = (spans.get(event["name"], 0) +
+                                    event["dur"] / 1000.0)
+        for name, duration in spans.items():
+            metrics["startup/" + name] = (duration, "ms")
+        if events:
+            start = min(event["ts"] for event in events)
+            end = max(event["ts"] + event["dur"] for event in events)
+            metrics["startup/total"] = ((end - start) / 1000.0, "ms")
+    return metrics
+
+
+def collect(args, runs):
+    env = environment(args)
+    samples = {}
+    units = {}
+    for number in range(runs):
+        print("run %d of %d" % (number + 1, runs), file=sys.stderr)
+        with tempfile.TemporaryDirectory() as scratch:
+            metrics = {}
+            metrics.update(qbenchmark_metrics(args, env, scratch))
+            metrics.update(keystroke_metrics(args, env, scratch))
+            metrics.update(language_switch_metrics(args, env, scratch))
+        for key, (value, unit) in metrics.items():
+            samples.setdefault(key, []).append(value)
+            units[key] = unit
+
+    return dict((key, {"median": median(values), "mad": mad(values),
+                       "unit": units[key]})
+                for key, values in samples.items())
+
+
+def machine():
+    """Describes the machine the benchmarks run on."""
+    cpu = platform.processor()
+    try:
+        with open("/proc/cpuinfo") as f:
+            for line in f:
+                if line.startswith("model name"):
+                    cpu = line.split(":", 1)[1].strip()
+                    break
+    except OSError:
+        pass
+    return {"system": platform.platform(), "cpu": cpu,
+            "cores": os.cpu_count()}
+
+
+def resolution(baseline, unit):
+    resolutions = dict(RESOLUTIONS)
+    resolutions.update(baseline.get("resolutions", {}))
+    return resolutions.get(unit, 0.0)
+
+
+def tolerance(baseline, key):
+    """The tolerance of the longest pattern matching the metric."""
+    tolerances = baseline.get("tolerances", {})
+    if key in tolerances:
+        return tolerances[key]
+    matches = [pattern for pattern in tolerances
+               if fnmatch.fnmatchcase(key, pattern)]
+    if matches:
+        return tolerances[max(matches, key=len)]
+    return baseline.get("default_tolerance", DEFAULT_TOLERANCE)
+
+
+def compare(baseline, current):
+    """Prints every metric, returns the number of failures."""
+    failures = 0
+    expected = baseline["metrics"]
+    print("%-64s %12s %12s %8s %8s  %s" % ("metric", "baseline", "current",
+                                            "change", "allowed", "status"))
+
+    for key in sorted(set(expected) | set(current)):
+        if key not in current:
+            print("%-64s %12.4g %12s %8s %8s  MISSING" %
+                  (key, expected[key]["median"], "-", "-", "-"))
+            failures += 1
+            continue
+        if key not in expected:
+            print("%-64s %12s %12.4g %8s %8s  new" %
+                  (key, "-", current[key]["median"], "-", "-"))
+            continue
+
+        old = expected[key]
+        new = current[key]
+        allowed = max(tolerance(baseline, key) * old["median"] +
+                      MAD_FACTOR * max(old["mad"], new["mad"]),
+                      resolution(baseline, old["unit"]))
+        change = new["median"] - old["median"]
+        relative = "%+7.1f%%" % (100.0 * change / old["median"]) \
+            if old["median"] else "-"
+
+        if change > allowed:
+            status = "REGRESSED"
+            failures += 1
+        elif change < -allowed:
+            status = "improved"
+        else:
+            status = "ok"
+        print("%-64s %12.4g %12.4g %8s %8.3g  %s" %
+              (key, old["median"], new["median"], relative, allowed, status))
+    return failures
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description="Compares the keyboard's benchmarks with a baseline.")
+    parser.add_argument("--build-dir", default=".",
+                        help="top of the build tree (default: .)")
+    parser.add_argument("--baseline", default=BASELINE,
+                        help="baseline file (default: %(default)s)")
+    parser.add_argument("--prefix",
+                        help="staged install to run the keyboard from")
+    parser.add_argument("--runs", type=int,
+                        help="runs of every benchmark (default: as in the "
+                        "baseline, or %d)" % DEFAULT_RUNS)
+    parser.add_argument("--update", action="store_true",
+                        help="write the results to the baseline instead of "
+                        "comparing, keeping its tolerances")
+    args = parser.parse_args()
+
+    try:
+        with open(args.baseline) as f:
+            baseline = json.load(f)
+    except FileNotFoundError:
+        baseline = {"version": 1, "metrics": {}}
+
+    args.build_dir = os.path.abspath(args.build_dir)
+    args.languages = baseline.get("languages", DEFAULT_LANGUAGES)
+    runs = args.runs or baseline.get("runs", DEFAULT_RUNS)
+
+    if not args.update:
+        if not baseline.get("metrics"):
+            print("%s has no metrics; record them on this machine with "
+                  "--update" % args.baseline, file=sys.stderr)
+            return 2
+        if baseline.get("machine") != machine():
+            print("%s was recorded on %s, timings may not compare" %
+                  (args.baseline, baseline.get("machine")), file=sys.stderr)
+
+    try:
+        current = collect(args, runs)
+    except GateError as error:
+        print(error, file=sys.stderr)
+        return 2
+
+    if args.update:
+        baseline.setdefault("version", 1)
+        baseline["machine"] = machine()
+        baseline["languages"] = args.languages
+        baseline["runs"] = runs
+        baseline["metrics"] = current
+        with open(args.baseline, "w") as f:
+            json.dump(baseline, f, indent=2, sort_keys=True)
+            f.write("\n")
+        print("wrote %d metrics to %s" % (len(current), args.baseline))
+        return 0
+
+    failures = compare(baseline, current)
+    if failures:
+        print("%d metrics regressed or went missing" % failures)
+        return 1
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -26,54 +26,69 @@
 #include <QCoreApplication>
 
 #define CHEWING_MAX_LEN 32
+#define CANDIDATE_PAGE_SIZE 10
 
 ChewingAdapter::ChewingAdapter(QObject *parent) :
     QObject(parent),
-    m_processingWords(false)
+    m_processingWords(false),
+    m_candidateCount(0),
+    m_nextCandidate(0)
 {
-    m_chewingContext = chewing_new();
-    chewing_set_easySymbolInput(m_chewingContext, 0);
-    chewing_set_maxChiSymbolLen(m_chewingContext, CHEWING_MAX_LEN);
-    chewing_set_spaceAsSelection(m_chewingContext, 0);
+    createContext();
+    m_keyStates.append(KeyState());
 }
 
 ChewingAdapter::~ChewingAdapter()
 {
-    chewing_delete(m_chewingContext);
+    if (m_chewingContext) {
+        chewing_delete(m_chewingContext);
+    }
+}
+
+void ChewingAdapter::createContext()
+{
+    m_chewingContext = chewing_new();
+    chewing_set_easySymbolInput(m_chewingContext, 0);
+    chewing_set_maxChiSymbolLen(m_chewingContext, CHEWING_MAX_LEN);
+    chewing_set_spaceAsSelection(m_chewingContext, 0);
 }
 
 void ChewingAdapter::parse(const QString& string)
 {
     m_candidates.clear();
-    clearChewingPreedit();
 
-    const QChar *c = string.data();
-    while (!c->isNull()) {
-        if (c->isSpace()) {
-            chewing_handle_Space(m_chewingContext);
-        } else {
-            chewing_handle_Default(m_chewingContext, c->toLatin1());
-        }
-        c++;
+    if (!m_chewingContext) {
+        createContext();
+    }
+
+    // Keep the chewing context alive between keystrokes and only feed it
+    // the keys that changed. Anything other than appending or removing keys
+    // at the end of the preedit needs a full replay.
+    bool cursorAtEnd = chewing_cursor_Current(m_chewingContext) == chewing_buffer_Len(m_chewingContext);
+
+    if (cursorAtEnd && string.startsWith(m_fedKeys)) {
+        feedKeys(string.mid(m_fedKeys.length()));
+    } else if (!cursorAtEnd || !m_fedKeys.startsWith(string) || !rollBack(string.length())) {
+        replay(string);
     }
 
     char * buf_str = chewing_buffer_String(m_chewingContext);
     QString buffer(buf_str);
-    QString choppedBuffer = buffer;
-    choppedBuffer.chop(1);
+    m_choppedBuffer = buffer;
+    m_choppedBuffer.chop(1);
     chewing_free(buf_str);
-    
+
+    m_word = string;
+    m_candidateCount = 0;
+    m_nextCandidate = 0;
+
     chewing_cand_open(m_chewingContext);
 
     if (!chewing_cand_CheckDone(m_chewingContext)) {
-        // Get candidate words
-        chewing_cand_Enumerate(m_chewingContext);
-        while (chewing_cand_hasNext(m_chewingContext)) {
-            char *chewingCand = chewing_cand_String(m_chewingContext);
-            QString candidate(chewingCand);
-            m_candidates.append(choppedBuffer + candidate);
-            chewing_free(chewingCand);
-        }
+        // Get the first page of candidate words, the rest is produced
+        // when the word ribbon asks for it
+        m_candidateCount = chewing_cand_TotalChoice(m_chewingContext);
+        materialiseCandidates(CANDIDATE_PAGE_SIZE);
     }
 
     if (chewing_buffer_Len(m_chewingContext) <= chewing_cursor_Current(m_chewingContext)) {    
@@ -83,11 +98,110 @@ void ChewingAdapter::parse(const QString& string)
 
     chewing_cand_close(m_chewingContext);
 
-    Q_EMIT newPredictionSuggestions(string, m_candidates);
+    Q_EMIT newPredictionSuggestions(string, m_candidates, m_nextCandidate < m_candidateCount);
+}
+
+void ChewingAdapter::fetchMoreCandidates()
+{
+    m_candidates.clear();
+
+    if (!m_chewingContext) {
+        Q_EMIT moreSuggestions(m_word, m_candidates, false);
+        return;
+    }
+
+    chewing_cand_open(m_chewingContext);
+    materialiseCandidates(CANDIDATE_PAGE_SIZE);
+    chewing_cand_close(m_chewingContext);
+
+    Q_EMIT moreSuggestions(m_word, m_candidates, m_nextCandidate < m_candidateCount);
+}
+
+void ChewingAdapter::materialiseCandidates(int count)
+{
+    int last = qMin(m_nextCandidate + count, m_candidateCount);
+    for (; m_nextCandidate < last; ++m_nextCandidate) {
+        QString candidate(chewing_cand_string_by_index_static(m_chewingContext, m_nextCandidate));
+        m_candidates.append(m_choppedBuffer + candidate);
+    }
+}
+
+void ChewingAdapter::feedKeys(const QString& keys)
+{
+    const QChar *c = keys.constData();
+    const QChar *end = c + keys.length();
+    for (; c != end && !c->isNull(); ++c) {
+        if (c->isSpace()) {
+            chewing_handle_Space(m_chewingContext);
+        } else {
+            chewing_handle_Default(m_chewingContext, c->toLatin1());
+        }
+
+        if (chewing_commit_Check(m_chewingContext)) {
+            // Text was committed out of the buffer (e.g. on reaching the
+            // maximum length), so earlier states can no longer be restored
+            // by deleting from the end.
+            for (int i = 0; i < m_keyStates.size(); ++i) {
+                m_keyStates[i].bufferLen = -1;
+            }
+        }
+
+        m_fedKeys.append(*c);
+        m_keyStates.append(KeyState(chewing_buffer_Len(m_chewingContext),
+                                    !*chewing_bopomofo_String_static(m_chewingContext)));
+    }
+}
+
+bool ChewingAdapter::rollBack(int length)
+{
+    // Keys after the last complete syllable only exist in the bopomofo
+    // buffer, so go back to that syllable boundary, delete the characters
+    // typed since then and re-feed the few remaining keys.
+    int anchor = length;
+    while (anchor > 0 && !m_keyStates.at(anchor).bopomofoEmpty) {
+        --anchor;
+    }
+
+    const KeyState anchorState = m_keyStates.at(anchor);
+    const KeyState current = m_keyStates.last();
+
+    if (anchorState.bufferLen < 0 || anchorState.bufferLen > current.bufferLen) {
+        return false;
+    }
+
+    if (!current.bopomofoEmpty) {
+        chewing_handle_Esc(m_chewingContext);
+    }
+
+    for (int i = anchorState.bufferLen; i < current.bufferLen; ++i) {
+        chewing_handle_Backspace(m_chewingContext);
+    }
+
+    if (chewing_buffer_Len(m_chewingContext) != anchorState.bufferLen
+        || *chewing_bopomofo_String_static(m_chewingContext)) {
+        return false;
+    }
+
+    const QString keys = m_fedKeys.mid(anchor, length - anchor);
+    m_fedKeys.truncate(anchor);
+    m_keyStates.resize(anchor + 1);
+    feedKeys(keys);
+
+    return true;
+}
+
+void ChewingAdapter::replay(const QString& string)
+{
+    clearChewingPreedit();
+    feedKeys(string);
 }
 
 void ChewingAdapter::clearChewingPreedit()
 {
+    if (!m_chewingContext) {
+        return;
+    }
+
     int origState = chewing_get_escCleanAllBuf(m_chewingContext);
     // Send a false event, then clean it to wipe the commit
     chewing_handle_Default(m_chewingContext, '1');
@@ -95,6 +209,11 @@ void ChewingAdapter::clearChewingPreedit()
     chewing_handle_Esc(m_chewingContext);
     chewing_set_escCleanAllBuf(m_chewingContext, origState);
     chewing_clean_preedit_buf(m_chewingContext);
+
+    m_fedKeys.clear();
+    m_keyStates.resize(1);
+    m_candidateCount = 0;
+    m_nextCandidate = 0;
 }
 
 void ChewingAdapter::wordCandidateSelected(const QString& word)
@@ -107,3 +226,20 @@ void ChewingAdapter::reset()
     clearChewingPreedit();
 }
 
+//! libchewing maps its dictionaries for each context, so dropping the
+//! context frees them. The next parse() creates a new one.
+void ChewingAdapter::releaseContext()
+{
+    if (!m_chewingContext) {
+        return;
+    }
+
+    chewing_delete(m_chewingContext);
+    m_chewingContext = 0;
+
+    m_fedKeys.clear();
+    m_keyStates.resize(1);
+    m_candidateCount = 0;
+    m_nextCandidate = 0;
+}
+
@@ -19,6 +19,7 @@
 
 #include <QObject>
 #include <QStringList>
+#include <QVector>
 
 #include "chewing.h"
 
@@ -26,22 +27,48 @@ class ChewingAdapter : public QObject
 {
     Q_OBJECT
 
+    // Snapshot of the chewing context taken after each key is fed, used to
+    // roll back to an earlier preedit without replaying every key.
+    struct KeyState {
+        KeyState(int len = 0, bool empty = true)
+            : bufferLen(len), bopomofoEmpty(empty) {}
+
+        int bufferLen;
+        bool bopomofoEmpty;
+    };
+
     QStringList m_candidates;
     bool m_processingWords;
     ChewingContext *m_chewingContext;
+    QString m_fedKeys;
+    QVector<KeyState> m_keyStates;
+
+    QString m_word;
+    QString m_choppedBuffer;
+    int m_candidateCount;
+    int m_nextCandidate;
+
+    void createContext();
+    void feedKeys(const QString& keys);
+    bool rollBack(int length);
+    void replay(const QString& string);
+    void materialiseCandidates(int count);
 
 public:
     explicit ChewingAdapter(QObject *parent = 0);
     ~ChewingAdapter();
 
 signals:
-    void newPredictionSuggestions(QString, QStringList);
+    void newPredictionSuggestions(QString, QStringList, bool);
+    void moreSuggestions(QString, QStringList, bool);
 
 public slots:
     void parse(const QString& string);
+    void fetchMoreCandidates();
     void clearChewingPreedit();
     void wordCandidateSelected(const QString& word);
     void reset();
+    void releaseContext();
 };
 
 
@@ -16,9 +16,21 @@
 
 #include "chewinglanguagefeatures.h"
 
+namespace {
+
+const CharacterClasses *characterClasses()
+{
+    static const CharacterClasses classes(QString::fromUtf8("。、!?:…\r\n"),
+                                          QString::fromUtf8("*#+=()@~\\€£$¥₹%<>[]`^|_—–•§{}¡¿«»\"“”„&"));
+    return &classes;
+}
+
+} // unnamed namespace
+
 ChewingLanguageFeatures::ChewingLanguageFeatures(QObject *parent) :
     QObject(parent)
 {
+    setCharacterClasses(characterClasses());
 }
 
 ChewingLanguageFeatures::~ChewingLanguageFeatures()
@@ -53,36 +65,6 @@ QString ChewingLanguageFeatures::appendixForReplacedPreedit(const QString &preed
     return QString(" ");
 }
 
-bool ChewingLanguageFeatures::isSeparator(const QString &text) const
-{
-    static const QString separators = QString::fromUtf8("。、!?:…\r\n");
-
-    if (text.isEmpty()) {
-        return false;
-    }
-
-    if (separators.contains(text.right(1))) {
-        return true;
-    }
-
-    return false;
-}
-
-bool ChewingLanguageFeatures::isSymbol(const QString &text) const
-{
-    static const QString symbols = QString::fromUtf8("*#+=()@~\\€£$¥₹%<>[]`^|_—–•§{}¡¿«»\"“”„&");
-
-    if (text.isEmpty()) {
-        return false;
-    }
-
-    if (symbols.contains(text.right(1))) {
-        return true;
-    }
-
-    return false;
-}
-
 bool ChewingLanguageFeatures::ignoreSimilarity() const
 {
     return true;
@@ -2,20 +2,34 @@
 #include "chewinglanguagefeatures.h"
 
 #include <QDebug>
+#include <QDir>
+#include <QFileInfo>
 
 ChewingPlugin::ChewingPlugin(QObject *parent) :
     AbstractLanguagePlugin(parent)
   , m_chewingLanguageFeatures(new ChewingLanguageFeatures)
   , m_processingWord(false)
+  , m_moreRequested(false)
+  , m_dataSize(0)
+  , m_contextReleased(false)
 {
     m_chewingThread = new QThread();
     m_chewingAdapter = new ChewingAdapter();
     m_chewingAdapter->moveToThread(m_chewingThread);
 
-    connect(m_chewingAdapter, SIGNAL(newPredictionSuggestions(QString, QStringList)), this, SLOT(finishedProcessing(QString, QStringList)));
+    connect(m_chewingAdapter, SIGNAL(newPredictionSuggestions(QString, QStringList, bool)), this, SLOT(finishedProcessing(QString, QStringList, bool)));
+    connect(m_chewingAdapter, SIGNAL(moreSuggestions(QString, QStringList, bool)), this, SLOT(finishedProcessingMore(QString, QStringList, bool)));
     connect(this, SIGNAL(parsePredictionText(QString)), m_chewingAdapter, SLOT(parse(QString)));
+    connect(this, SIGNAL(parseMoreCandidates()), m_chewingAdapter, SLOT(fetchMoreCandidates()));
     connect(this, SIGNAL(candidateSelected(QString)), m_chewingAdapter, SLOT(wordCandidateSelected(QString)));
+    connect(this, SIGNAL(releaseContextRequested()), m_chewingAdapter, SLOT(releaseContext()));
     m_chewingThread->start();
+
+    // libchewing maps all of its dictionary files, so their size is about
+    // what the engine takes.
+    Q_FOREACH(const QFileInfo &file, QDir(CHEWING_DATA_DIR).entryInfoList(QDir::Files)) {
+        m_dataSize += file.size();
+    }
 }
 
 ChewingPlugin::~ChewingPlugin()
@@ -28,7 +42,9 @@ ChewingPlugin::~ChewingPlugin()
 void ChewingPlugin::predict(const QString& surroundingLeft, const QString& preedit)
 {
     Q_UNUSED(surroundingLeft);
+    m_contextReleased = false;
     m_nextWord = preedit;
+    m_moreRequested = false;
     if (!m_processingWord) {
         m_processingWord = true;
         Q_EMIT parsePredictionText(preedit);
@@ -40,16 +56,53 @@ void ChewingPlugin::wordCandidateSelected(QString word)
     Q_EMIT candidateSelected(word);
 }
 
+qint64 ChewingPlugin::memoryUsage() const
+{
+    return m_contextReleased ? 0 : m_dataSize;
+}
+
+//! The chewing context is created again for the next prediction.
+void ChewingPlugin::releaseCaches()
+{
+    m_contextReleased = true;
+    Q_EMIT releaseContextRequested();
+}
+
 AbstractLanguageFeatures* ChewingPlugin::languageFeature()
 {
     return m_chewingLanguageFeatures;
 }
 
-void ChewingPlugin::finishedProcessing(QString word, QStringList suggestions)
+void ChewingPlugin::fetchMoreCandidates()
+{
+    if (!m_processingWord) {
+        m_processingWord = true;
+        Q_EMIT parseMoreCandidates();
+    } else {
+        m_moreRequested = true;
+    }
+}
+
+void ChewingPlugin::finishedProcessing(QString word, QStringList suggestions, bool hasMore)
 {
     Q_EMIT newPredictionSuggestions(word, suggestions);
+    Q_EMIT moreCandidatesAvailable(word, hasMore);
+    if (word != m_nextWord) {
+        Q_EMIT parsePredictionText(m_nextWord);
+    } else if (m_moreRequested && hasMore) {
+        m_moreRequested = false;
+        Q_EMIT parseMoreCandidates();
+    } else {
+        m_processingWord = false;
+    }
+}
+
+void ChewingPlugin::finishedProcessingMore(QString word, QStringList suggestions, bool hasMore)
+{
+    Q_EMIT morePredictionSuggestions(word, suggestions);
+    Q_EMIT moreCandidatesAvailable(word, hasMore);
     if (word != m_nextWord) {
-        Q_EMIT(parsePredictionText(word));
+        Q_EMIT parsePredictionText(m_nextWord);
     } else {
         m_processingWord = false;
     }
@@ -23,7 +23,10 @@ public:
     virtual ~ChewingPlugin();
     
     virtual void predict(const QString& surroundingLeft, const QString& preedit);
+    virtual void fetchMoreCandidates();
     virtual void wordCandidateSelected(QString word);
+    virtual qint64 memoryUsage() const;
+    virtual void releaseCaches();
 
     virtual AbstractLanguageFeatures* languageFeature();
 
@@ -35,10 +38,13 @@ public:
 signals:
     void newPredictionSuggestions(QString word, QStringList suggestions);
     void parsePredictionText(QString preedit);
+    void parseMoreCandidates();
     void candidateSelected(QString word);
+    void releaseContextRequested();
     
 public slots:
-    void finishedProcessing(QString word, QStringList suggestions);
+    void finishedProcessing(QString word, QStringList suggestions, bool hasMore);
+    void finishedProcessingMore(QString word, QStringList suggestions, bool hasMore);
     
 private:
     QThread *m_chewingThread;
@@ -46,6 +52,9 @@ private:
     ChewingLanguageFeatures* m_chewingLanguageFeatures;
     QString m_nextWord;
     bool m_processingWord;
+    bool m_moreRequested;
+    qint64 m_dataSize;
+    bool m_contextReleased;
 };
 
 #endif // CHEWINGPLUGIN_H
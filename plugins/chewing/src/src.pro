@@ -3,6 +3,9 @@ TOP_SRCDIR = $$PWD/../../..
 
 include($${TOP_SRCDIR}/config.pri)
 
+CHEWING_DATA_DIR = "$$system(pkg-config --variable datadir chewing)/libchewing"
+DEFINES += CHEWING_DATA_DIR=\\\"$${CHEWING_DATA_DIR}\\\"
+
 TEMPLATE        = lib
 CONFIG         += plugin
 QT             += widgets
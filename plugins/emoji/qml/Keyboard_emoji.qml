@@ -16,8 +16,8 @@
 
 import QtQuick 2.4
 import QtQuick.LocalStorage 2.0
+import UbuntuKeyboard 1.0
 import keys 1.0
-import "emoji.js" as Emoji
 
 KeyPad {
     anchors.fill: parent
@@ -29,64 +29,66 @@ KeyPad {
         panel.switchBack = true;
     }
 
+    EmojiModel {
+        id: emojiModel
+        rowsPerColumn: c1.numberOfRows - 1
+        maxRecent: (c1.numberOfRows - 1) * c1.maxNrOfKeys
+    }
+
     QtObject {
         id: internal
-        property int offset: 0
         property bool loading: true
-        property int maxRecent: (c1.numberOfRows - 1) * c1.maxNrOfKeys
-        property int oldVisibleIndex: -1
-        property var recentEmoji: []
-        property var chars
-        property var db
+        property int currentCategory: {
+            if (c1.midVisibleIndex == -1) {
+                return EmojiModel.People;
+            }
+            if (c1.contentX == 0 && emojiModel.recentCount > 0) {
+                return EmojiModel.Recent;
+            }
+            return emojiModel.categoryAt(c1.midVisibleIndex);
+        }
 
         Component.onCompleted: {
-            db = LocalStorage.openDatabaseSync("Emoji", "1.0", "Storage for emoji keyboard layout", 1000000);
+            if (!emojiModel.stored) {
+                importLocalStorage();
+            }
+            c1.positionViewAtIndex(emojiModel.position, GridView.Beginning);
+        }
+
+        // Recent emoji used to be kept in a LocalStorage database, take
+        // them over once.
+        function importLocalStorage() {
+            var db = LocalStorage.openDatabaseSync("Emoji", "1.0", "Storage for emoji keyboard layout", 1000000);
+            var recent = [];
 
             db.transaction(
                 function(tx) {
-                    // Create the database if it doesn't already exist
                     tx.executeSql('CREATE TABLE IF NOT EXISTS Recent(emoji VARCHAR(16), time TIMESTAMP DEFAULT CURRENT_TIMESTAMP)');
-                    tx.executeSql('CREATE TABLE IF NOT EXISTS State(contentX INTEGER, visibleIndex INTEGER)');
-
-                    var rs = tx.executeSql('SELECT emoji FROM Recent ORDER BY time ASC');
+                    var rs = tx.executeSql('SELECT emoji FROM Recent ORDER BY time DESC');
                     for (var i = 0; i < rs.rows.length; i++) {
-                        recentEmoji.push(rs.rows.item(i).emoji);
-                    }
-                    for (var i = 0; i < recentEmoji.length % (c1.numberOfRows - 1); i++) {
-                        recentEmoji.push("");
-                    }
-                    chars = recentEmoji.concat(Emoji.emoji);
-
-                    for (var i = 0; i < chars.length; i++) {
-                        c1.model.append({char: chars[i]});                        
-                    }
-
-                    rs = tx.executeSql('SELECT contentX, visibleIndex FROM State');
-                    if (rs.rows.length > 0) {
-                        internal.oldVisibleIndex = rs.rows.item(0).visibleIndex;
-                        c1.contentX = rs.rows.item(0).contentX;
-                    } else {
-                        tx.executeSql('INSERT INTO State VALUES(0, 0)');
-                        // Start on the smiley page
-                        c1.positionViewAtIndex(recentEmoji.length, GridView.Beginning)
-                        updatePositionDb();
+                        recent.push(rs.rows.item(i).emoji);
                     }
+                    tx.executeSql('DROP TABLE Recent');
+                    tx.executeSql('DROP TABLE IF EXISTS State');
                 }
             );
+
+            emojiModel.setRecent(recent);
+            // Start on the smiley page
+            emojiModel.position = emojiModel.categoryStart(EmojiModel.People);
         }
 
         function jumpTo(position) {
             c1.positionViewAtIndex(position, GridView.Beginning);
             c1.startingPosition = false;
-            internal.updatePositionDb();
+            emojiModel.position = position;
         }
 
-        function updatePositionDb() {
-            db.transaction(
-                function(tx) {
-                    tx.executeSql('UPDATE State SET contentX=?, visibleIndex=?', [c1.contentX, c1.midVisibleIndex]);
-                }
-            );
+        function storePosition() {
+            var index = c1.indexAt(c1.contentX, 0);
+            if (index != -1) {
+                emojiModel.position = index;
+            }
         }
 
         function updateRecent(emoji) {
@@ -94,52 +96,15 @@ KeyPad {
             // Hide the magnifier before we reposition the key
             magnifier.shown = false;
             magnifier.currentlyAssignedKey = null;
-            var originalLength = recentEmoji.length;
-            var position = recentEmoji.indexOf(emoji);
             c1.positionBeforeInsertion = c1.contentX;
-            // If this emoji is already in the recent list we leave it alone
-            if (position != -1) {
-                return;
-            }
-
-            // If the list is full remove the last emoji before inserting
-            if (recentEmoji.length >= maxRecent || recentEmoji[recentEmoji.length - 1] == "") {
-                recentEmoji.splice(recentEmoji.length - 1, 1);
-            } 
-
-            recentEmoji.unshift(emoji);
-
-            // Always append a column at a time
-            for (var i = 0; i < recentEmoji.length % (c1.numberOfRows - 1); i++) {
-                recentEmoji.push("");
-            }
-
-            // We then update the char properties in the model
-            for (var i = 0; i < recentEmoji.length; i++) {
-                if (i >= originalLength) {
-                    c1.model.insert(i, {"char" : recentEmoji[i]});
-                } else {
-                    c1.model.setProperty(i, "char", recentEmoji[i]);
-                }
-            }
-
-            db.transaction(
-                function(tx) {
-                    tx.executeSql('DELETE FROM Recent WHERE emoji = ?', emoji);
-                    tx.executeSql('INSERT INTO Recent(emoji) VALUES(?)', emoji);
-                    var rs = tx.executeSql('SELECT COUNT(emoji) as totalRecent FROM Recent');
-                    if (rs.rows.item(0).totalRecent > maxRecent) {
-                        tx.executeSql('DELETE FROM Recent ORDER BY time ASC LIMIT ?', rs.rows.item(0).totalRecent - maxRecent);
-                    }
-                }
-            );     
+            emojiModel.addRecent(emoji);
         }
     }
 
     GridView {
         id: c1
         objectName: "emojiGrid"
-        property int midVisibleIndex: indexAt(contentX + (width / 2), 0) == -1 ? internal.oldVisibleIndex : indexAt(contentX + (width / 2), 0);
+        property int midVisibleIndex: indexAt(contentX + (width / 2), 0) == -1 ? emojiModel.position : indexAt(contentX + (width / 2), 0);
         property int numberOfRows: 5
         property int maxNrOfKeys: fullScreenItem.tablet ? 12 : 10
         property int oldWidth: 0
@@ -149,7 +114,7 @@ KeyPad {
         anchors.bottom: categories.top
         anchors.left: parent.left
         anchors.right: parent.right
-        model: ListModel { }
+        model: emojiModel
         flow: GridView.FlowTopToBottom
         flickDeceleration: units.gu(500)
         snapMode: GridView.SnapToRow
@@ -171,7 +136,7 @@ KeyPad {
             oldWidth = contentWidth;
         }
         onMovementEnded: {
-            internal.updatePositionDb();
+            internal.storePosition();
             startingPosition = false;
         }
 
@@ -223,8 +188,7 @@ KeyPad {
         CategoryKey {
             id: recentCat
             label: "⏱"
-            highlight: (c1.midVisibleIndex < internal.recentEmoji.length && c1.midVisibleIndex > 0)
-                       || (c1.contentX == 0 && internal.recentEmoji.length > 0)
+            highlight: internal.currentCategory == EmojiModel.Recent
             onPressed: {
                 if (maliit_input_method.useHapticFeedback)
                     pressEffect.start();
@@ -234,15 +198,12 @@ KeyPad {
  
         CategoryKey {
             label: "😀"
-            highlight: (c1.midVisibleIndex >= internal.recentEmoji.length 
-                        && c1.midVisibleIndex < 540 + internal.recentEmoji.length
-                        && !recentCat.highlight)
-                       || c1.midVisibleIndex == -1
+            highlight: internal.currentCategory == EmojiModel.People
             onPressed: {
                 if (maliit_input_method.useHapticFeedback)
                     pressEffect.start();
-                internal.jumpTo(internal.recentEmoji.length);
-                if (internal.recentEmoji.length < internal.maxRecent) {
+                internal.jumpTo(emojiModel.categoryStart(EmojiModel.People));
+                if (emojiModel.recent.length < emojiModel.maxRecent) {
                     c1.startingPosition = true;
                 }
             }
@@ -250,71 +211,71 @@ KeyPad {
 
         CategoryKey {
             label: "🐶"
-            highlight: c1.midVisibleIndex >= 540 + internal.recentEmoji.length && c1.midVisibleIndex < 701 + internal.recentEmoji.length
+            highlight: internal.currentCategory == EmojiModel.Nature
             onPressed: {
                 if (maliit_input_method.useHapticFeedback)
                     pressEffect.start();
-                internal.jumpTo(540 + internal.recentEmoji.length);
+                internal.jumpTo(emojiModel.categoryStart(EmojiModel.Nature));
             }
         }
 
         CategoryKey {
             label: "🍏"
-            highlight: c1.midVisibleIndex >= 701 + internal.recentEmoji.length && c1.midVisibleIndex < 786 + internal.recentEmoji.length
+            highlight: internal.currentCategory == EmojiModel.Food
             onPressed: {
                 if (maliit_input_method.useHapticFeedback)
                     pressEffect.start();
-                internal.jumpTo(701 + internal.recentEmoji.length);
+                internal.jumpTo(emojiModel.categoryStart(EmojiModel.Food));
             }
         }
 
         CategoryKey {
             label: "🎾"
-            highlight: c1.midVisibleIndex >= 786 + internal.recentEmoji.length && c1.midVisibleIndex < 931 + internal.recentEmoji.length
+            highlight: internal.currentCategory == EmojiModel.Activity
             onPressed: {
                 if (maliit_input_method.useHapticFeedback)
                     pressEffect.start();
-                internal.jumpTo(786 + internal.recentEmoji.length);
+                internal.jumpTo(emojiModel.categoryStart(EmojiModel.Activity));
             }
         }
 
         CategoryKey {
             label: "🚗"
-             highlight: c1.midVisibleIndex >= 931 + internal.recentEmoji.length && c1.midVisibleIndex < 1050 + internal.recentEmoji.length
+            highlight: internal.currentCategory == EmojiModel.Travel
             onPressed: {
                 if (maliit_input_method.useHapticFeedback)
                     pressEffect.start();
-                internal.jumpTo(931 + internal.recentEmoji.length);
+                internal.jumpTo(emojiModel.categoryStart(EmojiModel.Travel));
             }
         }
 
         CategoryKey {
             label: "💡"
-            highlight: c1.midVisibleIndex >= 1050 + internal.recentEmoji.length && c1.midVisibleIndex < 1229 + internal.recentEmoji.length
+            highlight: internal.currentCategory == EmojiModel.Objects
             onPressed: {
                 if (maliit_input_method.useHapticFeedback)
                     pressEffect.start();
-                internal.jumpTo(1050 + internal.recentEmoji.length);
+                internal.jumpTo(emojiModel.categoryStart(EmojiModel.Objects));
             }
         }
 
         CategoryKey {
             label: "❤"
-            highlight: c1.midVisibleIndex >= 1229 + internal.recentEmoji.length && c1.midVisibleIndex < 1512 + internal.recentEmoji.length
+            highlight: internal.currentCategory == EmojiModel.Symbols
             onPressed: {
                 if (maliit_input_method.useHapticFeedback)
                     pressEffect.start();
-                internal.jumpTo(1229 + internal.recentEmoji.length);
+                internal.jumpTo(emojiModel.categoryStart(EmojiModel.Symbols));
             }
         }
 
         CategoryKey {
             label: "🌍"
-            highlight: c1.midVisibleIndex >= 1512 + internal.recentEmoji.length
+            highlight: internal.currentCategory == EmojiModel.Flags
             onPressed: {
                 if (maliit_input_method.useHapticFeedback)
                     pressEffect.start();
-                internal.jumpTo(1512 + internal.recentEmoji.length);
+                internal.jumpTo(emojiModel.categoryStart(EmojiModel.Flags));
             }
         }
 
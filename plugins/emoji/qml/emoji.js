@@ -1 +0,0 @@
-var emoji = ['😀','😬','😁','😂','😃','😄','😅','😆','😇','😉','😊','🙂','🙃','☺','😋','😌','😍','😘','😗','😙','😚','😜','😝','😛','🤑','🤓','😎','🤗','😏','😶','😐','😑','😒','🙄','🤔','😳','😞','😟','😠','😡','😔','😕','🙁','☹','😣','😖','😫','😩','😤','😮','😱','😨','😰','😯','😦','😧','😢','😥','😪','😓','😭','😵','😲','🤐','😷','🤒','🤕','😴','💤','💩','😈','👿','👹','👺','💀','👻','👽','🤖','😺','😸','😹','😻','😼','😽','🙀','😿','😾','🙌','👏','👋','👍','👎','👊','✊','✌','👌','✋','👐','💪','🙏','☝','👆','👇','👈','👉','🖕','🖐','🤘','🖖','✍','💅','👄','👅','👂','👃','👁','👀','👤','👥','🗣','👶','👦','👧','👱','👴','👵','👲','👳','👮','👷','💂','🕵','🎅','👼','👸','👰','🚶','🏃','💃','👯','👫','👬','👭','🙇','💁','🙅','🙆','🙋','🙎','🙍','💇','💆','💑','💏','👪','👚','👕','👖','👔','👗','👙','👘','💄','💋','👣','👠','👡','👢','👞','👟','👒','🎩','⛑','🎓','👑','🎒','👝','👛','👜','💼','👓','🕶','💍','🌂','🙌🏻','🙌🏼','🙌🏽','🙌🏾','🙌🏿','👏🏻','👏🏼','👏🏽','👏🏾','👏🏿','👋🏻','👋🏼','👋🏽','👋🏾','👋🏿','👍🏻','👍🏼','👍🏽','👍🏾','👍🏿','👎🏻','👎🏼','👎🏽','👎🏾','👎🏿','👊🏻','👊🏼','👊🏽','👊🏾','👊🏿','✊🏻','✊🏼','✊🏽','✊🏾','✊🏿','✌🏻','✌🏼','✌🏽','✌🏾','✌🏿','👌🏻','👌🏼','👌🏽','👌🏾','👌🏿','✋🏻','✋🏼','✋🏽','✋🏾','✋🏿','👐🏻','👐🏼','👐🏽','👐🏾','👐🏿','💪🏻','💪🏼','💪🏽','💪🏾','💪🏿','🙏🏻','🙏🏼','🙏🏽','🙏🏾','🙏🏿','☝🏻','☝🏼','☝🏽','☝🏾','☝🏿','👆🏻','👆🏼','👆🏽','👆🏾','👆🏿','👇🏻','👇🏼','👇🏽','👇🏾','👇🏿','👈🏻','👈🏼','👈🏽','👈🏾','👈🏿','👉🏻','👉🏼','👉🏽','👉🏾','👉🏿','🖕🏻','🖕🏼','🖕🏽','🖕🏾','🖕🏿','🖐🏻','🖐🏼','🖐🏽','🖐🏾','🖐🏿','🤘🏻','🤘🏼','🤘🏽','🤘🏾','🤘🏿','🖖🏻','🖖🏼','🖖🏽','🖖🏾','🖖🏿','✍🏻','✍🏼','✍🏽','✍🏾','✍🏿','💅🏻','💅🏼','💅🏽','💅🏾','💅🏿','👂🏻','👂🏼','👂🏽','👂🏾','👂🏿','👃🏻','👃🏼','👃🏽','👃🏾','👃🏿','👶🏻','👶🏼','👶🏽','👶🏾','👶🏿','👦🏻','👦🏼','👦🏽','👦🏾','👦🏿','👧🏻','👧🏼','👧🏽','👧🏾','👧🏿','👱🏻','👱🏼','👱🏽','👱🏾','👱🏿','👴🏻','👴🏼','👴🏽','👴🏾','👴🏿','👵🏻','👵🏼','👵🏽','👵🏾','👵🏿','👲🏻','👲🏼','👲🏽','👲🏾','👲🏿','👳🏻','👳🏼','👳🏽','👳🏾','👳🏿','👮🏻','👮🏼','👮🏽','👮🏾','👮🏿','👷🏻','👷🏼','👷🏽','👷🏾','👷🏿','💂🏻','💂🏼','💂🏽','💂🏾','💂🏿','🎅🏻','🎅🏼','🎅🏽','🎅🏾','🎅🏿','👼🏻','👼🏼','👼🏽','👼🏾','👼🏿','👸🏻','👸🏼','👸🏽','👸🏾','👸🏿','👰🏻','👰🏼','👰🏽','👰🏾','👰🏿','🚶🏻','🚶🏼','🚶🏽','🚶🏾','🚶🏿','🏃🏻','🏃🏼','🏃🏽','🏃🏾','🏃🏿','💃🏻','💃🏼','💃🏽','💃🏾','💃🏿','🙇🏻','🙇🏼','🙇🏽','🙇🏾','🙇🏿','💁🏻','💁🏼','💁🏽','💁🏾','💁🏿','🙅🏻','🙅🏼','🙅🏽','🙅🏾','🙅🏿','🙆🏻','🙆🏼','🙆🏽','🙆🏾','🙆🏿','🙋🏻','🙋🏼','🙋🏽','🙋🏾','🙋🏿','🙎🏻','🙎🏼','🙎🏽','🙎🏾','🙎🏿','🙍🏻','🙍🏼','🙍🏽','🙍🏾','🙍🏿','💇🏻','💇🏼','💇🏽','💇🏾','💇🏿','💆🏻','💆🏼','💆🏽','💆🏾','💆🏿','🕵🏻','🕵🏼','🕵🏽','🕵🏾','🕵🏿','🤴🏻','🤴🏼','🤴🏽','🤴🏾','🤴🏿','🤶🏻','🤶🏼','🤶🏽','🤶🏾','🤶🏿','🤵🏻','🤵🏼','🤵🏽','🤵🏾','🤵🏿','🤷🏻','🤷🏼','🤷🏽','🤷🏾','🤷🏿','🤦🏻','🤦🏼','🤦🏽','🤦🏾','🤦🏿','🤰🏻','🤰🏼','🤰🏽','🤰🏾','🤰🏿','🤳🏻','🤳🏼','🤳🏽','🤳🏾','🤳🏿','🤞🏻','🤞🏼','🤞🏽','🤞🏾','🤞🏿','🤙🏻','🤙🏼','🤙🏽','🤙🏾','🤙🏿','🤛🏻','🤛🏼','🤛🏽','🤛🏾','🤛🏿','🤜🏻','🤜🏼','🤜🏽','🤜🏾','🤜🏿','🤚🏻','🤚🏼','🤚🏽','🤚🏾','🤚🏿','🤝🏻','🤝🏼','🤝🏽','🤝🏾','🤝🏿','🤠','🤡','🤢','🤣','🤤','🤥','🤧','🤴','🤵','🤶','🤦','🤷','🤰','🤳','🕺','🤙','🤚','🤛','🤜','🤝','🤞','🐶','🐱','🐭','🐹','🐰','🐻','🐼','🐨','🐯','🦁','🐮','🐷','🐽','🐸','🐙','🐵','🙈','🙉','🙊','🐒','🐔','🐧','🐦','🐤','🐣','🐥','🐺','🐗','🐴','🦄','🐝','🐛','🐌','🐞','🐜','🕷','🦂','🦀','🐍','🐢','🐠','🐟','🐡','🐬','🐳','🐋','🐊','🐆','🐅','🐃','🐂','🐄','🐪','🐫','🐘','🐐','🐏','🐑','🐎','🐖','🐀','🐁','🐓','🦃','🕊','🐕','🐩','🐈','🐇','🐿','🐾','🐉','🐲','🌵','🎄','🌲','🌳','🌴','🌱','🌿','☘','🍀','🎍','🎋','🍃','🍂','🍁','🌾','🌺','🌻','🌹','🌷','🌼','🌸','💐','🍄','🌰','🎃','🐚','🕸','🌎','🌍','🌏','🌕','🌖','🌗','🌘','🌑','🌒','🌓','🌔','🌚','🌝','🌛','🌜','🌞','🌙','⭐','🌟','💫','✨','☄','☀','🌤','⛅','🌥','🌦','☁','🌧','⛈','🌩','⚡','🔥','💥','❄','🌨','☃','⛄','🌬','💨','🌪','🌫','☂','☔','💧','💦','🌊','🦅','🦆','🦇','🦈','🦉','🦊','🦋','🦌','🦍','🦎','🦏','🥀','🦐','🦑','🍏','🍎','🍐','🍊','🍋','🍌','🍉','🍇','🍓','🍈','🍒','🍑','🍍','🍅','🍆','🌶','🌽','🍠','🍯','🍞','🧀','🍗','🍖','🍤','🍳','🍔','🍟','🌭','🍕','🍝','🌮','🌯','🍜','🍲','🍥','🍣','🍱','🍛','🍙','🍚','🍘','🍢','🍡','🍧','🍨','🍦','🍰','🎂','🍮','🍬','🍭','🍫','🍿','🍩','🍪','🍺','🍻','🍷','🍸','🍹','🍾','🍶','🍵','☕','🍼','🍴','🍽','🥐','🥑','🥒','🥓','🥔','🥕','🥖','🥗','🥘','🥙','🥂','🥃','🥄','🥚','🥛','🥜','🥝','🥞','⚽','🏀','🏈','⚾','🎾','🏐','🏉','🎱','⛳','🏌','🏓','🏸','🏒','🏑','🏏','🎿','⛷','🏂','⛸','🏹','🎣','🚣','🏊','🏄','🛀','⛹','🏋','🚴','🚵','🏇','🕴','🏆','🎽','🏅','🎖','🎗','🏵','🎫','🎟','🎭','🎨','🎪','🎤','🎧','🎼','🎹','🎷','🎺','🎸','🎻','🎬','🎮','👾','🎯','🎲','🎰','🎳','🚣🏻','🚣🏼','🚣🏽','🚣🏾','🚣🏿','🏊🏻','🏊🏼','🏊🏽','🏊🏾','🏊🏿','🏄🏻','🏄🏼','🏄🏽','🏄🏾','🏄🏿','🛀🏻','🛀🏼','🛀🏽','🛀🏾','🛀🏿','⛹🏻','⛹🏼','⛹🏽','⛹🏾','⛹🏿','🏋🏻','🏋🏼','🏋🏽','🏋🏾','🏋🏿','🚴🏻','🚴🏼','🚴🏽','🚴🏾','🚴🏿','🚵🏻','🚵🏼','🚵🏽','🚵🏾','🚵🏿','🏇🏻','🏇🏼','🏇🏽','🏇🏾','🏇🏿','🕺🏻','🕺🏼','🕺🏽','🕺🏾','🕺🏿','🤸🏻','🤸🏼','🤸🏽','🤸🏾','🤸🏿','🤼🏻','🤼🏼','🤼🏽','🤼🏾','🤼🏿','🤽🏻','🤽🏼','🤽🏽','🤽🏾','🤽🏿','🤾🏻','🤾🏼','🤾🏽','🤾🏾','🤾🏿','🤹🏻','🤹🏼','🤹🏽','🤹🏾','🤹🏿','🤸','🤹','🤼','🥊','🥋','🤽','🤾','🥅','🤺','🥇','🥈','🥉','🥁','🚗','🚕','🚙','🚌','🚎','🏎','🚓','🚑','🚒','🚐','🚚','🚛','🚜','🏍','🚲','🚨','🚔','🚍','🚘','🚖','🚡','🚠','🚟','🚃','🚋','🚝','🚄','🚅','🚈','🚞','🚂','🚆','🚇','🚊','🚉','🚁','🛩','✈','🛫','🛬','⛵','🛥','🚤','⛴','🛳','🚀','🛰','💺','⚓','🚧','⛽','🚏','🚦','🚥','🏁','🚢','🎡','🎢','🎠','🏗','🌁','🗼','🏭','⛲','🎑','⛰','🏔','🗻','🌋','🗾','🏕','⛺','🏞','🛣','🛤','🌅','🌄','🏜','🏖','🏝','🌇','🌆','🏙','🌃','🌉','🌌','🌠','🎇','🎆','🌈','🏘','🏰','🏯','🏟','🗽','🏠','🏡','🏚','🏢','🏬','🏣','🏤','🏥','🏦','🏨','🏪','🏫','🏩','💒','🏛','⛪','🕌','🕍','🕋','⛩','🛒','🛴','🛵','🛶','⌚','📱','📲','💻','⌨','🖥','🖨','🖱','🖲','🕹','🗜','💽','💾','💿','📀','📼','📷','📸','📹','🎥','📽','🎞','📞','☎','📟','📠','📺','📻','🎙','🎚','🎛','⏱','⏲','⏰','🕰','⏳','⌛','📡','🔋','🔌','💡','🔦','🕯','🗑','🛢','💸','💵','💴','💶','💷','💰','💳','💎','⚖','🔧','🔨','⚒','🛠','⛏','🔩','⚙','⛓','🔫','💣','🔪','🗡','⚔','🛡','🚬','☠','⚰','⚱','🏺','🔮','📿','💈','⚗','🔭','🔬','🕳','💊','💉','🌡','🏷','🔖','🚽','🚿','🛁','🔑','🗝','🛋','🛌','🛏','🚪','🛎','🖼','🗺','⛱','🗿','🛍','🎈','🎏','🎀','🎁','🎊','🎉','🎎','🎐','🎌','🏮','✉','📩','📨','📧','💌','📮','📪','📫','📬','📭','📦','📯','📥','📤','📜','📃','📑','📊','📈','📉','📄','📅','📆','🗓','📇','🗃','🗳','🗄','📋','🗒','📁','📂','🗂','🗞','📰','📓','📕','📗','📘','📙','📔','📒','📚','📖','🔗','📎','🖇','✂','📐','📏','📌','📍','🚩','🏳','🏴','🔐','🔒','🔓','🔏','🖊','🖋','✒','📝','✏','🖍','🖌','🔍','🔎','💯','❤','💛','💚','💙','💜','💔','❣','💕','💞','💓','💗','💖','💘','💝','💟','☮','✝','☪','🕉','☸','✡','🔯','🕎','☯','☦','🛐','⛎','♈','♉','♊','♋','♌','♍','♎','♏','♐','♑','♒','♓','🆔','⚛','🈳','🈹','☢','☣','📴','📳','🈶','🈚','🈸','🈺','🈷','✴','🆚','🉑','💮','🉐','㊙','㊗','🈴','🈵','🈲','🅰','🅱','🆎','🆑','🅾','🆘','⛔','📛','🚫','❌','⭕','💢','♨','🚷','🚯','🚳','🚱','🔞','📵','❗','❕','❓','❔','‼','⁉','🔅','🔆','🔱','⚜','〽','⚠','🚸','🔰','♻','🈯','💹','❇','✳','❎','✅','💠','🌀','➿','🌐','Ⓜ','🏧','🈂','🛂','🛃','🛄','🛅','♿','🚭','🚾','🅿','🚰','🚹','🚺','🚼','🚻','🚮','🎦','📶','🈁','🆖','🆗','🆙','🆒','🆕','🆓','0⃣','1⃣','2⃣','3⃣','4⃣','5⃣','6⃣','7⃣','8⃣','9⃣','🔟','🔢','▶','⏸','⏯','⏹','⏺','⏭','⏮','⏩','⏪','🔀','🔁','🔂','◀','🔼','🔽','⏫','⏬','➡','⬅','⬆','⬇','↗','↘','↙','↖','↕','↔','🔄','↪','↩','⤴','⤵','#⃣','*⃣','ℹ','🔤','🔡','🔠','🔣','🎵','🎶','〰','➰','✔','🔃','➕','➖','➗','✖','💲','💱','©','®','™','🔚','🔙','🔛','🔝','🔜','☑','🔘','⚪','⚫','🔴','🔵','🔸','🔹','🔶','🔷','🔺','▪','▫','⬛','⬜','🔻','◼','◻','◾','◽','🔲','🔳','🔈','🔉','🔊','🔇','📣','📢','🔔','🔕','🃏','🀄','♠','♣','♥','♦','🎴','💭','🗯','💬','🕐','🕑','🕒','🕓','🕔','🕕','🕖','🕗','🕘','🕙','🕚','🕛','🕜','🕝','🕞','🕟','🕠','🕡','🕢','🕣','🕤','🕥','🕦','🕧','🗨','⏏','🖤','🛑','*','#','9','8','7','6','5','4','3','2','1','0','🇦🇨','🇦🇫','🇦🇱','🇩🇿','🇦🇩','🇦🇴','🇦🇮','🇦🇬','🇦🇷','🇦🇲','🇦🇼','🇦🇺','🇦🇹','🇦🇿','🇧🇸','🇧🇭','🇧🇩','🇧🇧','🇧🇾','🇧🇪','🇧🇿','🇧🇯','🇧🇲','🇧🇹','🇧🇴','🇧🇦','🇧🇼','🇧🇷','🇧🇳','🇧🇬','🇧🇫','🇧🇮','🇨🇻','🇰🇭','🇨🇲','🇨🇦','🇰🇾','🇨🇫','🇹🇩','🇨🇱','🇨🇳','🇨🇴','🇰🇲','🇨🇬','🇨🇩','🇨🇷','🇭🇷','🇨🇺','🇨🇾','🇨🇿','🇩🇰','🇩🇯','🇩🇲','🇩🇴','🇪🇨','🇪🇬','🇸🇻','🇬🇶','🇪🇷','🇪🇪','🇪🇹','🇫🇰','🇫🇴','🇫🇯','🇫🇮','🇫🇷','🇵🇫','🇬🇦','🇬🇲','🇬🇪','🇩🇪','🇬🇭','🇬🇮','🇬🇷','🇬🇱','🇬🇩','🇬🇺','🇬🇹','🇬🇳','🇬🇼','🇬🇾','🇭🇹','🇭🇳','🇭🇰','🇭🇺','🇮🇸','🇮🇳','🇮🇩','🇮🇷','🇮🇶','🇮🇪','🇮🇱','🇮🇹','🇨🇮','🇯🇲','🇯🇵','🇯🇪','🇯🇴','🇰🇿','🇰🇪','🇰🇮','🇽🇰','🇰🇼','🇰🇬','🇱🇦','🇱🇻','🇱🇧','🇱🇸','🇱🇷','🇱🇾','🇱🇮','🇱🇹','🇱🇺','🇲🇴','🇲🇰','🇲🇬','🇲🇼','🇲🇾','🇲🇻','🇲🇱','🇲🇹','🇲🇭','🇲🇷','🇲🇺','🇲🇽','🇫🇲','🇲🇩','🇲🇨','🇲🇳','🇲🇪','🇲🇸','🇲🇦','🇲🇿','🇲🇲','🇳🇦','🇳🇷','🇳🇵','🇳🇱','🇳🇨','🇳🇿','🇳🇮','🇳🇪','🇳🇬','🇳🇺','🇰🇵','🇳🇴','🇴🇲','🇵🇰','🇵🇼','🇵🇸','🇵🇦','🇵🇬','🇵🇾','🇵🇪','🇵🇭','🇵🇱','🇵🇹','🇵🇷','🇶🇦','🇷🇴','🇷🇺','🇷🇼','🇸🇭','🇰🇳','🇱🇨','🇻🇨','🇼🇸','🇸🇲','🇸🇹','🇸🇦','🇸🇳','🇷🇸','🇸🇨','🇸🇱','🇸🇬','🇸🇰','🇸🇮','🇸🇧','🇸🇴','🇿🇦','🇰🇷','🇪🇸','🇱🇰','🇸🇩','🇸🇷','🇸🇿','🇸🇪','🇨🇭','🇸🇾','🇹🇼','🇹🇯','🇹🇿','🇹🇭','🇹🇱','🇹🇬','🇹🇴','🇹🇹','🇹🇳','🇹🇷','🇹🇲','🇹🇻','🇺🇬','🇺🇦','🇦🇪','🇬🇧','🇺🇸','🇻🇮','🇺🇾','🇺🇿','🇻🇺','🇻🇦','🇻🇪','🇻🇳','🇼🇫','🇪🇭','🇾🇪','🇿🇲','🇿🇼','🇷🇪','🇦🇽','🇹🇦','🇮🇴','🇧🇶','🇨🇽','🇨🇨','🇬🇬','🇮🇲','🇾🇹','🇳🇫','🇵🇳','🇧🇱','🇵🇲','🇬🇸','🇹🇰','🇧🇻','🇭🇲','🇸🇯','🇺🇲','🇮🇨','🇪🇦','🇨🇵','🇩🇬','🇦🇸','🇦🇶','🇻🇬','🇨🇰','🇨🇼','🇪🇺','🇬🇫','🇹🇫','🇬🇵','🇲🇶','🇲🇵','🇸🇽','🇸🇸','🇹🇨','🇲🇫'];
@@ -7,7 +7,7 @@ TARGET = dummy
 TEMPLATE = lib
 
 lang_emoji.path = "$${UBUNTU_KEYBOARD_LIB_DIR}/emoji/"
-lang_emoji.files = *.qml *.js
+lang_emoji.files = *.qml
 
 INSTALLS += lang_emoji
 
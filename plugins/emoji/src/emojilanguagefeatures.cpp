@@ -16,9 +16,21 @@
 
 #include "emojilanguagefeatures.h"
 
+namespace {
+
+const CharacterClasses *characterClasses()
+{
+    static const CharacterClasses classes(QString::fromUtf8("。、,!?:;.\r\n"),
+                                          QString::fromUtf8("*#+=()@~/\\€£$¥₹%<>[]`^|_§{}¡¿«»\"“”„&0123456789"));
+    return &classes;
+}
+
+} // unnamed namespace
+
 EmojiLanguageFeatures::EmojiLanguageFeatures(QObject *parent) :
     QObject(parent)
 {
+    setCharacterClasses(characterClasses());
 }
 
 EmojiLanguageFeatures::~EmojiLanguageFeatures()
@@ -47,36 +59,6 @@ QString EmojiLanguageFeatures::appendixForReplacedPreedit(const QString &preedit
     return QString("");
 }
 
-bool EmojiLanguageFeatures::isSeparator(const QString &text) const
-{
-    static const QString separators = QString::fromUtf8("。、,!?:;.\r\n");
-
-    if (text.isEmpty()) {
-        return false;
-    }
-
-    if (separators.contains(text.right(1))) {
-        return true;
-    }
-
-    return false;
-}
-
-bool EmojiLanguageFeatures::isSymbol(const QString &text) const
-{
-    static const QString symbols = QString::fromUtf8("*#+=()@~/\\€£$¥₹%<>[]`^|_§{}¡¿«»\"“”„&0123456789");
-
-    if (text.isEmpty()) {
-        return false;
-    }
-
-    if (symbols.contains(text.right(1))) {
-        return true;
-    }
-
-    return false;
-}
-
 bool EmojiLanguageFeatures::ignoreSimilarity() const
 {
     return true;
@@ -24,9 +24,22 @@ TARGET          = $$qtLibraryTarget(emojiplugin)
 
 EXAMPLE_FILES = emojiplugin.json
 
+# compile the keyword index used to suggest emoji for words:
+emoji_index_en.target = emoji_en.idx
+emoji_index_en.commands = python3 $${TOP_SRCDIR}/tools/emoji-index.py $$PWD/../data/annotations/en.xml emoji_en.idx
+emoji_index_en.depends = $${TOP_SRCDIR}/tools/emoji-index.py $$PWD/../data/annotations/en.xml
+QMAKE_EXTRA_TARGETS += emoji_index_en
+PRE_TARGETDEPS += emoji_en.idx
+QMAKE_CLEAN += emoji_en.idx
+
+emoji_index_install.files = $$OUT_PWD/emoji_en.idx
+emoji_index_install.path = $${UBUNTU_KEYBOARD_LIB_DIR}/emoji/
+emoji_index_install.CONFIG += no_check_exist
+
 # install
 target.path = $${UBUNTU_KEYBOARD_LIB_DIR}/emoji/
-INSTALLS += target
+INSTALLS += target emoji_index_install
 
 OTHER_FILES += \
-    emojiplugin.json
+    emojiplugin.json \
+    ../data/annotations/en.xml
@@ -15,8 +15,15 @@
  */
 
 import QtQuick 2.4
+import UbuntuKeyboard 1.0
 
-MultiPointTouchArea {
+/*!
+  The touch area of a flick key. Like PressArea it is driven by the
+  TouchDispatcher of the keypad, which keeps reporting the touch point to
+  it while the finger moves out of the key, so the flick direction can be
+  told from mouseX and mouseY.
+ */
+KeyTouchArea {
     id: root
 
     /// Is true while the area is touched, and the finger did not yet lift
@@ -25,6 +32,7 @@ MultiPointTouchArea {
     /// Cancels the current pressed state of the mouse are
     function cancelPress() {
         pressed = false;
+        root.cancelHold();
     }
 
     onPressed: {
@@ -37,19 +45,27 @@ MultiPointTouchArea {
         pressed = false;
     }
 
+    onCanceled: {
+        pressed = false;
+    }
+
     property int index: 0   // 0:center, 1:left, 2:top, 3:right, 4:bottom
     property int old_index: 0
-    property real posX: point.x - parent.width / 2
-    property real posY: point.y - parent.height / 2
+    property real posX: mouseX - width / 2
+    property real posY: mouseY - height / 2
     property real rad: 0
 
-    touchPoints: [
-        TouchPoint { id: point }
-    ]
+    // The position is set before pressed() is emitted, only later moves
+    // count as a flick
+    onMouseXChanged: updateIndex()
+    onMouseYChanged: updateIndex()
+
+    function updateIndex() {
+        if (!pressed)
+            return;
 
-    onUpdated: {
         rad = Math.atan2(posY, posX)
-        if ((posX * posX + posY * posY) < (0.5 * parent.height * 0.5 * parent.height)) {
+        if ((posX * posX + posY * posY) < (0.5 * height * 0.5 * height)) {
             index = 0
         } else {
             if (rad < -Math.PI / 4.0) {
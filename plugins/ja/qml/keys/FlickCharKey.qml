@@ -67,7 +67,7 @@ Item {
     /*! indicates if te key is currently pressed/down*/
     property alias currentlyPressed: keyFlickArea.pressed
 
-    property string oskState: panel.activeKeypadState
+    property string oskState: maliit_keypad_state
 
     // Allow action keys to override the standard key behaviour
     property bool overridePressArea: false
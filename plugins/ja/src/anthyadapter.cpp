@@ -15,8 +15,10 @@
  */
 
 #include "anthyadapter.h"
+#include "learningstore.h"
 
 #include <QDebug>
+#include <QDir>
 
 #ifdef JA_DEBUG
 static void anthy_log(int level, const char *log)
@@ -27,12 +29,100 @@ static void anthy_log(int level, const char *log)
 }
 #endif
 
+#define CANDIDATE_SIZE 1024
+#define CANDIDATE_PAGE_SIZE 10
+
+// Replays selections on a context of its own and commits them there,
+// which is when anthy learns and writes its history.
+class AnthyLearningStore : public LearningStore
+{
+public:
+    explicit AnthyLearningStore(QObject *parent = 0)
+        : LearningStore("anthy", parent)
+        , m_context(0)
+    {}
+
+    void setContext(anthy_context_t context)
+    {
+        if (m_context) {
+            anthy_release_context(m_context);
+        }
+
+        m_context = context;
+        if (m_context) {
+            anthy_context_set_encoding(m_context, ANTHY_UTF8_ENCODING);
+        }
+    }
+
+protected:
+    virtual void learn(const QString &reading, const QString &word)
+    {
+        struct anthy_conv_stat cs;
+        struct anthy_segment_stat ss;
+
+        if (!m_context
+            || anthy_set_string(m_context, reading.toUtf8().constData()) != 0
+            || anthy_get_stat(m_context, &cs) != 0
+            || anthy_get_segment_stat(m_context, 0, &ss) != 0) {
+            return;
+        }
+
+        QString trail;
+        for (int i = 1; i < cs.nr_segment; ++i) {
+            trail.append(segmentString(i, 0));
+        }
+
+        for (int i = 0; i < ss.nr_candidate; ++i) {
+            if (segmentString(0, i) + trail == word) {
+                anthy_commit_segment(m_context, 0, i);
+                for (int j = 1; j < cs.nr_segment; ++j) {
+                    anthy_commit_segment(m_context, j, 0);
+                }
+                break;
+            }
+        }
+
+        anthy_reset_context(m_context);
+    }
+
+    virtual void save()
+    {
+        // anthy already wrote its history when the segments got committed.
+    }
+
+private:
+    QString segmentString(int segment, int candidate)
+    {
+        int len = anthy_get_segment(m_context, segment, candidate, NULL, 0);
+        if (len < 0) {
+            return QString();
+        }
+
+        QByteArray buffer(len + 1, '\0');
+        len = anthy_get_segment(m_context, segment, candidate, buffer.data(), buffer.size());
+        return len < 0 ? QString() : QString::fromUtf8(buffer.constData(), len);
+    }
+
+    anthy_context_t m_context;
+};
+
 AnthyAdapter::AnthyAdapter(QObject *parent) :
     QObject(parent)
+  , m_buffer(CANDIDATE_SIZE, '\0')
+  , m_candidateCount(0)
+  , m_nextCandidate(0)
+  , m_learningStore(new AnthyLearningStore(this))
 {
 #ifdef JA_DEBUG
     anthy_set_logger(anthy_log, 0);
 #endif
+    // anthy keeps its history below $HOME/.anthy, point it to our store,
+    // taking along what anthy learned before.
+    if (m_learningStore->importDirectory(QDir::home().filePath(".anthy"), ".anthy")) {
+        qDebug() << "[anthy] imported the existing history into" << m_learningStore->path();
+    }
+    anthy_conf_override("HOME", m_learningStore->path().toUtf8().constData());
+
     if (anthy_init() < 0)
         qCritical() << "[anthy] failed to init.";
 
@@ -41,77 +131,143 @@ AnthyAdapter::AnthyAdapter(QObject *parent) :
         qCritical() << "[anthy] failed to create anthy context.";
 
     anthy_context_set_encoding(m_context, ANTHY_UTF8_ENCODING);
+    m_learningStore->setContext(anthy_create_context());
 }
 
 AnthyAdapter::~AnthyAdapter()
 {
+    m_learningStore->flush();
+    m_learningStore->setContext(0);
+
     anthy_release_context(m_context);
     anthy_quit();
 }
 
-#define CANDIDATE_SIZE 1024
-void AnthyAdapter::parse(const QString& string)
+bool AnthyAdapter::segmentString(int segment, int candidate, QString *result)
 {
-    struct anthy_conv_stat cs;
-    struct anthy_segment_stat ss;
-    char buf[CANDIDATE_SIZE];
-    QString candidate, trail;
+    // Fetch straight into the reusable buffer and only ask anthy for the
+    // required size when the candidate didn't fit.
+    int len = anthy_get_segment(m_context, segment, candidate, m_buffer.data(), m_buffer.size());
 
-    if (anthy_set_string(m_context, string.toUtf8().constData()) != 0) {
-        qCritical() << "[anthy] failed to set string: " << string;
-    }
+    if (len < 0 || len >= m_buffer.size()) {
+        int required = anthy_get_segment(m_context, segment, candidate, NULL, 0);
+        if (required < 0) {
+            return false;
+        }
 
-    if (anthy_get_stat(m_context, &cs) != 0) {
-        qCritical() << "[anthy] failed to get stat: " << string;
+        m_buffer.resize(required + 1);
+        len = anthy_get_segment(m_context, segment, candidate, m_buffer.data(), m_buffer.size());
+        if (len < 0) {
+            return false;
+        }
     }
 
-    if (anthy_get_segment_stat(m_context, 0, &ss) != 0) {
+    *result = QString::fromUtf8(m_buffer.constData(), len);
+    return true;
+}
+
+void AnthyAdapter::materialiseCandidates(int count)
+{
+    QString candidate;
+    int last = qMin(m_nextCandidate + count, m_candidateCount);
+
+    for (; m_nextCandidate < last; ++m_nextCandidate) {
+        if (!segmentString(0, m_nextCandidate, &candidate)) {
+            qCritical() << "[anthy] failed to get segment: " << m_reading;
+            continue;
+        }
 
-        qCritical() << "[anthy] failed to get segment stat: " << string;
+        candidate.append(m_trail);
+        candidates.append(candidate);
     }
+}
 
-    /* Nth segment (N > 0) use only first candidate */
-    if (cs.nr_segment > 1) {
-        for (int i = 1; i < cs.nr_segment; ++i) {
-            if (anthy_get_segment(m_context, i, 0, NULL, 0) > CANDIDATE_SIZE - 1) {
-                qCritical() << "[anthy] buffer overflow: " << string;
-                continue;
-            }
+void AnthyAdapter::parse(const QString& string)
+{
+    m_learningStore->postpone();
+
+    candidates.clear();
+    candidates.append(string);
+
+    // anthy has no way of extending a conversion, but the reading is
+    // often requested again unchanged, in which case the existing
+    // conversion can be reused.
+    if (string != m_reading || m_candidateCount == 0) {
+        struct anthy_conv_stat cs;
+        struct anthy_segment_stat ss;
+
+        m_reading = string;
+        m_trail.clear();
+        m_candidateCount = 0;
+
+        if (anthy_set_string(m_context, string.toUtf8().constData()) != 0) {
+            qCritical() << "[anthy] failed to set string: " << string;
+        }
 
-            if (anthy_get_segment(m_context, i, 0, buf, sizeof(buf)) < 0) {
+        if (anthy_get_stat(m_context, &cs) != 0) {
+            qCritical() << "[anthy] failed to get stat: " << string;
+            cs.nr_segment = 0;
+        }
+
+        if (anthy_get_segment_stat(m_context, 0, &ss) != 0) {
+            qCritical() << "[anthy] failed to get segment stat: " << string;
+            ss.nr_candidate = 0;
+        }
+
+        /* Nth segment (N > 0) use only first candidate */
+        QString segment;
+        for (int i = 1; i < cs.nr_segment; ++i) {
+            if (!segmentString(i, 0, &segment)) {
                 qCritical() << "[anthy] failed to get segment: " << string;
                 continue;
             }
 
-            trail.append(buf);
+            m_trail.append(segment);
         }
+
+        m_candidateCount = ss.nr_candidate;
     }
 
-    /* Create candidate list for 1st segment */
-    candidates.clear();
-    candidates.append(string);
-    for (int i = 0; i < ss.nr_candidate; ++i) {
-        if (anthy_get_segment(m_context, 0, i, NULL, 0) > CANDIDATE_SIZE - 1) {
-            qCritical() << "[anthy] buffer overflow: " << string;
-            continue;
-        }
+    /* Create the first page of the candidate list for 1st segment */
+    m_nextCandidate = 0;
+    materialiseCandidates(CANDIDATE_PAGE_SIZE);
 
-        if (anthy_get_segment(m_context, 0, i, buf, sizeof(buf)) < 0) {
-            qCritical() << "[anthy] failed to get segment: " << string;
-            continue;
-        }
+    Q_EMIT newPredictionSuggestions(string, candidates, m_nextCandidate < m_candidateCount);
+}
 
-        candidate = QString(buf);
-        candidate.append(trail);
-        candidates.append(candidate);
-    }
+void AnthyAdapter::fetchMoreCandidates()
+{
+    candidates.clear();
+    materialiseCandidates(CANDIDATE_PAGE_SIZE);
 
-    Q_EMIT newPredictionSuggestions(string, candidates);
+    Q_EMIT moreSuggestions(m_reading, candidates, m_nextCandidate < m_candidateCount);
 }
 
 void AnthyAdapter::wordCandidateSelected(const QString& word)
 {
-    Q_UNUSED(word)
+    // Learning is left to the store, which does it in batches while the
+    // user isn't typing.
+    m_learningStore->record(m_reading, word);
+
+    anthy_reset_context(m_context);
+    m_reading.clear();
+    m_candidateCount = 0;
+    m_nextCandidate = 0;
+}
+
+void AnthyAdapter::flushLearning()
+{
+    m_learningStore->flush();
+}
 
+void AnthyAdapter::releaseConversion()
+{
     anthy_reset_context(m_context);
+    m_reading.clear();
+    m_trail.clear();
+    m_candidateCount = 0;
+    m_nextCandidate = 0;
+
+    candidates = QStringList();
+    m_buffer = QByteArray(CANDIDATE_SIZE, '\0');
 }
@@ -17,11 +17,14 @@
 #ifndef ANTHYADAPTER_H
 #define ANTHYADAPTER_H
 
+#include <QByteArray>
 #include <QObject>
 #include <QStringList>
 
 #include "anthy/anthy.h"
 
+class AnthyLearningStore;
+
 class AnthyAdapter : public QObject
 {
     Q_OBJECT
@@ -33,13 +36,30 @@ public:
     QStringList candidates;
 
 signals:
-    void newPredictionSuggestions(QString, QStringList);
+    void newPredictionSuggestions(QString, QStringList, bool);
+    void moreSuggestions(QString, QStringList, bool);
 
 public slots:
     void parse(const QString& string);
+    void fetchMoreCandidates();
     void wordCandidateSelected(const QString& word);
+    void flushLearning();
+    void releaseConversion();
 
 private:
+    bool segmentString(int segment, int candidate, QString *result);
+    void materialiseCandidates(int count);
+
     anthy_context_t  m_context;
+    QByteArray m_buffer;
+
+    // Conversion state of the current reading, so that candidates of the
+    // first segment can be produced a page at a time.
+    QString m_reading;
+    QString m_trail;
+    int m_candidateCount;
+    int m_nextCandidate;
+
+    AnthyLearningStore *m_learningStore;
 };
 #endif // ANTHYADAPTER_H
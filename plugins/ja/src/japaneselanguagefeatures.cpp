@@ -16,9 +16,20 @@
 
 #include "japaneselanguagefeatures.h"
 
+namespace {
+
+const CharacterClasses *characterClasses()
+{
+    static const CharacterClasses classes(QString::fromUtf8("。、,!?:;.\r\n"));
+    return &classes;
+}
+
+} // unnamed namespace
+
 JapaneseLanguageFeatures::JapaneseLanguageFeatures(QObject *parent) :
     QObject(parent)
 {
+    setCharacterClasses(characterClasses());
 }
 
 JapaneseLanguageFeatures::~JapaneseLanguageFeatures()
@@ -49,28 +60,6 @@ QString JapaneseLanguageFeatures::appendixForReplacedPreedit(const QString &pree
     return QString("");
 }
 
-bool JapaneseLanguageFeatures::isSeparator(const QString &text) const
-{
-    static const QString separators = QString::fromUtf8("。、,!?:;.\r\n");
-
-    if (text.isEmpty()) {
-        return false;
-    }
-
-    if (separators.contains(text.right(1))) {
-        return true;
-    }
-
-    return false;
-}
-
-bool JapaneseLanguageFeatures::isSymbol(const QString &text) const
-{
-    Q_UNUSED(text)
-
-    return false;
-}
-
 bool JapaneseLanguageFeatures::ignoreSimilarity() const
 {
     return true;
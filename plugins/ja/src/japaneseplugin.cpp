@@ -2,21 +2,45 @@
 #include "japaneselanguagefeatures.h"
 
 #include <QDebug>
+#include <QFileInfo>
+
+// Where distributions install the dictionary compiled by anthy-dic.
+static const char *const ANTHY_DICTIONARIES[] = {
+    "/var/lib/anthy/anthy.dic",
+    "/usr/share/anthy/anthy.dic",
+    0
+};
 
 JapanesePlugin::JapanesePlugin(QObject *parent) :
     AbstractLanguagePlugin(parent)
   , m_japaneseLanguageFeatures(new JapaneseLanguageFeatures)
   , m_processingWord(false)
+  , m_moreRequested(false)
+  , m_dictionarySize(-1)
 {
     m_anthyThread = new QThread();
     m_anthyAdapter = new AnthyAdapter();
     m_anthyAdapter->moveToThread(m_anthyThread);
 
-    connect(m_anthyAdapter, SIGNAL(newPredictionSuggestions(QString, QStringList)), this, SLOT(finishedProcessing(QString, QStringList)));
+    connect(m_anthyAdapter, SIGNAL(newPredictionSuggestions(QString, QStringList, bool)), this, SLOT(finishedProcessing(QString, QStringList, bool)));
+    connect(m_anthyAdapter, SIGNAL(moreSuggestions(QString, QStringList, bool)), this, SLOT(finishedProcessingMore(QString, QStringList, bool)));
     connect(this, SIGNAL(parsePredictionText(QString)), m_anthyAdapter, SLOT(parse(const QString&)));
+    connect(this, SIGNAL(parseMoreCandidates()), m_anthyAdapter, SLOT(fetchMoreCandidates()));
     connect(this, SIGNAL(candidateSelected(QString)), m_anthyAdapter, SLOT(wordCandidateSelected(const QString&)));
+    connect(this, SIGNAL(learningFlushRequested()), m_anthyAdapter, SLOT(flushLearning()));
+    connect(this, SIGNAL(conversionReleaseRequested()), m_anthyAdapter, SLOT(releaseConversion()));
 
     m_anthyThread->start();
+
+    // anthy maps its dictionary as a whole, so its size is about what the
+    // engine takes.
+    for (int i = 0; ANTHY_DICTIONARIES[i]; ++i) {
+        QFileInfo dictionary(ANTHY_DICTIONARIES[i]);
+        if (dictionary.exists()) {
+            m_dictionarySize = dictionary.size();
+            break;
+        }
+    }
 }
 
 JapanesePlugin::~JapanesePlugin()
@@ -36,6 +60,7 @@ void JapanesePlugin::predict(const QString& surroundingLeft, const QString& pree
     Q_UNUSED(surroundingLeft)
 
     m_nextWord = preedit;
+    m_moreRequested = false;
     if (!m_processingWord) {
         m_processingWord = true;
         Q_EMIT parsePredictionText(preedit);
@@ -47,13 +72,56 @@ void JapanesePlugin::wordCandidateSelected(QString word)
     Q_EMIT candidateSelected(word);
 }
 
-void JapanesePlugin::finishedProcessing(QString word, QStringList suggestions)
+void JapanesePlugin::flushLearning()
+{
+    Q_EMIT learningFlushRequested();
+}
+
+qint64 JapanesePlugin::memoryUsage() const
+{
+    return m_dictionarySize;
+}
+
+//! Only the conversion can be dropped, the dictionary stays mapped for as
+//! long as anthy is initialized, i.e. until the plugin is unloaded.
+void JapanesePlugin::releaseCaches()
+{
+    Q_EMIT conversionReleaseRequested();
+}
+
+void JapanesePlugin::fetchMoreCandidates()
+{
+    // Only ask anthy for the next page once the current request is done,
+    // otherwise remember it for when it is.
+    if (!m_processingWord) {
+        m_processingWord = true;
+        Q_EMIT parseMoreCandidates();
+    } else {
+        m_moreRequested = true;
+    }
+}
+
+void JapanesePlugin::finishedProcessing(QString word, QStringList suggestions, bool hasMore)
 {
     Q_EMIT newPredictionSuggestions(word, suggestions);
+    Q_EMIT moreCandidatesAvailable(word, hasMore);
     if (word != m_nextWord) {
         Q_EMIT parsePredictionText(m_nextWord);
+    } else if (m_moreRequested && hasMore) {
+        m_moreRequested = false;
+        Q_EMIT parseMoreCandidates();
     } else {
         m_processingWord = false;
     }
 }
 
+void JapanesePlugin::finishedProcessingMore(QString word, QStringList suggestions, bool hasMore)
+{
+    Q_EMIT morePredictionSuggestions(word, suggestions);
+    Q_EMIT moreCandidatesAvailable(word, hasMore);
+    if (word != m_nextWord) {
+        Q_EMIT parsePredictionText(m_nextWord);
+    } else {
+        m_processingWord = false;
+    }
+}
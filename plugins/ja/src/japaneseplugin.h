@@ -22,15 +22,23 @@ public:
     virtual AbstractLanguageFeatures* languageFeature();
 
     virtual void predict(const QString& surroundingLeft, const QString& preedit);
+    virtual void fetchMoreCandidates();
     virtual void wordCandidateSelected(QString word);
+    virtual void flushLearning();
+    virtual qint64 memoryUsage() const;
+    virtual void releaseCaches();
 
 signals:
     void newPredictionSuggestions(QString word, QStringList suggestions);
     void parsePredictionText(QString preedit);
+    void parseMoreCandidates();
     void candidateSelected(QString word);
+    void learningFlushRequested();
+    void conversionReleaseRequested();
 
 public slots:
-    void finishedProcessing(QString word, QStringList suggestions);
+    void finishedProcessing(QString word, QStringList suggestions, bool hasMore);
+    void finishedProcessingMore(QString word, QStringList suggestions, bool hasMore);
 
 private:
     JapaneseLanguageFeatures* m_japaneseLanguageFeatures;
@@ -38,6 +46,8 @@ private:
     AnthyAdapter *m_anthyAdapter;
     QString m_nextWord;
     bool m_processingWord;
+    bool m_moreRequested;
+    qint64 m_dictionarySize;
 };
 
 #endif // JAPANESEPLUGIN_H
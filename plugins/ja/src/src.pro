@@ -15,13 +15,15 @@ HEADERS         = \
     japaneseplugin.h \
     japaneselanguagefeatures.h \
     anthyadapter.h \
-    $${TOP_SRCDIR}/src/lib/logic/abstractlanguageplugin.h
+    $${TOP_SRCDIR}/src/lib/logic/abstractlanguageplugin.h \
+    $${TOP_SRCDIR}/src/lib/logic/learningstore.h
 
 SOURCES         = \
     japaneseplugin.cpp \
     japaneselanguagefeatures.cpp \
     anthyadapter.cpp \
-    $${TOP_SRCDIR}/src/lib/logic/abstractlanguageplugin.cpp
+    $${TOP_SRCDIR}/src/lib/logic/abstractlanguageplugin.cpp \
+    $${TOP_SRCDIR}/src/lib/logic/learningstore.cpp
 
 TARGET          = $$qtLibraryTarget(japlugin)
 
@@ -16,8 +16,7 @@
 
 import QtQuick 2.4
 import keys 1.0
-
-import "parser.js" as Parser
+import UbuntuKeyboard 1.0
 
 ActionKey {
     iconNormal: "erase";
@@ -26,32 +25,17 @@ ActionKey {
     action: "backspace";
 
     property string preedit: maliit_input_method.preedit
-    property string m_preedit: ""
-    property string syllable_preedit: ""
-    property string last_preedit: ""
     property bool isPreedit: preedit != ""
 
     overridePressArea: true;
 
     onReleased: {
         if (isPreedit) {
-            if (preedit.length > 1){ /* at least 2 length */
-                syllable_preedit = preedit.substring(0,preedit.length - 1);
-                last_preedit = preedit[preedit.length - 1]; /* last jamo or syllable */
-
-                m_preedit = Parser.erase_jamo(last_preedit);
-                if (m_preedit != ""){ /* exsit jamo */
-                    maliit_input_method.preedit = syllable_preedit + m_preedit;
-                } else {
-                    maliit_input_method.preedit = syllable_preedit;
-                }
-            } else {
-                  if (Parser.is_syllable(preedit)){ /* preedit is one syllable */
-                    m_preedit = Parser.erase_jamo(preedit);
-                    maliit_input_method.preedit = m_preedit;
-                  } else { /* it is only jamo like "ㄱ" or "ㅏ" */
-                     event_handler.onKeyReleased("", action);
-                  }
+            if (preedit.length > 1 || Hangul.isSyllable(preedit)) {
+                /* erase the last jamo of the last syllable */
+                maliit_input_method.preedit = Hangul.eraseJamo(preedit);
+            } else { /* it is only jamo like "ㄱ" or "ㅏ" */
+                event_handler.onKeyReleased("", action);
             }
         } else {
              event_handler.onKeyReleased("", action);
@@ -68,7 +52,7 @@ ActionKey {
         if (!isPreedit) {
             event_handler.onKeyPressed("", action);
         } else {
-            if (preedit.length == 1 && !Parser.is_syllable(preedit)) /* fixed erase action repeat */
+            if (preedit.length == 1 && !Hangul.isSyllable(preedit)) /* fixed erase action repeat */
                 event_handler.onKeyPressed("", action);
         }
     }
@@ -20,8 +20,8 @@ import Ubuntu.Components 1.3
 import Ubuntu.Components.Popups 1.3
 
 import keys 1.0
+import UbuntuKeyboard 1.0
 import "key_constants.js" as UI
-import "parser.js" as Parser
 
 CharKey {
 
@@ -38,16 +38,9 @@ CharKey {
             // get previous preedit string
             var preedit = maliit_input_method.preedit;
 
-            if (Parser.is_hangul(keyString)) {
-                // parsing preedit until compose one syllable. 
-                if (preedit.length > 1) { 
-                    var syllableString = preedit.substring(0,preedit.length - 1);
-                    var preeditString = preedit[preedit.length - 1];
-                    maliit_input_method.preedit = syllableString + Parser.add_jamo(preeditString, keyString);
-                } else {
-                    maliit_input_method.preedit = Parser.add_jamo(preedit, keyString);
-                }
-
+            if (Hangul.isHangul(keyString)) {
+                // compose the jamo into the syllable at the end of the preedit
+                maliit_input_method.preedit = Hangul.addJamo(preedit, keyString);
                 return;
             }
 
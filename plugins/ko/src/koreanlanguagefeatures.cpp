@@ -16,9 +16,21 @@
 
 #include "koreanlanguagefeatures.h"
 
+namespace {
+
+const CharacterClasses *characterClasses()
+{
+    static const CharacterClasses classes(QString::fromUtf8("。、,!?:;.\r\n"),
+                                          QString::fromUtf8("*#+=()@~/\\€£$¥₹%<>[]`^|_§{}¡¿«»\"“”„&0123456789"));
+    return &classes;
+}
+
+} // unnamed namespace
+
 KoreanLanguageFeatures::KoreanLanguageFeatures(QObject *parent) :
     QObject(parent)
 {
+    setCharacterClasses(characterClasses());
 }
 
 KoreanLanguageFeatures::~KoreanLanguageFeatures()
@@ -49,36 +61,6 @@ QString KoreanLanguageFeatures::appendixForReplacedPreedit(const QString &preedi
     return QString(" ");
 }
 
-bool KoreanLanguageFeatures::isSeparator(const QString &text) const
-{
-    static const QString separators = QString::fromUtf8("。、,!?:;.\r\n");
-
-    if (text.isEmpty()) {
-        return false;
-    }
-
-    if (separators.contains(text.right(1))) {
-        return true;
-    }
-
-    return false;
-}
-
-bool KoreanLanguageFeatures::isSymbol(const QString &text) const
-{
-    static const QString symbols = QString::fromUtf8("*#+=()@~/\\€£$¥₹%<>[]`^|_§{}¡¿«»\"“”„&0123456789");
-
-    if (text.isEmpty()) {
-        return false;
-    }
-
-    if (symbols.contains(text.right(1))) {
-        return true;
-    }
-
-    return false;
-}
-
 bool KoreanLanguageFeatures::ignoreSimilarity() const
 {
     return true;
@@ -16,9 +16,21 @@
 
 #include "chineselanguagefeatures.h"
 
+namespace {
+
+const CharacterClasses *characterClasses()
+{
+    static const CharacterClasses classes(QString::fromUtf8("。、,!?:;.…\r\n"),
+                                          QString::fromUtf8("*#+=()@~/\\€£$¥₹%<>[]`^|_—–•§{}¡¿«»\"“”„&0123456789"));
+    return &classes;
+}
+
+} // unnamed namespace
+
 ChineseLanguageFeatures::ChineseLanguageFeatures(QObject *parent) :
     QObject(parent)
 {
+    setCharacterClasses(characterClasses());
 }
 
 ChineseLanguageFeatures::~ChineseLanguageFeatures()
@@ -54,36 +66,6 @@ QString ChineseLanguageFeatures::appendixForReplacedPreedit(const QString &preed
     return QString("");
 }
 
-bool ChineseLanguageFeatures::isSeparator(const QString &text) const
-{
-    static const QString separators = QString::fromUtf8("。、,!?:;.…\r\n");
-
-    if (text.isEmpty()) {
-        return false;
-    }
-
-    if (separators.contains(text.right(1))) {
-        return true;
-    }
-
-    return false;
-}
-
-bool ChineseLanguageFeatures::isSymbol(const QString &text) const
-{
-    static const QString symbols = QString::fromUtf8("*#+=()@~/\\€£$¥₹%<>[]`^|_—–•§{}¡¿«»\"“”„&0123456789");
-
-    if (text.isEmpty()) {
-        return false;
-    }
-
-    if (symbols.contains(text.right(1))) {
-        return true;
-    }
-
-    return false;
-}
-
 bool ChineseLanguageFeatures::ignoreSimilarity() const
 {
     return true;
@@ -15,6 +15,7 @@
  */
 
 #include "pinyinadapter.h"
+#include "learningstore.h"
 
 #include <iostream>
 
@@ -26,25 +27,101 @@
 #include <QCoreApplication>
 
 #define MAX_SUGGESTIONS 100
+#define CANDIDATE_PAGE_SIZE 10
+
+// Replays selections on an instance of its own, so that training doesn't
+// disturb the instance used for typing.
+class PinyinLearningStore : public LearningStore
+{
+public:
+    explicit PinyinLearningStore(QObject *parent = 0)
+        : LearningStore("pinyin", parent)
+        , m_context(0)
+        , m_instance(0)
+    {}
+
+    void setContext(pinyin_context_t *context)
+    {
+        if (m_instance) {
+            pinyin_free_instance(m_instance);
+            m_instance = 0;
+        }
+
+        m_context = context;
+        if (m_context) {
+            m_instance = pinyin_alloc_instance(m_context);
+        }
+    }
+
+protected:
+    virtual void learn(const QString &reading, const QString &word)
+    {
+        if (!m_instance) {
+            return;
+        }
+
+        pinyin_parse_more_full_pinyins(m_instance, reading.toLatin1().data());
+        pinyin_guess_candidates(m_instance, 0);
+
+        guint count = 0;
+        pinyin_get_n_candidate(m_instance, &count);
+        for (guint i = 0; i < count; i++) {
+            lookup_candidate_t * candidate = NULL;
+            if (!pinyin_get_candidate(m_instance, i, &candidate)) {
+                continue;
+            }
+
+            const char* string = NULL;
+            pinyin_get_candidate_string(m_instance, candidate, &string);
+            if (string && word == QString(string)) {
+                pinyin_choose_candidate(m_instance, 0, candidate);
+                pinyin_train(m_instance);
+                break;
+            }
+        }
+
+        pinyin_reset(m_instance);
+    }
+
+    virtual void save()
+    {
+        if (m_context) {
+            pinyin_save(m_context);
+        }
+    }
+
+private:
+    pinyin_context_t*  m_context;
+    pinyin_instance_t* m_instance;
+};
 
 PinyinAdapter::PinyinAdapter(QObject *parent) :
     QObject(parent),
-    m_processingWords(false)
+    m_processingWords(false),
+    m_candidateCount(0),
+    m_nextCandidate(0),
+    m_learningStore(new PinyinLearningStore(this))
 {
-    m_context = pinyin_init(PINYIN_DATA_DIR, ".");
+    m_context = pinyin_init(PINYIN_DATA_DIR, m_learningStore->path().toUtf8().constData());
     m_instance = pinyin_alloc_instance(m_context);
+    m_learningStore->setContext(m_context);
 
     pinyin_set_options(m_context, IS_PINYIN | PINYIN_INCOMPLETE | USE_DIVIDED_TABLE | USE_RESPLIT_TABLE);
 }
 
 PinyinAdapter::~PinyinAdapter()
 {
+    m_learningStore->flush();
+    m_learningStore->setContext(0);
+
     pinyin_free_instance(m_instance);
     pinyin_fini(m_context);
 }
 
 void PinyinAdapter::parse(const QString& string)
 {
+    m_learningStore->postpone();
+
     pinyin_parse_more_full_pinyins(m_instance, string.toLatin1().data());
 
 #ifdef PINYIN_DEBUG
@@ -60,15 +137,37 @@ void PinyinAdapter::parse(const QString& string)
 
     pinyin_guess_candidates(m_instance, 0);
 
+    m_word = string;
+    m_candidateCount = 0;
+    m_nextCandidate = 0;
+    pinyin_get_n_candidate(m_instance, &m_candidateCount);
+    m_candidateCount = m_candidateCount > MAX_SUGGESTIONS ? MAX_SUGGESTIONS : m_candidateCount;
+
+    // Only the first page is sent along with the parse, the rest is
+    // produced when the word ribbon asks for it.
+    candidates.clear();
+    materialiseCandidates(CANDIDATE_PAGE_SIZE);
+
+    Q_EMIT newPredictionSuggestions(string, candidates, m_nextCandidate < m_candidateCount);
+}
+
+void PinyinAdapter::fetchMoreCandidates()
+{
     candidates.clear();
-    guint len = 0;
-    pinyin_get_n_candidate(m_instance, &len);
-    len = len > MAX_SUGGESTIONS ? MAX_SUGGESTIONS : len;
-    for (unsigned int i = 0 ; i < len; i ++ )
+    materialiseCandidates(CANDIDATE_PAGE_SIZE);
+
+    Q_EMIT moreSuggestions(m_word, candidates, m_nextCandidate < m_candidateCount);
+}
+
+void PinyinAdapter::materialiseCandidates(guint count)
+{
+    guint last = m_nextCandidate + count;
+    last = last > m_candidateCount ? m_candidateCount : last;
+    for (; m_nextCandidate < last; m_nextCandidate++)
     {
         lookup_candidate_t * candidate = NULL;
 
-        if (pinyin_get_candidate(m_instance, i, &candidate)) {
+        if (pinyin_get_candidate(m_instance, m_nextCandidate, &candidate)) {
             const char* word = NULL;
             pinyin_get_candidate_string(m_instance, candidate, &word);
             // Translate the token to utf-8 phrase.
@@ -77,22 +176,29 @@ void PinyinAdapter::parse(const QString& string)
             }
         }
     }
-
-    Q_EMIT newPredictionSuggestions(string, candidates);
 }
 
 void PinyinAdapter::wordCandidateSelected(const QString& word)
 {
-    Q_UNUSED(word)
-
     lookup_candidate_t * candidate = NULL;
     if (pinyin_get_candidate(m_instance, 1, &candidate)) {
         pinyin_choose_candidate(m_instance, 0, candidate);
     }
+
+    // Training and saving are left to the store, which does them in
+    // batches while the user isn't typing.
+    m_learningStore->record(m_word, word);
+}
+
+void PinyinAdapter::flushLearning()
+{
+    m_learningStore->flush();
 }
 
 void PinyinAdapter::reset()
 {
     pinyin_reset(m_instance);
+    m_candidateCount = 0;
+    m_nextCandidate = 0;
 }
 
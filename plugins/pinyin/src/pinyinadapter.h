@@ -22,6 +22,8 @@
 
 #include "pinyin.h"
 
+class PinyinLearningStore;
+
 class PinyinAdapter : public QObject
 {
     Q_OBJECT
@@ -33,16 +35,27 @@ class PinyinAdapter : public QObject
 
     bool m_processingWords;
 
+    QString m_word;
+    guint m_candidateCount;
+    guint m_nextCandidate;
+
+    void materialiseCandidates(guint count);
+
+    PinyinLearningStore *m_learningStore;
+
 public:
     explicit PinyinAdapter(QObject *parent = 0);
     ~PinyinAdapter();
 
 signals:
-    void newPredictionSuggestions(QString, QStringList);
+    void newPredictionSuggestions(QString, QStringList, bool);
+    void moreSuggestions(QString, QStringList, bool);
 
 public slots:
     void parse(const QString& string);
+    void fetchMoreCandidates();
     void wordCandidateSelected(const QString& word);
+    void flushLearning();
     void reset();
 };
 
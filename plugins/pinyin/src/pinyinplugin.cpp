@@ -2,20 +2,32 @@
 #include "chineselanguagefeatures.h"
 
 #include <QDebug>
+#include <QDir>
 
 PinyinPlugin::PinyinPlugin(QObject *parent) :
     AbstractLanguagePlugin(parent)
   , m_chineseLanguageFeatures(new ChineseLanguageFeatures)
   , m_processingWord(false)
+  , m_moreRequested(false)
+  , m_dataSize(0)
 {
     m_pinyinThread = new QThread();
     m_pinyinAdapter = new PinyinAdapter();
     m_pinyinAdapter->moveToThread(m_pinyinThread);
 
-    connect(m_pinyinAdapter, SIGNAL(newPredictionSuggestions(QString, QStringList)), this, SLOT(finishedProcessing(QString, QStringList)));
+    connect(m_pinyinAdapter, SIGNAL(newPredictionSuggestions(QString, QStringList, bool)), this, SLOT(finishedProcessing(QString, QStringList, bool)));
+    connect(m_pinyinAdapter, SIGNAL(moreSuggestions(QString, QStringList, bool)), this, SLOT(finishedProcessingMore(QString, QStringList, bool)));
     connect(this, SIGNAL(parsePredictionText(QString)), m_pinyinAdapter, SLOT(parse(QString)));
+    connect(this, SIGNAL(parseMoreCandidates()), m_pinyinAdapter, SLOT(fetchMoreCandidates()));
     connect(this, SIGNAL(candidateSelected(QString)), m_pinyinAdapter, SLOT(wordCandidateSelected(QString)));
+    connect(this, SIGNAL(learningFlushRequested()), m_pinyinAdapter, SLOT(flushLearning()));
     m_pinyinThread->start();
+
+    // libpinyin reads its tables into memory, so their size is about what
+    // the engine takes.
+    Q_FOREACH(const QFileInfo &file, QDir(PINYIN_DATA_DIR).entryInfoList(QDir::Files)) {
+        m_dataSize += file.size();
+    }
 }
 
 PinyinPlugin::~PinyinPlugin()
@@ -29,6 +41,7 @@ void PinyinPlugin::predict(const QString& surroundingLeft, const QString& preedi
 {
     Q_UNUSED(surroundingLeft);
     m_nextWord = preedit;
+    m_moreRequested = false;
     if (!m_processingWord) {
         m_processingWord = true;
         Q_EMIT parsePredictionText(preedit);
@@ -40,16 +53,51 @@ void PinyinPlugin::wordCandidateSelected(QString word)
     Q_EMIT candidateSelected(word);
 }
 
+void PinyinPlugin::flushLearning()
+{
+    Q_EMIT learningFlushRequested();
+}
+
+qint64 PinyinPlugin::memoryUsage() const
+{
+    return m_dataSize;
+}
+
 AbstractLanguageFeatures* PinyinPlugin::languageFeature()
 {
     return m_chineseLanguageFeatures;
 }
 
-void PinyinPlugin::finishedProcessing(QString word, QStringList suggestions)
+void PinyinPlugin::fetchMoreCandidates()
+{
+    if (!m_processingWord) {
+        m_processingWord = true;
+        Q_EMIT parseMoreCandidates();
+    } else {
+        m_moreRequested = true;
+    }
+}
+
+void PinyinPlugin::finishedProcessing(QString word, QStringList suggestions, bool hasMore)
 {
     Q_EMIT newPredictionSuggestions(word, suggestions);
+    Q_EMIT moreCandidatesAvailable(word, hasMore);
+    if (word != m_nextWord) {
+        Q_EMIT parsePredictionText(m_nextWord);
+    } else if (m_moreRequested && hasMore) {
+        m_moreRequested = false;
+        Q_EMIT parseMoreCandidates();
+    } else {
+        m_processingWord = false;
+    }
+}
+
+void PinyinPlugin::finishedProcessingMore(QString word, QStringList suggestions, bool hasMore)
+{
+    Q_EMIT morePredictionSuggestions(word, suggestions);
+    Q_EMIT moreCandidatesAvailable(word, hasMore);
     if (word != m_nextWord) {
-        Q_EMIT(parsePredictionText(word));
+        Q_EMIT parsePredictionText(m_nextWord);
     } else {
         m_processingWord = false;
     }
@@ -23,7 +23,10 @@ public:
     virtual ~PinyinPlugin();
     
     virtual void predict(const QString& surroundingLeft, const QString& preedit);
+    virtual void fetchMoreCandidates();
     virtual void wordCandidateSelected(QString word);
+    virtual void flushLearning();
+    virtual qint64 memoryUsage() const;
 
     virtual AbstractLanguageFeatures* languageFeature();
 
@@ -35,10 +38,13 @@ public:
 signals:
     void newPredictionSuggestions(QString word, QStringList suggestions);
     void parsePredictionText(QString preedit);
+    void parseMoreCandidates();
     void candidateSelected(QString word);
+    void learningFlushRequested();
     
 public slots:
-    void finishedProcessing(QString word, QStringList suggestions);
+    void finishedProcessing(QString word, QStringList suggestions, bool hasMore);
+    void finishedProcessingMore(QString word, QStringList suggestions, bool hasMore);
     
 private:
     QThread *m_pinyinThread;
@@ -46,6 +52,8 @@ private:
     ChineseLanguageFeatures* m_chineseLanguageFeatures;
     QString m_nextWord;
     bool m_processingWord;
+    bool m_moreRequested;
+    qint64 m_dataSize;
 };
 
 #endif // PINYINPLUGIN_H
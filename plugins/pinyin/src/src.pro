@@ -17,13 +17,15 @@ HEADERS         = \
                   pinyinadapter.h \
                   pinyinplugin.h \
                   chineselanguagefeatures.h \
-                  $${TOP_SRCDIR}/src/lib/logic/abstractlanguageplugin.h
+                  $${TOP_SRCDIR}/src/lib/logic/abstractlanguageplugin.h \
+                  $${TOP_SRCDIR}/src/lib/logic/learningstore.h
 
 SOURCES         = \
                   pinyinadapter.cpp \
                   pinyinplugin.cpp \
                   chineselanguagefeatures.cpp \
-                  $${TOP_SRCDIR}/src/lib/logic/abstractlanguageplugin.cpp
+                  $${TOP_SRCDIR}/src/lib/logic/abstractlanguageplugin.cpp \
+                  $${TOP_SRCDIR}/src/lib/logic/learningstore.cpp
 
 TARGET          = $$qtLibraryTarget(zh-hansplugin)
 
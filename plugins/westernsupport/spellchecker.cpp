@@ -72,6 +72,10 @@ struct SpellCheckerPrivate
     QString user_dictionary_file;
     QString aff_file;
     QString dic_file;
+    //! Dictionary handed in by setDictionary(), empty if there is none.
+    QString known_language;
+    QString known_aff_file;
+    QString known_dic_file;
 
     SpellCheckerPrivate(const QString &user_dictionary);
     ~SpellCheckerPrivate();
@@ -88,6 +92,9 @@ SpellCheckerPrivate::SpellCheckerPrivate(const QString &user_dictionary)
     , user_dictionary_file(user_dictionary)
     , aff_file()
     , dic_file()
+    , known_language()
+    , known_aff_file()
+    , known_dic_file()
 {
 }
 
@@ -288,25 +295,36 @@ bool SpellChecker::setLanguage(const QString &language)
 
     qDebug() << "spellechecker.cpp in setLanguage() lang=" << language << "dictPath=" << dictPath();
 
-    QDir dictDir(dictPath());
-    QStringList affMatches = dictDir.entryList(QStringList(language+"*.aff"));
-    QStringList dicMatches = dictDir.entryList(QStringList(language+"*.dic"));
+    if (language == d->known_language) {
+        if (d->known_aff_file.isEmpty()) {
+            qWarning() << "No dictionary found for" << language << "turning off spellchecking";
+            d->clear();
+            return false;
+        }
+
+        d->aff_file = d->known_aff_file;
+        d->dic_file = d->known_dic_file;
+    } else {
+        QDir dictDir(dictPath());
+        QStringList affMatches = dictDir.entryList(QStringList(language+"*.aff"));
+        QStringList dicMatches = dictDir.entryList(QStringList(language+"*.dic"));
+
+        if (affMatches.isEmpty() || dicMatches.isEmpty()) {
+            QString lang = language;
+            lang.truncate(2);
+            qWarning() << "Did not find a dictionary for" << language << " - checking for " << lang;
+            if (language.length() > 2) {
+                return setLanguage(lang);
+            }
 
-    if (affMatches.isEmpty() || dicMatches.isEmpty()) {
-        QString lang = language;
-        lang.truncate(2);
-        qWarning() << "Did not find a dictionary for" << language << " - checking for " << lang;
-        if (language.length() > 2) {
-            return setLanguage(lang);
+            qWarning() << "No dictionary found for" << language << "turning off spellchecking";
+            d->clear();
+            return false;
         }
 
-        qWarning() << "No dictionary found for" << language << "turning off spellchecking";
-        d->clear();
-        return false;
+        d->aff_file = dictPath() + QDir::separator() + affMatches[0];
+        d->dic_file = dictPath() + QDir::separator() + dicMatches[0];
     }
-
-    d->aff_file = dictPath() + QDir::separator() + affMatches[0];
-    d->dic_file = dictPath() + QDir::separator() + dicMatches[0];
     d->user_dictionary_file = QStandardPaths::writableLocation(QStandardPaths::DataLocation) + QDir::separator() + language + "_userDictionary.dic";
 
     qDebug() << "spellechecker.cpp in setLanguage() aff_file=" << d->aff_file << "dic_file=" << d->dic_file << "user dictionary=" << d->user_dictionary_file;
@@ -319,6 +337,20 @@ bool SpellChecker::setLanguage(const QString &language)
     }
 }
 
+//! \brief SpellChecker::setDictionary tells which dictionary to use for a
+//! language, so that setLanguage() does not have to search dictPath() for it
+//! \param language The language the dictionary is for
+//! \param affFile The hunspell affix file, empty if there is no dictionary
+//! \param dicFile The hunspell dictionary file
+void SpellChecker::setDictionary(const QString &language, const QString &affFile, const QString &dicFile)
+{
+    Q_D(SpellChecker);
+
+    d->known_language = language;
+    d->known_aff_file = affFile;
+    d->known_dic_file = dicFile;
+}
+
 // static
 QString SpellChecker::dictPath()
 {
@@ -58,6 +58,7 @@ public:
     void updateWord(const QString &word);
 
     bool setLanguage(const QString& language);
+    void setDictionary(const QString& language, const QString& affFile, const QString& dicFile);
 
     static QString dictPath();
 
@@ -26,6 +26,7 @@
  */
 
 #include "spellpredictworker.h"
+#include "startuptrace.h"
 
 #include <QDebug>
 
@@ -88,14 +89,30 @@ void SpellPredictWorker::setLanguage(QString locale, QString pluginPath)
 {
     QString dbFileName = "database_"+locale+".db";
     QString fullPath(pluginPath + QDir::separator() + dbFileName);
+
+    qint64 start = MaliitKeyboard::StartupTrace::now();
     m_spellChecker.setLanguage(locale);
     m_spellChecker.setEnabled(true);
+    qint64 end = MaliitKeyboard::StartupTrace::now();
+    Q_EMIT loadingPhaseFinished("hunspell " + locale, start, end);
 
+    start = end;
     try {
         m_presage.config("Presage.Predictors.DefaultSmoothedNgramPredictor.DBFILENAME", fullPath.toLatin1().data());
     } catch (int error) {
         qWarning() << "An exception was thrown in libpresage when changing language database, exception nr: " << error;
     }
+    Q_EMIT loadingPhaseFinished("presage " + locale, start, MaliitKeyboard::StartupTrace::now());
+}
+
+void SpellPredictWorker::setDictionary(QString language, QString affFile, QString dicFile)
+{
+    m_spellChecker.setDictionary(language, affFile, dicFile);
+}
+
+void SpellPredictWorker::releaseDictionary()
+{
+    m_spellChecker.setEnabled(false);
 }
 
 void SpellPredictWorker::suggest(const QString& word, int limit)
@@ -50,6 +50,8 @@ public slots:
     void parsePredictionText(const QString& surroundingLeft, const QString& preedit);
     void newSpellCheckWord(QString word);
     void setLanguage(QString language, QString pluginPath);
+    void setDictionary(QString language, QString affFile, QString dicFile);
+    void releaseDictionary();
     void setSpellCheckLimit(int limit);
     void addToUserWordList(const QString& word);
     void addOverride(const QString& orig, const QString& overriden);
@@ -57,6 +59,7 @@ public slots:
 signals:
     void newSpellingSuggestions(QString word, QStringList suggestions);
     void newPredictionSuggestions(QString word, QStringList suggestions);
+    void loadingPhaseFinished(QString phase, qint64 startUsecs, qint64 endUsecs);
 
 private:
     std::string m_candidatesContext;
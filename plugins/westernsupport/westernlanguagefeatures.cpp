@@ -33,9 +33,21 @@
 
 #include <QtCore>
 
+namespace {
+
+const CharacterClasses *characterClasses()
+{
+    static const CharacterClasses classes(QString::fromUtf8(",.!?:;…\r\n"),
+                                          QString::fromUtf8("*#+=()@~/\\€£$¥₹%<>[]`^|_—–•§{}¡¿«»\"“”„&0123456789"));
+    return &classes;
+}
+
+} // unnamed namespace
+
 WesternLanguageFeatures::WesternLanguageFeatures(QObject *parent) :
     QObject(parent)
 {
+    setCharacterClasses(characterClasses());
 }
 
 WesternLanguageFeatures::~WesternLanguageFeatures()
@@ -75,36 +87,6 @@ QString WesternLanguageFeatures::appendixForReplacedPreedit(const QString &preed
     return QString(" ");
 }
 
-bool WesternLanguageFeatures::isSeparator(const QString &text) const
-{
-    static const QString separators = QString::fromUtf8(",.!?:;…\r\n");
-
-    if (text.isEmpty()) {
-        return false;
-    }
-
-    if (separators.contains(text.right(1))) {
-        return true;
-    }
-
-    return false;
-}
-
-bool WesternLanguageFeatures::isSymbol(const QString &text) const
-{
-    static const QString symbols = QString::fromUtf8("*#+=()@~/\\€£$¥₹%<>[]`^|_—–•§{}¡¿«»\"“”„&0123456789");
-
-    if (text.isEmpty()) {
-        return false;
-    }
-
-    if (symbols.contains(text.right(1))) {
-        return true;
-    }
-
-    return false;
-}
-
 bool WesternLanguageFeatures::ignoreSimilarity() const
 {
     return false;
@@ -46,9 +46,7 @@ public:
     virtual bool autoCapsAvailable() const;
     virtual bool activateAutoCaps(const QString &preedit) const;
     virtual QString appendixForReplacedPreedit(const QString &preedit) const;
-    virtual bool isSeparator(const QString &text) const;
     virtual QString fullStopSequence() const { return QString("."); }
-    virtual bool isSymbol(const QString &text) const;
     virtual bool ignoreSimilarity() const;
     virtual bool wordEngineAvailable() const;
 };
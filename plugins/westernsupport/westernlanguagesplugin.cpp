@@ -9,6 +9,9 @@ WesternLanguagesPlugin::WesternLanguagesPlugin(QObject *parent) :
   , m_languageFeatures(new WesternLanguageFeatures)
   , m_spellCheckEnabled(false)
   , m_processingSpelling(false)
+  , m_resources()
+  , m_dictionarySize(-1)
+  , m_databaseSize(0)
 {
     m_spellPredictThread = new QThread();
     m_spellPredictWorker = new SpellPredictWorker();
@@ -16,8 +19,11 @@ WesternLanguagesPlugin::WesternLanguagesPlugin(QObject *parent) :
 
     connect(m_spellPredictWorker, SIGNAL(newSpellingSuggestions(QString, QStringList)), this, SLOT(spellCheckFinishedProcessing(QString, QStringList)));
     connect(m_spellPredictWorker, SIGNAL(newPredictionSuggestions(QString, QStringList)), this, SIGNAL(newPredictionSuggestions(QString, QStringList)));
+    connect(m_spellPredictWorker, SIGNAL(loadingPhaseFinished(QString, qint64, qint64)), this, SIGNAL(loadingPhaseFinished(QString, qint64, qint64)));
     connect(this, SIGNAL(newSpellCheckWord(QString)), m_spellPredictWorker, SLOT(newSpellCheckWord(QString)));
     connect(this, SIGNAL(setSpellPredictLanguage(QString, QString)), m_spellPredictWorker, SLOT(setLanguage(QString, QString)));
+    connect(this, SIGNAL(setSpellPredictDictionary(QString, QString, QString)), m_spellPredictWorker, SLOT(setDictionary(QString, QString, QString)));
+    connect(this, SIGNAL(releaseSpellPredictDictionary()), m_spellPredictWorker, SLOT(releaseDictionary()));
     connect(this, SIGNAL(setSpellCheckLimit(int)), m_spellPredictWorker, SLOT(setSpellCheckLimit(int)));
     connect(this, SIGNAL(parsePredictionText(QString, QString)), m_spellPredictWorker, SLOT(parsePredictionText(QString, QString)));
     connect(this, SIGNAL(addToUserWordList(QString)), m_spellPredictWorker, SLOT(addToUserWordList(QString)));
@@ -67,10 +73,41 @@ void WesternLanguagesPlugin::addToSpellCheckerUserWordList(const QString& word)
 bool WesternLanguagesPlugin::setLanguage(const QString& languageId, const QString& pluginPath)
 {
     Q_EMIT setSpellPredictLanguage(languageId, pluginPath);
-    loadOverrides(pluginPath);
+    // No need to look for overrides the keyboard already knows are missing.
+    if (m_resources.id != languageId || !m_resources.overrides.isEmpty()) {
+        loadOverrides(pluginPath);
+    }
+
+    // The files hunspell and presage load stand in for the memory they take.
+    if (m_resources.id == languageId) {
+        m_dictionarySize = QFileInfo(m_resources.affFile).size() + QFileInfo(m_resources.dicFile).size();
+        m_databaseSize = QFileInfo(m_resources.database).size();
+    } else {
+        m_dictionarySize = -1;
+    }
     return true;
 }
 
+void WesternLanguagesPlugin::setLanguageResources(const LanguageResources &resources)
+{
+    m_resources = resources;
+    Q_EMIT setSpellPredictDictionary(resources.id, resources.affFile, resources.dicFile);
+}
+
+qint64 WesternLanguagesPlugin::memoryUsage() const
+{
+    return m_dictionarySize < 0 ? -1 : m_dictionarySize + m_databaseSize;
+}
+
+//! The spell checker dictionary is loaded again by setLanguage().
+void WesternLanguagesPlugin::releaseCaches()
+{
+    Q_EMIT releaseSpellPredictDictionary();
+    if (m_dictionarySize > 0) {
+        m_dictionarySize = 0;
+    }
+}
+
 void WesternLanguagesPlugin::addSpellingOverride(const QString& orig, const QString& overriden)
 {
     Q_EMIT addOverride(orig, overriden);
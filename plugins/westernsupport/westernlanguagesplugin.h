@@ -31,6 +31,9 @@ public:
     virtual void spellCheckerSuggest(const QString& word, int limit);
     virtual void addToSpellCheckerUserWordList(const QString& word);
     virtual bool setLanguage(const QString& languageId, const QString& pluginPath);
+    virtual void setLanguageResources(const LanguageResources &resources);
+    virtual qint64 memoryUsage() const;
+    virtual void releaseCaches();
     virtual void addSpellingOverride(const QString& orig, const QString& overriden);
     virtual void loadOverrides(const QString& pluginPath);
 
@@ -40,6 +43,8 @@ signals:
     void newSpellCheckWord(QString word);
     void setSpellCheckLimit(int limit);
     void setSpellPredictLanguage(QString language, QString pluginPath);
+    void setSpellPredictDictionary(QString language, QString affFile, QString dicFile);
+    void releaseSpellPredictDictionary();
     void parsePredictionText(QString surroundingLeft, QString preedit);
     void setPredictionLanguage(QString language);
     void addToUserWordList(const QString& word);
@@ -55,6 +60,9 @@ private:
     bool m_spellCheckEnabled;
     QString m_nextSpellWord;
     bool m_processingSpelling;
+    LanguageResources m_resources;
+    qint64 m_dictionarySize;
+    qint64 m_databaseSize;
 };
 
 #endif // WESTERNLANGUAGESPLUGIN_H
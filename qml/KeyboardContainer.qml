@@ -19,6 +19,7 @@ import QtMultimedia 5.0
 import QtQuick.Window 2.0
 import "languages/"
 import "keys/"
+import "keys/key_constants.js" as UI
 import UbuntuKeyboard 1.0
 import QtFeedback 5.0
 
@@ -36,8 +37,6 @@ Item {
     property bool switchBack: false // Switch back to the previous layout when changing fields
     property bool hideKeyLabels: false // Hide key labels when in cursor movement mode
 
-    property Item lastKeyPressed // Used for determining double click validity in PressArea
-
     state: "CHARACTERS"
 
     function closeExtendedKeys()
@@ -45,11 +44,29 @@ Item {
         extendedKeysSelector.closePopover();
     }
 
-    Loader {
+    // Draws the faces of all keys, beneath the icons of the keypad itself
+    KeypadRenderer {
+        id: keypadRenderer
+        anchors.fill: parent
+        keypad: characterKeypadLoader.item
+        shifted: panel.activeKeypadState !== "NORMAL"
+        labelsVisible: !panel.hideKeyLabels
+        font.family: UI.fontFamily
+        font.weight: Font.Light
+        fontColor: UI.fontColor
+        annotationColor: UI.annotationFontColor
+        radius: units.dp(4)
+        labelMargin: units.gu(0.2)
+        annotationMargins: Qt.point(units.gu(UI.annotationRightMargin), units.gu(UI.annotationTopMargin))
+    }
+
+    KeypadCache {
         id: characterKeypadLoader
         objectName: "characterKeyPadLoader"
         anchors.fill: parent
-        asynchronous: false
+        orientation: maliit_geometry.orientation
+        asynchronous: true
+        keypadState: panel.activeKeypadState
         source: panel.state === "CHARACTERS" ? internal.characterKeypadSource : internal.symbolKeypadSource
         onLoaded: {
             if (delayedAutoCaps) {
@@ -61,6 +78,45 @@ Item {
         }
     }
 
+    // Delivers the touch points to the keys of the shown keypad
+    TouchDispatcher {
+        id: touchDispatcher
+        objectName: "touchDispatcher"
+        anchors.fill: parent
+        keypad: characterKeypadLoader.item
+    }
+
+    // Rough outline of the keys, shown until the first keypad is created
+    Column {
+        id: keypadPlaceholder
+        anchors.fill: parent
+        visible: !characterKeypadLoader.item && characterKeypadLoader.status === KeypadCache.Loading
+
+        Repeater {
+            model: 4
+
+            Row {
+                anchors.horizontalCenter: parent.horizontalCenter
+
+                Repeater {
+                    model: 10
+
+                    Item {
+                        width: keypadPlaceholder.width / 10
+                        height: keypadPlaceholder.height / 4
+
+                        Rectangle {
+                            anchors.fill: parent
+                            anchors.margins: Math.min(parent.width, parent.height) / 16
+                            radius: units.dp(4)
+                            color: UI.charKeyColor
+                        }
+                    }
+                }
+            }
+        }
+    }
+
     ExtendedKeysSelector {
         id: extendedKeysSelector
         objectName: "extendedKeysSelector"
@@ -145,19 +201,26 @@ Item {
 
             // EmailContentType
             if (contentType === 3) {
-                canvas.layoutId = "email";
-                return maliit_input_method.currentPluginPath + "/Keyboard_" + language + "_email.qml";
+                var emailLayout = maliit_input_method.layoutFile(language, "email");
+                if (emailLayout !== "") {
+                    canvas.layoutId = "email";
+                    return emailLayout;
+                }
             }
 
             // UrlContentType
             if (contentType === 4) {
-                canvas.layoutId = "url";
-                return maliit_input_method.currentPluginPath + "/Keyboard_" + language + "_url_search.qml";
+                var urlLayout = maliit_input_method.layoutFile(language, "url_search");
+                if (urlLayout !== "") {
+                    canvas.layoutId = "url";
+                    return urlLayout;
+                }
             }
 
-            // FreeTextContentType used as fallback
+            // FreeTextContentType used as fallback, also for languages
+            // without a layout of their own for email addresses or urls
             canvas.layoutId = "freetext";
-            return maliit_input_method.currentPluginPath + "/Keyboard_" + language + ".qml";
+            return maliit_input_method.layoutFile(language, "");
         }
     }
 }
@@ -69,7 +69,7 @@ CharKey {
     }
 
     // make sure the icon changes even if the property icon* change on runtime
-    state: panel.activeKeypadState
+    state: maliit_keypad_state
     states: [
         State {
             name: "SHIFTED"
@@ -19,6 +19,8 @@ import QtMultimedia 5.0
 import Ubuntu.Components 1.3
 import Ubuntu.Components.Popups 1.3
 
+import UbuntuKeyboard 1.0
+
 import "key_constants.js" as UI
 
 Item {
@@ -38,10 +40,13 @@ Item {
     property bool highlight: false;
     property double textCenterOffset: units.gu(-0.15)
 
-    property string valueToSubmit: keyLabel.text
+    property string valueToSubmit: (maliit_keypad_state === "NORMAL") ? label : shifted
 
     property alias acceptDoubleClick: keyMouseArea.acceptDoubleClick
     property alias horizontalSwipe: keyMouseArea.horizontalSwipe
+    // Keys handling touches with their own MouseArea take the press area
+    // out of the touch dispatch
+    property alias pressAreaEnabled: keyMouseArea.enabled
 
     property string action
     property bool noMagnifier: false
@@ -92,8 +97,8 @@ Item {
      * extended keys change as well when shifting keyboard, typically lower-uppercase: ê vs Ê
      */
 
-    property string oskState: panel.activeKeypadState
-    property var activeExtendedModel: (panel.activeKeypadState === "NORMAL") ? extended : extendedShifted
+    property string oskState: maliit_keypad_state
+    property var activeExtendedModel: (maliit_keypad_state === "NORMAL") ? extended : extendedShifted
 
     // Allow action keys to override the standard key behaviour
     property bool overridePressArea: false
@@ -134,55 +139,69 @@ Item {
         height: panel.keyHeight
         width: parent.width
 
-        Rectangle {
+        KeyFace {
             id: buttonRect
-            color: key.currentlyPressed || key.highlight ? pressedColor : normalColor
+            color: normalColor
+            pressedColor: key.pressedColor
+            pressed: key.currentlyPressed || key.highlight
             anchors.fill: parent
             anchors.leftMargin: key.leftSide ? (parent.width - panel.keyWidth) + key.keyMargin : key.keyMargin
             anchors.rightMargin: key.rightSide ? (parent.width - panel.keyWidth) + key.keyMargin : key.keyMargin
             anchors.bottomMargin: key.rowMargin
-            radius: units.dp(4)
 
-            /// label of the key
+            /// label of the key, drawn by the keypad's KeypadRenderer
             //  the label is also the value subitted to the app
-        
-            Text {
-                id: keyLabel
-                text: (panel.activeKeypadState === "NORMAL") ? label : shifted;
-                font.family: UI.fontFamily
-                font.pixelSize: fontSize
-                font.weight: Font.Light
-                color: UI.fontColor
-                anchors.right: parent.right
-                anchors.left: parent.left
-                anchors.leftMargin: units.gu(0.2)
-                anchors.rightMargin: units.gu(0.2)
-                anchors.verticalCenter: parent.verticalCenter 
-                anchors.verticalCenterOffset: key.textCenterOffset
-                horizontalAlignment: Text.AlignHCenter
-                // Avoid eliding characters that are slightly too wide (e.g. some emoji and chinese characters)
-                elide: text.length <= 4 ? Text.ElideNone : Text.ElideRight
-                visible: !panel.hideKeyLabels
-            }
-        
+            label: key.label
+            shiftedLabel: key.shifted
+            fontSize: key.fontSize
+            labelOffset: key.textCenterOffset
+
             /// shows an annotation
             // used e.g. for indicating the existence of extended keys
-        
-            Text {
-                id: annotationLabel
-                text: (panel.activeKeypadState != "NORMAL") ? __annotationLabelShifted : __annotationLabelNormal
-        
-                anchors.right: parent.right
-                anchors.top: parent.top
-                anchors.topMargin: units.gu(UI.annotationTopMargin)
-                anchors.rightMargin: units.gu(UI.annotationRightMargin)
-                font.family: UI.annotationFont
-                font.pixelSize: fontSize / 3
-                font.weight: Font.Light
-                color: UI.annotationFontColor
-                visible: !panel.hideKeyLabels
-            }
+            annotation: __annotationLabelNormal
+            shiftedAnnotation: __annotationLabelShifted
+        }
 
+        // Keys inside a Flickable, like the emoji grid, scroll away from the
+        // KeypadRenderer and draw their face themselves
+        Loader {
+            anchors.fill: buttonRect
+            active: buttonRect.selfDrawn
+            sourceComponent: Rectangle {
+                color: buttonRect.pressed ? buttonRect.pressedColor : buttonRect.color
+                radius: units.dp(4)
+
+                Text {
+                    text: (maliit_keypad_state === "NORMAL") ? key.label : key.shifted
+                    font.family: UI.fontFamily
+                    font.pixelSize: key.fontSize
+                    font.weight: Font.Light
+                    color: UI.fontColor
+                    anchors.right: parent.right
+                    anchors.left: parent.left
+                    anchors.leftMargin: units.gu(0.2)
+                    anchors.rightMargin: units.gu(0.2)
+                    anchors.verticalCenter: parent.verticalCenter
+                    anchors.verticalCenterOffset: key.textCenterOffset
+                    horizontalAlignment: Text.AlignHCenter
+                    // Avoid eliding characters that are slightly too wide (e.g. some emoji and chinese characters)
+                    elide: text.length <= 4 ? Text.ElideNone : Text.ElideRight
+                    visible: !panel.hideKeyLabels
+                }
+
+                Text {
+                    text: (maliit_keypad_state !== "NORMAL") ? __annotationLabelShifted : __annotationLabelNormal
+                    anchors.right: parent.right
+                    anchors.top: parent.top
+                    anchors.topMargin: units.gu(UI.annotationTopMargin)
+                    anchors.rightMargin: units.gu(UI.annotationRightMargin)
+                    font.family: UI.annotationFont
+                    font.pixelSize: key.fontSize / 3
+                    font.weight: Font.Light
+                    color: UI.annotationFontColor
+                    visible: !panel.hideKeyLabels
+                }
+            }
         }
     }
 
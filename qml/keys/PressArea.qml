@@ -15,13 +15,15 @@
  */
 
 import QtQuick 2.4
+import UbuntuKeyboard 1.0
 
 /*!
-  MultiPointTouchArea is similar to the MouseArea
-  But to enable multiple PressAreas to be touched at the same time, this is based
-  on MultiPointTouchArea
+  The touch area of a key. Touch points are not delivered to it directly,
+  the TouchDispatcher of the keypad resolves them to the key underneath and
+  drives the press, hold and double click state in C++. This only handles
+  what the touch means for the keyboard surface.
  */
-MultiPointTouchArea {
+KeyTouchArea {
     id: root
 
     /// Is true while the area is touched, and the finger did not yet lift
@@ -29,117 +31,66 @@ MultiPointTouchArea {
     // Track whether we've swiped out of a key press to dismiss the keyboard
     property bool swipedOut: false
     property bool horizontalSwipe: false
-    property bool held: false
-    property alias mouseX: point.x
-    property alias mouseY: point.y
-    // Keep track of the touch start position ourselves instead of using
-    // point.startY, as this always reports 0 for mouse interaction 
-    // (https://bugreports.qt.io/browse/QTBUG-41692)
-    property real startY
 
-    property bool acceptDoubleClick: false
-    maximumTouchPoints: 1
-
-    /// Same as MouseArea pressAndHold()
-    signal pressAndHold()
-
-    signal doubleClicked()
+    property double lastY
+    property double lastYChange
 
     /// Cancels the current pressed state of the mouse are
     function cancelPress() {
         pressed = false;
-        holdTimer.stop();
+        root.cancelHold();
     }
 
-    touchPoints: [
-        TouchPoint { 
-            id: point
-            property double lastY
-            property double lastYChange
-
-            // Dragging implemented here rather than in higher level
-            // mouse area to avoid conflict with swipe selection
-            // of extended keys
-            onYChanged: {
-                if (point.y > root.y + root.height) {
-                    if (!swipedOut) {
-                        // We've swiped out of the key
-                        swipedOut = true;
-                        cancelPress();
-                    }
-
-                    var distance = point.y - lastY;
-                    // If changing direction wait until movement passes 1 gu
-                    // to avoid jitter
-                    if ((lastYChange * distance > 0 || Math.abs(distance) > units.gu(1)) && !held) {
-                        keyboardSurface.y += distance;
-                        lastY = point.y;
-                        lastYChange = distance;
-                    }
-                    // Hide if we get close to the bottom of the screen
-                    // This works around issues with devices with touch buttons
-                    // below the screen preventing release events when swiped
-                    // over
-                    if(point.sceneY > fullScreenItem.height - units.gu(4) && point.y > startY + units.gu(8) && !held) {
-                        maliit_input_method.hide();
-                    }
-                } else {
-                    lastY = point.y;
-                }
+    // Dragging implemented here rather than in higher level
+    // mouse area to avoid conflict with swipe selection
+    // of extended keys
+    onMouseYChanged: {
+        if (mouseY > root.height) {
+            if (!swipedOut) {
+                // We've swiped out of the key
+                swipedOut = true;
+                cancelPress();
             }
-        }
-    ]
 
-    Timer {
-        id: holdTimer
-        interval: 300
-        onTriggered: {
-            if (root.pressed) {
-                root.pressAndHold();
-                held = true;
+            var distance = mouseY - lastY;
+            // If changing direction wait until movement passes 1 gu
+            // to avoid jitter
+            if ((lastYChange * distance > 0 || Math.abs(distance) > units.gu(1)) && !held) {
+                keyboardSurface.y += distance;
+                lastY = mouseY;
+                lastYChange = distance;
             }
+            // Hide if we get close to the bottom of the screen
+            // This works around issues with devices with touch buttons
+            // below the screen preventing release events when swiped
+            // over
+            var sceneY = root.mapToItem(null, 0, mouseY).y;
+            if(sceneY > fullScreenItem.height - units.gu(4) && mouseY > startY + units.gu(8) && !held) {
+                maliit_input_method.hide();
+            }
+        } else {
+            lastY = mouseY;
         }
     }
 
-    Timer {
-        id: doubleClickTimer
-        interval: 400 // Default Qt double click interval
-    }
-
     onPressed: {
         pressed = true;
-        held = false;
         swipedOut = false;
-        startY = point.y;
-        holdTimer.restart();
-
-        // We keep a global view of whether any other keys have been
-        // pressed in between the first tap on this key and the second
-        // one, so that quickly tapping one key, then tapping another,
-        // then tapping the first again doesn't trigger a double click.
-
-        if (doubleClickTimer.running) {
-            if (panel.lastKeyPressed == root) {
-                doubleClicked();
-            }
-        } else {
-            if (acceptDoubleClick) {
-                doubleClickTimer.restart();
-            }
-            panel.lastKeyPressed = root
-        }
+        lastY = mouseY;
     }
 
     onReleased: {
         // Allow the user to swipe away the keyboard
-        if (point.y > startY + units.gu(8) && !held) {
+        if (mouseY > startY + units.gu(8) && !held) {
             maliit_input_method.hide();
         } else {
             bounceBackAnimation.from = keyboardSurface.y;
             bounceBackAnimation.start();
         }
         pressed = false;
-        held = false;
-        holdTimer.stop();
+    }
+
+    onCanceled: {
+        pressed = false;
     }
 }
@@ -31,6 +31,7 @@ ActionKey {
     switchBackFromSymbols: true
 
     overridePressArea: true
+    pressAreaEnabled: false
 
     Label {
         anchors.centerIn: parent
@@ -13,13 +13,14 @@ LIBS += libpinyin
 include(models/models.pri)
 include(logic/logic.pri)
 
-HEADERS += coreutils.h
-SOURCES += coreutils.cpp
+HEADERS += coreutils.h startuptrace.h
+SOURCES += coreutils.cpp startuptrace.cpp
 
 include(../word-prediction.pri)
 
 # for plugins
 API_HEADERS = logic/languageplugininterface.h
+API_HEADERS += logic/languageresources.h
 API_HEADERS += logic/abstractplugininterface.h
 
 api_headers.files = $$API_HEADERS
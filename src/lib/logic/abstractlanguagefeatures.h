@@ -33,22 +33,150 @@
 #define MALIIT_KEYBOARD_ABSTRACTLANGUAGEFEATURES_H
 
 #include <QObject>
+#include <QVector>
 #include <maliit/plugins/abstractinputmethod.h>
 
+#include <algorithm>
+
 class QObject;
+
+//! Character classification table of a language. Characters of the basic
+//! multilingual plane are looked up in one bitmap per class, characters
+//! from other planes in a sorted range list. A language builds its table
+//! once (typically as a function-local static) and hands it to
+//! AbstractLanguageFeatures::setCharacterClasses().
+class CharacterClasses
+{
+public:
+    enum Class {
+        NoClass = 0x0,
+        Separator = 0x1,
+        Symbol = 0x2
+    };
+
+    explicit CharacterClasses(const QString &separators,
+                              const QString &symbols = QString())
+        : m_separators(BitmapSize, 0)
+        , m_symbols(BitmapSize, 0)
+        , m_ranges()
+    {
+        add(Separator, separators);
+        add(Symbol, symbols);
+    }
+
+    int classify(QChar c) const
+    {
+        const ushort u = c.unicode();
+        int result = NoClass;
+        if (m_separators.at(u >> 5) & (1u << (u & 31))) {
+            result |= Separator;
+        }
+        if (m_symbols.at(u >> 5) & (1u << (u & 31))) {
+            result |= Symbol;
+        }
+        return result;
+    }
+
+    int classify(uint ucs4) const
+    {
+        if (ucs4 <= 0xffff) {
+            return classify(QChar(ushort(ucs4)));
+        }
+
+        QVector<Range>::const_iterator it = std::upper_bound(m_ranges.constBegin(), m_ranges.constEnd(), Range(ucs4, ucs4, NoClass));
+        if (it == m_ranges.constBegin()) {
+            return NoClass;
+        }
+        --it;
+        return (ucs4 <= it->last) ? it->classes : NoClass;
+    }
+
+    //! Classifies the last character of \a text, which may be a surrogate
+    //! pair.
+    int classifyLast(const QString &text) const
+    {
+        const int length = text.length();
+        if (length == 0) {
+            return NoClass;
+        }
+
+        const QChar last = text.at(length - 1);
+        if (last.isLowSurrogate() && length > 1 && text.at(length - 2).isHighSurrogate()) {
+            return classify(QChar::surrogateToUcs4(text.at(length - 2), last));
+        }
+        return classify(last);
+    }
+
+    //! Same as QRegExp's \w: letters, digits, marks and the underscore.
+    static bool isWordChar(QChar c)
+    {
+        return c.isLetterOrNumber() || c.isMark() || c == QLatin1Char('_');
+    }
+
+private:
+    enum { BitmapSize = 0x10000 / 32 };
+
+    struct Range
+    {
+        Range()
+            : first(0)
+            , last(0)
+            , classes(NoClass)
+        {}
+
+        Range(uint r_first, uint r_last, int r_classes)
+            : first(r_first)
+            , last(r_last)
+            , classes(r_classes)
+        {}
+
+        bool operator<(const Range &other) const { return first < other.first; }
+
+        uint first;
+        uint last;
+        int classes;
+    };
+
+    void add(Class c, const QString &chars)
+    {
+        QVector<quint32> &bitmap(c == Separator ? m_separators : m_symbols);
+        Q_FOREACH (uint ucs4, chars.toUcs4()) {
+            if (ucs4 <= 0xffff) {
+                bitmap[ucs4 >> 5] |= (1u << (ucs4 & 31));
+                continue;
+            }
+
+            QVector<Range>::iterator it = std::lower_bound(m_ranges.begin(), m_ranges.end(), Range(ucs4, ucs4, NoClass));
+            if (it != m_ranges.end() && it->first == ucs4) {
+                it->classes |= c;
+            } else {
+                m_ranges.insert(it, Range(ucs4, ucs4, c));
+            }
+        }
+    }
+
+    QVector<quint32> m_separators;
+    QVector<quint32> m_symbols;
+    QVector<Range> m_ranges;
+};
+
 class AbstractLanguageFeatures
 {
     // FIXME: Add a language/locale property (also for AbstractWordEngine)
 public:
+    AbstractLanguageFeatures()
+        : m_contentType(Maliit::FreeTextContentType)
+        , m_characterClasses(0)
+    {}
     virtual ~AbstractLanguageFeatures() {}
     
     virtual bool alwaysShowSuggestions() const = 0;
     virtual bool autoCapsAvailable() const = 0;
     virtual bool activateAutoCaps(const QString &preedit) const = 0;
     virtual QString appendixForReplacedPreedit(const QString &preedit) const = 0;
-    virtual bool isSeparator(const QString &text) const { Q_UNUSED(text); return false; }
+    virtual bool isSeparator(const QString &text) const { return classifyLast(text) & CharacterClasses::Separator; }
     virtual QString fullStopSequence() const { return QString(); }
-    virtual bool isSymbol(const QString &text) const { Q_UNUSED(text); return false; }
+    virtual bool isSymbol(const QString &text) const { return classifyLast(text) & CharacterClasses::Symbol; }
     // Typically we disable auto-correct if the predicted word isn't similar
     // to the user's input. However for input methods such as pinyin this
     // can be disabled by implementing this method to return true.
@@ -62,8 +190,18 @@ public:
     Maliit::TextContentType contentType() const { return m_contentType; }
     void setContentType(Maliit::TextContentType contentType) { m_contentType = contentType; }
 
+    // Per-character lookups for hot paths; these never allocate.
+    int classify(QChar c) const { return m_characterClasses ? m_characterClasses->classify(c) : int(CharacterClasses::NoClass); }
+    bool isSeparatorChar(QChar c) const { return classify(c) & CharacterClasses::Separator; }
+    bool isSymbolChar(QChar c) const { return classify(c) & CharacterClasses::Symbol; }
+
+protected:
+    void setCharacterClasses(const CharacterClasses *classes) { m_characterClasses = classes; }
+    int classifyLast(const QString &text) const { return m_characterClasses ? m_characterClasses->classifyLast(text) : int(CharacterClasses::NoClass); }
+
 private:
     Maliit::TextContentType m_contentType;
+    const CharacterClasses *m_characterClasses;
 };
 
 #endif // MALIIT_KEYBOARD_ABSTRACTLANGUAGEFEATURES_H
@@ -39,12 +39,29 @@ void AbstractLanguagePlugin::predict(const QString& surroundingLeft, const QStri
     Q_UNUSED(surroundingLeft)
     Q_UNUSED(preedit)
 }
- 
+
+void AbstractLanguagePlugin::fetchMoreCandidates()
+{
+}
+
 void AbstractLanguagePlugin::wordCandidateSelected(QString word)
 {
     Q_UNUSED(word)
 }
 
+void AbstractLanguagePlugin::flushLearning()
+{
+}
+
+qint64 AbstractLanguagePlugin::memoryUsage() const
+{
+    return -1;
+}
+
+void AbstractLanguagePlugin::releaseCaches()
+{
+}
+
 AbstractLanguageFeatures* AbstractLanguagePlugin::languageFeature()
 {
     return NULL;
@@ -68,3 +85,7 @@ bool AbstractLanguagePlugin::setLanguage(const QString& languageId, const QStrin
     return false;
 }
 
+void AbstractLanguagePlugin::setLanguageResources(const LanguageResources &resources)
+{
+    Q_UNUSED(resources)
+}
@@ -42,17 +42,27 @@ public:
     virtual ~AbstractLanguagePlugin();
 
     virtual void predict(const QString& surroundingLeft, const QString& preedit);
+    virtual void fetchMoreCandidates();
     virtual void wordCandidateSelected(QString word);
+    virtual void flushLearning();
+    virtual qint64 memoryUsage() const;
+    virtual void releaseCaches();
     virtual AbstractLanguageFeatures* languageFeature();
 
     //! spell checker
     virtual void spellCheckerSuggest(const QString& word, int limit);
     virtual void addToSpellCheckerUserWordList(const QString& word);
     virtual bool setLanguage(const QString& languageId, const QString& pluginPath);
+    virtual void setLanguageResources(const LanguageResources &resources);
 
 signals:
     void newSpellingSuggestions(QString word, QStringList suggestions);
     void newPredictionSuggestions(QString word, QStringList suggestions);
+    void morePredictionSuggestions(QString word, QStringList suggestions);
+    void moreCandidatesAvailable(QString word, bool available);
+    //! Reports a loading step (dictionary, model, ...) that took place in
+    //! the plugin, timed with StartupTrace::now() in microseconds.
+    void loadingPhaseFinished(QString phase, qint64 startUsecs, qint64 endUsecs);
 };
 
 #endif // ABSTRACTLANGUAGEPLUGIN_H
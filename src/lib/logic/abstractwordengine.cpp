@@ -49,6 +49,11 @@ namespace Logic {
 //! \brief Emitted when new candidates have been computed.
 //! \param candidates The list of updated candidates.
 
+//! \fn void AbstractWordEngine::moreCandidatesAvailable(bool available)
+//! \brief Emitted when it changes whether fetchMoreCandidates() can
+//! extend the current candidates.
+//! \param available Whether more candidates can be fetched.
+
 //! \fn WordCandidateList AbstractWordEngine::fetchCandidates(Model::Text *text)
 //! \brief Returns a list of candidates.
 //! \param text The text model.
@@ -149,6 +154,20 @@ void AbstractWordEngine::computeCandidates(Model::Text *text)
     fetchCandidates(text);
 }
 
+//! \brief Requests the next page of candidates for the current preedit.
+//!
+//! Can trigger emission of candidatesChanged() with the extended list.
+//! Needs to be implemented in derived classes. This does nothing.
+void AbstractWordEngine::fetchMoreCandidates()
+{}
+
+//! \brief Writes out whatever the engine learned from the user so far.
+//!
+//! Called when the keyboard is hidden, so that engines can defer their
+//! disk writes until the user isn't typing. This does nothing.
+void AbstractWordEngine::flushLearning()
+{}
+
 //! \brief Adds a word to user dictionary.
 //! \param word A word.
 //!
@@ -178,6 +197,34 @@ void AbstractWordEngine::setAutoCorrectEnabled(bool on)
     qDebug() << Q_FUNC_INFO << "should be implemented by inherited class";
 }
 
+void AbstractWordEngine::setEmojiSuggestionsEnabled(bool on)
+{
+    Q_UNUSED(on);
+    qDebug() << Q_FUNC_INFO << "should be implemented by inherited class";
+}
+
+void AbstractWordEngine::setLanguageResources(const LanguageResources &resources)
+{
+    Q_UNUSED(resources);
+    qDebug() << Q_FUNC_INFO << "should be implemented by inherited class";
+}
+
+void AbstractWordEngine::setMemoryBudget(int megabytes)
+{
+    Q_UNUSED(megabytes);
+    qDebug() << Q_FUNC_INFO << "should be implemented by inherited class";
+}
+
+void AbstractWordEngine::releaseCaches()
+{
+    qDebug() << Q_FUNC_INFO << "should be implemented by inherited class";
+}
+
+void AbstractWordEngine::releaseInactiveEngines()
+{
+    qDebug() << Q_FUNC_INFO << "should be implemented by inherited class";
+}
+
 /*
 AbstractLanguageFeature* AbstractWordEngine::languageFeature()
 {
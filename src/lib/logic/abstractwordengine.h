@@ -34,6 +34,7 @@
 
 #include "models/text.h"
 #include "models/wordcandidate.h"
+#include "logic/languageresources.h"
 #include <QtCore>
 
 class AbstractLanguageFeatures;
@@ -65,12 +66,25 @@ public:
     Q_SLOT virtual void setWordPredictionEnabled(bool on);
     Q_SLOT virtual void setSpellcheckerEnabled(bool on);
     Q_SLOT virtual void setAutoCorrectEnabled(bool on);
+    Q_SLOT virtual void setEmojiSuggestionsEnabled(bool on);
+    //! Files of the language that is loaded next.
+    virtual void setLanguageResources(const LanguageResources &resources);
+    //! Memory that the loaded language engines may take, in MiB.
+    Q_SLOT virtual void setMemoryBudget(int megabytes);
+    //! Drops what is rebuilt on the next use, e.g. while the keyboard is
+    //! hidden.
+    Q_SLOT virtual void releaseCaches();
+    //! Unloads all language engines but the active one.
+    Q_SLOT virtual void releaseInactiveEngines();
 
     virtual void clearCandidates();
     void computeCandidates(Model::Text *text);
     Q_SIGNAL void candidatesChanged(const WordCandidateList &candidates);
+    Q_SLOT virtual void fetchMoreCandidates();
+    Q_SIGNAL void moreCandidatesAvailable(bool available);
 
     virtual void addToUserDictionary(const QString &word);
+    Q_SLOT virtual void flushLearning();
 
     virtual AbstractLanguageFeatures* languageFeature() = 0;
 
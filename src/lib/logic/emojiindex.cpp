@@ -0,0 +1,245 @@
+/*
+ * Copyright (C) 2016 Canonical, Ltd.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this list
+ * of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice, this list
+ * of conditions and the following disclaimer in the documentation and/or other materials
+ * provided with the distribution.
+ * Neither the name of Nokia Corporation nor the names of its contributors may be
+ * used to endorse or promote products derived from this software without specific
+ * prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL
+ * THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#include "emojiindex.h"
+
+#include <QDebug>
+#include <QtEndian>
+
+// Has to match tools/emoji-index.py.
+#define EMOJI_INDEX_VERSION 1
+
+struct EmojiIndex::Header
+{
+    char magic[4];
+    quint32 version;
+    quint32 nodeCount;
+    quint32 edgeCount;
+    quint32 postingCount;
+    quint32 emojiCount;
+    quint32 stringsSize;
+    quint32 reserved;
+};
+
+struct EmojiIndex::Node
+{
+    quint32 firstEdge;
+    quint32 edgeCount;
+    quint32 firstPosting;
+    quint16 postingCount;
+    quint16 exactCount;
+};
+
+struct EmojiIndex::Edge
+{
+    quint32 byte;
+    quint32 node;
+};
+
+namespace {
+
+template <typename T>
+T le(T value)
+{
+    return qFromLittleEndian(value);
+}
+
+} // unnamed namespace
+
+EmojiIndex::EmojiIndex(const QString &fileName)
+    : m_file(fileName)
+    , m_mapped(false)
+    , m_data(0)
+    , m_header(0)
+{}
+
+EmojiIndex::~EmojiIndex()
+{}
+
+QString EmojiIndex::fileName() const
+{
+    return m_file.fileName();
+}
+
+//! \brief Whether the file could be mapped and looks like an index. Maps
+//! the file if that didn't happen yet.
+bool EmojiIndex::isValid() const
+{
+    return map();
+}
+
+//! \brief Emoji for word, best first.
+//! \param word Word as typed, looked up in lower case.
+//! \param limit Largest number of emoji returned.
+//! \param mode Whether keywords have to match word completely.
+QStringList EmojiIndex::lookup(const QString &word, int limit, MatchMode mode) const
+{
+    QStringList result;
+
+    if (word.isEmpty() || limit <= 0 || !map()) {
+        return result;
+    }
+
+    const QByteArray key(word.toLower().toUtf8());
+    const Node *current = node(0);
+
+    for (int i = 0; current && i < key.size(); ++i) {
+        current = child(current, uchar(key.at(i)));
+    }
+
+    if (!current) {
+        return result;
+    }
+
+    const quint32 first = le(current->firstPosting);
+    const quint32 count = qMin<quint32>(mode == ExactMatch ? le(current->exactCount) : le(current->postingCount),
+                                        limit);
+    if (first + count > le(m_header->postingCount)) {
+        return result;
+    }
+
+    const quint32 *postings = reinterpret_cast<const quint32 *>(
+                m_data + sizeof(Header)
+                + le(m_header->nodeCount) * sizeof(Node)
+                + le(m_header->edgeCount) * sizeof(Edge));
+
+    for (quint32 i = first; i < first + count; ++i) {
+        const QString found(emoji(le(postings[i])));
+        if (!found.isEmpty()) {
+            result.append(found);
+        }
+    }
+
+    return result;
+}
+
+bool EmojiIndex::map() const
+{
+    if (m_mapped) {
+        return m_header != 0;
+    }
+
+    m_mapped = true;
+
+    if (!m_file.open(QIODevice::ReadOnly)) {
+        qWarning() << "EmojiIndex: cannot open" << m_file.fileName() << m_file.errorString();
+        return false;
+    }
+
+    const qint64 size = m_file.size();
+    // The file stays open for as long as it is mapped.
+    const uchar *data = m_file.map(0, size);
+
+    if (!data || size < qint64(sizeof(Header))) {
+        qWarning() << "EmojiIndex: cannot map" << m_file.fileName();
+        return false;
+    }
+
+    const Header *header = reinterpret_cast<const Header *>(data);
+    const quint64 expected = sizeof(Header)
+            + quint64(le(header->nodeCount)) * sizeof(Node)
+            + quint64(le(header->edgeCount)) * sizeof(Edge)
+            + quint64(le(header->postingCount)) * sizeof(quint32)
+            + quint64(le(header->emojiCount)) * sizeof(quint32)
+            + le(header->stringsSize);
+
+    if (qstrncmp(header->magic, "UKEI", 4) != 0
+            || le(header->version) != EMOJI_INDEX_VERSION
+            || le(header->nodeCount) == 0
+            || expected != quint64(size)
+            || (le(header->stringsSize) > 0 && data[size - 1] != '\0')) {
+        qWarning() << "EmojiIndex:" << m_file.fileName() << "is not a valid index";
+        m_file.unmap(const_cast<uchar *>(data));
+        return false;
+    }
+
+    m_data = data;
+    m_header = header;
+
+    return true;
+}
+
+const EmojiIndex::Node *EmojiIndex::node(quint32 number) const
+{
+    if (number >= le(m_header->nodeCount)) {
+        return 0;
+    }
+
+    return reinterpret_cast<const Node *>(m_data + sizeof(Header)) + number;
+}
+
+//! Edges of a node are sorted by byte, so they can be bisected.
+const EmojiIndex::Node *EmojiIndex::child(const Node *parent, uchar byte) const
+{
+    const quint32 first = le(parent->firstEdge);
+    const quint32 count = le(parent->edgeCount);
+
+    if (quint64(first) + count > le(m_header->edgeCount)) {
+        return 0;
+    }
+
+    const Edge *edges = reinterpret_cast<const Edge *>(
+                m_data + sizeof(Header) + le(m_header->nodeCount) * sizeof(Node)) + first;
+
+    quint32 low = 0;
+    quint32 high = count;
+    while (low < high) {
+        const quint32 middle = (low + high) / 2;
+        const quint32 value = le(edges[middle].byte);
+
+        if (value == byte) {
+            return node(le(edges[middle].node));
+        } else if (value < byte) {
+            low = middle + 1;
+        } else {
+            high = middle;
+        }
+    }
+
+    return 0;
+}
+
+QString EmojiIndex::emoji(quint32 number) const
+{
+    if (number >= le(m_header->emojiCount)) {
+        return QString();
+    }
+
+    const uchar *table = m_data + sizeof(Header)
+            + le(m_header->nodeCount) * sizeof(Node)
+            + le(m_header->edgeCount) * sizeof(Edge)
+            + le(m_header->postingCount) * sizeof(quint32);
+    const quint32 offset = le(reinterpret_cast<const quint32 *>(table)[number]);
+
+    if (offset >= le(m_header->stringsSize)) {
+        return QString();
+    }
+
+    const char *strings = reinterpret_cast<const char *>(table + le(m_header->emojiCount) * sizeof(quint32));
+    // The strings end with a NUL, checked in map().
+    return QString::fromUtf8(strings + offset);
+}
@@ -0,0 +1,77 @@
+/*
+ * Copyright (C) 2016 Canonical, Ltd.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this list
+ * of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice, this list
+ * of conditions and the following disclaimer in the documentation and/or other materials
+ * provided with the distribution.
+ * Neither the name of Nokia Corporation nor the names of its contributors may be
+ * used to endorse or promote products derived from this software without specific
+ * prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL
+ * THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#ifndef EMOJIINDEX_H
+#define EMOJIINDEX_H
+
+#include <QFile>
+#include <QString>
+#include <QStringList>
+
+//! Looks up emoji by keyword in an index compiled from CLDR style
+//! annotations by tools/emoji-index.py. The file is only mapped into
+//! memory on the first lookup, and a lookup just walks the bytes of the
+//! word through a trie, so the index neither costs anything until it is
+//! used nor has to be parsed.
+class EmojiIndex
+{
+public:
+    enum MatchMode {
+        //! Only emoji that have word as keyword.
+        ExactMatch,
+        //! Also emoji with keywords that start with word, ranked after
+        //! the exact ones.
+        PrefixMatch
+    };
+
+    explicit EmojiIndex(const QString &fileName);
+    ~EmojiIndex();
+
+    QString fileName() const;
+    bool isValid() const;
+
+    QStringList lookup(const QString &word, int limit, MatchMode mode = PrefixMatch) const;
+
+private:
+    Q_DISABLE_COPY(EmojiIndex)
+
+    struct Header;
+    struct Node;
+    struct Edge;
+
+    bool map() const;
+    const Node *node(quint32 number) const;
+    const Node *child(const Node *parent, uchar byte) const;
+    QString emoji(quint32 number) const;
+
+    mutable QFile m_file;
+    mutable bool m_mapped;
+    mutable const uchar *m_data;
+    mutable const Header *m_header;
+};
+
+#endif // EMOJIINDEX_H
@@ -0,0 +1,434 @@
+/*
+ * Copyright (C) 2016 Canonical, Ltd.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this list
+ * of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice, this list
+ * of conditions and the following disclaimer in the documentation and/or other materials
+ * provided with the distribution.
+ * Neither the name of Nokia Corporation nor the names of its contributors may be
+ * used to endorse or promote products derived from this software without specific
+ * prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL
+ * THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#include "emojimodel.h"
+#include "emojitable.h"
+
+#include <QAtomicInt>
+#include <QDebug>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QRunnable>
+#include <QSaveFile>
+#include <QStandardPaths>
+#include <QTextStream>
+#include <QThreadPool>
+#include <QTimer>
+
+// Time the recent emoji are left alone before being written, so that
+// typing several emoji in a row only writes once.
+#define SAVE_DELAY 1000
+
+namespace {
+
+QAtomicInt nextGeneration(1);
+QMutex writeMutex;
+int writtenGeneration = 0;
+
+int paddedCount(int size, int rowsPerColumn)
+{
+    return ((size + rowsPerColumn - 1) / rowsPerColumn) * rowsPerColumn;
+}
+
+//! Writes a snapshot of the model. Snapshots can end up running out of
+//! order in the thread pool, so older ones are dropped.
+class RecentWriter : public QRunnable
+{
+public:
+    RecentWriter(const QString &path, int position, const QStringList &recent)
+        : m_path(path)
+        , m_generation(nextGeneration.fetchAndAddOrdered(1))
+        , m_position(position)
+        , m_recent(recent)
+    {}
+
+    virtual void run()
+    {
+        QMutexLocker locker(&writeMutex);
+
+        if (m_generation < writtenGeneration) {
+            return;
+        }
+        writtenGeneration = m_generation;
+
+        QDir::home().mkpath(QFileInfo(m_path).absolutePath());
+
+        QSaveFile file(m_path);
+        if (!file.open(QIODevice::WriteOnly | QIODevice::Text)) {
+            qWarning() << "EmojiModel: cannot write" << m_path << file.errorString();
+            return;
+        }
+
+        QTextStream out(&file);
+        out.setCodec("UTF-8");
+        out << m_position << '\n';
+        Q_FOREACH(const QString &emoji, m_recent) {
+            out << emoji << '\n';
+        }
+        out.flush();
+
+        if (!file.commit()) {
+            qWarning() << "EmojiModel: cannot write" << m_path << file.errorString();
+        }
+    }
+
+private:
+    QString m_path;
+    int m_generation;
+    int m_position;
+    QStringList m_recent;
+};
+
+} // unnamed namespace
+
+EmojiModel::EmojiModel(QObject *parent)
+    : QAbstractListModel(parent)
+    , m_recent()
+    , m_rowsPerColumn(1)
+    , m_maxRecent(40)
+    , m_position(0)
+    , m_stored(false)
+    , m_saveTimer(new QTimer(this))
+    , m_categories(EmojiTable::categoryCount)
+{
+    m_saveTimer->setSingleShot(true);
+    m_saveTimer->setInterval(SAVE_DELAY);
+    connect(m_saveTimer, SIGNAL(timeout()), this, SLOT(save()));
+
+    load();
+}
+
+//! Pending changes are written right away, the model can be gone by the
+//! time the thread pool would get to them.
+EmojiModel::~EmojiModel()
+{
+    if (m_saveTimer->isActive()) {
+        m_saveTimer->stop();
+        RecentWriter(storagePath(), m_position, m_recent).run();
+    }
+}
+
+int EmojiModel::rowCount(const QModelIndex &parent) const
+{
+    if (parent.isValid()) {
+        return 0;
+    }
+
+    int count = recentCount();
+    for (int table = 0; table < EmojiTable::categoryCount; ++table) {
+        count += EmojiTable::categories[table].count;
+    }
+
+    return count;
+}
+
+QVariant EmojiModel::data(const QModelIndex &index, int role) const
+{
+    if (!index.isValid() || index.row() >= rowCount()) {
+        return QVariant();
+    }
+
+    const int categoryIndex = categoryAt(index.row());
+
+    switch (role) {
+    case Qt::DisplayRole:
+    case CharRole: {
+        if (categoryIndex == Recent) {
+            // Padding up to a full column is left empty.
+            return index.row() < m_recent.size() ? m_recent.at(index.row()) : QString();
+        }
+
+        const int table = categoryIndex - People;
+        return category(table).value(index.row() - categoryStart(categoryIndex));
+    }
+    case CategoryRole:
+        return categoryIndex;
+    }
+
+    return QVariant();
+}
+
+QHash<int, QByteArray> EmojiModel::roleNames() const
+{
+    QHash<int, QByteArray> roles;
+    roles[CharRole] = "char";
+    roles[CategoryRole] = "category";
+
+    return roles;
+}
+
+//! \brief Number of rows a column of the view has. The recent emoji are
+//! padded to full columns, so that the other categories always start a
+//! new one.
+int EmojiModel::rowsPerColumn() const
+{
+    return m_rowsPerColumn;
+}
+
+void EmojiModel::setRowsPerColumn(int rows)
+{
+    rows = qMax(1, rows);
+
+    if (m_rowsPerColumn == rows) {
+        return;
+    }
+
+    beginResetModel();
+    const int oldCount = recentCount();
+    m_rowsPerColumn = rows;
+    endResetModel();
+
+    Q_EMIT rowsPerColumnChanged(m_rowsPerColumn);
+    if (recentCount() != oldCount) {
+        Q_EMIT recentCountChanged(recentCount());
+    }
+}
+
+//! \brief Number of recent emoji kept; the oldest ones are dropped.
+int EmojiModel::maxRecent() const
+{
+    return m_maxRecent;
+}
+
+void EmojiModel::setMaxRecent(int max)
+{
+    max = qMax(0, max);
+
+    if (m_maxRecent == max) {
+        return;
+    }
+
+    m_maxRecent = max;
+    Q_EMIT maxRecentChanged(m_maxRecent);
+
+    if (m_recent.size() > m_maxRecent) {
+        updateRecent(m_recent.mid(0, m_maxRecent));
+    }
+}
+
+//! \brief Number of rows taken by the recent emoji, padding included.
+int EmojiModel::recentCount() const
+{
+    return paddedCount(m_recent.size(), m_rowsPerColumn);
+}
+
+//! \brief Row the view was last left at, restored when the layout is
+//! loaded again.
+int EmojiModel::position() const
+{
+    return m_position;
+}
+
+void EmojiModel::setPosition(int position)
+{
+    if (m_position == position) {
+        return;
+    }
+
+    m_position = position;
+    Q_EMIT positionChanged(m_position);
+    scheduleSave();
+}
+
+//! \brief Whether recent emoji and position were read from storagePath().
+bool EmojiModel::isStored() const
+{
+    return m_stored;
+}
+
+//! \brief Whether the emoji of category have been decoded already.
+bool EmojiModel::isLoaded(Category category) const
+{
+    if (category == Recent) {
+        return true;
+    }
+
+    return !m_categories.at(category - People).isEmpty();
+}
+
+//! \brief Recently used emoji, most recent first, without padding.
+QStringList EmojiModel::recent() const
+{
+    return m_recent;
+}
+
+//! \brief First row of category, -1 for unknown categories.
+int EmojiModel::categoryStart(int category) const
+{
+    if (category < Recent || category > People + EmojiTable::categoryCount - 1) {
+        return -1;
+    }
+
+    int start = recentCount();
+    for (int table = 0; table < category - People; ++table) {
+        start += EmojiTable::categories[table].count;
+    }
+
+    return start;
+}
+
+//! \brief Category row belongs to, -1 if it is out of range.
+int EmojiModel::categoryAt(int row) const
+{
+    if (row < 0) {
+        return -1;
+    }
+
+    int end = recentCount();
+    if (row < end) {
+        return Recent;
+    }
+
+    for (int table = 0; table < EmojiTable::categoryCount; ++table) {
+        end += EmojiTable::categories[table].count;
+        if (row < end) {
+            return People + table;
+        }
+    }
+
+    return -1;
+}
+
+//! \brief Puts emoji in front of the recent ones, unless it already is
+//! one of them.
+void EmojiModel::addRecent(const QString &emoji)
+{
+    if (emoji.isEmpty() || m_recent.contains(emoji)) {
+        return;
+    }
+
+    QStringList recent(m_recent);
+    recent.prepend(emoji);
+    updateRecent(recent.mid(0, m_maxRecent));
+}
+
+//! \brief Replaces the recent emoji, most recent first.
+void EmojiModel::setRecent(const QStringList &recent)
+{
+    QStringList filtered;
+    Q_FOREACH(const QString &emoji, recent) {
+        if (!emoji.isEmpty() && !filtered.contains(emoji)) {
+            filtered.append(emoji);
+        }
+    }
+
+    updateRecent(filtered.mid(0, m_maxRecent));
+    // Write even if nothing changed, so that isStored() holds next time.
+    scheduleSave();
+}
+
+//! \brief File the recent emoji and position are kept in.
+QString EmojiModel::storagePath()
+{
+    return QStandardPaths::writableLocation(QStandardPaths::DataLocation)
+            + QDir::separator() + "emoji" + QDir::separator() + "recent";
+}
+
+//! \brief Hands the current state to the thread pool for writing.
+void EmojiModel::save()
+{
+    m_saveTimer->stop();
+    QThreadPool::globalInstance()->start(new RecentWriter(storagePath(), m_position, m_recent));
+}
+
+void EmojiModel::load()
+{
+    QFile file(storagePath());
+    if (!file.open(QIODevice::ReadOnly | QIODevice::Text)) {
+        return;
+    }
+
+    QTextStream in(&file);
+    in.setCodec("UTF-8");
+
+    m_stored = true;
+    m_position = in.readLine().toInt();
+
+    while (!in.atEnd() && m_recent.size() < m_maxRecent) {
+        const QString emoji(in.readLine().trimmed());
+        if (!emoji.isEmpty() && !m_recent.contains(emoji)) {
+            m_recent.append(emoji);
+        }
+    }
+}
+
+void EmojiModel::scheduleSave()
+{
+    m_saveTimer->start();
+}
+
+void EmojiModel::updateRecent(const QStringList &recent)
+{
+    if (recent == m_recent) {
+        return;
+    }
+
+    // Rows that come and go are the padded tail of the recent emoji,
+    // everything in front of it just changes its content.
+    const int oldCount = recentCount();
+    const int newCount = paddedCount(recent.size(), m_rowsPerColumn);
+
+    if (newCount > oldCount) {
+        beginInsertRows(QModelIndex(), oldCount, newCount - 1);
+        m_recent = recent;
+        endInsertRows();
+    } else if (newCount < oldCount) {
+        beginRemoveRows(QModelIndex(), newCount, oldCount - 1);
+        m_recent = recent;
+        endRemoveRows();
+    } else {
+        m_recent = recent;
+    }
+
+    const int changed = qMin(oldCount, newCount);
+    if (changed > 0) {
+        Q_EMIT dataChanged(index(0), index(changed - 1));
+    }
+
+    Q_EMIT recentChanged();
+    if (newCount != oldCount) {
+        Q_EMIT recentCountChanged(newCount);
+    }
+
+    scheduleSave();
+}
+
+//! Decodes the emoji of a category of EmojiTable on first use.
+const QStringList &EmojiModel::category(int table) const
+{
+    QStringList &emoji = m_categories[table];
+
+    if (emoji.isEmpty()) {
+        emoji = QString::fromUtf8(EmojiTable::categories[table].data).split(QLatin1Char(' '));
+        Q_ASSERT(emoji.size() == EmojiTable::categories[table].count);
+    }
+
+    return emoji;
+}
@@ -0,0 +1,122 @@
+/*
+ * Copyright (C) 2016 Canonical, Ltd.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this list
+ * of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice, this list
+ * of conditions and the following disclaimer in the documentation and/or other materials
+ * provided with the distribution.
+ * Neither the name of Nokia Corporation nor the names of its contributors may be
+ * used to endorse or promote products derived from this software without specific
+ * prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL
+ * THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#ifndef EMOJIMODEL_H
+#define EMOJIMODEL_H
+
+#include <QAbstractListModel>
+#include <QStringList>
+#include <QVector>
+
+class QTimer;
+
+//! Lists all emoji of the emoji layout, preceded by the recently used
+//! ones. Categories are decoded from the compiled EmojiTable the first
+//! time one of their rows is asked for. The recent emoji and the last
+//! viewed position are kept below the user data location and written
+//! from the thread pool.
+class EmojiModel : public QAbstractListModel
+{
+    Q_OBJECT
+    Q_ENUMS(Category)
+    Q_PROPERTY(int rowsPerColumn READ rowsPerColumn WRITE setRowsPerColumn NOTIFY rowsPerColumnChanged)
+    Q_PROPERTY(int maxRecent READ maxRecent WRITE setMaxRecent NOTIFY maxRecentChanged)
+    Q_PROPERTY(QStringList recent READ recent NOTIFY recentChanged)
+    Q_PROPERTY(int recentCount READ recentCount NOTIFY recentCountChanged)
+    Q_PROPERTY(int position READ position WRITE setPosition NOTIFY positionChanged)
+    Q_PROPERTY(bool stored READ isStored CONSTANT)
+
+public:
+    enum Category {
+        Recent,
+        People,
+        Nature,
+        Food,
+        Activity,
+        Travel,
+        Objects,
+        Symbols,
+        Flags
+    };
+
+    enum Roles {
+        CharRole = Qt::UserRole + 1,
+        CategoryRole
+    };
+
+    explicit EmojiModel(QObject *parent = 0);
+    virtual ~EmojiModel();
+
+    virtual int rowCount(const QModelIndex &parent = QModelIndex()) const;
+    virtual QVariant data(const QModelIndex &index, int role) const;
+    virtual QHash<int, QByteArray> roleNames() const;
+
+    int rowsPerColumn() const;
+    void setRowsPerColumn(int rows);
+    int maxRecent() const;
+    void setMaxRecent(int max);
+    int recentCount() const;
+    int position() const;
+    void setPosition(int position);
+    bool isStored() const;
+
+    bool isLoaded(Category category) const;
+    QStringList recent() const;
+
+    Q_INVOKABLE int categoryStart(int category) const;
+    Q_INVOKABLE int categoryAt(int row) const;
+    Q_INVOKABLE void addRecent(const QString &emoji);
+    Q_INVOKABLE void setRecent(const QStringList &recent);
+
+    static QString storagePath();
+
+public Q_SLOTS:
+    void save();
+
+Q_SIGNALS:
+    void rowsPerColumnChanged(int rows);
+    void maxRecentChanged(int max);
+    void recentChanged();
+    void recentCountChanged(int count);
+    void positionChanged(int position);
+
+private:
+    void load();
+    void scheduleSave();
+    void updateRecent(const QStringList &recent);
+    const QStringList &category(int table) const;
+
+    QStringList m_recent;
+    int m_rowsPerColumn;
+    int m_maxRecent;
+    int m_position;
+    bool m_stored;
+    QTimer *m_saveTimer;
+    mutable QVector<QStringList> m_categories;
+};
+
+#endif // EMOJIMODEL_H
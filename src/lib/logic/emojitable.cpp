@@ -0,0 +1,180 @@
+/*
+ * Copyright (C) 2016 Canonical, Ltd.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this list
+ * of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice, this list
+ * of conditions and the following disclaimer in the documentation and/or other materials
+ * provided with the distribution.
+ * Neither the name of Nokia Corporation nor the names of its contributors may be
+ * used to endorse or promote products derived from this software without specific
+ * prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL
+ * THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#include "emojitable.h"
+
+// Emoji of each category, separated by a single space. The order is the one
+// shown on the emoji layout.
+
+namespace EmojiTable {
+
+static const char people[] =
+    "😀 😬 😁 😂 😃 😄 😅 😆 😇 😉 😊 🙂 🙃 ☺ 😋 😌 "
+    "😍 😘 😗 😙 😚 😜 😝 😛 🤑 🤓 😎 🤗 😏 😶 😐 😑 "
+    "😒 🙄 🤔 😳 😞 😟 😠 😡 😔 😕 🙁 ☹ 😣 😖 😫 😩 "
+    "😤 😮 😱 😨 😰 😯 😦 😧 😢 😥 😪 😓 😭 😵 😲 🤐 "
+    "😷 🤒 🤕 😴 💤 💩 😈 👿 👹 👺 💀 👻 👽 🤖 😺 😸 "
+    "😹 😻 😼 😽 🙀 😿 😾 🙌 👏 👋 👍 👎 👊 ✊ ✌ 👌 "
+    "✋ 👐 💪 🙏 ☝ 👆 👇 👈 👉 🖕 🖐 🤘 🖖 ✍ 💅 👄 "
+    "👅 👂 👃 👁 👀 👤 👥 🗣 👶 👦 👧 👱 👴 👵 👲 👳 "
+    "👮 👷 💂 🕵 🎅 👼 👸 👰 🚶 🏃 💃 👯 👫 👬 👭 🙇 "
+    "💁 🙅 🙆 🙋 🙎 🙍 💇 💆 💑 💏 👪 👚 👕 👖 👔 👗 "
+    "👙 👘 💄 💋 👣 👠 👡 👢 👞 👟 👒 🎩 ⛑ 🎓 👑 🎒 "
+    "👝 👛 👜 💼 👓 🕶 💍 🌂 🙌🏻 🙌🏼 🙌🏽 🙌🏾 🙌🏿 👏🏻 👏🏼 👏🏽 "
+    "👏🏾 👏🏿 👋🏻 👋🏼 👋🏽 👋🏾 👋🏿 👍🏻 👍🏼 👍🏽 👍🏾 👍🏿 👎🏻 👎🏼 👎🏽 👎🏾 "
+    "👎🏿 👊🏻 👊🏼 👊🏽 👊🏾 👊🏿 ✊🏻 ✊🏼 ✊🏽 ✊🏾 ✊🏿 ✌🏻 ✌🏼 ✌🏽 ✌🏾 ✌🏿 "
+    "👌🏻 👌🏼 👌🏽 👌🏾 👌🏿 ✋🏻 ✋🏼 ✋🏽 ✋🏾 ✋🏿 👐🏻 👐🏼 👐🏽 👐🏾 👐🏿 💪🏻 "
+    "💪🏼 💪🏽 💪🏾 💪🏿 🙏🏻 🙏🏼 🙏🏽 🙏🏾 🙏🏿 ☝🏻 ☝🏼 ☝🏽 ☝🏾 ☝🏿 👆🏻 👆🏼 "
+    "👆🏽 👆🏾 👆🏿 👇🏻 👇🏼 👇🏽 👇🏾 👇🏿 👈🏻 👈🏼 👈🏽 👈🏾 👈🏿 👉🏻 👉🏼 👉🏽 "
+    "👉🏾 👉🏿 🖕🏻 🖕🏼 🖕🏽 🖕🏾 🖕🏿 🖐🏻 🖐🏼 🖐🏽 🖐🏾 🖐🏿 🤘🏻 🤘🏼 🤘🏽 🤘🏾 "
+    "🤘🏿 🖖🏻 🖖🏼 🖖🏽 🖖🏾 🖖🏿 ✍🏻 ✍🏼 ✍🏽 ✍🏾 ✍🏿 💅🏻 💅🏼 💅🏽 💅🏾 💅🏿 "
+    "👂🏻 👂🏼 👂🏽 👂🏾 👂🏿 👃🏻 👃🏼 👃🏽 👃🏾 👃🏿 👶🏻 👶🏼 👶🏽 👶🏾 👶🏿 👦🏻 "
+    "👦🏼 👦🏽 👦🏾 👦🏿 👧🏻 👧🏼 👧🏽 👧🏾 👧🏿 👱🏻 👱🏼 👱🏽 👱🏾 👱🏿 👴🏻 👴🏼 "
+    "👴🏽 👴🏾 👴🏿 👵🏻 👵🏼 👵🏽 👵🏾 👵🏿 👲🏻 👲🏼 👲🏽 👲🏾 👲🏿 👳🏻 👳🏼 👳🏽 "
+    "👳🏾 👳🏿 👮🏻 👮🏼 👮🏽 👮🏾 👮🏿 👷🏻 👷🏼 👷🏽 👷🏾 👷🏿 💂🏻 💂🏼 💂🏽 💂🏾 "
+    "💂🏿 🎅🏻 🎅🏼 🎅🏽 🎅🏾 🎅🏿 👼🏻 👼🏼 👼🏽 👼🏾 👼🏿 👸🏻 👸🏼 👸🏽 👸🏾 👸🏿 "
+    "👰🏻 👰🏼 👰🏽 👰🏾 👰🏿 🚶🏻 🚶🏼 🚶🏽 🚶🏾 🚶🏿 🏃🏻 🏃🏼 🏃🏽 🏃🏾 🏃🏿 💃🏻 "
+    "💃🏼 💃🏽 💃🏾 💃🏿 🙇🏻 🙇🏼 🙇🏽 🙇🏾 🙇🏿 💁🏻 💁🏼 💁🏽 💁🏾 💁🏿 🙅🏻 🙅🏼 "
+    "🙅🏽 🙅🏾 🙅🏿 🙆🏻 🙆🏼 🙆🏽 🙆🏾 🙆🏿 🙋🏻 🙋🏼 🙋🏽 🙋🏾 🙋🏿 🙎🏻 🙎🏼 🙎🏽 "
+    "🙎🏾 🙎🏿 🙍🏻 🙍🏼 🙍🏽 🙍🏾 🙍🏿 💇🏻 💇🏼 💇🏽 💇🏾 💇🏿 💆🏻 💆🏼 💆🏽 💆🏾 "
+    "💆🏿 🕵🏻 🕵🏼 🕵🏽 🕵🏾 🕵🏿 🤴🏻 🤴🏼 🤴🏽 🤴🏾 🤴🏿 🤶🏻 🤶🏼 🤶🏽 🤶🏾 🤶🏿 "
+    "🤵🏻 🤵🏼 🤵🏽 🤵🏾 🤵🏿 🤷🏻 🤷🏼 🤷🏽 🤷🏾 🤷🏿 🤦🏻 🤦🏼 🤦🏽 🤦🏾 🤦🏿 🤰🏻 "
+    "🤰🏼 🤰🏽 🤰🏾 🤰🏿 🤳🏻 🤳🏼 🤳🏽 🤳🏾 🤳🏿 🤞🏻 🤞🏼 🤞🏽 🤞🏾 🤞🏿 🤙🏻 🤙🏼 "
+    "🤙🏽 🤙🏾 🤙🏿 🤛🏻 🤛🏼 🤛🏽 🤛🏾 🤛🏿 🤜🏻 🤜🏼 🤜🏽 🤜🏾 🤜🏿 🤚🏻 🤚🏼 🤚🏽 "
+    "🤚🏾 🤚🏿 🤝🏻 🤝🏼 🤝🏽 🤝🏾 🤝🏿 🤠 🤡 🤢 🤣 🤤 🤥 🤧 🤴 🤵 "
+    "🤶 🤦 🤷 🤰 🤳 🕺 🤙 🤚 🤛 🤜 🤝 🤞";
+
+static const char nature[] =
+    "🐶 🐱 🐭 🐹 🐰 🐻 🐼 🐨 🐯 🦁 🐮 🐷 🐽 🐸 🐙 🐵 "
+    "🙈 🙉 🙊 🐒 🐔 🐧 🐦 🐤 🐣 🐥 🐺 🐗 🐴 🦄 🐝 🐛 "
+    "🐌 🐞 🐜 🕷 🦂 🦀 🐍 🐢 🐠 🐟 🐡 🐬 🐳 🐋 🐊 🐆 "
+    "🐅 🐃 🐂 🐄 🐪 🐫 🐘 🐐 🐏 🐑 🐎 🐖 🐀 🐁 🐓 🦃 "
+    "🕊 🐕 🐩 🐈 🐇 🐿 🐾 🐉 🐲 🌵 🎄 🌲 🌳 🌴 🌱 🌿 "
+    "☘ 🍀 🎍 🎋 🍃 🍂 🍁 🌾 🌺 🌻 🌹 🌷 🌼 🌸 💐 🍄 "
+    "🌰 🎃 🐚 🕸 🌎 🌍 🌏 🌕 🌖 🌗 🌘 🌑 🌒 🌓 🌔 🌚 "
+    "🌝 🌛 🌜 🌞 🌙 ⭐ 🌟 💫 ✨ ☄ ☀ 🌤 ⛅ 🌥 🌦 ☁ "
+    "🌧 ⛈ 🌩 ⚡ 🔥 💥 ❄ 🌨 ☃ ⛄ 🌬 💨 🌪 🌫 ☂ ☔ "
+    "💧 💦 🌊 🦅 🦆 🦇 🦈 🦉 🦊 🦋 🦌 🦍 🦎 🦏 🥀 🦐 "
+    "🦑";
+
+static const char food[] =
+    "🍏 🍎 🍐 🍊 🍋 🍌 🍉 🍇 🍓 🍈 🍒 🍑 🍍 🍅 🍆 🌶 "
+    "🌽 🍠 🍯 🍞 🧀 🍗 🍖 🍤 🍳 🍔 🍟 🌭 🍕 🍝 🌮 🌯 "
+    "🍜 🍲 🍥 🍣 🍱 🍛 🍙 🍚 🍘 🍢 🍡 🍧 🍨 🍦 🍰 🎂 "
+    "🍮 🍬 🍭 🍫 🍿 🍩 🍪 🍺 🍻 🍷 🍸 🍹 🍾 🍶 🍵 ☕ "
+    "🍼 🍴 🍽 🥐 🥑 🥒 🥓 🥔 🥕 🥖 🥗 🥘 🥙 🥂 🥃 🥄 "
+    "🥚 🥛 🥜 🥝 🥞";
+
+static const char activity[] =
+    "⚽ 🏀 🏈 ⚾ 🎾 🏐 🏉 🎱 ⛳ 🏌 🏓 🏸 🏒 🏑 🏏 🎿 "
+    "⛷ 🏂 ⛸ 🏹 🎣 🚣 🏊 🏄 🛀 ⛹ 🏋 🚴 🚵 🏇 🕴 🏆 "
+    "🎽 🏅 🎖 🎗 🏵 🎫 🎟 🎭 🎨 🎪 🎤 🎧 🎼 🎹 🎷 🎺 "
+    "🎸 🎻 🎬 🎮 👾 🎯 🎲 🎰 🎳 🚣🏻 🚣🏼 🚣🏽 🚣🏾 🚣🏿 🏊🏻 🏊🏼 "
+    "🏊🏽 🏊🏾 🏊🏿 🏄🏻 🏄🏼 🏄🏽 🏄🏾 🏄🏿 🛀🏻 🛀🏼 🛀🏽 🛀🏾 🛀🏿 ⛹🏻 ⛹🏼 ⛹🏽 "
+    "⛹🏾 ⛹🏿 🏋🏻 🏋🏼 🏋🏽 🏋🏾 🏋🏿 🚴🏻 🚴🏼 🚴🏽 🚴🏾 🚴🏿 🚵🏻 🚵🏼 🚵🏽 🚵🏾 "
+    "🚵🏿 🏇🏻 🏇🏼 🏇🏽 🏇🏾 🏇🏿 🕺🏻 🕺🏼 🕺🏽 🕺🏾 🕺🏿 🤸🏻 🤸🏼 🤸🏽 🤸🏾 🤸🏿 "
+    "🤼🏻 🤼🏼 🤼🏽 🤼🏾 🤼🏿 🤽🏻 🤽🏼 🤽🏽 🤽🏾 🤽🏿 🤾🏻 🤾🏼 🤾🏽 🤾🏾 🤾🏿 🤹🏻 "
+    "🤹🏼 🤹🏽 🤹🏾 🤹🏿 🤸 🤹 🤼 🥊 🥋 🤽 🤾 🥅 🤺 🥇 🥈 🥉 "
+    "🥁";
+
+static const char travel[] =
+    "🚗 🚕 🚙 🚌 🚎 🏎 🚓 🚑 🚒 🚐 🚚 🚛 🚜 🏍 🚲 🚨 "
+    "🚔 🚍 🚘 🚖 🚡 🚠 🚟 🚃 🚋 🚝 🚄 🚅 🚈 🚞 🚂 🚆 "
+    "🚇 🚊 🚉 🚁 🛩 ✈ 🛫 🛬 ⛵ 🛥 🚤 ⛴ 🛳 🚀 🛰 💺 "
+    "⚓ 🚧 ⛽ 🚏 🚦 🚥 🏁 🚢 🎡 🎢 🎠 🏗 🌁 🗼 🏭 ⛲ "
+    "🎑 ⛰ 🏔 🗻 🌋 🗾 🏕 ⛺ 🏞 🛣 🛤 🌅 🌄 🏜 🏖 🏝 "
+    "🌇 🌆 🏙 🌃 🌉 🌌 🌠 🎇 🎆 🌈 🏘 🏰 🏯 🏟 🗽 🏠 "
+    "🏡 🏚 🏢 🏬 🏣 🏤 🏥 🏦 🏨 🏪 🏫 🏩 💒 🏛 ⛪ 🕌 "
+    "🕍 🕋 ⛩ 🛒 🛴 🛵 🛶";
+
+static const char objects[] =
+    "⌚ 📱 📲 💻 ⌨ 🖥 🖨 🖱 🖲 🕹 🗜 💽 💾 💿 📀 📼 "
+    "📷 📸 📹 🎥 📽 🎞 📞 ☎ 📟 📠 📺 📻 🎙 🎚 🎛 ⏱ "
+    "⏲ ⏰ 🕰 ⏳ ⌛ 📡 🔋 🔌 💡 🔦 🕯 🗑 🛢 💸 💵 💴 "
+    "💶 💷 💰 💳 💎 ⚖ 🔧 🔨 ⚒ 🛠 ⛏ 🔩 ⚙ ⛓ 🔫 💣 "
+    "🔪 🗡 ⚔ 🛡 🚬 ☠ ⚰ ⚱ 🏺 🔮 📿 💈 ⚗ 🔭 🔬 🕳 "
+    "💊 💉 🌡 🏷 🔖 🚽 🚿 🛁 🔑 🗝 🛋 🛌 🛏 🚪 🛎 🖼 "
+    "🗺 ⛱ 🗿 🛍 🎈 🎏 🎀 🎁 🎊 🎉 🎎 🎐 🎌 🏮 ✉ 📩 "
+    "📨 📧 💌 📮 📪 📫 📬 📭 📦 📯 📥 📤 📜 📃 📑 📊 "
+    "📈 📉 📄 📅 📆 🗓 📇 🗃 🗳 🗄 📋 🗒 📁 📂 🗂 🗞 "
+    "📰 📓 📕 📗 📘 📙 📔 📒 📚 📖 🔗 📎 🖇 ✂ 📐 📏 "
+    "📌 📍 🚩 🏳 🏴 🔐 🔒 🔓 🔏 🖊 🖋 ✒ 📝 ✏ 🖍 🖌 "
+    "🔍 🔎 💯";
+
+static const char symbols[] =
+    "❤ 💛 💚 💙 💜 💔 ❣ 💕 💞 💓 💗 💖 💘 💝 💟 ☮ "
+    "✝ ☪ 🕉 ☸ ✡ 🔯 🕎 ☯ ☦ 🛐 ⛎ ♈ ♉ ♊ ♋ ♌ "
+    "♍ ♎ ♏ ♐ ♑ ♒ ♓ 🆔 ⚛ 🈳 🈹 ☢ ☣ 📴 📳 🈶 "
+    "🈚 🈸 🈺 🈷 ✴ 🆚 🉑 💮 🉐 ㊙ ㊗ 🈴 🈵 🈲 🅰 🅱 "
+    "🆎 🆑 🅾 🆘 ⛔ 📛 🚫 ❌ ⭕ 💢 ♨ 🚷 🚯 🚳 🚱 🔞 "
+    "📵 ❗ ❕ ❓ ❔ ‼ ⁉ 🔅 🔆 🔱 ⚜ 〽 ⚠ 🚸 🔰 ♻ "
+    "🈯 💹 ❇ ✳ ❎ ✅ 💠 🌀 ➿ 🌐 Ⓜ 🏧 🈂 🛂 🛃 🛄 "
+    "🛅 ♿ 🚭 🚾 🅿 🚰 🚹 🚺 🚼 🚻 🚮 🎦 📶 🈁 🆖 🆗 "
+    "🆙 🆒 🆕 🆓 0⃣ 1⃣ 2⃣ 3⃣ 4⃣ 5⃣ 6⃣ 7⃣ 8⃣ 9⃣ 🔟 🔢 "
+    "▶ ⏸ ⏯ ⏹ ⏺ ⏭ ⏮ ⏩ ⏪ 🔀 🔁 🔂 ◀ 🔼 🔽 ⏫ "
+    "⏬ ➡ ⬅ ⬆ ⬇ ↗ ↘ ↙ ↖ ↕ ↔ 🔄 ↪ ↩ ⤴ ⤵ "
+    "#⃣ *⃣ ℹ 🔤 🔡 🔠 🔣 🎵 🎶 〰 ➰ ✔ 🔃 ➕ ➖ ➗ "
+    "✖ 💲 💱 © ® ™ 🔚 🔙 🔛 🔝 🔜 ☑ 🔘 ⚪ ⚫ 🔴 "
+    "🔵 🔸 🔹 🔶 🔷 🔺 ▪ ▫ ⬛ ⬜ 🔻 ◼ ◻ ◾ ◽ 🔲 "
+    "🔳 🔈 🔉 🔊 🔇 📣 📢 🔔 🔕 🃏 🀄 ♠ ♣ ♥ ♦ 🎴 "
+    "💭 🗯 💬 🕐 🕑 🕒 🕓 🕔 🕕 🕖 🕗 🕘 🕙 🕚 🕛 🕜 "
+    "🕝 🕞 🕟 🕠 🕡 🕢 🕣 🕤 🕥 🕦 🕧 🗨 ⏏ 🖤 🛑 * "
+    "# 9 8 7 6 5 4 3 2 1 0";
+
+static const char flags[] =
+    "🇦🇨 🇦🇫 🇦🇱 🇩🇿 🇦🇩 🇦🇴 🇦🇮 🇦🇬 🇦🇷 🇦🇲 🇦🇼 🇦🇺 🇦🇹 🇦🇿 🇧🇸 🇧🇭 "
+    "🇧🇩 🇧🇧 🇧🇾 🇧🇪 🇧🇿 🇧🇯 🇧🇲 🇧🇹 🇧🇴 🇧🇦 🇧🇼 🇧🇷 🇧🇳 🇧🇬 🇧🇫 🇧🇮 "
+    "🇨🇻 🇰🇭 🇨🇲 🇨🇦 🇰🇾 🇨🇫 🇹🇩 🇨🇱 🇨🇳 🇨🇴 🇰🇲 🇨🇬 🇨🇩 🇨🇷 🇭🇷 🇨🇺 "
+    "🇨🇾 🇨🇿 🇩🇰 🇩🇯 🇩🇲 🇩🇴 🇪🇨 🇪🇬 🇸🇻 🇬🇶 🇪🇷 🇪🇪 🇪🇹 🇫🇰 🇫🇴 🇫🇯 "
+    "🇫🇮 🇫🇷 🇵🇫 🇬🇦 🇬🇲 🇬🇪 🇩🇪 🇬🇭 🇬🇮 🇬🇷 🇬🇱 🇬🇩 🇬🇺 🇬🇹 🇬🇳 🇬🇼 "
+    "🇬🇾 🇭🇹 🇭🇳 🇭🇰 🇭🇺 🇮🇸 🇮🇳 🇮🇩 🇮🇷 🇮🇶 🇮🇪 🇮🇱 🇮🇹 🇨🇮 🇯🇲 🇯🇵 "
+    "🇯🇪 🇯🇴 🇰🇿 🇰🇪 🇰🇮 🇽🇰 🇰🇼 🇰🇬 🇱🇦 🇱🇻 🇱🇧 🇱🇸 🇱🇷 🇱🇾 🇱🇮 🇱🇹 "
+    "🇱🇺 🇲🇴 🇲🇰 🇲🇬 🇲🇼 🇲🇾 🇲🇻 🇲🇱 🇲🇹 🇲🇭 🇲🇷 🇲🇺 🇲🇽 🇫🇲 🇲🇩 🇲🇨 "
+    "🇲🇳 🇲🇪 🇲🇸 🇲🇦 🇲🇿 🇲🇲 🇳🇦 🇳🇷 🇳🇵 🇳🇱 🇳🇨 🇳🇿 🇳🇮 🇳🇪 🇳🇬 🇳🇺 "
+    "🇰🇵 🇳🇴 🇴🇲 🇵🇰 🇵🇼 🇵🇸 🇵🇦 🇵🇬 🇵🇾 🇵🇪 🇵🇭 🇵🇱 🇵🇹 🇵🇷 🇶🇦 🇷🇴 "
+    "🇷🇺 🇷🇼 🇸🇭 🇰🇳 🇱🇨 🇻🇨 🇼🇸 🇸🇲 🇸🇹 🇸🇦 🇸🇳 🇷🇸 🇸🇨 🇸🇱 🇸🇬 🇸🇰 "
+    "🇸🇮 🇸🇧 🇸🇴 🇿🇦 🇰🇷 🇪🇸 🇱🇰 🇸🇩 🇸🇷 🇸🇿 🇸🇪 🇨🇭 🇸🇾 🇹🇼 🇹🇯 🇹🇿 "
+    "🇹🇭 🇹🇱 🇹🇬 🇹🇴 🇹🇹 🇹🇳 🇹🇷 🇹🇲 🇹🇻 🇺🇬 🇺🇦 🇦🇪 🇬🇧 🇺🇸 🇻🇮 🇺🇾 "
+    "🇺🇿 🇻🇺 🇻🇦 🇻🇪 🇻🇳 🇼🇫 🇪🇭 🇾🇪 🇿🇲 🇿🇼 🇷🇪 🇦🇽 🇹🇦 🇮🇴 🇧🇶 🇨🇽 "
+    "🇨🇨 🇬🇬 🇮🇲 🇾🇹 🇳🇫 🇵🇳 🇧🇱 🇵🇲 🇬🇸 🇹🇰 🇧🇻 🇭🇲 🇸🇯 🇺🇲 🇮🇨 🇪🇦 "
+    "🇨🇵 🇩🇬 🇦🇸 🇦🇶 🇻🇬 🇨🇰 🇨🇼 🇪🇺 🇬🇫 🇹🇫 🇬🇵 🇲🇶 🇲🇵 🇸🇽 🇸🇸 🇹🇨 "
+    "🇲🇫";
+
+const Category categories[] = {
+    { 540, people },
+    { 161, nature },
+    { 85, food },
+    { 145, activity },
+    { 119, travel },
+    { 179, objects },
+    { 283, symbols },
+    { 257, flags },
+};
+
+const int categoryCount = sizeof(categories) / sizeof(categories[0]);
+
+} // namespace EmojiTable
@@ -0,0 +1,356 @@
+/*
+ * Copyright (C) 2016 Canonical, Ltd.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this list
+ * of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice, this list
+ * of conditions and the following disclaimer in the documentation and/or other materials
+ * provided with the distribution.
+ * Neither the name of Nokia Corporation nor the names of its contributors may be
+ * used to endorse or promote products derived from this software without specific
+ * prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL
+ * THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#include "hangulcomposer.h"
+
+namespace {
+
+// Syllables are SYLLABLE_BASE + (lead * VOWEL_COUNT + vowel) * TRAIL_COUNT + trail,
+// with trail 0 meaning no trailing consonant.
+const ushort SYLLABLE_BASE = 0xAC00;
+const ushort SYLLABLE_LAST = 0xD7A3;
+const int LEAD_COUNT = 19;
+const int VOWEL_COUNT = 21;
+const int TRAIL_COUNT = 28;
+
+const ushort COMPONENT_LEAD_BASE = 0x1100;
+const ushort COMPONENT_VOWEL_BASE = 0x1161;
+const ushort COMPONENT_TRAIL_BASE = 0x11A7;
+
+// Compatibility jamo: consonants first, then vowels in syllable order.
+const ushort JAMO_FIRST = 0x3131;
+const ushort JAMO_FIRST_VOWEL = 0x314F;
+const ushort JAMO_LAST_VOWEL = 0x3163;
+const ushort JAMO_LAST = 0x318F;
+
+struct Consonant
+{
+    signed char lead;
+    signed char trail;
+};
+
+// Lead and trail index of each compatibility consonant, -1 (lead) or 0
+// (trail) if it can't be used as such.
+const Consonant CONSONANTS[JAMO_FIRST_VOWEL - JAMO_FIRST] = {
+    { 0,  1}, { 1,  2}, {-1,  3}, { 2,  4}, {-1,  5}, {-1,  6}, // ㄱ ㄲ ㄳ ㄴ ㄵ ㄶ
+    { 3,  7}, { 4,  0}, { 5,  8}, {-1,  9}, {-1, 10}, {-1, 11}, // ㄷ ㄸ ㄹ ㄺ ㄻ ㄼ
+    {-1, 12}, {-1, 13}, {-1, 14}, {-1, 15}, { 6, 16}, { 7, 17}, // ㄽ ㄾ ㄿ ㅀ ㅁ ㅂ
+    { 8,  0}, {-1, 18}, { 9, 19}, {10, 20}, {11, 21}, {12, 22}, // ㅃ ㅄ ㅅ ㅆ ㅇ ㅈ
+    {13,  0}, {14, 23}, {15, 24}, {16, 25}, {17, 26}, {18, 27}  // ㅉ ㅊ ㅋ ㅌ ㅍ ㅎ
+};
+
+// Compatibility jamo of each lead and trail index.
+const ushort LEADS[LEAD_COUNT] = {
+    0x3131, 0x3132, 0x3134, 0x3137, 0x3138, 0x3139, 0x3141, 0x3142, 0x3143, 0x3145,
+    0x3146, 0x3147, 0x3148, 0x3149, 0x314A, 0x314B, 0x314C, 0x314D, 0x314E
+};
+
+const ushort TRAILS[TRAIL_COUNT] = {
+    0x0000, 0x3131, 0x3132, 0x3133, 0x3134, 0x3135, 0x3136, 0x3137, 0x3139, 0x313A,
+    0x313B, 0x313C, 0x313D, 0x313E, 0x313F, 0x3140, 0x3141, 0x3142, 0x3144, 0x3145,
+    0x3146, 0x3147, 0x3148, 0x314A, 0x314B, 0x314C, 0x314D, 0x314E
+};
+
+struct Compound
+{
+    signed char first;
+    signed char second;
+    signed char result;
+};
+
+// Legal diphthongs, by vowel index.
+const Compound VOWEL_COMPOUNDS[] = {
+    { 8,  0,  9}, { 8,  1, 10}, { 8, 20, 11},   // ㅗㅏ ㅗㅐ ㅗㅣ
+    {13,  4, 14}, {13,  5, 15}, {13, 20, 16},   // ㅜㅓ ㅜㅔ ㅜㅣ
+    {18, 20, 19}                                // ㅡㅣ
+};
+
+// Legal compound final consonants, by trail index.
+const Compound TRAIL_COMPOUNDS[] = {
+    { 1, 19,  3},                               // ㄱㅅ
+    { 4, 22,  5}, { 4, 27,  6},                 // ㄴㅈ ㄴㅎ
+    { 8,  1,  9}, { 8, 16, 10}, { 8, 17, 11},   // ㄹㄱ ㄹㅁ ㄹㅂ
+    { 8, 19, 12}, { 8, 25, 13}, { 8, 26, 14},   // ㄹㅅ ㄹㅌ ㄹㅍ
+    { 8, 27, 15},                               // ㄹㅎ
+    {17, 19, 18}                                // ㅂㅅ
+};
+
+const int VOWEL_COMPOUND_COUNT = sizeof(VOWEL_COMPOUNDS) / sizeof(VOWEL_COMPOUNDS[0]);
+const int TRAIL_COMPOUND_COUNT = sizeof(TRAIL_COMPOUNDS) / sizeof(TRAIL_COMPOUNDS[0]);
+
+inline bool isJamoChar(ushort c)
+{
+    return c >= JAMO_FIRST && c <= JAMO_LAST;
+}
+
+inline bool isSyllableChar(ushort c)
+{
+    return c >= SYLLABLE_BASE && c <= SYLLABLE_LAST;
+}
+
+inline int leadIndex(ushort c)
+{
+    if (c >= COMPONENT_LEAD_BASE && c < COMPONENT_LEAD_BASE + LEAD_COUNT) {
+        return c - COMPONENT_LEAD_BASE;
+    }
+    if (c >= JAMO_FIRST && c < JAMO_FIRST_VOWEL) {
+        return CONSONANTS[c - JAMO_FIRST].lead;
+    }
+    return -1;
+}
+
+inline int vowelIndex(ushort c)
+{
+    if (c >= COMPONENT_VOWEL_BASE && c < COMPONENT_VOWEL_BASE + VOWEL_COUNT) {
+        return c - COMPONENT_VOWEL_BASE;
+    }
+    if (c >= JAMO_FIRST_VOWEL && c <= JAMO_LAST_VOWEL) {
+        return c - JAMO_FIRST_VOWEL;
+    }
+    return -1;
+}
+
+inline int trailIndex(ushort c)
+{
+    if (c > COMPONENT_TRAIL_BASE && c < COMPONENT_TRAIL_BASE + TRAIL_COUNT) {
+        return c - COMPONENT_TRAIL_BASE;
+    }
+    if (c >= JAMO_FIRST && c < JAMO_FIRST_VOWEL) {
+        return CONSONANTS[c - JAMO_FIRST].trail;
+    }
+    return 0;
+}
+
+inline QChar compose(int lead, int vowel, int trail)
+{
+    return QChar(SYLLABLE_BASE + (lead * VOWEL_COUNT + vowel) * TRAIL_COUNT + trail);
+}
+
+inline void decompose(ushort c, int *lead, int *vowel, int *trail)
+{
+    const int offset = c - SYLLABLE_BASE;
+    *lead = offset / (VOWEL_COUNT * TRAIL_COUNT);
+    *vowel = (offset / TRAIL_COUNT) % VOWEL_COUNT;
+    *trail = offset % TRAIL_COUNT;
+}
+
+inline int combine(const Compound *table, int count, int first, int second)
+{
+    for (int i = 0; i < count; ++i) {
+        if (table[i].first == first && table[i].second == second) {
+            return table[i].result;
+        }
+    }
+    return -1;
+}
+
+inline bool separate(const Compound *table, int count, int result, int *first, int *second)
+{
+    for (int i = 0; i < count; ++i) {
+        if (table[i].result == result) {
+            *first = table[i].first;
+            *second = table[i].second;
+            return true;
+        }
+    }
+    return false;
+}
+
+// Merges jamo into the single character c, returns the replacement for c.
+QString addToChar(ushort c, QChar jamo)
+{
+    const ushort j = jamo.unicode();
+
+    if (!isJamoChar(j)) {
+        return QString(QChar(c)) + jamo;
+    }
+
+    if (isJamoChar(c)) {
+        const int lead = leadIndex(c);
+        const int vowel = vowelIndex(j);
+        if (lead >= 0 && vowel >= 0) {
+            return QString(compose(lead, vowel, 0));
+        }
+    } else if (isSyllableChar(c)) {
+        int lead, vowel, trail;
+        decompose(c, &lead, &vowel, &trail);
+
+        const int addedVowel = vowelIndex(j);
+        if (addedVowel >= 0) {
+            if (trail != 0) {
+                // The final consonant moves on to start the next syllable,
+                // or its second half does if it is a compound.
+                const int nextLead = leadIndex(TRAILS[trail]);
+                if (nextLead >= 0) {
+                    return QString(compose(lead, vowel, 0)) + compose(nextLead, addedVowel, 0);
+                }
+
+                int first, second;
+                if (separate(TRAIL_COMPOUNDS, TRAIL_COMPOUND_COUNT, trail, &first, &second)) {
+                    return QString(compose(lead, vowel, first))
+                            + compose(leadIndex(TRAILS[second]), addedVowel, 0);
+                }
+            } else {
+                const int compound = combine(VOWEL_COMPOUNDS, VOWEL_COMPOUND_COUNT, vowel, addedVowel);
+                if (compound >= 0) {
+                    return QString(compose(lead, compound, 0));
+                }
+            }
+        } else {
+            const int addedTrail = trailIndex(j);
+            if (addedTrail != 0) {
+                if (trail == 0) {
+                    return QString(compose(lead, vowel, addedTrail));
+                }
+
+                const int compound = combine(TRAIL_COMPOUNDS, TRAIL_COMPOUND_COUNT, trail, addedTrail);
+                if (compound >= 0) {
+                    return QString(compose(lead, vowel, compound));
+                }
+            }
+        }
+    }
+
+    return QString(QChar(c)) + jamo;
+}
+
+// Removes the last jamo typed into c, returns the replacement for c.
+QString eraseFromChar(ushort c)
+{
+    if (!isSyllableChar(c)) {
+        return QString();
+    }
+
+    int lead, vowel, trail;
+    decompose(c, &lead, &vowel, &trail);
+
+    int first, second;
+    if (trail != 0) {
+        if (separate(TRAIL_COMPOUNDS, TRAIL_COMPOUND_COUNT, trail, &first, &second)) {
+            return QString(compose(lead, vowel, first));
+        }
+        return QString(compose(lead, vowel, 0));
+    }
+
+    if (separate(VOWEL_COMPOUNDS, VOWEL_COMPOUND_COUNT, vowel, &first, &second)) {
+        return QString(compose(lead, first, 0));
+    }
+
+    return QString(QChar(LEADS[lead]));
+}
+
+} // unnamed namespace
+
+HangulComposer::HangulComposer(QObject *parent)
+    : QObject(parent)
+{}
+
+HangulComposer::~HangulComposer()
+{}
+
+//! \brief Whether text starts with a compatibility jamo.
+bool HangulComposer::isJamo(const QString &text) const
+{
+    return !text.isEmpty() && isJamoChar(text.at(0).unicode());
+}
+
+//! \brief Whether text starts with a syllable block.
+bool HangulComposer::isSyllable(const QString &text) const
+{
+    return !text.isEmpty() && isSyllableChar(text.at(0).unicode());
+}
+
+bool HangulComposer::isHangul(const QString &text) const
+{
+    return isJamo(text) || isSyllable(text);
+}
+
+//! \brief Composes a syllable block.
+//! \param trail Final consonant, can be empty.
+//! \return The syllable, or an empty string if the jamo don't form one.
+QString HangulComposer::join(const QString &lead, const QString &vowel, const QString &trail) const
+{
+    if (lead.isEmpty() || vowel.isEmpty()) {
+        return QString();
+    }
+
+    const int l = leadIndex(lead.at(0).unicode());
+    const int v = vowelIndex(vowel.at(0).unicode());
+    const int t = trail.isEmpty() ? 0 : trailIndex(trail.at(0).unicode());
+
+    if (l < 0 || v < 0 || (!trail.isEmpty() && t == 0)) {
+        return QString();
+    }
+
+    return QString(compose(l, v, t));
+}
+
+//! \brief Splits a syllable block into compatibility jamo.
+//! \return Lead, vowel and final consonant (empty if there is none), or
+//! an empty list if syllable isn't one.
+QStringList HangulComposer::split(const QString &syllable) const
+{
+    QStringList result;
+
+    if (!isSyllable(syllable)) {
+        return result;
+    }
+
+    int lead, vowel, trail;
+    decompose(syllable.at(0).unicode(), &lead, &vowel, &trail);
+
+    result << QString(QChar(LEADS[lead]))
+           << QString(QChar(JAMO_FIRST_VOWEL + vowel))
+           << (trail ? QString(QChar(TRAILS[trail])) : QString());
+    return result;
+}
+
+//! \brief Types jamo into the syllable at the end of preedit.
+//! \return The new preedit.
+QString HangulComposer::addJamo(const QString &preedit, const QString &jamo) const
+{
+    if (preedit.isEmpty() || jamo.length() != 1) {
+        return preedit + jamo;
+    }
+
+    return preedit.left(preedit.length() - 1)
+            + addToChar(preedit.at(preedit.length() - 1).unicode(), jamo.at(0));
+}
+
+//! \brief Erases the last jamo typed into the syllable at the end of
+//! preedit.
+//! \return The new preedit, which drops the last character if that was a
+//! lone jamo or not Hangul at all.
+QString HangulComposer::eraseJamo(const QString &preedit) const
+{
+    if (preedit.isEmpty()) {
+        return preedit;
+    }
+
+    return preedit.left(preedit.length() - 1)
+            + eraseFromChar(preedit.at(preedit.length() - 1).unicode());
+}
@@ -0,0 +1,58 @@
+/*
+ * Copyright (C) 2016 Canonical, Ltd.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this list
+ * of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice, this list
+ * of conditions and the following disclaimer in the documentation and/or other materials
+ * provided with the distribution.
+ * Neither the name of Nokia Corporation nor the names of its contributors may be
+ * used to endorse or promote products derived from this software without specific
+ * prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL
+ * THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#ifndef HANGULCOMPOSER_H
+#define HANGULCOMPOSER_H
+
+#include <QObject>
+#include <QString>
+#include <QStringList>
+
+//! Combines Hangul compatibility jamo, as found on the keys, into
+//! syllable blocks and takes them apart again, following the Unicode
+//! composition algorithm. Exposed to QML as the UbuntuKeyboard.Hangul
+//! singleton.
+class HangulComposer : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit HangulComposer(QObject *parent = 0);
+    virtual ~HangulComposer();
+
+    Q_INVOKABLE bool isJamo(const QString &text) const;
+    Q_INVOKABLE bool isSyllable(const QString &text) const;
+    Q_INVOKABLE bool isHangul(const QString &text) const;
+
+    Q_INVOKABLE QString join(const QString &lead, const QString &vowel, const QString &trail) const;
+    Q_INVOKABLE QStringList split(const QString &syllable) const;
+
+    Q_INVOKABLE QString addJamo(const QString &preedit, const QString &jamo) const;
+    Q_INVOKABLE QString eraseJamo(const QString &preedit) const;
+};
+
+#endif // HANGULCOMPOSER_H
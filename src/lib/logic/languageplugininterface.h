@@ -4,6 +4,8 @@
 #include <QString>
 #include <QStringList>
 
+#include "languageresources.h"
+
 class AbstractLanguageFeatures;
 
 class LanguagePluginInterface
@@ -12,7 +14,20 @@ public:
     virtual ~LanguagePluginInterface() {}
 
     virtual void predict(const QString& surroundingLeft, const QString& preedit) = 0;
+    //! Plugins with long candidate lists only deliver the first page from
+    //! predict(); the following pages are produced by this on request.
+    virtual void fetchMoreCandidates() = 0;
     virtual void wordCandidateSelected(QString word) = 0;
+    //! Plugins that learn from selections in the background write out
+    //! what they learned so far, e.g. because the keyboard got hidden.
+    virtual void flushLearning() = 0;
+
+    //! Approximate memory taken by the plugin's dictionaries and models,
+    //! in bytes, or -1 if the plugin cannot tell.
+    virtual qint64 memoryUsage() const = 0;
+    //! Frees what the plugin can load again. Called while another language
+    //! is active; setLanguage() is called again before the plugin is used.
+    virtual void releaseCaches() = 0;
 
     virtual AbstractLanguageFeatures* languageFeature() = 0;
 
@@ -20,9 +35,12 @@ public:
     virtual void spellCheckerSuggest(const QString& word, int limit) = 0;
     virtual void addToSpellCheckerUserWordList(const QString& word) = 0;
     virtual bool setLanguage(const QString& languageId, const QString &pluginPath) = 0;
+    //! Called before setLanguage() with the files the keyboard found for
+    //! the language, so that the plugin does not have to look for them.
+    virtual void setLanguageResources(const LanguageResources &resources) = 0;
 };
 
-#define LanguagePluginInterface_iid "com.canonical.UbuntuKeyboard.LanguagePluginInterface"
+#define LanguagePluginInterface_iid "com.canonical.UbuntuKeyboard.LanguagePluginInterface.2"
 
 Q_DECLARE_INTERFACE(LanguagePluginInterface, LanguagePluginInterface_iid)
 
@@ -0,0 +1,195 @@
+/*
+ * Copyright (C) 2016 Canonical, Ltd.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this list
+ * of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice, this list
+ * of conditions and the following disclaimer in the documentation and/or other materials
+ * provided with the distribution.
+ * Neither the name of Nokia Corporation nor the names of its contributors may be
+ * used to endorse or promote products derived from this software without specific
+ * prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL
+ * THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#include "languageregistry.h"
+
+#include <QDebug>
+#include <QDir>
+
+//! Installing a package changes a directory many times in a row; the scan
+//! waits that long for it to settle, in ms.
+#define RESCAN_DELAY 200
+
+namespace MaliitKeyboard {
+namespace Logic {
+
+LanguageRegistry::LanguageRegistry(QObject *parent)
+    : QObject(parent)
+    , m_pluginPaths()
+    , m_dictionaryPath()
+    , m_languages()
+    , m_watcher()
+    , m_rescanTimer()
+{
+    m_rescanTimer.setSingleShot(true);
+    m_rescanTimer.setInterval(RESCAN_DELAY);
+
+    connect(&m_rescanTimer, SIGNAL(timeout()), this, SLOT(rescan()));
+    connect(&m_watcher, SIGNAL(directoryChanged(QString)),
+            this, SLOT(onDirectoryChanged()));
+}
+
+LanguageRegistry::~LanguageRegistry()
+{}
+
+//! \brief LanguageRegistry::setSearchPaths scans the given directories
+//! \param pluginPaths Directories with one subdirectory per language, the
+//! first one containing a language wins.
+//! \param dictionaryPath Directory with the hunspell dictionaries.
+void LanguageRegistry::setSearchPaths(const QStringList &pluginPaths,
+                                      const QString &dictionaryPath)
+{
+    m_pluginPaths = pluginPaths;
+    m_dictionaryPath = dictionaryPath;
+    rescan();
+}
+
+QStringList LanguageRegistry::languages() const
+{
+    return m_languages.keys();
+}
+
+bool LanguageRegistry::contains(const QString &language) const
+{
+    return m_languages.contains(language);
+}
+
+LanguageResources LanguageRegistry::resources(const QString &language) const
+{
+    return m_languages.value(language);
+}
+
+//! \brief LanguageRegistry::rescan reads all search paths again and
+//! watches them for changes
+void LanguageRegistry::rescan()
+{
+    m_rescanTimer.stop();
+
+    QStringList watched;
+    QMap<QString, LanguageResources> languages;
+
+    QDir dictionaryDir(m_dictionaryPath);
+    const QStringList dictionaries(dictionaryDir.entryList(QStringList() << "*.aff" << "*.dic",
+                                                           QDir::Files, QDir::Name));
+    if (dictionaryDir.exists()) {
+        watched.append(dictionaryDir.absolutePath());
+    }
+
+    Q_FOREACH(const QString &pluginPath, m_pluginPaths) {
+        QDir pluginDir(pluginPath);
+        if (!pluginDir.exists()) {
+            continue;
+        }
+        watched.append(pluginDir.absolutePath());
+
+        Q_FOREACH(const QString &id, pluginDir.entryList(QDir::Dirs | QDir::NoDotAndDotDot)) {
+            const QDir languageDir(pluginDir.absoluteFilePath(id));
+            const QStringList files(languageDir.entryList(QDir::Files));
+            const QString plugin("lib" + id + "plugin.so");
+            watched.append(languageDir.absolutePath());
+
+            // A language without plugin in an earlier path can still get
+            // its word engine from a later one.
+            if (languages.contains(id)) {
+                LanguageResources &resources(languages[id]);
+                if (resources.plugin.isEmpty() && files.contains(plugin)) {
+                    resources.plugin = languageDir.absoluteFilePath(plugin);
+                }
+                continue;
+            }
+
+            LanguageResources resources;
+            resources.id = id;
+            resources.path = languageDir.absolutePath();
+
+            const QString layoutPrefix("Keyboard_" + id);
+            Q_FOREACH(const QString &file, files) {
+                if (file == plugin) {
+                    resources.plugin = languageDir.absoluteFilePath(file);
+                } else if (file == "database_" + id + ".db") {
+                    resources.database = languageDir.absoluteFilePath(file);
+                } else if (file == "overrides.csv") {
+                    resources.overrides = languageDir.absoluteFilePath(file);
+                } else if (file == layoutPrefix + ".qml") {
+                    resources.layouts.insert(QString(), languageDir.absoluteFilePath(file));
+                } else if (file.startsWith(layoutPrefix + "_") && file.endsWith(".qml")) {
+                    const QString variant(file.mid(layoutPrefix.length() + 1,
+                                                   file.length() - layoutPrefix.length() - 5));
+                    resources.layouts.insert(variant, languageDir.absoluteFilePath(file));
+                }
+            }
+
+            const QString aff(findDictionary(dictionaries.filter(QRegExp("\\.aff$")), id));
+            const QString dic(findDictionary(dictionaries.filter(QRegExp("\\.dic$")), id));
+            if (!aff.isEmpty() && !dic.isEmpty()) {
+                resources.affFile = dictionaryDir.absoluteFilePath(aff);
+                resources.dicFile = dictionaryDir.absoluteFilePath(dic);
+            }
+
+            languages.insert(id, resources);
+        }
+    }
+
+    m_languages = languages;
+
+    const QStringList stale(m_watcher.directories());
+    if (stale != watched) {
+        if (!stale.isEmpty()) {
+            m_watcher.removePaths(stale);
+        }
+        if (!watched.isEmpty()) {
+            m_watcher.addPaths(watched);
+        }
+    }
+
+    Q_EMIT changed();
+}
+
+void LanguageRegistry::onDirectoryChanged()
+{
+    m_rescanTimer.start();
+}
+
+//! Same choice as SpellChecker makes: the first dictionary named after the
+//! language, or else after the language without its region.
+QString LanguageRegistry::findDictionary(const QStringList &files,
+                                         const QString &language) const
+{
+    Q_FOREACH(const QString &file, files) {
+        if (file.startsWith(language)) {
+            return file;
+        }
+    }
+
+    if (language.length() > 2) {
+        return findDictionary(files, language.left(2));
+    }
+
+    return QString();
+}
+
+}} // namespace Logic, MaliitKeyboard
@@ -0,0 +1,79 @@
+/*
+ * Copyright (C) 2016 Canonical, Ltd.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this list
+ * of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice, this list
+ * of conditions and the following disclaimer in the documentation and/or other materials
+ * provided with the distribution.
+ * Neither the name of Nokia Corporation nor the names of its contributors may be
+ * used to endorse or promote products derived from this software without specific
+ * prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL
+ * THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#ifndef MALIIT_KEYBOARD_LANGUAGEREGISTRY_H
+#define MALIIT_KEYBOARD_LANGUAGEREGISTRY_H
+
+#include "languageresources.h"
+
+#include <QFileSystemWatcher>
+#include <QMap>
+#include <QObject>
+#include <QStringList>
+#include <QTimer>
+
+namespace MaliitKeyboard {
+namespace Logic {
+
+//! Knows which languages are installed and where their files are. The
+//! plugin paths and the hunspell dictionaries are scanned once, and again
+//! only when the file system watcher reports a change in one of them, so
+//! looking up a language never touches the file system.
+class LanguageRegistry
+    : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit LanguageRegistry(QObject *parent = 0);
+    virtual ~LanguageRegistry();
+
+    void setSearchPaths(const QStringList &pluginPaths,
+                        const QString &dictionaryPath);
+
+    QStringList languages() const;
+    bool contains(const QString &language) const;
+    LanguageResources resources(const QString &language) const;
+
+    Q_SLOT void rescan();
+    Q_SIGNAL void changed();
+
+private:
+    Q_SLOT void onDirectoryChanged();
+    QString findDictionary(const QStringList &files,
+                           const QString &language) const;
+
+    QStringList m_pluginPaths;
+    QString m_dictionaryPath;
+    QMap<QString, LanguageResources> m_languages;
+    QFileSystemWatcher m_watcher;
+    QTimer m_rescanTimer;
+};
+
+}} // namespace Logic, MaliitKeyboard
+
+#endif // MALIIT_KEYBOARD_LANGUAGEREGISTRY_H
@@ -0,0 +1,56 @@
+/*
+ * Copyright (C) 2016 Canonical, Ltd.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this list
+ * of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice, this list
+ * of conditions and the following disclaimer in the documentation and/or other materials
+ * provided with the distribution.
+ * Neither the name of Nokia Corporation nor the names of its contributors may be
+ * used to endorse or promote products derived from this software without specific
+ * prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL
+ * THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#ifndef LANGUAGERESOURCES_H
+#define LANGUAGERESOURCES_H
+
+#include <QHash>
+#include <QString>
+
+//! Files belonging to one language, as found by the keyboard's
+//! LanguageRegistry. Files a language does not have are left empty.
+struct LanguageResources
+{
+    //! Language id, e.g. "en" or "zh-hans".
+    QString id;
+    //! Directory of the language plugin.
+    QString path;
+    //! The plugin itself, lib<id>plugin.so.
+    QString plugin;
+    //! Keyboard_<id>[_<variant>].qml by variant, "" for free text,
+    //! "email" and "url_search" for the other content types.
+    QHash<QString, QString> layouts;
+    //! Hunspell dictionary.
+    QString affFile;
+    QString dicFile;
+    //! Presage n-gram database, database_<id>.db.
+    QString database;
+    //! Spelling overrides, overrides.csv.
+    QString overrides;
+};
+
+#endif // LANGUAGERESOURCES_H
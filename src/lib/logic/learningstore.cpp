@@ -0,0 +1,213 @@
+/*
+ * Copyright (C) 2016 Canonical, Ltd.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this list
+ * of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice, this list
+ * of conditions and the following disclaimer in the documentation and/or other materials
+ * provided with the distribution.
+ * Neither the name of Nokia Corporation nor the names of its contributors may be
+ * used to endorse or promote products derived from this software without specific
+ * prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL
+ * THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#include "learningstore.h"
+
+#include <QDebug>
+#include <QDir>
+#include <QDirIterator>
+#include <QFile>
+#include <QFileInfo>
+#include <QStandardPaths>
+#include <QTimer>
+
+// Time without new selections after which the pending ones are learned.
+#define LEARNING_IDLE_TIMEOUT 10000
+// Selections kept in memory before a shorter pause is enough to learn them.
+#define MAX_PENDING_EVENTS 128
+// Time after which that many selections are learned, however busy typing is.
+#define LEARNING_BUSY_TIMEOUT 1000
+// Selections learned at once before keystrokes get a turn again.
+#define LEARNING_CHUNK_SIZE 16
+// Size of an engine's store above which it is rotated on the next start.
+#define MAX_STORE_SIZE (16 * 1024 * 1024)
+
+LearningStore::Event::Event(const QString &reading, const QString &word)
+    : reading(reading)
+    , word(word)
+{}
+
+//! \brief Creates the store of an engine.
+//! \param engine Name of the engine, used as directory below the user
+//! data location.
+LearningStore::LearningStore(const QString &engine, QObject *parent)
+    : QObject(parent)
+    , m_path(QStandardPaths::writableLocation(QStandardPaths::DataLocation)
+             + QDir::separator() + engine)
+    , m_pending()
+    , m_idleTimer(new QTimer(this))
+{
+    // Engines open their user data right after creating the store, so this
+    // is the last moment a store that grew too large can be replaced.
+    if (diskUsage() > MAX_STORE_SIZE) {
+        rotate();
+    }
+
+    QDir::home().mkpath(m_path);
+
+    m_idleTimer->setSingleShot(true);
+    m_idleTimer->setInterval(LEARNING_IDLE_TIMEOUT);
+    connect(m_idleTimer, SIGNAL(timeout()), this, SLOT(learnChunk()));
+}
+
+//! Derived classes have to flush() before their engine goes away, as
+//! learn() and save() can't be called from here anymore.
+LearningStore::~LearningStore()
+{
+    if (!m_pending.isEmpty()) {
+        qWarning() << "LearningStore: dropping" << m_pending.size() << "unsaved selections for" << m_path;
+    }
+}
+
+//! \brief Directory the engine should keep its user data in.
+QString LearningStore::path() const
+{
+    return m_path;
+}
+
+//! \brief Copies the user data an engine kept elsewhere into the store,
+//! unless path()/\a name exists already.
+//! \param directory Directory the engine used before.
+//! \param name Name of the copy below path().
+//! \return Whether anything was copied.
+//!
+//! The original stays in place, other users of the engine may still need it.
+bool LearningStore::importDirectory(const QString &directory, const QString &name)
+{
+    const QDir source(directory);
+    const QDir target(m_path + QDir::separator() + name);
+
+    if (target.exists() || !source.exists()) {
+        return false;
+    }
+
+    QDirIterator it(source.path(), QDir::Files | QDir::Hidden, QDirIterator::Subdirectories);
+    while (it.hasNext()) {
+        it.next();
+
+        const QString copy(target.filePath(source.relativeFilePath(it.filePath())));
+        QDir::home().mkpath(QFileInfo(copy).path());
+        if (!QFile::copy(it.filePath(), copy)) {
+            qWarning() << "LearningStore: cannot copy" << it.filePath() << "to" << copy;
+        }
+    }
+
+    // Also marks the import as done if there was nothing to copy.
+    QDir::home().mkpath(target.path());
+    return true;
+}
+
+//! \brief Queues a selection, to be learned with the next batch.
+void LearningStore::record(const QString &reading, const QString &word)
+{
+    if (reading.isEmpty() || word.isEmpty()) {
+        return;
+    }
+
+    m_pending.append(Event(reading, word));
+    postpone();
+}
+
+//! \brief Holds back learning while the user is typing. Pending selections
+//! are learned once there was no keystroke for a while. Once many of them
+//! piled up they are learned shortly after, even if typing goes on.
+void LearningStore::postpone()
+{
+    if (m_pending.isEmpty()) {
+        return;
+    }
+
+    if (m_pending.size() < MAX_PENDING_EVENTS) {
+        m_idleTimer->start(LEARNING_IDLE_TIMEOUT);
+    } else if (!m_idleTimer->isActive() || m_idleTimer->interval() > LEARNING_BUSY_TIMEOUT) {
+        m_idleTimer->start(LEARNING_BUSY_TIMEOUT);
+    }
+}
+
+//! \brief Learns and saves all pending selections.
+void LearningStore::flush()
+{
+    m_idleTimer->stop();
+    learnPending(m_pending.size());
+}
+
+//! Learns a few pending selections and lets the keystrokes queued for the
+//! adapter thread meanwhile go first before learning the next few.
+void LearningStore::learnChunk()
+{
+    learnPending(LEARNING_CHUNK_SIZE);
+
+    if (!m_pending.isEmpty()) {
+        m_idleTimer->start(0);
+    }
+}
+
+//! Learns up to \a count of the oldest pending selections, and saves once
+//! none are left.
+void LearningStore::learnPending(int count)
+{
+    if (m_pending.isEmpty()) {
+        return;
+    }
+
+    for (int i = 0; i < count && !m_pending.isEmpty(); ++i) {
+        const Event event(m_pending.takeFirst());
+        learn(event.reading, event.word);
+    }
+
+    if (m_pending.isEmpty()) {
+        save();
+    }
+}
+
+//! Moves the store aside, replacing the one moved aside before, so that
+//! the engine starts over with an empty one.
+void LearningStore::rotate()
+{
+    const QString old(m_path + ".old");
+
+    qWarning() << "LearningStore:" << m_path << "is over its size limit, moving it to" << old;
+
+    QDir(old).removeRecursively();
+    if (!QDir::home().rename(m_path, old)) {
+        qWarning() << "LearningStore: cannot move" << m_path << ", removing it";
+        QDir(m_path).removeRecursively();
+    }
+}
+
+qint64 LearningStore::diskUsage() const
+{
+    qint64 size = 0;
+
+    QDirIterator it(m_path, QDir::Files | QDir::Hidden, QDirIterator::Subdirectories);
+    while (it.hasNext()) {
+        it.next();
+        size += it.fileInfo().size();
+    }
+
+    return size;
+}
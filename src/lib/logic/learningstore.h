@@ -0,0 +1,88 @@
+/*
+ * Copyright (C) 2016 Canonical, Ltd.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this list
+ * of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice, this list
+ * of conditions and the following disclaimer in the documentation and/or other materials
+ * provided with the distribution.
+ * Neither the name of Nokia Corporation nor the names of its contributors may be
+ * used to endorse or promote products derived from this software without specific
+ * prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL
+ * THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#ifndef LEARNINGSTORE_H
+#define LEARNINGSTORE_H
+
+#include <QObject>
+#include <QList>
+#include <QString>
+
+class QTimer;
+
+//! Collects the words the user picked for a reading and hands them to the
+//! engine in small chunks, either once typing has been idle for a while or
+//! when flush() is called (e.g. the keyboard got hidden). Once many are
+//! pending they are learned soon, however busy typing is. Meant to live in
+//! the thread of the engine adapter, which calls postpone() for every
+//! keystroke it handles, so that neither learning nor writing ever happens
+//! on the keystroke path. A store that outgrew its size limit is moved
+//! aside when it is created, before the engine opens it.
+class LearningStore : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit LearningStore(const QString &engine, QObject *parent = 0);
+    virtual ~LearningStore();
+
+    QString path() const;
+    bool importDirectory(const QString &directory, const QString &name);
+    void record(const QString &reading, const QString &word);
+    void postpone();
+
+public slots:
+    void flush();
+
+private slots:
+    void learnChunk();
+
+protected:
+    //! Teaches the engine that word was picked for reading.
+    virtual void learn(const QString &reading, const QString &word) = 0;
+    //! Writes what has been learned so far to path().
+    virtual void save() = 0;
+
+private:
+    struct Event
+    {
+        Event(const QString &reading = QString(), const QString &word = QString());
+
+        QString reading;
+        QString word;
+    };
+
+    void learnPending(int count);
+    void rotate();
+    qint64 diskUsage() const;
+
+    QString m_path;
+    QList<Event> m_pending;
+    QTimer *m_idleTimer;
+};
+
+#endif // LEARNINGSTORE_H
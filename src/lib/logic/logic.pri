@@ -9,8 +9,15 @@ HEADERS += \
     logic/wordengine.h \
     logic/abstractlanguagefeatures.h \
     logic/eventhandler.h \
+    logic/emojiindex.h \
+    logic/emojimodel.h \
+    logic/emojitable.h \
     logic/languageplugininterface.h \
+    logic/languageregistry.h \
+    logic/languageresources.h \
     logic/abstractlanguageplugin.h \
+    logic/hangulcomposer.h \
+    logic/sentencestate.h \
 
 SOURCES += \
 #    logic/layouthelper.cpp \
@@ -20,6 +27,12 @@ SOURCES += \
     logic/abstractwordengine.cpp \
     logic/wordengine.cpp \
     logic/eventhandler.cpp \
-    logic/abstractlanguageplugin.cpp  
+    logic/emojiindex.cpp \
+    logic/emojimodel.cpp \
+    logic/emojitable.cpp \
+    logic/abstractlanguageplugin.cpp \
+    logic/languageregistry.cpp \
+    logic/hangulcomposer.cpp \
+    logic/sentencestate.cpp
 
 DEPENDPATH += $$LOGIC_DIR
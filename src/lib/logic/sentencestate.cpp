@@ -0,0 +1,194 @@
+/*
+ * Copyright (C) 2016 Canonical, Ltd.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this list
+ * of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice, this list
+ * of conditions and the following disclaimer in the documentation and/or other materials
+ * provided with the distribution.
+ * Neither the name of Nokia Corporation nor the names of its contributors may be
+ * used to endorse or promote products derived from this software without specific
+ * prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL
+ * THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#include "sentencestate.h"
+#include "abstractlanguagefeatures.h"
+#include "models/text.h"
+
+namespace MaliitKeyboard {
+namespace Logic {
+
+namespace {
+
+// Enough for the language rules and for spotting an email address being
+// typed.
+const int CONTEXT_LENGTH = 64;
+
+// Characters of the line the language rules get to see. They only look at
+// the last couple, e.g. whether a full stop is followed by a space.
+const int RULE_CONTEXT_LENGTH = 4;
+
+// Returns the index after the last line break in text, -1 if there is none.
+int lineStartIn(const QString &text)
+{
+    for (int i = text.length(); i > 0; --i) {
+        if (Model::Text::isLineBreak(text.at(i - 1))) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+} // unnamed namespace
+
+//! \class SentenceState
+//! \brief Tracks the text left of the cursor for auto-capitalisation.
+//!
+//! Only the last few committed characters are kept, along with where the
+//! current line and word start in them. The editor feeds commits and
+//! deletions as it sends them to the host, and resyncs with the host's
+//! surrounding text whenever that gets updated, e.g. because the cursor
+//! jumped. Answering whether shift should be active then only looks at the
+//! preedit and the last few characters.
+
+SentenceState::SentenceState()
+    : m_tail()
+    , m_at_start(true)
+    , m_line_start(0)
+    , m_word_start(0)
+    , m_word_has_at(false)
+{}
+
+//! \brief Number of characters left of the cursor that resync() needs.
+int SentenceState::contextLength()
+{
+    return CONTEXT_LENGTH;
+}
+
+//! \brief Replaces the tracked text.
+//! \param textOnLeft Committed text left of the cursor, only the last
+//! contextLength() characters are used.
+//! \param atStart Whether textOnLeft starts at the beginning of the text.
+void SentenceState::resync(const QString &textOnLeft, bool atStart)
+{
+    m_at_start = atStart && textOnLeft.length() <= CONTEXT_LENGTH;
+    m_tail = textOnLeft.right(CONTEXT_LENGTH);
+    update(0);
+}
+
+//! \brief Records text committed at the cursor.
+void SentenceState::commit(const QString &text)
+{
+    const int from = m_tail.length();
+    m_tail.append(text);
+
+    if (m_tail.length() > CONTEXT_LENGTH) {
+        m_tail.remove(0, m_tail.length() - CONTEXT_LENGTH);
+        m_at_start = false;
+        update(0);
+    } else {
+        update(from);
+    }
+}
+
+//! \brief Records \a count characters deleted left of the cursor.
+void SentenceState::erase(int count)
+{
+    m_tail.chop(count);
+
+    if (m_line_start > m_tail.length() || m_word_start > m_tail.length()) {
+        update(0);
+    } else if (m_word_has_at) {
+        // The '@' may have been deleted
+        m_word_has_at = false;
+        update(m_word_start);
+    }
+}
+
+//! \brief Returns the character left of the cursor, a null character if
+//! it isn't known.
+//! \param preedit Uncommitted text at the cursor.
+QChar SentenceState::lastChar(const QString &preedit) const
+{
+    if (!preedit.isEmpty()) {
+        return preedit.at(preedit.length() - 1);
+    }
+
+    return m_tail.isEmpty() ? QChar() : m_tail.at(m_tail.length() - 1);
+}
+
+//! \brief Whether the next character typed should be capitalised.
+//! \param features Rules of the current language.
+//! \param preedit Uncommitted text at the cursor.
+//!
+//! True at the start of the text or of a line, otherwise up to the
+//! language, except while an email address is being typed.
+bool SentenceState::autoCapsActive(const AbstractLanguageFeatures *features,
+                                   const QString &preedit) const
+{
+    const int preedit_line_start = lineStartIn(preedit);
+    const QString line_in_preedit = preedit_line_start < 0 ? preedit : preedit.mid(preedit_line_start);
+    const int tail_line_length = preedit_line_start < 0 ? m_tail.length() - m_line_start : 0;
+
+    if (line_in_preedit.isEmpty() && tail_line_length == 0) {
+        return preedit_line_start >= 0 || m_line_start > 0 || m_at_start;
+    }
+
+    const int space = line_in_preedit.lastIndexOf(QLatin1Char(' '));
+    if (space >= 0 || preedit_line_start >= 0) {
+        if (line_in_preedit.midRef(space + 1).contains(QLatin1Char('@'))) {
+            return false;
+        }
+    } else if (m_word_has_at || line_in_preedit.contains(QLatin1Char('@'))) {
+        return false;
+    }
+
+    if (!features) {
+        return false;
+    }
+
+    const int from_tail = qMin(tail_line_length, qMax(0, RULE_CONTEXT_LENGTH - line_in_preedit.length()));
+    return features->activateAutoCaps(m_tail.right(from_tail) + line_in_preedit.right(RULE_CONTEXT_LENGTH));
+}
+
+//! Finds where the current line and word start in the tracked text, knowing
+//! that nothing before \a from changed.
+void SentenceState::update(int from)
+{
+    if (from == 0) {
+        m_line_start = 0;
+        m_word_start = 0;
+        m_word_has_at = false;
+    }
+
+    for (int i = from; i < m_tail.length(); ++i) {
+        const QChar c = m_tail.at(i);
+
+        if (Model::Text::isLineBreak(c)) {
+            m_line_start = i + 1;
+            m_word_start = i + 1;
+            m_word_has_at = false;
+        } else if (c == QLatin1Char(' ')) {
+            m_word_start = i + 1;
+            m_word_has_at = false;
+        } else if (c == QLatin1Char('@')) {
+            m_word_has_at = true;
+        }
+    }
+}
+
+}} // namespace Logic, MaliitKeyboard
@@ -0,0 +1,65 @@
+/*
+ * Copyright (C) 2016 Canonical, Ltd.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this list
+ * of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice, this list
+ * of conditions and the following disclaimer in the documentation and/or other materials
+ * provided with the distribution.
+ * Neither the name of Nokia Corporation nor the names of its contributors may be
+ * used to endorse or promote products derived from this software without specific
+ * prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL
+ * THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#ifndef MALIIT_KEYBOARD_SENTENCESTATE_H
+#define MALIIT_KEYBOARD_SENTENCESTATE_H
+
+#include <QtCore>
+
+class AbstractLanguageFeatures;
+
+namespace MaliitKeyboard {
+namespace Logic {
+
+class SentenceState
+{
+public:
+    explicit SentenceState();
+
+    static int contextLength();
+
+    void resync(const QString &textOnLeft, bool atStart);
+    void commit(const QString &text);
+    void erase(int count);
+
+    QChar lastChar(const QString &preedit = QString()) const;
+    bool autoCapsActive(const AbstractLanguageFeatures *features,
+                        const QString &preedit = QString()) const;
+
+private:
+    void update(int from);
+
+    QString m_tail; //!< last committed characters left of the cursor.
+    bool m_at_start; //!< whether m_tail reaches back to the start of the text.
+    int m_line_start; //!< position in m_tail after its last line break, 0 if there is none.
+    int m_word_start; //!< position in m_tail where the word at its end starts.
+    bool m_word_has_at; //!< whether that word contains an '@'.
+};
+
+}} // namespace Logic, MaliitKeyboard
+
+#endif // MALIIT_KEYBOARD_SENTENCESTATE_H
@@ -31,11 +31,48 @@
 
 #include "wordengine.h"
 #include "abstractlanguageplugin.h"
+#include "emojiindex.h"
+#include "startuptrace.h"
 
 namespace MaliitKeyboard {
 namespace Logic {
 
 #define DEFAULT_PLUGIN "/usr/share/maliit/plugins/com/ubuntu/lib/en/libenplugin.so"
+// Emoji offered on the word ribbon for a word.
+#define MAX_EMOJI_CANDIDATES 2
+// Shorter words only get emoji for keywords they match completely.
+#define MIN_EMOJI_PREFIX_LENGTH 3
+// Memory the loaded language engines may take, in MiB, unless set
+// otherwise.
+#define DEFAULT_MEMORY_BUDGET 48
+// Assumed for plugins that do not report their memory usage, in bytes.
+#define UNKNOWN_ENGINE_SIZE (8 * 1024 * 1024)
+
+//! A language plugin that stays loaded after switching away from it, so
+//! that switching back does not have to load it again.
+struct LoadedEngine
+{
+    LoadedEngine()
+        : fileName()
+        , languageId()
+        , loader(0)
+        , plugin(0)
+        , cachesReleased(false)
+    {}
+
+    QString fileName;
+    //! Language the plugin was last set up for.
+    QString languageId;
+    QPluginLoader *loader;
+    LanguagePluginInterface *plugin;
+    bool cachesReleased;
+
+    qint64 memoryUsage() const
+    {
+        const qint64 usage = plugin->memoryUsage();
+        return usage < 0 ? UNKNOWN_ENGINE_SIZE : usage;
+    }
+};
 
 //! \class WordEngine
 //! \brief Provides error correction (based on Hunspell) and word
@@ -56,19 +93,51 @@ public:
 
     bool auto_correct_enabled;
 
+    bool use_emoji_suggestions;
+    QString emojiIndexFile;
+    LanguageResources languageResources;
+    QScopedPointer<EmojiIndex> emojiIndex;
+
     bool calculated_primary_candidate;
 
     bool clear_candidates_on_incoming;
 
+    bool more_candidates_available;
+
     LanguagePluginInterface* languagePlugin;
 
-    QPluginLoader pluginLoader;
+    //! Loaded engines, the active one first and the least recently used
+    //! one last.
+    QList<LoadedEngine> engines;
+    qint64 memoryBudget;
 
     WordCandidateList* candidates;
 
     Model::Text *currentText;
 
     explicit WordEnginePrivate();
+    ~WordEnginePrivate();
+
+    //! Emoji for word, if emoji suggestions are on and the language has
+    //! an index. The index is only opened on the first lookup.
+    QStringList emojiFor(const QString &word)
+    {
+        if (!use_emoji_suggestions || word.isEmpty() || emojiIndexFile.isEmpty()) {
+            return QStringList();
+        }
+
+        if (!emojiIndex || emojiIndex->fileName() != emojiIndexFile) {
+            if (!QFile::exists(emojiIndexFile)) {
+                emojiIndexFile.clear();
+                return QStringList();
+            }
+            emojiIndex.reset(new EmojiIndex(emojiIndexFile));
+        }
+
+        return emojiIndex->lookup(word, MAX_EMOJI_CANDIDATES,
+                                  word.size() >= MIN_EMOJI_PREFIX_LENGTH ? EmojiIndex::PrefixMatch
+                                                                         : EmojiIndex::ExactMatch);
+    }
 
     QString currentPlugin;
     void loadPlugin(QString pluginPath)
@@ -76,12 +145,7 @@ public:
         if (pluginPath == currentPlugin)
             return;
 
-        delete languagePlugin;
-        pluginLoader.unload();
-
-        // to avoid hickups in libpresage, libpinyin
-        QLocale::setDefault(QLocale::c());
-        setlocale(LC_NUMERIC, "C");
+        StartupTrace::Span span("loadPlugin " + QFileInfo(pluginPath).fileName());
 
         if (pluginPath == DEFAULT_PLUGIN) {
             QString prefix = qgetenv("KEYBOARD_PREFIX_PATH");
@@ -90,28 +154,89 @@ public:
             }
         }
 
-        pluginLoader.setFileName(pluginPath);
-        QObject *plugin = pluginLoader.instance();
+        for (int i = 0; i < engines.size(); ++i) {
+            if (engines.at(i).fileName == pluginPath) {
+                engines.move(i, 0);
+                languagePlugin = engines.first().plugin;
+                currentPlugin = pluginPath;
+                qDebug() << "wordengine.cpp plugin" << pluginPath << "still loaded";
+                return;
+            }
+        }
+
+        // to avoid hickups in libpresage, libpinyin
+        QLocale::setDefault(QLocale::c());
+        setlocale(LC_NUMERIC, "C");
+
+        QPluginLoader *loader = new QPluginLoader(pluginPath);
+        QObject *plugin = loader->instance();
 
         if (plugin) {
-            languagePlugin = qobject_cast<LanguagePluginInterface *>(plugin);
-            if (!languagePlugin) {
+            LanguagePluginInterface *languagePluginInstance = qobject_cast<LanguagePluginInterface *>(plugin);
+            if (!languagePluginInstance) {
                 qCritical() << "wordengine.cpp - loading plugin failed: " + pluginPath;
+                delete plugin;
+                loader->unload();
+                delete loader;
 
                 // fallback
                 if (pluginPath != DEFAULT_PLUGIN)
                     loadPlugin(DEFAULT_PLUGIN);
             } else {
                 qDebug() << "wordengine.cpp plugin" << pluginPath << "loaded";
+                LoadedEngine engine;
+                engine.fileName = pluginPath;
+                engine.loader = loader;
+                engine.plugin = languagePluginInstance;
+                engines.prepend(engine);
+                languagePlugin = languagePluginInstance;
                 currentPlugin = pluginPath;
             }
         } else {
-            qCritical() << __PRETTY_FUNCTION__ << " Loading plugin failed: " << pluginLoader.errorString();
+            qCritical() << __PRETTY_FUNCTION__ << " Loading plugin failed: " << loader->errorString();
+            delete loader;
             // fallback
             if (pluginPath != DEFAULT_PLUGIN)
                 loadPlugin(DEFAULT_PLUGIN);
         }
     }
+
+    void unloadEngine(const LoadedEngine &engine)
+    {
+        qDebug() << "wordengine.cpp unloading plugin" << engine.fileName;
+
+        delete engine.plugin;
+        engine.loader->unload();
+        delete engine.loader;
+    }
+
+    //! Keeps the loaded engines within memoryBudget. Engines that were not
+    //! used for the longest time first give up their caches, then get
+    //! unloaded; they are loaded again once switched to. The active engine
+    //! always stays.
+    void enforceMemoryBudget()
+    {
+        qint64 total = 0;
+        Q_FOREACH(const LoadedEngine &engine, engines) {
+            total += engine.memoryUsage();
+        }
+
+        for (int i = engines.size() - 1; i > 0 && total > memoryBudget; --i) {
+            LoadedEngine &engine(engines[i]);
+            if (!engine.cachesReleased) {
+                const qint64 before = engine.memoryUsage();
+                engine.plugin->releaseCaches();
+                engine.cachesReleased = true;
+                total -= before - engine.memoryUsage();
+            }
+        }
+
+        while (total > memoryBudget && engines.size() > 1) {
+            const LoadedEngine engine(engines.takeLast());
+            total -= engine.memoryUsage();
+            unloadEngine(engine);
+        }
+    }
 };
 
 WordEnginePrivate::WordEnginePrivate()
@@ -120,15 +245,29 @@ WordEnginePrivate::WordEnginePrivate()
     , use_spell_checker(false)
     , is_preedit_capitalized(false)
     , auto_correct_enabled(false)
+    , use_emoji_suggestions(false)
+    , emojiIndexFile()
+    , languageResources()
+    , emojiIndex()
     , calculated_primary_candidate(false)
     , clear_candidates_on_incoming(false)
+    , more_candidates_available(false)
     , languagePlugin(0)
+    , engines()
+    , memoryBudget(qint64(DEFAULT_MEMORY_BUDGET) * 1024 * 1024)
     , currentText(0)
 {
     loadPlugin(DEFAULT_PLUGIN);
     candidates = new WordCandidateList();
 }
 
+WordEnginePrivate::~WordEnginePrivate()
+{
+    while (!engines.isEmpty()) {
+        unloadEngine(engines.takeLast());
+    }
+}
+
 
 //! \brief Constructor.
 //! \param parent The owner of this instance. Can be 0, in case QObject
@@ -172,9 +311,19 @@ void WordEngine::appendToCandidates(WordCandidateList *candidates,
 
     WordCandidate word_candidate(source, changed_candidate);
 
-    if (not candidates->contains(word_candidate)) {
-        candidates->append(word_candidate);
+    if (candidates->contains(word_candidate)) {
+        return;
+    }
+
+    // Keep emoji behind all words, so that they never get to be the
+    // primary candidate.
+    int position = candidates->size();
+    while (source != WordCandidate::SourceEmoji && position > 0
+           && candidates->at(position - 1).source() == WordCandidate::SourceEmoji) {
+        --position;
     }
+
+    candidates->insert(position, word_candidate);
 }
 
 void WordEngine::setWordPredictionEnabled(bool enabled)
@@ -227,6 +376,31 @@ void WordEngine::setAutoCorrectEnabled(bool enabled)
     d->auto_correct_enabled = enabled;
 }
 
+//! \brief WordEngine::setEmojiSuggestionsEnabled turns on/off emoji next to
+//! the word predictions, for languages that ship an emoji index.
+//! \param enabled
+void WordEngine::setEmojiSuggestionsEnabled(bool enabled)
+{
+    Q_D(WordEngine);
+
+    d->use_emoji_suggestions = enabled;
+
+    if (!enabled) {
+        // Nothing is looked up anymore, give the mapping back.
+        d->emojiIndex.reset();
+    }
+}
+
+//! \brief WordEngine::setLanguageResources keeps the files found for the
+//! language that is loaded next, to hand them to its plugin.
+//! \param resources
+void WordEngine::setLanguageResources(const LanguageResources &resources)
+{
+    Q_D(WordEngine);
+
+    d->languageResources = resources;
+}
+
 void WordEngine::onWordCandidateSelected(QString word)
 {
     Q_D(WordEngine);
@@ -262,6 +436,8 @@ void WordEngine::fetchCandidates(Model::Text *text)
 
     Q_EMIT primaryCandidateChanged(QString());
 
+    setMoreCandidatesAvailable(false);
+
     if (d->use_predictive_text) {
         d->languagePlugin->predict(text->surroundingLeft(), preedit);
     }
@@ -322,6 +498,10 @@ void WordEngine::newPredictionSuggestions(QString word, QStringList suggestions)
         appendToCandidates(d->candidates, WordCandidate::SourcePrediction, correction);
     }
 
+    Q_FOREACH(const QString &emoji, d->emojiFor(word)) {
+        appendToCandidates(d->candidates, WordCandidate::SourceEmoji, emoji);
+    }
+
     calculatePrimaryCandidate();
 
     Q_EMIT candidatesChanged(*d->candidates);
@@ -329,6 +509,67 @@ void WordEngine::newPredictionSuggestions(QString word, QStringList suggestions)
     suggestionMutex.unlock();
 }
 
+void WordEngine::morePredictionSuggestions(QString word, QStringList suggestions)
+{
+    Q_D(WordEngine);
+
+    if (d->currentText && word != d->currentText->preedit()) {
+        // Don't add suggestions coming in for a previous word
+        return;
+    }
+
+    suggestionMutex.lock();
+
+    // A later page only extends the candidates of the first page, so drop
+    // it if the first page hasn't arrived for the current request yet.
+    if (!d->clear_candidates_on_incoming) {
+        Q_FOREACH(const QString &correction, suggestions) {
+            appendToCandidates(d->candidates, WordCandidate::SourcePrediction, correction);
+        }
+
+        Q_EMIT candidatesChanged(*d->candidates);
+    }
+
+    suggestionMutex.unlock();
+}
+
+void WordEngine::onMoreCandidatesAvailable(QString word, bool available)
+{
+    Q_D(WordEngine);
+
+    if (d->currentText && word != d->currentText->preedit()) {
+        return;
+    }
+
+    setMoreCandidatesAvailable(available);
+}
+
+void WordEngine::setMoreCandidatesAvailable(bool available)
+{
+    Q_D(WordEngine);
+
+    if (d->more_candidates_available != available) {
+        d->more_candidates_available = available;
+        Q_EMIT moreCandidatesAvailable(available);
+    }
+}
+
+//! \brief Asks the language plugin for the next page of candidates, if
+//! it announced that there are any.
+void WordEngine::fetchMoreCandidates()
+{
+    Q_D(WordEngine);
+
+    if (!d->more_candidates_available || !d->languagePlugin) {
+        return;
+    }
+
+    // Only one page is requested at a time, the plugin announces again
+    // whether more are available along with the page.
+    setMoreCandidatesAvailable(false);
+    d->languagePlugin->fetchMoreCandidates();
+}
+
 void WordEngine::calculatePrimaryCandidate() 
 {
     Q_D(WordEngine);
@@ -355,6 +596,12 @@ void WordEngine::calculatePrimaryCandidate()
         // We don't have any predictions, so the user input is the primary candidate
         WordCandidate primary = d->candidates->value(0);
         Q_EMIT primaryCandidateChanged(primary.word());
+    } else if (d->candidates->at(1).source() == WordCandidate::SourceEmoji) {
+        // Only emoji came in so far, which are never picked automatically,
+        // so the user input is the primary candidate until words arrive.
+        WordCandidate primary = d->candidates->value(0);
+        Q_EMIT primaryCandidateChanged(primary.word());
+        return;
     } else if (d->candidates->at(0).word() == d->candidates->at(1).word()) {
         // The user candidate matches the first prediction; remove the prediction
         // and make the user input the primary candidate so as not to duplicate
@@ -400,23 +647,134 @@ void WordEngine::addToUserDictionary(const QString &word)
     d->languagePlugin->addToSpellCheckerUserWordList(word);
 }
 
+void WordEngine::flushLearning()
+{
+    Q_D(WordEngine);
+
+    // Engines kept loaded in the background may have learned as well.
+    Q_FOREACH(const LoadedEngine &engine, d->engines) {
+        engine.plugin->flushLearning();
+    }
+}
+
+//! \brief WordEngine::setMemoryBudget limits the memory that the loaded
+//! language engines may take together. Engines that were not used for the
+//! longest time are released first.
+//! \param megabytes
+void WordEngine::setMemoryBudget(int megabytes)
+{
+    Q_D(WordEngine);
+
+    d->memoryBudget = qint64(qMax(0, megabytes)) * 1024 * 1024;
+    d->enforceMemoryBudget();
+}
+
+//! \brief WordEngine::releaseCaches drops the current candidates, the
+//! emoji index and the caches of the engines that are not active
+//! The active engine keeps its dictionary, so that typing resumes without
+//! delay.
+void WordEngine::releaseCaches()
+{
+    Q_D(WordEngine);
+
+    d->candidates->clear();
+    Q_EMIT candidatesChanged(*d->candidates);
+    setMoreCandidatesAvailable(false);
+    d->emojiIndex.reset();
+
+    for (int i = 1; i < d->engines.size(); ++i) {
+        LoadedEngine &engine(d->engines[i]);
+        if (!engine.cachesReleased) {
+            engine.plugin->releaseCaches();
+            engine.cachesReleased = true;
+        }
+    }
+}
+
+void WordEngine::releaseInactiveEngines()
+{
+    Q_D(WordEngine);
+
+    while (d->engines.size() > 1) {
+        d->unloadEngine(d->engines.takeLast());
+    }
+}
+
+//! \brief WordEngine::memoryUsage reports the approximate memory taken by
+//! each loaded language engine, for diagnostics
+//! \return bytes by language id, the active language included
+QVariantMap WordEngine::memoryUsage() const
+{
+    Q_D(const WordEngine);
+
+    QVariantMap usage;
+    Q_FOREACH(const LoadedEngine &engine, d->engines) {
+        const QString language(engine.languageId.isEmpty() ? QFileInfo(engine.fileName).fileName()
+                                                           : engine.languageId);
+        usage.insert(language, engine.memoryUsage());
+    }
+
+    return usage;
+}
+
 void WordEngine::onLanguageChanged(const QString &pluginPath, const QString &languageId)
 {
     Q_D(WordEngine);
 
+    // The previous engine may stay loaded, but must not deliver any
+    // candidates anymore.
+    if (d->languagePlugin) {
+        disconnect((AbstractLanguagePlugin *) d->languagePlugin, 0, this, 0);
+    }
+
     d->loadPlugin(pluginPath);
 
+    if (d->engines.isEmpty()) {
+        qCritical() << "wordengine.cpp - no language plugin for" << languageId;
+        return;
+    }
+
     setWordPredictionEnabled(d->requested_prediction_state);
 
-    d->languagePlugin->setLanguage(languageId, QFileInfo(d->currentPlugin).absolutePath());
+    // An engine still set up for the language is ready as it is.
+    LoadedEngine &engine(d->engines.first());
+    if (engine.languageId != languageId || engine.cachesReleased) {
+        StartupTrace::Span span("setLanguage " + languageId);
+        if (d->languageResources.id == languageId) {
+            d->languagePlugin->setLanguageResources(d->languageResources);
+        }
+        d->languagePlugin->setLanguage(languageId, QFileInfo(d->currentPlugin).absolutePath());
+        engine.languageId = languageId;
+        engine.cachesReleased = false;
+    }
+
+    d->enforceMemoryBudget();
+
+    // Emoji indexes are installed along with the emoji plugin, one per
+    // language; the file is only looked at once emoji are asked for.
+    const QString language(languageId.section(QRegExp("[-_@]"), 0, 0));
+    d->emojiIndexFile = QDir::cleanPath(QFileInfo(d->currentPlugin).absolutePath()
+                                        + "/../emoji/emoji_" + language + ".idx");
 
     Q_EMIT enabledChanged(isEnabled());
 
     connect((AbstractLanguagePlugin *) d->languagePlugin, SIGNAL(newSpellingSuggestions(QString, QStringList)), this, SLOT(newSpellingSuggestions(QString, QStringList)));
     connect((AbstractLanguagePlugin *) d->languagePlugin, SIGNAL(newPredictionSuggestions(QString, QStringList)), this, SLOT(newPredictionSuggestions(QString, QStringList)));
+    connect((AbstractLanguagePlugin *) d->languagePlugin, SIGNAL(morePredictionSuggestions(QString, QStringList)), this, SLOT(morePredictionSuggestions(QString, QStringList)));
+    connect((AbstractLanguagePlugin *) d->languagePlugin, SIGNAL(moreCandidatesAvailable(QString, bool)), this, SLOT(onMoreCandidatesAvailable(QString, bool)));
+    connect((AbstractLanguagePlugin *) d->languagePlugin, SIGNAL(loadingPhaseFinished(QString, qint64, qint64)),
+            this, SLOT(onLoadingPhaseFinished(QString, qint64, qint64)), Qt::UniqueConnection);
     Q_EMIT pluginChanged();
 }
 
+//! \brief Records a loading step reported by the language plugin. Plugins
+//! are loaded at runtime and do not share the trace of this library, so
+//! their timings are forwarded here.
+void WordEngine::onLoadingPhaseFinished(QString phase, qint64 startUsecs, qint64 endUsecs)
+{
+    StartupTrace::record(phase, startUsecs, endUsecs, "language plugin");
+}
+
 AbstractLanguageFeatures* WordEngine::languageFeature()
 {
     Q_D(WordEngine);
@@ -432,8 +790,8 @@ bool WordEngine::similarWords(QString word1, QString word2) {
         return true;
     }
 
-    int *v0 = (int *) malloc(sizeof(int) * word1.size() + 1);
-    int *v1 = (int *) malloc(sizeof(int) * word1.size() + 1);
+    int *v0 = (int *) malloc(sizeof(int) * (word1.size() + 1));
+    int *v1 = (int *) malloc(sizeof(int) * (word1.size() + 1));
 
     for (int i = 0; i < word2.size() + 1; i++) {
         v0[i] = i;
@@ -474,6 +832,7 @@ void WordEngine::clearCandidates()
         }
         Q_EMIT candidatesChanged(*d->candidates);
     }
+    setMoreCandidatesAvailable(false);
 }
 
 }} // namespace Logic, MaliitKeyboard
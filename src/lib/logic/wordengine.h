@@ -61,9 +61,16 @@ public:
     virtual void setWordPredictionEnabled(bool enabled);
 
     virtual void addToUserDictionary(const QString &word);
+    virtual void flushLearning();
     virtual void setSpellcheckerEnabled(bool enabled);
     virtual void setAutoCorrectEnabled(bool enabled);
+    virtual void setEmojiSuggestionsEnabled(bool enabled);
+    virtual void setLanguageResources(const LanguageResources &resources);
+    virtual void setMemoryBudget(int megabytes);
+    virtual void releaseCaches();
+    virtual void releaseInactiveEngines();
     virtual void clearCandidates();
+    virtual void fetchMoreCandidates();
     //! \reimp_end
 
     void appendToCandidates(WordCandidateList *candidates,
@@ -75,15 +82,22 @@ public:
     Q_SLOT void updateQmlCandidates(QStringList qmlCandidates);
     Q_SLOT void newSpellingSuggestions(QString word, QStringList suggestions);
     Q_SLOT void newPredictionSuggestions(QString word, QStringList suggestions);
+    Q_SLOT void morePredictionSuggestions(QString word, QStringList suggestions);
+    Q_SLOT void onMoreCandidatesAvailable(QString word, bool available);
+    Q_SLOT void onLoadingPhaseFinished(QString phase, qint64 startUsecs, qint64 endUsecs);
 
     virtual AbstractLanguageFeatures* languageFeature();
 
+    Q_INVOKABLE QVariantMap memoryUsage() const;
+
+    static bool similarWords(QString word1, QString word2);
+
 private:
     //! \reimp
     virtual void fetchCandidates(Model::Text *text);
     //! \reimp_end
     void calculatePrimaryCandidate();
-    bool similarWords(QString word1, QString word2);
+    void setMoreCandidatesAvailable(bool available);
 
     const QScopedPointer<WordEnginePrivate> d_ptr;
 
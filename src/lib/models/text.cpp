@@ -31,6 +31,8 @@
 
 #include "text.h"
 
+#include <algorithm>
+
 //! \class Text
 //! \brief Represents the text state of the editor
 //!
@@ -40,6 +42,63 @@
 namespace MaliitKeyboard {
 namespace Model {
 
+namespace {
+
+// Replaces the boundaries from position from up to old_end by found, and
+// moves the ones after old_end by delta.
+void spliceBoundaries(QVector<int> *boundaries, int from, int old_end,
+                      const QVector<int> &found, int delta)
+{
+    QVector<int>::iterator first = std::lower_bound(boundaries->begin(), boundaries->end(), from);
+    QVector<int>::iterator last = std::upper_bound(first, boundaries->end(), old_end);
+
+    QVector<int> tail;
+    tail.reserve(boundaries->end() - last);
+    for (QVector<int>::const_iterator it = last; it != boundaries->constEnd(); ++it) {
+        tail.append(*it + delta);
+    }
+
+    boundaries->erase(first, boundaries->end());
+    *boundaries += found;
+    *boundaries += tail;
+}
+
+// Returns the last boundary at or before position, 0 if there is none.
+int boundaryBefore(const QVector<int> &boundaries, int position)
+{
+    QVector<int>::const_iterator it = std::upper_bound(boundaries.constBegin(), boundaries.constEnd(), position);
+    return it == boundaries.constBegin() ? 0 : *(it - 1);
+}
+
+int commonPrefixLength(const QString &a, const QString &b)
+{
+    const int length = qMin(a.length(), b.length());
+    const QChar *x = a.constData();
+    const QChar *y = b.constData();
+
+    int i = 0;
+    while (i < length && x[i] == y[i]) {
+        ++i;
+    }
+    return i;
+}
+
+// Leaves out the first skip characters of both, which are known to match.
+int commonSuffixLength(const QString &a, const QString &b, int skip)
+{
+    const int length = qMin(a.length(), b.length()) - skip;
+    const QChar *x = a.constData() + a.length();
+    const QChar *y = b.constData() + b.length();
+
+    int i = 0;
+    while (i < length && x[-i - 1] == y[-i - 1]) {
+        ++i;
+    }
+    return i;
+}
+
+} // unnamed namespace
+
 //! C'tor
 Text::Text()
     : m_preedit()
@@ -48,7 +107,38 @@ Text::Text()
     , m_face(PreeditDefault)
     , m_cursor_position(0)
     , m_restored_preedit(false)
-{}
+    , m_word_starts()
+    , m_sentence_starts()
+    , m_line_starts()
+{
+    updateBoundaries(0, 0, 0);
+}
+
+//! Returns whether \a c ends a line. Carriage returns count as well, as
+//! hosts may send Windows or old Mac line endings.
+bool Text::isLineBreak(const QChar &c)
+{
+    return c == QLatin1Char('\n')
+            || c == QLatin1Char('\r')
+            || c == QChar(QChar::LineSeparator)
+            || c == QChar(QChar::ParagraphSeparator);
+}
+
+//! Returns whether \a c ends a sentence when followed by whitespace.
+bool Text::isSentenceTerminator(const QChar &c)
+{
+    switch (c.unicode()) {
+    case '.':
+    case '!':
+    case '?':
+    case 0x3002: // ideographic full stop
+    case 0xFF01: // fullwidth exclamation mark
+    case 0xFF1F: // fullwidth question mark
+        return true;
+    default:
+        return false;
+    }
+}
 
 //! Returns current preedit.
 QString Text::preedit() const
@@ -109,7 +199,7 @@ void Text::commitPreedit()
     // we would expect the text editor to just update the surrounding text.
     // Raises the question whether we should have commitPreedit here at all,
     // but it does preserve some consistency at least.
-    m_surrounding = m_preedit;
+    setSurrounding(m_preedit);
     m_surrounding_offset = m_preedit.length();
     m_preedit.clear();
     m_primary_candidate.clear();
@@ -137,12 +227,15 @@ QString Text::surrounding() const
 }
 
 //! Returns text left of cursor position. Depends on surroundingOffset.
+//! With the cursor at the end, the usual case while typing, this shares
+//! the surrounding text instead of copying it.
 QString Text::surroundingLeft() const
 {
     return m_surrounding.left(m_surrounding_offset);
 }
 
 //! Returns text right of cursor position. Depends on surroundingOffset.
+//! Use isBlankAfterCursor() to only check for text there without a copy.
 QString Text::surroundingRight() const
 {
     return m_surrounding.mid(m_surrounding_offset);
@@ -152,7 +245,55 @@ QString Text::surroundingRight() const
 //! \param surrounding the updated surrounding text.
 void Text::setSurrounding(const QString &surrounding)
 {
+    if (surrounding.isSharedWith(m_surrounding)) {
+        return;
+    }
+
+    // Boundaries before the first and after the last change stay valid, so
+    // only the edited characters need to be classified again.
+    const int old_length = m_surrounding.length();
+    const int prefix = commonPrefixLength(m_surrounding, surrounding);
+    const int suffix = commonSuffixLength(m_surrounding, surrounding, prefix);
+
     m_surrounding = surrounding;
+    updateBoundaries(prefix, old_length - suffix, surrounding.length() - suffix);
+}
+
+//! Rescans the surrounding text for word, sentence and line boundaries
+//! from position \a from up to \a new_end, which replaced the text up to
+//! \a old_end. Boundaries after it are moved along.
+//!
+//! Whether there is a boundary at a position only depends on the
+//! character there and the one before it.
+void Text::updateBoundaries(int from, int old_end, int new_end)
+{
+    QVector<int> word_starts;
+    QVector<int> sentence_starts;
+    QVector<int> line_starts;
+
+    const QChar *data = m_surrounding.constData();
+    const int length = m_surrounding.length();
+
+    for (int i = from; i <= new_end; ++i) {
+        const QChar previous = i > 0 ? data[i - 1] : QChar(QLatin1Char('\n'));
+        const QChar current = i < length ? data[i] : QChar();
+
+        if (isLineBreak(previous)) {
+            line_starts.append(i);
+            sentence_starts.append(i);
+        } else if (isSentenceTerminator(previous) && current.isSpace()) {
+            sentence_starts.append(i);
+        }
+
+        if (i < length && !current.isSpace() && previous.isSpace()) {
+            word_starts.append(i);
+        }
+    }
+
+    const int delta = new_end - old_end;
+    spliceBoundaries(&m_word_starts, from, old_end, word_starts, delta);
+    spliceBoundaries(&m_sentence_starts, from, old_end, sentence_starts, delta);
+    spliceBoundaries(&m_line_starts, from, old_end, line_starts, delta);
 }
 
 //! Returns offset of cursor position in surrounding text.
@@ -169,6 +310,80 @@ void Text::setSurroundingOffset(uint offset)
     m_surrounding_offset = offset;
 }
 
+//! Returns the character \a distance positions left of the cursor, in
+//! preedit and then surrounding text, or a null character if there is
+//! none.
+QChar Text::charBeforeCursor(int distance /* = 1 */) const
+{
+    if (distance <= 0) {
+        return QChar();
+    }
+
+    const int in_preedit = (m_cursor_position > 0 && m_cursor_position <= m_preedit.length())
+            ? m_cursor_position : 0;
+    if (distance <= in_preedit) {
+        return m_preedit.at(in_preedit - distance);
+    }
+
+    const int offset = qMin<int>(m_surrounding_offset, m_surrounding.length());
+    const int position = offset - (distance - in_preedit);
+    return position >= 0 ? m_surrounding.at(position) : QChar();
+}
+
+//! Returns the non-whitespace characters directly left of the cursor in
+//! surrounding text, ignoring the preedit.
+QString Text::lastWord() const
+{
+    return wordBefore(m_surrounding_offset);
+}
+
+//! Returns the non-whitespace characters directly left of \a position in
+//! surrounding text.
+QString Text::wordBefore(int position) const
+{
+    position = qBound(0, position, m_surrounding.length());
+    if (position == 0 || m_surrounding.at(position - 1).isSpace()) {
+        return QString();
+    }
+
+    const int start = boundaryBefore(m_word_starts, position - 1);
+    return m_surrounding.mid(start, position - start);
+}
+
+//! Returns whether surrounding text right of the cursor is only whitespace,
+//! without copying it like surroundingRight().
+bool Text::isBlankAfterCursor() const
+{
+    for (int i = m_surrounding_offset; i < m_surrounding.length(); ++i) {
+        if (!m_surrounding.at(i).isSpace()) {
+            return false;
+        }
+    }
+    return true;
+}
+
+//! Returns the position in surrounding text where the sentence the cursor
+//! is in starts, ignoring leading whitespace. Equals surroundingOffset()
+//! if a new sentence is about to start.
+int Text::sentenceStart() const
+{
+    const int offset = qMin<int>(m_surrounding_offset, m_surrounding.length());
+
+    int start = boundaryBefore(m_sentence_starts, offset);
+    while (start < offset && m_surrounding.at(start).isSpace()) {
+        ++start;
+    }
+    return start;
+}
+
+//! Returns the position in surrounding text where the line the cursor is
+//! in starts.
+int Text::lineStart() const
+{
+    const int offset = qMin<int>(m_surrounding_offset, m_surrounding.length());
+    return boundaryBefore(m_line_starts, offset);
+}
+
 //! Returns face of preedit.
 Text::PreeditFace Text::preeditFace() const
 {
@@ -56,10 +56,18 @@ private:
     PreeditFace m_face; //!< face of preedit.
     int m_cursor_position; //!< position of cursor in preedit string.
     bool m_restored_preedit; //!< indicates that the preedit has just been restored by the user pressing backspace
+    QVector<int> m_word_starts; //!< positions in surrounding text where a word starts.
+    QVector<int> m_sentence_starts; //!< positions in surrounding text where a sentence may start.
+    QVector<int> m_line_starts; //!< positions in surrounding text where a line starts.
+
+    void updateBoundaries(int from, int old_end, int new_end);
 
 public:
     explicit Text();
 
+    static bool isLineBreak(const QChar &c);
+    static bool isSentenceTerminator(const QChar &c);
+
     QString preedit() const;
     void setPreedit(const QString &preedit,
                     int cursor_pos_override = -1);
@@ -78,6 +86,13 @@ public:
     uint surroundingOffset() const;
     void setSurroundingOffset(uint offset);
 
+    QChar charBeforeCursor(int distance = 1) const;
+    QString lastWord() const;
+    QString wordBefore(int position) const;
+    bool isBlankAfterCursor() const;
+    int sentenceStart() const;
+    int lineStart() const;
+
     PreeditFace preeditFace() const;
     void setPreeditFace(PreeditFace face);
 
@@ -45,7 +45,8 @@ public:
         SourceUnknown,
         SourceSpellChecking,
         SourcePrediction,
-        SourceUser // Candidate based on current preedit word for adding to the user dictionary
+        SourceUser, // Candidate based on current preedit word for adding to the user dictionary
+        SourceEmoji // Emoji for the preedit word, always listed after the other candidates
     };
 
 private:
@@ -39,6 +39,7 @@ WordRibbon::WordRibbon(QObject* parent)
     , m_origin()
     , m_area()
     , m_enabled(false)
+    , m_moreCandidatesAvailable(false)
 {
     m_roles.insert(WordRole, "word");
     m_roles.insert(IsUserInputRole, "isUserInput");
@@ -150,6 +151,37 @@ QHash<int, QByteArray> WordRibbon::roleNames() const
     return m_roles;
 }
 
+//! \brief Whether the word engine can extend the candidate list, used by
+//! the QML view to pull the next page once it is scrolled to the end.
+bool WordRibbon::canFetchMore(const QModelIndex &parent) const
+{
+    Q_UNUSED(parent);
+    return m_moreCandidatesAvailable;
+}
+
+void WordRibbon::fetchMore(const QModelIndex &parent)
+{
+    Q_UNUSED(parent);
+
+    if (m_moreCandidatesAvailable) {
+        setMoreCandidatesAvailable(false);
+        Q_EMIT moreCandidatesRequested();
+    }
+}
+
+bool WordRibbon::moreCandidatesAvailable() const
+{
+    return m_moreCandidatesAvailable;
+}
+
+void WordRibbon::setMoreCandidatesAvailable(bool available)
+{
+    if (m_moreCandidatesAvailable != available) {
+        m_moreCandidatesAvailable = available;
+        Q_EMIT moreCandidatesAvailableChanged(m_moreCandidatesAvailable);
+    }
+}
+
 bool WordRibbon::enabled() const
 {
     return m_enabled;
@@ -169,7 +201,8 @@ void WordRibbon::onWordCandidatePressed(const WordCandidate &candidate)
 void WordRibbon::onWordCandidateReleased(const WordCandidate &candidate)
 {
     if (candidate.source() == WordCandidate::SourcePrediction
-        || candidate.source() == WordCandidate::SourceSpellChecking) {
+        || candidate.source() == WordCandidate::SourceSpellChecking
+        || candidate.source() == WordCandidate::SourceEmoji) {
         Q_EMIT wordCandidateSelected(candidate.word());
     } else if (candidate.source() == WordCandidate::SourceUser) {
         Q_EMIT userCandidateSelected(candidate.word());
@@ -179,11 +212,25 @@ void WordRibbon::onWordCandidateReleased(const WordCandidate &candidate)
 
 void WordRibbon::onWordCandidatesChanged(const WordCandidateList &candidates)
 {
-    clearCandidates();
+    // A further page of candidates only extends the current list, in which
+    // case the new rows are appended without resetting the view.
+    int index = 0;
+    bool extendsCurrent = !m_candidates.isEmpty() && candidates.count() > m_candidates.count();
+    for (; extendsCurrent && index < m_candidates.count(); ++index) {
+        extendsCurrent = m_candidates.at(index) == candidates.at(index);
+    }
+
+    if (!extendsCurrent) {
+        clearCandidates();
+        index = 0;
+    }
 
-    for (int index = 0; index < candidates.count(); ++index) {
-        WordCandidate word_candidate(candidates.at(index));
-        appendCandidate(word_candidate);
+    if (index < candidates.count()) {
+        beginInsertRows(QModelIndex(), index, candidates.count() - 1);
+        for (; index < candidates.count(); ++index) {
+            m_candidates.append(candidates.at(index));
+        }
+        endInsertRows();
     }
 }
 
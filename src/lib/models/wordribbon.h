@@ -52,6 +52,7 @@ class WordRibbon : public QAbstractListModel
     Area m_area;
     QHash<int, QByteArray> m_roles;
     bool m_enabled;
+    bool m_moreCandidatesAvailable;
 
 public:
     explicit WordRibbon(QObject* parent = 0);
@@ -65,6 +66,8 @@ public:
     virtual QVariant data(const QModelIndex &index, int role) const;
     virtual int rowCount(const QModelIndex &parent = QModelIndex()) const;
     virtual QHash<int, QByteArray> roleNames() const;
+    virtual bool canFetchMore(const QModelIndex &parent) const;
+    virtual void fetchMore(const QModelIndex &parent);
 
     bool valid() const;
     QRect rect() const;
@@ -98,8 +101,17 @@ public:
 
     Q_SLOT void setWordRibbonVisible(bool visible);
 
+    Q_PROPERTY(bool moreCandidatesAvailable
+               READ moreCandidatesAvailable
+               WRITE setMoreCandidatesAvailable
+               NOTIFY moreCandidatesAvailableChanged)
+    bool moreCandidatesAvailable() const;
+    Q_SLOT void setMoreCandidatesAvailable(bool available);
+    Q_SIGNAL void moreCandidatesRequested();
+
 Q_SIGNALS:
     void enabledChanged(bool enabled);
+    void moreCandidatesAvailableChanged(bool available);
 };
 
 bool operator==(const WordRibbon &lhs,
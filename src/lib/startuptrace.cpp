@@ -0,0 +1,271 @@
+/*
+ * Copyright (C) 2016 Canonical, Ltd.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this list
+ * of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice, this list
+ * of conditions and the following disclaimer in the documentation and/or other materials
+ * provided with the distribution.
+ * Neither the name of Nokia Corporation nor the names of its contributors may be
+ * used to endorse or promote products derived from this software without specific
+ * prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL
+ * THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#include "startuptrace.h"
+
+#include <QAtomicInt>
+#include <QCoreApplication>
+#include <QDebug>
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QMutex>
+#include <QThread>
+#include <QThreadStorage>
+#include <QVector>
+
+#include <algorithm>
+
+namespace MaliitKeyboard {
+namespace StartupTrace {
+namespace {
+
+//! Set to a file name to get the startup phases as a Chrome trace
+//! (chrome://tracing, Perfetto).
+const char *const g_trace_file_env = "UBUNTU_KEYBOARD_STARTUP_TRACE";
+
+struct Event
+{
+    Event()
+        : name()
+        , thread()
+        , start(0)
+        , end(0)
+        , depth(0)
+    {}
+
+    Event(const QString &e_name, const QString &e_thread,
+          qint64 e_start, qint64 e_end, int e_depth)
+        : name(e_name)
+        , thread(e_thread)
+        , start(e_start)
+        , end(e_end)
+        , depth(e_depth)
+    {}
+
+    //! Spans are recorded when they end; this orders them as they started,
+    //! enclosing ones first.
+    bool operator<(const Event &other) const
+    {
+        return start < other.start || (start == other.start && depth < other.depth);
+    }
+
+    QString name;
+    QString thread;
+    qint64 start;
+    qint64 end;
+    int depth;
+};
+
+struct Trace
+{
+    Trace()
+        : mutex()
+        , events()
+        , finished(0)
+        , finished_at(0)
+    {}
+
+    QMutex mutex;
+    QVector<Event> events;
+    //! Nesting of the spans open in each thread.
+    QThreadStorage<int> depth;
+    //! Set by finish(), after which only phases recorded for work that
+    //! began before it are kept.
+    QAtomicInt finished;
+    qint64 finished_at;
+};
+
+Trace *trace()
+{
+    static Trace instance;
+    return &instance;
+}
+
+QString currentThreadName()
+{
+    if (QCoreApplication::instance()
+        && QThread::currentThread() == QCoreApplication::instance()->thread()) {
+        return QString::fromLatin1("main");
+    }
+
+    return QString::number(quintptr(QThread::currentThreadId()));
+}
+
+void writeChromeTrace(const QString &file_name, const QVector<Event> &events)
+{
+    QJsonArray trace_events;
+    const qint64 pid = QCoreApplication::applicationPid();
+
+    Q_FOREACH (const Event &event, events) {
+        QJsonObject trace_event;
+        trace_event.insert("name", event.name);
+        trace_event.insert("cat", QString::fromLatin1("startup"));
+        trace_event.insert("ph", QString::fromLatin1("X"));
+        trace_event.insert("ts", double(event.start));
+        trace_event.insert("dur", double(event.end - event.start));
+        trace_event.insert("pid", double(pid));
+        trace_event.insert("tid", event.thread);
+        trace_events.append(trace_event);
+    }
+
+    QJsonObject root;
+    root.insert("traceEvents", trace_events);
+    root.insert("displayTimeUnit", QString::fromLatin1("ms"));
+
+    QFile file(file_name);
+    if (not file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        qWarning() << __PRETTY_FUNCTION__
+                   << "Cannot write startup trace to" << file_name << file.errorString();
+        return;
+    }
+    file.write(QJsonDocument(root).toJson(QJsonDocument::Compact));
+}
+
+void writeTraceFile(QVector<Event> events)
+{
+    const QString file_name = QString::fromLocal8Bit(qgetenv(g_trace_file_env));
+    if (file_name.isEmpty()) {
+        return;
+    }
+
+    std::stable_sort(events.begin(), events.end());
+    writeChromeTrace(file_name, events);
+}
+
+} // unnamed namespace
+
+// Spans opened after finish() are not recorded and have no start.
+Span::Span(const char *name)
+    : m_name(QString::fromLatin1(name))
+    , m_start(trace()->finished.load() ? -1 : now())
+{
+    if (m_start >= 0) {
+        ++trace()->depth.localData();
+    }
+}
+
+Span::Span(const QString &name)
+    : m_name(name)
+    , m_start(trace()->finished.load() ? -1 : now())
+{
+    if (m_start >= 0) {
+        ++trace()->depth.localData();
+    }
+}
+
+Span::~Span()
+{
+    if (m_start < 0) {
+        return;
+    }
+
+    const qint64 end = now();
+    Trace *const t = trace();
+    const int depth = --t->depth.localData();
+
+    if (not t->finished.load()) {
+        QMutexLocker locker(&t->mutex);
+        t->events.append(Event(m_name, currentThreadName(), m_start, end, depth));
+    }
+}
+
+//! \brief Records a startup phase measured elsewhere, with times taken
+//! from now(). Phases that began before finish() but are reported after
+//! it, like dictionaries loaded in the background, are still recorded:
+//! they are logged on their own and the trace file is written again.
+void record(const QString &name, qint64 start_usecs, qint64 end_usecs,
+            const QString &thread)
+{
+    Trace *const t = trace();
+    const Event event(name, thread.isEmpty() ? currentThreadName() : thread,
+                      start_usecs, end_usecs, 0);
+    QVector<Event> events;
+
+    {
+        QMutexLocker locker(&t->mutex);
+
+        if (t->finished.load() && start_usecs >= t->finished_at) {
+            return;
+        }
+
+        t->events.append(event);
+        if (not t->finished.load()) {
+            return;
+        }
+        events = t->events;
+    }
+
+    qDebug().nospace() << "Startup phase finished after show: "
+                       << name.toUtf8().constData() << ": "
+                       << (end_usecs - start_usecs) / 1000.0 << " ms (in background)";
+    writeTraceFile(events);
+}
+
+//! \brief Ends startup: logs a summary of the recorded phases and, if
+//! UBUNTU_KEYBOARD_STARTUP_TRACE is set, writes them to that file as a
+//! Chrome trace. Only the first call has an effect.
+void finish()
+{
+    QVector<Event> events;
+    {
+        Trace *const t = trace();
+        QMutexLocker locker(&t->mutex);
+
+        if (not t->finished.testAndSetOrdered(0, 1)) {
+            return;
+        }
+
+        t->finished_at = now();
+        events = t->events;
+    }
+
+    if (events.isEmpty()) {
+        return;
+    }
+    std::stable_sort(events.begin(), events.end());
+
+    qint64 first = events.first().start;
+    qint64 last = events.first().end;
+    Q_FOREACH (const Event &event, events) {
+        first = qMin(first, event.start);
+        last = qMax(last, event.end);
+    }
+
+    qDebug() << "Startup took" << (last - first) / 1000.0 << "ms:";
+    Q_FOREACH (const Event &event, events) {
+        qDebug().nospace() << "  " << QString(event.depth * 2, QLatin1Char(' ')).toLatin1().constData()
+                           << event.name.toUtf8().constData() << ": "
+                           << (event.end - event.start) / 1000.0 << " ms"
+                           << (event.thread == QLatin1String("main") ? "" : " (in background)");
+    }
+
+    writeTraceFile(events);
+}
+
+}} // namespace StartupTrace, MaliitKeyboard
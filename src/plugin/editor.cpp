@@ -38,12 +38,25 @@
 
 namespace MaliitKeyboard {
 
+//! \class Editor
+//! Text editor talking to a Maliit host. Host operations caused by one
+//! input event are collected in a transaction and sent when it ends, with
+//! redundant ones dropped:
+//! - a preedit is dropped if another preedit or a commit follows, as both
+//!   replace it (unless it also deletes surrounding text, in which case
+//!   the deletion moves to the following preedit),
+//! - adjacent commits are sent as one.
+//! Key events and actions are never merged, and nothing is reordered.
+
 Editor::Editor(const EditorOptions &options,
                Model::Text *text,
                Logic::AbstractWordEngine *word_engine,
                QObject *parent)
     : AbstractTextEditor(options, text, word_engine, parent)
     , m_host(0)
+    , m_pending_operations()
+    , m_transaction_depth(0)
+    , m_last_transaction_message_count(0)
 {}
 
 Editor::~Editor()
@@ -54,59 +67,145 @@ void Editor::setHost(MAbstractInputMethodHost *host)
     m_host = host;
 }
 
+//! \brief Returns how many messages were sent to the host for the last
+//! input event.
+int Editor::lastTransactionMessageCount() const
+{
+    return m_last_transaction_message_count;
+}
+
 void Editor::sendPreeditString(const QString &preedit,
                                Model::Text::PreeditFace face,
                                const Replacement &replacement)
 {
-    if (not m_host) {
-        qWarning() << __PRETTY_FUNCTION__
-                   << "Host not set, ignoring.";
-        return;
-    }
+    HostOperation operation(HostOperation::Preedit);
+    operation.text = preedit;
+    operation.face = face;
+    operation.replacement = replacement;
+    enqueue(operation);
+}
 
-    QList<Maliit::PreeditTextFormat> format_list;
-    const int start (0);
-    const int length (preedit.length());
+void Editor::sendCommitString(const QString &commit)
+{
+    HostOperation operation(HostOperation::Commit);
+    operation.text = commit;
+    enqueue(operation);
+}
 
-    format_list.append(Maliit::PreeditTextFormat(start,
-                                                 length,
-                                                 static_cast< ::Maliit::PreeditFace>(face)));
+void Editor::sendKeyEvent(const QKeyEvent &ev)
+{
+    HostOperation operation(HostOperation::KeyEvent);
+    operation.event_type = ev.type();
+    operation.key = ev.key();
+    operation.modifiers = ev.modifiers();
+    operation.text = ev.text();
+    operation.auto_repeat = ev.isAutoRepeat();
+    operation.count = ev.count();
+    enqueue(operation);
+}
 
-    m_host->sendPreeditString(preedit, format_list, replacement.start,
-                              replacement.length, replacement.cursor_position);
+void Editor::invokeAction(const QString &action, const QKeySequence &sequence)
+{
+    HostOperation operation(HostOperation::Action);
+    operation.text = action;
+    operation.sequence = sequence;
+    enqueue(operation);
 }
 
-void Editor::sendCommitString(const QString &commit)
+void Editor::beginHostTransaction()
 {
-    if (not m_host) {
-        qWarning() << __PRETTY_FUNCTION__
-                   << "Host not set, ignoring.";
+    ++m_transaction_depth;
+}
+
+void Editor::endHostTransaction()
+{
+    if (m_transaction_depth == 0 || --m_transaction_depth > 0) {
         return;
     }
 
-    m_host->sendCommitString(commit);
+    const QList<HostOperation> operations(m_pending_operations);
+    m_pending_operations.clear();
+
+    Q_FOREACH (const HostOperation &operation, operations) {
+        send(operation);
+    }
+    m_last_transaction_message_count = operations.count();
 }
 
-void Editor::sendKeyEvent(const QKeyEvent &ev)
+void Editor::enqueue(const HostOperation &operation)
 {
-    if (not m_host) {
-        qWarning() << __PRETTY_FUNCTION__
-                     << "Host not set, ignoring.";
+    if (m_transaction_depth == 0) {
+        send(operation);
         return;
     }
 
-    m_host->sendKeyEvent(ev);
+    if (not m_pending_operations.isEmpty()) {
+        HostOperation &last(m_pending_operations.last());
+        const bool last_replaces_text(last.replacement.start != 0 || last.replacement.length != 0);
+
+        if (operation.type == HostOperation::Preedit && last.type == HostOperation::Preedit) {
+            const bool replaces_text(operation.replacement.start != 0 || operation.replacement.length != 0);
+
+            if (not last_replaces_text) {
+                last = operation;
+                return;
+            } else if (not replaces_text) {
+                const Replacement replacement(last.replacement.start,
+                                              last.replacement.length,
+                                              operation.replacement.cursor_position);
+                last = operation;
+                last.replacement = replacement;
+                return;
+            }
+        } else if (operation.type == HostOperation::Commit) {
+            if (last.type == HostOperation::Commit) {
+                last.text.append(operation.text);
+                return;
+            } else if (last.type == HostOperation::Preedit && not last_replaces_text) {
+                last = operation;
+                return;
+            }
+        }
+    }
+
+    m_pending_operations.append(operation);
 }
 
-void Editor::invokeAction(const QString &action, const QKeySequence &sequence)
+void Editor::send(const HostOperation &operation)
 {
     if (not m_host) {
         qWarning() << __PRETTY_FUNCTION__
-                     << "Host not set, ignoring.";
+                   << "Host not set, ignoring.";
         return;
     }
 
-    m_host->invokeAction(action, sequence);
+    switch (operation.type) {
+    case HostOperation::Preedit: {
+        QList<Maliit::PreeditTextFormat> format_list;
+        const int start (0);
+        const int length (operation.text.length());
+
+        format_list.append(Maliit::PreeditTextFormat(start,
+                                                     length,
+                                                     static_cast< ::Maliit::PreeditFace>(operation.face)));
+
+        m_host->sendPreeditString(operation.text, format_list, operation.replacement.start,
+                                  operation.replacement.length, operation.replacement.cursor_position);
+    } break;
+
+    case HostOperation::Commit:
+        m_host->sendCommitString(operation.text);
+        break;
+
+    case HostOperation::KeyEvent:
+        m_host->sendKeyEvent(QKeyEvent(operation.event_type, operation.key, operation.modifiers,
+                                       operation.text, operation.auto_repeat, operation.count));
+        break;
+
+    case HostOperation::Action:
+        m_host->invokeAction(operation.text, operation.sequence);
+        break;
+    }
 }
 
 } // namespace MaliitKeyboard
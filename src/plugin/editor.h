@@ -38,6 +38,7 @@
 
 #include <maliit/plugins/abstractinputmethodhost.h>
 #include <QtCore>
+#include <QtGui/QKeySequence>
 
 namespace MaliitKeyboard {
 
@@ -48,7 +49,44 @@ class Editor
     Q_DISABLE_COPY(Editor)
 
 private:
+    struct HostOperation
+    {
+        enum Type {
+            Preedit,
+            Commit,
+            KeyEvent,
+            Action
+        };
+
+        HostOperation(Type o_type)
+            : type(o_type)
+            , text()
+            , face(Model::Text::PreeditDefault)
+            , replacement()
+            , event_type(QEvent::None)
+            , key(0)
+            , modifiers(Qt::NoModifier)
+            , auto_repeat(false)
+            , count(1)
+            , sequence()
+        {}
+
+        Type type;
+        QString text;
+        Model::Text::PreeditFace face;
+        Replacement replacement;
+        QEvent::Type event_type;
+        int key;
+        Qt::KeyboardModifiers modifiers;
+        bool auto_repeat;
+        int count;
+        QKeySequence sequence;
+    };
+
     MAbstractInputMethodHost *m_host;
+    QList<HostOperation> m_pending_operations;
+    int m_transaction_depth;
+    int m_last_transaction_message_count;
 
 public:
     explicit Editor(const EditorOptions &options,
@@ -58,6 +96,7 @@ public:
     virtual ~Editor();
 
     void setHost(MAbstractInputMethodHost *host);
+    int lastTransactionMessageCount() const;
 
 private:
     //! \reimp
@@ -67,7 +106,12 @@ private:
     virtual void sendCommitString(const QString &commit);
     virtual void sendKeyEvent(const QKeyEvent &ev);
     virtual void invokeAction(const QString &command, const QKeySequence &sequence);
+    virtual void beginHostTransaction();
+    virtual void endHostTransaction();
     //! \reimp_end
+
+    void enqueue(const HostOperation &operation);
+    void send(const HostOperation &operation);
 };
 
 } // namespace MaliitKeyboard
@@ -0,0 +1,265 @@
+/*
+ * Copyright (C) 2016 Canonical, Ltd.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this list
+ * of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice, this list
+ * of conditions and the following disclaimer in the documentation and/or other materials
+ * provided with the distribution.
+ * Neither the name of Nokia Corporation nor the names of its contributors may be
+ * used to endorse or promote products derived from this software without specific
+ * prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL
+ * THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#include "glyphatlas.h"
+
+#include <QFontMetricsF>
+#include <QPainter>
+#include <QStringList>
+#include <qmath.h>
+
+namespace {
+
+// Grows to fit labels that are wider on their own
+const int MinAtlasWidth = 512;
+// Keeps linear filtering from bleeding into neighbouring entries
+const int Padding = 2;
+
+typedef QHash<QString, QWeakPointer<GlyphAtlas> > AtlasCache;
+
+AtlasCache &atlasCache()
+{
+    static AtlasCache cache;
+    return cache;
+}
+
+struct Entry
+{
+    Entry()
+        : key()
+        , text()
+        , font()
+        , ascent(0)
+        , rect()
+    {}
+
+    QString key;
+    QString text;
+    QFont font;
+    qreal ascent;
+    QRect rect;
+};
+
+bool tallerThan(const Entry &left, const Entry &right)
+{
+    return left.rect.height() > right.rect.height();
+}
+
+} // unnamed namespace
+
+GlyphAtlas::Glyph::Glyph()
+    : texCoords()
+    , size()
+    , color(false)
+{}
+
+GlyphAtlas::GlyphAtlas()
+    : m_image()
+    , m_glyphs()
+    , m_frame()
+    , m_radius(0)
+{}
+
+//! \brief GlyphAtlas::get returns the atlas for the given labels, building
+//! it if no other keypad uses it yet
+//! \param labels keys built with labelKey()
+QSharedPointer<GlyphAtlas> GlyphAtlas::get(const QFont &font,
+                                           qreal radius,
+                                           qreal devicePixelRatio,
+                                           const QSet<QString> &labels)
+{
+    QStringList sorted(labels.toList());
+    sorted.sort();
+
+    const QString key(QString("%1|%2|%3|%4|%5\n%6")
+                      .arg(font.family())
+                      .arg(font.weight())
+                      .arg(font.italic())
+                      .arg(radius)
+                      .arg(devicePixelRatio)
+                      .arg(sorted.join("\n")));
+
+    AtlasCache &cache(atlasCache());
+
+    for (AtlasCache::iterator it = cache.begin(); it != cache.end();) {
+        if (it.value().isNull()) {
+            it = cache.erase(it);
+        } else {
+            ++it;
+        }
+    }
+
+    QSharedPointer<GlyphAtlas> atlas(cache.value(key).toStrongRef());
+    if (!atlas) {
+        atlas = QSharedPointer<GlyphAtlas>(new GlyphAtlas);
+        atlas->build(font, radius, devicePixelRatio, labels);
+        cache.insert(key, atlas.toWeakRef());
+    }
+
+    return atlas;
+}
+
+//! \brief GlyphAtlas::labelKey identifies \a text rendered at \a pixelSize
+QString GlyphAtlas::labelKey(const QString &text, int pixelSize)
+{
+    return QString::number(pixelSize) + QLatin1Char(' ') + text;
+}
+
+//! \brief GlyphAtlas::hasColors returns whether the pixels of \a rect in
+//! \a image are not all gray. Labels are drawn in white, so only color
+//! glyphs have differing channels.
+bool GlyphAtlas::hasColors(const QImage &image, const QRect &rect)
+{
+    const QRect bounded(rect & image.rect());
+
+    for (int y = bounded.top(); y <= bounded.bottom(); ++y) {
+        const QRgb *line = reinterpret_cast<const QRgb *>(image.constScanLine(y));
+        for (int x = bounded.left(); x <= bounded.right(); ++x) {
+            const QRgb pixel = line[x];
+            if (qRed(pixel) != qGreen(pixel) || qGreen(pixel) != qBlue(pixel))
+                return true;
+        }
+    }
+
+    return false;
+}
+
+const QImage &GlyphAtlas::image() const
+{
+    return m_image;
+}
+
+//! \brief GlyphAtlas::glyph returns the entry of a label, an empty glyph if
+//! it is not part of the atlas
+GlyphAtlas::Glyph GlyphAtlas::glyph(const QString &labelKey) const
+{
+    return m_glyphs.value(labelKey);
+}
+
+const GlyphAtlas::Glyph &GlyphAtlas::frame() const
+{
+    return m_frame;
+}
+
+qreal GlyphAtlas::radius() const
+{
+    return m_radius;
+}
+
+void GlyphAtlas::build(const QFont &font, qreal radius, qreal devicePixelRatio,
+                       const QSet<QString> &labels)
+{
+    m_radius = radius;
+
+    // The frame is two corners and a single texel to stretch in between
+    const int frameRadius = qCeil(radius * devicePixelRatio);
+    Entry frame;
+    frame.rect.setSize(QSize(2 * frameRadius + 1, 2 * frameRadius + 1));
+
+    QList<Entry> entries;
+    Q_FOREACH (const QString &label, labels) {
+        const int separator = label.indexOf(QLatin1Char(' '));
+        const int pixelSize = label.left(separator).toInt();
+
+        Entry entry;
+        entry.key = label;
+        entry.text = label.mid(separator + 1);
+        entry.font = font;
+        entry.font.setPixelSize(qMax(1, qRound(pixelSize * devicePixelRatio)));
+
+        const QFontMetricsF metrics(entry.font);
+        entry.ascent = metrics.ascent();
+        // One pixel on each side for glyphs overhanging their advance
+        entry.rect.setSize(QSize(qCeil(metrics.width(entry.text)) + 2,
+                                 qCeil(metrics.height())));
+        entries.append(entry);
+    }
+
+    qSort(entries.begin(), entries.end(), tallerThan);
+    entries.prepend(frame);
+
+    int atlasWidth = MinAtlasWidth;
+    for (int index = 0; index < entries.count(); ++index) {
+        atlasWidth = qMax(atlasWidth, entries.at(index).rect.width() + 2 * Padding);
+    }
+
+    // Shelf packing, tallest entries first
+    int x = Padding;
+    int y = Padding;
+    int shelfHeight = 0;
+    for (int index = 0; index < entries.count(); ++index) {
+        QRect &rect(entries[index].rect);
+
+        if (x + rect.width() + Padding > atlasWidth && x > Padding) {
+            x = Padding;
+            y += shelfHeight + Padding;
+            shelfHeight = 0;
+        }
+
+        rect.moveTo(x, y);
+        x += rect.width() + Padding;
+        shelfHeight = qMax(shelfHeight, rect.height());
+    }
+
+    m_image = QImage(atlasWidth, y + shelfHeight + Padding, QImage::Format_ARGB32_Premultiplied);
+    m_image.fill(Qt::transparent);
+
+    const qreal width = m_image.width();
+    const qreal height = m_image.height();
+
+    QPainter painter(&m_image);
+    painter.setRenderHints(QPainter::Antialiasing | QPainter::TextAntialiasing);
+
+    for (int index = 0; index < entries.count(); ++index) {
+        const Entry &entry(entries.at(index));
+
+        Glyph glyph;
+        glyph.texCoords = QRectF(entry.rect.x() / width, entry.rect.y() / height,
+                                 entry.rect.width() / width, entry.rect.height() / height);
+        glyph.size = QSizeF(entry.rect.size()) / devicePixelRatio;
+
+        if (index == 0) {
+            painter.setPen(Qt::NoPen);
+            painter.setBrush(Qt::white);
+            painter.drawRoundedRect(entry.rect, frameRadius, frameRadius);
+            m_frame = glyph;
+        } else {
+            painter.setPen(Qt::white);
+            painter.setFont(entry.font);
+            painter.drawText(QPointF(entry.rect.x() + 1, entry.rect.y() + entry.ascent), entry.text);
+            m_glyphs.insert(entry.key, glyph);
+        }
+    }
+
+    painter.end();
+
+    for (int index = 1; index < entries.count(); ++index) {
+        const Entry &entry(entries.at(index));
+        if (hasColors(m_image, entry.rect))
+            m_glyphs[entry.key].color = true;
+    }
+}
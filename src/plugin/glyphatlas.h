@@ -0,0 +1,87 @@
+/*
+ * Copyright (C) 2016 Canonical, Ltd.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this list
+ * of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice, this list
+ * of conditions and the following disclaimer in the documentation and/or other materials
+ * provided with the distribution.
+ * Neither the name of Nokia Corporation nor the names of its contributors may be
+ * used to endorse or promote products derived from this software without specific
+ * prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL
+ * THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#ifndef GLYPHATLAS_H
+#define GLYPHATLAS_H
+
+#include <QFont>
+#include <QHash>
+#include <QImage>
+#include <QRectF>
+#include <QSet>
+#include <QSharedPointer>
+#include <QString>
+
+//! \brief The GlyphAtlas class holds the pre-rendered labels of a keypad
+//!
+//! Every label is rendered once, in white unless its font brings its own
+//! colors, at the pixel size it is shown at. Besides the labels the atlas
+//! holds a rounded rectangle that key backgrounds are stretched from.
+//! Atlases are shared between all users asking for the same font, labels
+//! and device pixel ratio.
+class GlyphAtlas
+{
+public:
+    struct Glyph
+    {
+        Glyph();
+
+        //! Normalized texture coordinates
+        QRectF texCoords;
+        //! Size in logical pixels
+        QSizeF size;
+        //! Whether the label has colors of its own, like an emoji, and must
+        //! not be tinted
+        bool color;
+    };
+
+    static QSharedPointer<GlyphAtlas> get(const QFont &font,
+                                          qreal radius,
+                                          qreal devicePixelRatio,
+                                          const QSet<QString> &labels);
+    static QString labelKey(const QString &text, int pixelSize);
+    static bool hasColors(const QImage &image, const QRect &rect);
+
+    const QImage &image() const;
+    Glyph glyph(const QString &labelKey) const;
+
+    //! The rounded rectangle, its corners are radius() pixels wide
+    const Glyph &frame() const;
+    qreal radius() const;
+
+private:
+    GlyphAtlas();
+    void build(const QFont &font, qreal radius, qreal devicePixelRatio,
+               const QSet<QString> &labels);
+
+    QImage m_image;
+    QHash<QString, Glyph> m_glyphs;
+    Glyph m_frame;
+    qreal m_radius;
+};
+
+#endif // GLYPHATLAS_H
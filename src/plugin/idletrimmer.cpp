@@ -0,0 +1,206 @@
+/*
+ * Copyright (C) 2016 Canonical, Ltd.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this list
+ * of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice, this list
+ * of conditions and the following disclaimer in the documentation and/or other materials
+ * provided with the distribution.
+ * Neither the name of Nokia Corporation nor the names of its contributors may be
+ * used to endorse or promote products derived from this software without specific
+ * prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL
+ * THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#include "idletrimmer.h"
+
+#include <QDebug>
+#include <QFile>
+
+#ifdef __GLIBC__
+#include <malloc.h>
+#endif
+
+// Hidden time before rebuildable caches are dropped, in ms.
+#define DEFAULT_CACHE_DELAY (30 * 1000)
+// Hidden time before engines and keypads are released, in ms.
+#define DEFAULT_ENGINE_DELAY (5 * 60 * 1000)
+
+namespace {
+
+qint64 residentKb()
+{
+    QFile status("/proc/self/status");
+    if (!status.open(QIODevice::ReadOnly | QIODevice::Text)) {
+        return 0;
+    }
+
+    Q_FOREACH(const QByteArray &line, status.readAll().split('\n')) {
+        if (line.startsWith("VmRSS:")) {
+            return line.mid(6).trimmed().split(' ').first().toLongLong();
+        }
+    }
+
+    return 0;
+}
+
+} // unnamed namespace
+
+IdleTrimmer::StageMetrics::StageMetrics()
+    : runs(0)
+    , lastMsecs(-1)
+    , lastFreedKb(0)
+{}
+
+IdleTrimmer::IdleTrimmer(QObject *parent)
+    : QObject(parent)
+    , m_cacheDelay(DEFAULT_CACHE_DELAY)
+    , m_engineDelay(DEFAULT_ENGINE_DELAY)
+    , m_stage(NoStage)
+    , m_timer()
+    , m_cacheMetrics()
+    , m_engineMetrics()
+    , m_warmUp()
+    , m_warmUpStage(NoStage)
+    , m_lastWarmUpMsecs(-1)
+    , m_lastWarmUpStage(NoStage)
+{
+    m_timer.setSingleShot(true);
+    connect(&m_timer, SIGNAL(timeout()), this, SLOT(onTimeout()));
+}
+
+IdleTrimmer::~IdleTrimmer()
+{}
+
+int IdleTrimmer::cacheDelay() const
+{
+    return m_cacheDelay;
+}
+
+void IdleTrimmer::setCacheDelay(int msecs)
+{
+    m_cacheDelay = msecs;
+}
+
+int IdleTrimmer::engineDelay() const
+{
+    return m_engineDelay;
+}
+
+void IdleTrimmer::setEngineDelay(int msecs)
+{
+    m_engineDelay = msecs;
+}
+
+IdleTrimmer::Stage IdleTrimmer::stage() const
+{
+    return m_stage;
+}
+
+//! \brief IdleTrimmer::metrics returns runs, duration and freed resident
+//! memory of the last run of each stage and the last warm-up
+QVariantMap IdleTrimmer::metrics() const
+{
+    QVariantMap cache;
+    cache["runs"] = m_cacheMetrics.runs;
+    cache["lastMsecs"] = m_cacheMetrics.lastMsecs;
+    cache["lastFreedKb"] = m_cacheMetrics.lastFreedKb;
+
+    QVariantMap engine;
+    engine["runs"] = m_engineMetrics.runs;
+    engine["lastMsecs"] = m_engineMetrics.lastMsecs;
+    engine["lastFreedKb"] = m_engineMetrics.lastFreedKb;
+
+    QVariantMap warmUp;
+    warmUp["lastMsecs"] = m_lastWarmUpMsecs;
+    warmUp["lastStage"] = int(m_lastWarmUpStage);
+
+    QVariantMap metrics;
+    metrics["cache"] = cache;
+    metrics["engine"] = engine;
+    metrics["warmUp"] = warmUp;
+    return metrics;
+}
+
+void IdleTrimmer::setHidden(bool hidden)
+{
+    if (hidden) {
+        if (!m_timer.isActive() && m_stage == NoStage) {
+            m_timer.start(m_cacheDelay);
+        }
+        return;
+    }
+
+    m_timer.stop();
+
+    if (m_stage != NoStage) {
+        m_warmUpStage = m_stage;
+        m_warmUp.start();
+        m_stage = NoStage;
+    }
+}
+
+void IdleTrimmer::finishWarmUp()
+{
+    if (m_warmUpStage == NoStage) {
+        return;
+    }
+
+    m_lastWarmUpMsecs = m_warmUp.elapsed();
+    m_lastWarmUpStage = m_warmUpStage;
+    m_warmUpStage = NoStage;
+
+    qDebug() << "idletrimmer.cpp warm-up after stage" << m_lastWarmUpStage
+             << "took" << m_lastWarmUpMsecs << "ms";
+}
+
+void IdleTrimmer::onTimeout()
+{
+    if (m_stage == NoStage) {
+        runStage(CacheStage);
+        m_timer.start(qMax(0, m_engineDelay - m_cacheDelay));
+    } else if (m_stage == CacheStage) {
+        runStage(EngineStage);
+    }
+}
+
+void IdleTrimmer::runStage(Stage stage)
+{
+    const qint64 residentBefore = residentKb();
+    QElapsedTimer timer;
+    timer.start();
+
+    StageMetrics *metrics = 0;
+    if (stage == CacheStage) {
+        Q_EMIT trimCaches();
+        metrics = &m_cacheMetrics;
+    } else {
+        Q_EMIT trimEngines();
+#ifdef __GLIBC__
+        // Freed memory mostly stays with malloc otherwise.
+        malloc_trim(0);
+#endif
+        metrics = &m_engineMetrics;
+    }
+
+    m_stage = stage;
+    ++metrics->runs;
+    metrics->lastMsecs = timer.elapsed();
+    metrics->lastFreedKb = residentBefore - residentKb();
+
+    qDebug() << "idletrimmer.cpp stage" << stage << "took" << metrics->lastMsecs
+             << "ms and freed" << metrics->lastFreedKb << "kB";
+}
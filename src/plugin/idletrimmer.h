@@ -0,0 +1,103 @@
+/*
+ * Copyright (C) 2016 Canonical, Ltd.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this list
+ * of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice, this list
+ * of conditions and the following disclaimer in the documentation and/or other materials
+ * provided with the distribution.
+ * Neither the name of Nokia Corporation nor the names of its contributors may be
+ * used to endorse or promote products derived from this software without specific
+ * prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL
+ * THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#ifndef IDLETRIMMER_H
+#define IDLETRIMMER_H
+
+#include <QElapsedTimer>
+#include <QObject>
+#include <QTimer>
+#include <QVariantMap>
+
+//! \brief The IdleTrimmer class gives memory back while the keyboard is
+//! hidden
+//!
+//! Once the keyboard has been hidden for cacheDelay, trimCaches() asks to
+//! drop what is cheap to rebuild. After engineDelay it is followed by
+//! trimEngines(), which asks to release everything but what the active
+//! language needs to show again, after which the heap is trimmed as well.
+//! Each stage is timed along with the resident memory it freed. So is the
+//! warm-up, from the next show until the first frame.
+class IdleTrimmer
+    : public QObject
+{
+    Q_OBJECT
+
+public:
+    enum Stage {
+        NoStage,
+        CacheStage,
+        EngineStage
+    };
+
+    explicit IdleTrimmer(QObject *parent = 0);
+    virtual ~IdleTrimmer();
+
+    int cacheDelay() const;
+    void setCacheDelay(int msecs);
+    int engineDelay() const;
+    void setEngineDelay(int msecs);
+
+    //! The deepest stage that ran since the keyboard was hidden.
+    Stage stage() const;
+    QVariantMap metrics() const;
+
+    Q_SLOT void setHidden(bool hidden);
+    //! To be called once the keyboard has drawn its first frame after
+    //! being shown.
+    Q_SLOT void finishWarmUp();
+
+    Q_SIGNAL void trimCaches();
+    Q_SIGNAL void trimEngines();
+
+private:
+    struct StageMetrics
+    {
+        StageMetrics();
+
+        int runs;
+        qint64 lastMsecs;
+        qint64 lastFreedKb;
+    };
+
+    Q_SLOT void onTimeout();
+    void runStage(Stage stage);
+
+    int m_cacheDelay;
+    int m_engineDelay;
+    Stage m_stage;
+    QTimer m_timer;
+    StageMetrics m_cacheMetrics;
+    StageMetrics m_engineMetrics;
+    //! Warm-up after a trimmed keyboard is shown again.
+    QElapsedTimer m_warmUp;
+    Stage m_warmUpStage;
+    qint64 m_lastWarmUpMsecs;
+    Stage m_lastWarmUpStage;
+};
+
+#endif // IDLETRIMMER_H
@@ -0,0 +1,77 @@
+/*
+ * Copyright (C) 2016 Canonical, Ltd.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this list
+ * of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice, this list
+ * of conditions and the following disclaimer in the documentation and/or other materials
+ * provided with the distribution.
+ * Neither the name of Nokia Corporation nor the names of its contributors may be
+ * used to endorse or promote products derived from this software without specific
+ * prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL
+ * THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#include "incubationcontroller.h"
+
+#include <QTimerEvent>
+
+namespace {
+
+// A third of a 60Hz frame, leaving the rest for input, polish and sync
+const int DefaultBudget = 5;
+
+} // unnamed namespace
+
+IncubationController::IncubationController(QObject *parent)
+    : QObject(parent)
+    , QQmlIncubationController()
+    , m_timer()
+    , m_budget(DefaultBudget)
+{
+}
+
+//! \brief IncubationController::budget returns the time in milliseconds
+//! spent incubating before returning to the event loop
+int IncubationController::budget() const
+{
+    return m_budget;
+}
+
+void IncubationController::setBudget(int msecs)
+{
+    m_budget = qMax(1, msecs);
+}
+
+void IncubationController::incubatingObjectCountChanged(int count)
+{
+    if (count > 0) {
+        if (!m_timer.isActive())
+            m_timer.start(0, this);
+    } else {
+        m_timer.stop();
+    }
+}
+
+void IncubationController::timerEvent(QTimerEvent *event)
+{
+    if (event->timerId() != m_timer.timerId()) {
+        QObject::timerEvent(event);
+        return;
+    }
+
+    incubateFor(m_budget);
+}
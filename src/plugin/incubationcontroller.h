@@ -0,0 +1,60 @@
+/*
+ * Copyright (C) 2016 Canonical, Ltd.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this list
+ * of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice, this list
+ * of conditions and the following disclaimer in the documentation and/or other materials
+ * provided with the distribution.
+ * Neither the name of Nokia Corporation nor the names of its contributors may be
+ * used to endorse or promote products derived from this software without specific
+ * prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL
+ * THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#ifndef INCUBATIONCONTROLLER_H
+#define INCUBATIONCONTROLLER_H
+
+#include <QObject>
+#include <QBasicTimer>
+#include <QQmlIncubationController>
+
+//! \brief The IncubationController class creates asynchronously incubated
+//! QML objects in small slices
+//!
+//! Each slice is limited to \a budget milliseconds and the event loop runs
+//! between two slices, so frames keep being rendered and touch events keep
+//! being delivered while a keypad is being created.
+class IncubationController : public QObject, public QQmlIncubationController
+{
+    Q_OBJECT
+
+public:
+    explicit IncubationController(QObject *parent = 0);
+
+    int budget() const;
+    void setBudget(int msecs);
+
+protected:
+    virtual void incubatingObjectCountChanged(int count);
+    virtual void timerEvent(QTimerEvent *event);
+
+private:
+    QBasicTimer m_timer;
+    int m_budget;
+};
+
+#endif // INCUBATIONCONTROLLER_H
@@ -31,6 +31,7 @@
 
 #include "inputmethod.h"
 #include "inputmethod_p.h"
+#include "keypadcache.h"
 
 #include "models/key.h"
 #include "models/keyarea.h"
@@ -42,6 +43,7 @@
 //#include "logic/style.h"
 
 #include "view/setup.h"
+#include "startuptrace.h"
 
 #include <maliit/plugins/subviewdescription.h>
 #include <maliit/plugins/updateevent.h>
@@ -92,6 +94,7 @@ const QString g_maliit_keyboard_qml(UBUNTU_KEYBOARD_DATA_DIR "/Keyboard.qml");
 
 InputMethod::InputMethod(MAbstractInputMethodHost *host)
     : MAbstractInputMethod(host)
+    , m_startup_span(new StartupTrace::Span("InputMethod"))
     , d_ptr(new InputMethodPrivate(this, host))
 {
     Q_D(InputMethod);
@@ -107,41 +110,62 @@ InputMethod::InputMethod(MAbstractInputMethodHost *host)
     connect(&d->event_handler, SIGNAL(qmlCandidateChanged(QStringList)), d->editor.wordEngine(), SLOT(updateQmlCandidates(QStringList)));
     connect(this, SIGNAL(hasSelectionChanged(bool)), &d->editor, SLOT(onHasSelectionChanged(bool)));
     connect(d->editor.wordEngine(), SIGNAL(pluginChanged()), this, SLOT(onWordEnginePluginChanged()));
+    connect(&d->languageRegistry, SIGNAL(changed()), this, SLOT(onLanguageResourcesChanged()));
+    connect(&d->idleTrimmer, SIGNAL(trimCaches()), this, SLOT(onIdleTrimCaches()));
+    connect(&d->idleTrimmer, SIGNAL(trimEngines()), this, SLOT(onIdleTrimEngines()));
+    connect(d->view, SIGNAL(frameSwapped()), &d->idleTrimmer, SLOT(finishWarmUp()));
     connect(this, SIGNAL(keyboardStateChanged(QString)), &d->editor, SLOT(onKeyboardStateChanged(QString)));
     connect(d->m_geometry, SIGNAL(visibleRectChanged()), this, SLOT(onVisibleRectChanged()));
     connect(&d->m_settings, SIGNAL(disableHeightChanged(bool)), this, SLOT(onVisibleRectChanged()));
 
+    connect(&d->updateNotifier, SIGNAL(hasSelectionChanged(bool)), this, SLOT(onHostSelectionChanged(bool)));
+    connect(&d->updateNotifier, SIGNAL(contentTypeChanged(int)), this, SLOT(onHostContentTypeChanged(int)));
+    connect(&d->updateNotifier, SIGNAL(predictionEnabledChanged(bool)), this, SLOT(onHostPredictionEnabledChanged(bool)));
+    connect(&d->updateNotifier, SIGNAL(autoCapitalizationEnabledChanged(bool)), this, SLOT(onHostAutoCapsEnabledChanged(bool)));
+    connect(&d->updateNotifier, SIGNAL(surroundingTextChanged(QString,int)), this, SLOT(onHostSurroundingTextChanged(QString,int)));
+
     connect(&d->editor, SIGNAL(preeditChanged(QString)), this, SIGNAL(preeditChanged(QString)));
     connect(&d->editor, SIGNAL(cursorPositionChanged(int)), this, SIGNAL(cursorPositionChanged(int)));
 
-    d->registerAudioFeedbackSoundSetting();
-    d->registerAudioFeedbackSetting();
-    d->registerHapticFeedbackSetting();
-    d->registerAutoCorrectSetting();
-    d->registerAutoCapsSetting();
-    d->registerWordEngineSetting();
-    d->registerActiveLanguage();
-    d->registerPreviousLanguage();
-    d->registerEnabledLanguages();
-    d->registerDoubleSpaceFullStop();
-    d->registerStayHidden();
-    d->registerPluginPaths();
-    d->registerOpacity();
+    {
+        StartupTrace::Span settings_span("registerSettings");
+        d->registerAudioFeedbackSoundSetting();
+        d->registerAudioFeedbackSetting();
+        d->registerHapticFeedbackSetting();
+        d->registerAutoCorrectSetting();
+        d->registerAutoCapsSetting();
+        d->registerWordEngineSetting();
+        d->registerActiveLanguage();
+        d->registerPreviousLanguage();
+        d->registerEnabledLanguages();
+        d->registerDoubleSpaceFullStop();
+        d->registerStayHidden();
+        d->registerPluginPaths();
+        d->registerOpacity();
+    }
 
     //fire signal so all listeners know what active language is
-    Q_EMIT activeLanguageChanged(d->activeLanguage);
+    {
+        StartupTrace::Span language_span("activateLanguage");
+        Q_EMIT activeLanguageChanged(d->activeLanguage);
+    }
 
     // Setting layout orientation depends on word engine and hide word ribbon
     // settings to be initialized first:
     d->setLayoutOrientation(d->appsCurrentOrientation);
 
     QString prefix = qgetenv("KEYBOARD_PREFIX_PATH");
-    if (!prefix.isEmpty()) {
-        d->view->setSource(QUrl::fromLocalFile(prefix + QDir::separator() + g_maliit_keyboard_qml));
-    } else {
-        d->view->setSource(QUrl::fromLocalFile(g_maliit_keyboard_qml));
+    {
+        StartupTrace::Span source_span("setSource");
+        if (!prefix.isEmpty()) {
+            d->view->setSource(QUrl::fromLocalFile(prefix + QDir::separator() + g_maliit_keyboard_qml));
+        } else {
+            d->view->setSource(QUrl::fromLocalFile(g_maliit_keyboard_qml));
+        }
     }
     d->view->setGeometry(qGuiApp->primaryScreen()->geometry());
+
+    m_startup_span.reset();
 }
 
 InputMethod::~InputMethod()
@@ -152,9 +176,15 @@ void InputMethod::show()
     Q_D(InputMethod);
 
     if(!d->m_settings.stayHidden()) {
-        d->m_geometry->setShown(true);
-        update();
-        d->view->setVisible(true);
+        {
+            StartupTrace::Span span("show");
+            d->idleTrimmer.setHidden(false);
+            d->m_geometry->setShown(true);
+            refreshFromHost();
+            d->view->setVisible(true);
+        }
+        // The first time the keyboard appears ends startup
+        StartupTrace::finish();
     }
 }
 
@@ -250,11 +280,22 @@ void InputMethod::handleClientChange()
     hide();
 }
 
+//! \brief Applies the properties that changed according to an update
+//! event. The update() call the host makes right after it then has
+//! nothing left to do.
 bool InputMethod::imExtensionEvent(MImExtensionEvent *event)
 {
+    Q_D(InputMethod);
+
     if (not event or event->type() != MImExtensionEvent::Update) {
         return false;
     }
+
+    if (d->m_geometry->shown()) {
+        // While hidden the event is dropped, show() refreshes everything.
+        d->updateNotifier.notify(static_cast<MImUpdateEvent *>(event));
+        d->updateEventHandled = true;
+    }
     return true;
 }
 
@@ -279,8 +320,7 @@ void InputMethod::updateAutoCaps()
     Q_D(InputMethod);
     bool enabled = d->m_settings.autoCapitalization();
     enabled &= d->contentType == FreeTextContentType;
-    bool valid = true;
-    bool autocap = d->host->autoCapitalizationEnabled(valid) && d->editor.wordEngine()->languageFeature()->autoCapsAvailable();
+    bool autocap = d->hostAutoCapsEnabled && d->editor.wordEngine()->languageFeature()->autoCapsAvailable();
     enabled &= autocap;
 
     if (enabled != d->autocapsEnabled) {
@@ -301,6 +341,8 @@ void InputMethod::onEnabledLanguageSettingsChanged()
     if (!d->enabledLanguages.contains(d->previousLanguage)) {
         setPreviousLanguage("");
     }
+    // Emoji are suggested for words as long as the emoji layout is enabled.
+    d->editor.wordEngine()->setEmojiSuggestionsEnabled(d->enabledLanguages.contains("emoji"));
     Q_EMIT enabledLanguagesChanged(d->enabledLanguages);
 }
 
@@ -363,6 +405,24 @@ void InputMethod::update()
 {
     Q_D(InputMethod);
 
+    if (d->updateEventHandled) {
+        // Already applied from the update event
+        d->updateEventHandled = false;
+        return;
+    }
+
+    // Without an event nothing tells what changed, so everything is asked
+    // for. Values the notifier already delivered are not applied again.
+    refreshFromHost();
+}
+
+//! \brief InputMethod::refreshFromHost queries all state relevant to the
+//! keyboard from the host, for when it is not known what changed. Only
+//! values that differ from the ones already applied are handled.
+void InputMethod::refreshFromHost()
+{
+    Q_D(InputMethod);
+
     if (!d->m_geometry->shown()) {
         // Don't update if we're in the process of hiding
         return;
@@ -371,47 +431,74 @@ void InputMethod::update()
     bool valid;
 
     bool hasSelection = d->host->hasSelection(valid);
+    if (valid) {
+        onHostSelectionChanged(hasSelection);
+    }
+
+    int newContentType = d->host->contentType(valid);
+    onHostContentTypeChanged(valid ? newContentType : FreeTextContentType);
+
+    bool predictionEnabled = d->host->predictionEnabled(valid);
+    onHostPredictionEnabledChanged(predictionEnabled || !valid);
 
-    if (valid && hasSelection != d->hasSelection) {
+    onHostAutoCapsEnabledChanged(d->host->autoCapitalizationEnabled(valid));
+
+    QString text;
+    int position;
+    bool ok = d->host->surroundingText(text, position);
+    if (ok && (position != d->previous_position
+               || text != d->editor.text()->surrounding())) {
+        onHostSurroundingTextChanged(text, position);
+    }
+}
+
+void InputMethod::onHostSelectionChanged(bool hasSelection)
+{
+    Q_D(InputMethod);
+
+    if (hasSelection != d->hasSelection) {
         d->hasSelection = hasSelection;
         Q_EMIT hasSelectionChanged(d->hasSelection);
     }
+}
 
-    bool emitPredictionEnabled = false;
+void InputMethod::onHostContentTypeChanged(int contentType)
+{
+    setContentType(static_cast<TextContentType>(contentType));
+}
 
-    bool newPredictionEnabled = inputMethodHost()->predictionEnabled(valid)
-                                || d->editor.wordEngine()->languageFeature()->alwaysShowSuggestions();
+void InputMethod::onHostPredictionEnabledChanged(bool predictionEnabled)
+{
+    Q_D(InputMethod);
 
-    if (!valid)
-        newPredictionEnabled = true;
+    bool newPredictionEnabled = predictionEnabled
+                                || d->editor.wordEngine()->languageFeature()->alwaysShowSuggestions();
 
     if (d->wordEngineEnabled != newPredictionEnabled) {
         d->wordEngineEnabled = newPredictionEnabled;
-        emitPredictionEnabled = true;
-    }
-
-    TextContentType newContentType = static_cast<TextContentType>( inputMethodHost()->contentType(valid) );
-    if (!valid) {
-        newContentType = FreeTextContentType;
-    }
-    setContentType(newContentType);
-
-    if (emitPredictionEnabled) {
         updateWordEngine();
     }
+}
 
+void InputMethod::onHostAutoCapsEnabledChanged(bool enabled)
+{
+    Q_D(InputMethod);
+
+    d->hostAutoCapsEnabled = enabled;
     updateAutoCaps();
+}
 
-    QString text;
-    int position;
-    bool ok = d->host->surroundingText(text, position);
-    if (ok) {
-        d->editor.text()->setSurrounding(text);
-        d->editor.text()->setSurroundingOffset(position);
+void InputMethod::onHostSurroundingTextChanged(const QString &text, int position)
+{
+    Q_D(InputMethod);
 
-        checkAutocaps();
-        d->previous_position = position;
-    }
+    // Model::Text only rescans what differs from the text it already has.
+    d->editor.text()->setSurrounding(text);
+    d->editor.text()->setSurroundingOffset(position);
+    d->editor.resyncSentenceState();
+
+    checkAutocaps();
+    d->previous_position = position;
 }
 
 void InputMethod::updateWordEngine()
@@ -463,21 +550,7 @@ void InputMethod::checkAutocaps()
     Q_D(InputMethod);
 
     if (d->autocapsEnabled) {
-        QString text;
-        int position;
-        bool ok = d->host->surroundingText(text, position);
-        QString textOnLeft = d->editor.text()->surroundingLeft() + d->editor.text()->preedit();
-        if (textOnLeft.contains("\n")) {
-            textOnLeft = textOnLeft.split("\n").last();
-        }
-        QStringList leftHandWords = textOnLeft.split(" ");
-        bool email_detected = false;
-        if (!leftHandWords.isEmpty() && leftHandWords.last().contains("@")) {
-            email_detected = true;
-        }
-        if (ok && !email_detected && ((textOnLeft.isEmpty() && d->editor.text()->preedit().isEmpty())
-                || d->editor.wordEngine()->languageFeature()->activateAutoCaps(textOnLeft)
-                || d->editor.wordEngine()->languageFeature()->activateAutoCaps(textOnLeft.trimmed()))) {
+        if (d->editor.autoCapsActive()) {
             Q_EMIT activateAutocaps();
         } else {
             Q_EMIT deactivateAutocaps();
@@ -554,12 +627,9 @@ void InputMethod::setActiveLanguage(const QString &newLanguage)
 
     qDebug() << "in inputMethod.cpp setActiveLanguage() activeLanguage is:" << newLanguage;
 
-    foreach(QString pluginPath, d->pluginPaths) {
-        QDir testDir(pluginPath + QDir::separator() + newLanguage);
-        if (testDir.exists()) {
-            d->currentPluginPath = testDir.absolutePath();
-            break;
-        }
+    const LanguageResources resources(d->languageRegistry.resources(newLanguage));
+    if (!resources.path.isEmpty()) {
+        d->currentPluginPath = resources.path;
     }
 
     if (d->activeLanguage == newLanguage)
@@ -593,10 +663,47 @@ void InputMethod::setPreviousLanguage(const QString &prevLanguage)
 }
 
 
+//! \brief InputMethod::onIdleTrimCaches
+//! Drops caches that are rebuilt on demand once the keyboard has been
+//! hidden for a while
+void InputMethod::onIdleTrimCaches()
+{
+    Q_D(InputMethod);
+
+    d->editor.wordEngine()->releaseCaches();
+    d->view->releaseResources();
+    d->view->engine()->trimComponentCache();
+}
+
+//! \brief InputMethod::onIdleTrimEngines
+//! Releases the engines of inactive languages and all keypads but the
+//! current one once the keyboard has been hidden for long
+void InputMethod::onIdleTrimEngines()
+{
+    Q_D(InputMethod);
+
+    d->editor.wordEngine()->releaseInactiveEngines();
+
+    if (d->view->rootObject()) {
+        Q_FOREACH(KeypadCache *cache, d->view->rootObject()->findChildren<KeypadCache *>()) {
+            cache->clear();
+        }
+    }
+
+    d->view->engine()->collectGarbage();
+    d->view->engine()->trimComponentCache();
+}
+
+QVariantMap InputMethod::idleTrimMetrics() const
+{
+    Q_D(const InputMethod);
+    return d->idleTrimmer.metrics();
+}
+
 void InputMethod::onWordEnginePluginChanged()
 {
     reset();
-    update();
+    refreshFromHost();
 }
 
 const QString InputMethod::keyboardState() const
@@ -691,28 +798,43 @@ QString InputMethod::surroundingRight()
 
 bool InputMethod::languageIsSupported(const QString plugin) {
     Q_D(const InputMethod);
-    foreach(QString pluginPath, d->pluginPaths) {
-        QDir testDir(pluginPath + QDir::separator() + plugin);
-        if (testDir.exists()) {
-            return true;
-        }
-    }
+    return d->languageRegistry.contains(plugin);
+}
 
-    return false;
+//! \brief InputMethod::layoutFile returns the QML layout of a language
+//! \param language id of the language, e.g. "en"
+//! \param variant "email", "url_search" or empty for free text
+//! \return path of the layout, empty if the language has no such layout
+QString InputMethod::layoutFile(const QString &language, const QString &variant) const
+{
+    Q_D(const InputMethod);
+    return d->languageRegistry.resources(language).layouts.value(variant);
 }
 
 void InputMethod::onLanguageChanged(const QString &language) {
     Q_D(InputMethod);
-    foreach(QString pluginPath, d->pluginPaths) {
-        QFile testFile(pluginPath + QDir::separator() + language + QDir::separator() + "lib" + language + "plugin.so");
-        if (testFile.exists()) {
-            Q_EMIT languagePluginChanged(testFile.fileName(), language);
-            return;
-        }
+    const LanguageResources resources(d->languageRegistry.resources(language));
+    if (!resources.plugin.isEmpty()) {
+        d->editor.wordEngine()->setLanguageResources(resources);
+        Q_EMIT languagePluginChanged(resources.plugin, language);
+        return;
     }
     qCritical() << "Couldn't find word engine plugin for " << language;
 }
 
+//! \brief InputMethod::onLanguageResourcesChanged follows languages being
+//! installed or removed while the keyboard runs
+void InputMethod::onLanguageResourcesChanged()
+{
+    Q_D(InputMethod);
+
+    const QString path(d->languageRegistry.resources(d->activeLanguage).path);
+    if (!path.isEmpty() && path != d->currentPluginPath) {
+        d->currentPluginPath = path;
+        Q_EMIT currentPluginPathChanged(d->currentPluginPath);
+    }
+}
+
 void InputMethod::onPluginPathsChanged(const QStringList& pluginPaths) {
     Q_D(InputMethod);
     Q_UNUSED(pluginPaths);
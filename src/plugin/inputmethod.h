@@ -41,6 +41,11 @@
 
 class InputMethodPrivate;
 
+namespace MaliitKeyboard {
+namespace StartupTrace {
+class Span;
+}} // namespace StartupTrace, MaliitKeyboard
+
 class InputMethod
     : public MAbstractInputMethod
 {
@@ -145,6 +150,8 @@ public:
     Q_SLOT void close();
 
     Q_INVOKABLE bool languageIsSupported(const QString plugin);
+    Q_INVOKABLE QString layoutFile(const QString &language, const QString &variant) const;
+    Q_INVOKABLE QVariantMap idleTrimMetrics() const;
     Q_SLOT void onLanguageChanged(const QString& language);
 
     Q_SLOT void onPluginPathsChanged(const QStringList& pluginPaths);
@@ -184,9 +191,22 @@ private:
     Q_SLOT void onLayoutHeightChanged(int height);
 
     Q_SLOT void onWordEnginePluginChanged();
+    Q_SLOT void onLanguageResourcesChanged();
+
+    Q_SLOT void onIdleTrimCaches();
+    Q_SLOT void onIdleTrimEngines();
+
+    Q_SLOT void onHostSelectionChanged(bool hasSelection);
+    Q_SLOT void onHostContentTypeChanged(int contentType);
+    Q_SLOT void onHostPredictionEnabledChanged(bool predictionEnabled);
+    Q_SLOT void onHostAutoCapsEnabledChanged(bool enabled);
+    Q_SLOT void onHostSurroundingTextChanged(const QString &text, int position);
 
+    void refreshFromHost();
     void checkAutocaps();
 
+    //! Times the whole constructor, so it is initialised before d_ptr.
+    QScopedPointer<MaliitKeyboard::StartupTrace::Span> m_startup_span;
     const QScopedPointer<InputMethodPrivate> d_ptr;
 };
 
@@ -16,14 +16,19 @@
 
 #include "inputmethod.h"
 #include "coreutils.h"
+#include "startuptrace.h"
 
 #include "logic/layoutupdater.h"
 #include "editor.h"
 #include "greeterstatus.h"
+#include "idletrimmer.h"
+#include "incubationcontroller.h"
 #include "keyboardgeometry.h"
 #include "keyboardsettings.h"
+#include "updatenotifier.h"
 
 #include "logic/eventhandler.h"
+#include "logic/languageregistry.h"
 #include "logic/wordengine.h"
 
 #include <maliit/plugins/abstractinputmethodhost.h>
@@ -50,8 +55,13 @@ typedef QMap<QString, SharedOverride>::const_iterator OverridesIterator;
 
 QQuickView *createWindow(MAbstractInputMethodHost *host)
 {
+    StartupTrace::Span span("createWindow");
+
     QScopedPointer<QQuickView> view(new QQuickView);
 
+    // Keypads are incubated in slices that leave room for rendering and input
+    view->engine()->setIncubationController(new IncubationController(view.data()));
+
     QSurfaceFormat format;
     format.setAlphaBufferSize(8);
     view->setFormat(format);
@@ -92,8 +102,14 @@ public:
 
     int previous_position;
 
+    UpdateNotifier updateNotifier;
+    bool hostAutoCapsEnabled;
+    bool updateEventHandled;
+
     QStringList pluginPaths;
     QString currentPluginPath;
+    Logic::LanguageRegistry languageRegistry;
+    IdleTrimmer idleTrimmer;
 
     explicit InputMethodPrivate(InputMethod * const _q,
                                 MAbstractInputMethodHost *host)
@@ -117,7 +133,14 @@ public:
         , m_greeterStatus(new GreeterStatus())
         , wordRibbon(new WordRibbon)
         , previous_position(-1)
+        , updateNotifier()
+        , hostAutoCapsEnabled(true)
+        , updateEventHandled(false)
+        , languageRegistry()
+        , idleTrimmer()
     {
+        StartupTrace::Span span("InputMethodPrivate");
+
         view = createWindow(host);
 
         editor.setHost(host);
@@ -144,6 +167,12 @@ public:
         QObject::connect(wordRibbon, SIGNAL(wordCandidateSelected(QString)),
                          editor.wordEngine(),  SLOT(onWordCandidateSelected(QString)));
 
+        QObject::connect(editor.wordEngine(), SIGNAL(moreCandidatesAvailable(bool)),
+                         wordRibbon, SLOT(setMoreCandidatesAvailable(bool)));
+
+        QObject::connect(wordRibbon, SIGNAL(moreCandidatesRequested()),
+                         editor.wordEngine(), SLOT(fetchMoreCandidates()));
+
     #ifdef DISABLED_FLAGS_FROM_SURFACE
         view->setFlags(Qt::Dialog | Qt::FramelessWindowHint | Qt::WindowStaysOnTopHint
                           | Qt::X11BypassWindowManagerHint | Qt::WindowDoesNotAcceptFocus);
@@ -209,6 +238,8 @@ public:
 
     void setContextProperties(QQmlContext *qml_context)
     {
+        StartupTrace::Span span("setContextProperties");
+
         qml_context->setContextProperty("maliit_input_method", q);
         qml_context->setContextProperty("maliit_geometry", m_geometry);
         qml_context->setContextProperty("maliit_event_handler", &event_handler);
@@ -227,6 +258,10 @@ public:
             pluginPaths.append(QString(UBUNTU_KEYBOARD_DATA_DIR) + QDir::separator() + "lib");
         }
         pluginPaths.append(m_settings.pluginPaths());
+
+        const QString dictionaryPath(prefix.isEmpty() ? QString(HUNSPELL_DICT_PATH)
+                                                      : prefix + QDir::separator() + HUNSPELL_DICT_PATH);
+        languageRegistry.setSearchPaths(pluginPaths, dictionaryPath);
     }
 
     /*
@@ -234,24 +269,32 @@ public:
      */
     void registerAudioFeedbackSoundSetting()
     {
+        StartupTrace::Span span("registerAudioFeedbackSoundSetting");
+
         QObject::connect(&m_settings, SIGNAL(keyPressAudioFeedbackSoundChanged(QString)),
                          q, SIGNAL(audioFeedbackSoundChanged(QString)));
     }
 
     void registerAudioFeedbackSetting()
     {
+        StartupTrace::Span span("registerAudioFeedbackSetting");
+
         QObject::connect(&m_settings, SIGNAL(keyPressAudioFeedbackChanged(bool)),
                          q, SIGNAL(useAudioFeedbackChanged()));
     }
 
     void registerHapticFeedbackSetting()
     {
+        StartupTrace::Span span("registerHapticFeedbackSetting");
+
         QObject::connect(&m_settings, SIGNAL(keyPressHapticFeedbackChanged(bool)),
                          q, SIGNAL(useHapticFeedbackChanged()));
     }
 
     void registerAutoCorrectSetting()
     {
+        StartupTrace::Span span("registerAutoCorrectSetting");
+
         QObject::connect(&m_settings, SIGNAL(autoCompletionChanged(bool)),
                          q, SLOT(onAutoCorrectSettingChanged()));
         editor.setAutoCorrectEnabled(m_settings.autoCompletion());
@@ -259,12 +302,16 @@ public:
 
     void registerAutoCapsSetting()
     {
+        StartupTrace::Span span("registerAutoCapsSetting");
+
         QObject::connect(&m_settings, SIGNAL(autoCapitalizationChanged(bool)),
                          q, SLOT(updateAutoCaps()));
     }
 
     void registerWordEngineSetting()
     {
+        StartupTrace::Span span("registerWordEngineSetting");
+
         QObject::connect(&m_settings, SIGNAL(predictiveTextChanged(bool)),
                          editor.wordEngine(), SLOT(setWordPredictionEnabled(bool)));
         editor.wordEngine()->setWordPredictionEnabled(m_settings.predictiveText());
@@ -272,10 +319,16 @@ public:
         QObject::connect(&m_settings, SIGNAL(spellCheckingChanged(bool)),
                          editor.wordEngine(), SLOT(setSpellcheckerEnabled(bool)));
         editor.wordEngine()->setSpellcheckerEnabled(m_settings.spellchecking());
+
+        QObject::connect(&m_settings, SIGNAL(engineMemoryBudgetChanged(int)),
+                         editor.wordEngine(), SLOT(setMemoryBudget(int)));
+        editor.wordEngine()->setMemoryBudget(m_settings.engineMemoryBudget());
     }
 
     void registerActiveLanguage()
     {
+        StartupTrace::Span span("registerActiveLanguage");
+
         QObject::connect(&m_settings, SIGNAL(activeLanguageChanged(QString)),
                          q, SLOT(setActiveLanguage(QString)));
 
@@ -286,6 +339,8 @@ public:
 
     void registerPreviousLanguage()
     {
+        StartupTrace::Span span("registerPreviousLanguage");
+
         QObject::connect(&m_settings, SIGNAL(previousLanguageChanged(QString)),
                          q, SLOT(setPreviousLanguage(QString)));
 
@@ -295,6 +350,8 @@ public:
 
     void registerEnabledLanguages()
     {
+        StartupTrace::Span span("registerEnabledLanguages");
+
         QObject::connect(&m_settings, SIGNAL(enabledLanguagesChanged(QStringList)),
                          q, SLOT(onEnabledLanguageSettingsChanged()));
         q->onEnabledLanguageSettingsChanged();
@@ -305,6 +362,8 @@ public:
 
     void registerDoubleSpaceFullStop()
     {
+        StartupTrace::Span span("registerDoubleSpaceFullStop");
+
         QObject::connect(&m_settings, SIGNAL(doubleSpaceFullStopChanged(bool)),
                          q, SLOT(onDoubleSpaceSettingChanged()));
         editor.setDoubleSpaceFullStopEnabled(m_settings.doubleSpaceFullStop());
@@ -312,18 +371,24 @@ public:
 
     void registerStayHidden()
     {
+        StartupTrace::Span span("registerStayHidden");
+
         QObject::connect(&m_settings, SIGNAL(stayHiddenChanged(bool)),
                          q, SLOT(hide()));
     }
 
     void registerPluginPaths()
     {
+        StartupTrace::Span span("registerPluginPaths");
+
         QObject::connect(&m_settings, SIGNAL(pluginPathsChanged(QStringList)),
                         q, SLOT(onPluginPathsChanged(QStringList)));
     }
 
     void registerOpacity()
     {
+        StartupTrace::Span span("registerOpacity");
+
         QObject::connect(&m_settings, SIGNAL(opacityChanged(double)),
                         q, SIGNAL(opacityChanged(double)));
     }
@@ -338,7 +403,9 @@ public:
         m_geometry->setShown(false);
 
         editor.clearPreedit();
+        editor.wordEngine()->flushLearning();
 
         view->setVisible(false);
+        idleTrimmer.setHidden(true);
     }
 };
@@ -49,20 +49,57 @@ const QLatin1String STAY_HIDDEN_KEY = QLatin1String("stayHidden");
 const QLatin1String DISABLE_HEIGHT_KEY = QLatin1String("disableHeight");
 const QLatin1String PLUGIN_PATHS_KEY = QLatin1String("pluginPaths");
 const QLatin1String OPACITY_KEY = QLatin1String("opacity");
+const QLatin1String ENGINE_MEMORY_BUDGET_KEY = QLatin1String("engineMemoryBudget");
+
+//! Time to gather writes before they go to the settings backend, in ms.
+#define WRITE_DELAY 500
 
 /*!
  * \brief KeyboardSettings::KeyboardSettings class to load the settings, and
  * listens on runtime to changes of them
+ * All settings are read once and kept in memory, so the getters never go to
+ * the settings backend. Writes are gathered for WRITE_DELAY ms and then
+ * stored together.
  * \param parent
  */
 KeyboardSettings::KeyboardSettings(QObject *parent) :
     QObject(parent)
   , m_settings(new QGSettings("com.canonical.keyboard.maliit",
                               "/com/canonical/keyboard/maliit/", this))
+  , m_autoCapitalization(false)
+  , m_autoCompletion(false)
+  , m_predictiveText(false)
+  , m_spellchecking(false)
+  , m_keyPressAudioFeedback(false)
+  , m_keyPressHapticFeedback(false)
+  , m_doubleSpaceFullStop(false)
+  , m_stayHidden(false)
+  , m_disableHeight(false)
+  , m_opacity(0)
+  , m_engineMemoryBudget(0)
+  , m_pendingWrites()
+  , m_writeTimer()
 {
     QObject::connect(m_settings, SIGNAL(changed(QString)),
                      this, SLOT(settingUpdated(QString)));
 
+    m_writeTimer.setSingleShot(true);
+    m_writeTimer.setInterval(WRITE_DELAY);
+    QObject::connect(&m_writeTimer, SIGNAL(timeout()),
+                     this, SLOT(flush()));
+
+    const QLatin1String keys[] = {
+        ACTIVE_LANGUAGE_KEY, PREVIOUS_LANGUAGE_KEY, ENABLED_LANGUAGES_KEY,
+        AUTO_CAPITALIZATION_KEY, AUTO_COMPLETION_KEY, PREDICTIVE_TEXT_KEY,
+        SPELL_CHECKING_KEY, KEY_PRESS_AUDIO_FEEDBACK_KEY,
+        KEY_PRESS_AUDIO_FEEDBACK_SOUND_KEY, KEY_PRESS_HAPTIC_FEEDBACK_KEY,
+        DOUBLE_SPACE_FULL_STOP_KEY, STAY_HIDDEN_KEY, DISABLE_HEIGHT_KEY,
+        PLUGIN_PATHS_KEY, OPACITY_KEY, ENGINE_MEMORY_BUDGET_KEY
+    };
+    for (unsigned int i = 0; i < sizeof(keys) / sizeof(keys[0]); ++i) {
+        refresh(keys[i]);
+    }
+
     // Migrate from supporting one chinese plugin ('zh') to multiple
     // ('zh-hans' and 'zh-hant')
     if (activeLanguage() == "zh") {
@@ -71,10 +108,16 @@ KeyboardSettings::KeyboardSettings(QObject *parent) :
     QStringList enabled = enabledLanguages();
     if (enabled.contains("zh")) {
         enabled.replace(enabled.indexOf("zh"), "zh-hans");
-        m_settings->set(ENABLED_LANGUAGES_KEY, QVariant(enabled));
+        write(ENABLED_LANGUAGES_KEY, QVariant(enabled));
+        m_enabledLanguages = enabled;
     }
 }
 
+KeyboardSettings::~KeyboardSettings()
+{
+    flush();
+}
+
 /*!
  * \brief KeyboardSettings::activeLanguage returns currently active language
  * \return active language
@@ -82,12 +125,13 @@ KeyboardSettings::KeyboardSettings(QObject *parent) :
 
 QString KeyboardSettings::activeLanguage() const
 {
-    return m_settings->get(ACTIVE_LANGUAGE_KEY).toString();
+    return m_activeLanguage;
 }
 
 void KeyboardSettings::setActiveLanguage(const QString& id)
 {
-    m_settings->set(ACTIVE_LANGUAGE_KEY, QVariant(id));
+    m_activeLanguage = id;
+    write(ACTIVE_LANGUAGE_KEY, QVariant(id));
 }
 
 /*!
@@ -98,12 +142,13 @@ void KeyboardSettings::setActiveLanguage(const QString& id)
 
 QString KeyboardSettings::previousLanguage() const
 {
-    return m_settings->get(PREVIOUS_LANGUAGE_KEY).toString();
+    return m_previousLanguage;
 }
 
 void KeyboardSettings::setPreviousLanguage(const QString& id)
 {
-    m_settings->set(PREVIOUS_LANGUAGE_KEY, QVariant(id));
+    m_previousLanguage = id;
+    write(PREVIOUS_LANGUAGE_KEY, QVariant(id));
 }
 
 /*!
@@ -113,7 +158,7 @@ void KeyboardSettings::setPreviousLanguage(const QString& id)
  */
 QStringList KeyboardSettings::enabledLanguages() const
 {
-    return m_settings->get(ENABLED_LANGUAGES_KEY).toStringList();
+    return m_enabledLanguages;
 }
 
 /*!
@@ -123,7 +168,7 @@ QStringList KeyboardSettings::enabledLanguages() const
  */
 bool KeyboardSettings::autoCapitalization() const
 {
-    return m_settings->get(AUTO_CAPITALIZATION_KEY).toBool();
+    return m_autoCapitalization;
 }
 
 /*!
@@ -133,7 +178,7 @@ bool KeyboardSettings::autoCapitalization() const
  */
 bool KeyboardSettings::autoCompletion() const
 {
-    return m_settings->get(AUTO_COMPLETION_KEY).toBool();
+    return m_autoCompletion;
 }
 
 /*!
@@ -143,7 +188,7 @@ bool KeyboardSettings::autoCompletion() const
  */
 bool KeyboardSettings::predictiveText() const
 {
-    return m_settings->get(PREDICTIVE_TEXT_KEY).toBool();
+    return m_predictiveText;
 }
 
 /*!
@@ -152,7 +197,7 @@ bool KeyboardSettings::predictiveText() const
  */
 bool KeyboardSettings::spellchecking() const
 {
-    return m_settings->get(SPELL_CHECKING_KEY).toBool();
+    return m_spellchecking;
 }
 
 /*!
@@ -162,7 +207,7 @@ bool KeyboardSettings::spellchecking() const
  */
 bool KeyboardSettings::keyPressAudioFeedback() const
 {
-    return m_settings->get(KEY_PRESS_AUDIO_FEEDBACK_KEY).toBool();
+    return m_keyPressAudioFeedback;
 }
 
 /*!
@@ -172,7 +217,7 @@ bool KeyboardSettings::keyPressAudioFeedback() const
  */
 bool KeyboardSettings::keyPressHapticFeedback() const
 {
-    return m_settings->get(KEY_PRESS_HAPTIC_FEEDBACK_KEY).toBool();
+    return m_keyPressHapticFeedback;
 }
 
 /*!
@@ -182,7 +227,7 @@ bool KeyboardSettings::keyPressHapticFeedback() const
  */
 QString KeyboardSettings::keyPressAudioFeedbackSound() const
 {
-    return m_settings->get(KEY_PRESS_AUDIO_FEEDBACK_SOUND_KEY).toString();
+    return m_keyPressAudioFeedbackSound;
 }
 
 /*!
@@ -191,7 +236,7 @@ QString KeyboardSettings::keyPressAudioFeedbackSound() const
  */
 bool KeyboardSettings::doubleSpaceFullStop() const
 {
-    return m_settings->get(DOUBLE_SPACE_FULL_STOP_KEY).toBool();
+    return m_doubleSpaceFullStop;
 }
 
 /*!
@@ -200,7 +245,7 @@ bool KeyboardSettings::doubleSpaceFullStop() const
  */
 bool KeyboardSettings::stayHidden() const
 {
-    return m_settings->get(STAY_HIDDEN_KEY).toBool();
+    return m_stayHidden;
 }
 
 /*!
@@ -209,12 +254,12 @@ bool KeyboardSettings::stayHidden() const
  */
 QStringList KeyboardSettings::pluginPaths() const
 {
-    return m_settings->get(PLUGIN_PATHS_KEY).toStringList();
+    return m_pluginPaths;
 }
 
 bool KeyboardSettings::disableHeight() const
 {
-    return m_settings->get(DISABLE_HEIGHT_KEY).toBool();
+    return m_disableHeight;
 }
 
 /*!
@@ -223,61 +268,137 @@ bool KeyboardSettings::disableHeight() const
  */
 double KeyboardSettings::opacity() const
 {
-    return m_settings->get(OPACITY_KEY).toDouble();
+    return m_opacity;
+}
+
+/*!
+ * \brief KeyboardSettings::engineMemoryBudget returns how much memory, in MiB,
+ * the loaded language engines may take together
+ */
+int KeyboardSettings::engineMemoryBudget() const
+{
+    return m_engineMemoryBudget;
+}
+
+/*!
+ * \brief KeyboardSettings::flush stores all pending writes in the settings
+ * backend
+ */
+void KeyboardSettings::flush()
+{
+    m_writeTimer.stop();
+
+    const QHash<QString, QVariant> pending(m_pendingWrites);
+    m_pendingWrites.clear();
+
+    for (QHash<QString, QVariant>::const_iterator it = pending.constBegin(); it != pending.constEnd(); ++it) {
+        m_settings->set(it.key(), it.value());
+    }
+}
+
+void KeyboardSettings::write(const QString &key, const QVariant &value)
+{
+    m_pendingWrites.insert(key, value);
+    if (!m_writeTimer.isActive()) {
+        m_writeTimer.start();
+    }
+}
+
+/*!
+ * \brief KeyboardSettings::refresh reads the value of key from the settings
+ * backend into the snapshot
+ * \param key
+ * \return false if the key is not known
+ */
+bool KeyboardSettings::refresh(const QString &key)
+{
+    if (key == ACTIVE_LANGUAGE_KEY) {
+        m_activeLanguage = m_settings->get(key).toString();
+    } else if (key == PREVIOUS_LANGUAGE_KEY) {
+        m_previousLanguage = m_settings->get(key).toString();
+    } else if (key == ENABLED_LANGUAGES_KEY) {
+        m_enabledLanguages = m_settings->get(key).toStringList();
+    } else if (key == AUTO_CAPITALIZATION_KEY) {
+        m_autoCapitalization = m_settings->get(key).toBool();
+    } else if (key == AUTO_COMPLETION_KEY) {
+        m_autoCompletion = m_settings->get(key).toBool();
+    } else if (key == PREDICTIVE_TEXT_KEY) {
+        m_predictiveText = m_settings->get(key).toBool();
+    } else if (key == SPELL_CHECKING_KEY) {
+        m_spellchecking = m_settings->get(key).toBool();
+    } else if (key == KEY_PRESS_AUDIO_FEEDBACK_KEY) {
+        m_keyPressAudioFeedback = m_settings->get(key).toBool();
+    } else if (key == KEY_PRESS_HAPTIC_FEEDBACK_KEY) {
+        m_keyPressHapticFeedback = m_settings->get(key).toBool();
+    } else if (key == KEY_PRESS_AUDIO_FEEDBACK_SOUND_KEY) {
+        m_keyPressAudioFeedbackSound = m_settings->get(key).toString();
+    } else if (key == DOUBLE_SPACE_FULL_STOP_KEY) {
+        m_doubleSpaceFullStop = m_settings->get(key).toBool();
+    } else if (key == STAY_HIDDEN_KEY) {
+        m_stayHidden = m_settings->get(key).toBool();
+    } else if (key == DISABLE_HEIGHT_KEY) {
+        m_disableHeight = m_settings->get(key).toBool();
+    } else if (key == PLUGIN_PATHS_KEY) {
+        m_pluginPaths = m_settings->get(key).toStringList();
+    } else if (key == OPACITY_KEY) {
+        m_opacity = m_settings->get(key).toDouble();
+    } else if (key == ENGINE_MEMORY_BUDGET_KEY) {
+        m_engineMemoryBudget = m_settings->get(key).toInt();
+    } else {
+        return false;
+    }
+
+    return true;
 }
 
 /*!
  * \brief KeyboardSettings::settingUpdated slot to handle changes in the settings backend
- * A specialized signal is emitted for the affected setting
+ * The snapshot is updated and a specialized signal is emitted for the affected setting
  * \param key
  */
 void KeyboardSettings::settingUpdated(const QString &key)
 {
+    // Our own value is about to be written and wins over the backend's.
+    if (m_pendingWrites.contains(key)) {
+        return;
+    }
+
+    if (!refresh(key)) {
+        qWarning() << Q_FUNC_INFO << "unknown settings key:" << key;
+        return;
+    }
+
     if (key == ACTIVE_LANGUAGE_KEY) {
         Q_EMIT activeLanguageChanged(activeLanguage());
-        return;
     } else if (key == PREVIOUS_LANGUAGE_KEY) {
         Q_EMIT previousLanguageChanged(previousLanguage());
-        return;
     } else if (key == ENABLED_LANGUAGES_KEY) {
         Q_EMIT enabledLanguagesChanged(enabledLanguages());
-        return;
     } else if (key == AUTO_CAPITALIZATION_KEY) {
         Q_EMIT autoCapitalizationChanged(autoCapitalization());
-        return;
     } else if (key == AUTO_COMPLETION_KEY) {
         Q_EMIT autoCompletionChanged(autoCompletion());
-        return;
     } else if (key == PREDICTIVE_TEXT_KEY) {
         Q_EMIT predictiveTextChanged(predictiveText());
-        return;
     } else if (key == SPELL_CHECKING_KEY) {
         Q_EMIT spellCheckingChanged(spellchecking());
-        return;
     } else if (key == KEY_PRESS_AUDIO_FEEDBACK_KEY) {
         Q_EMIT keyPressAudioFeedbackChanged(keyPressAudioFeedback());
-        return;
     } else if (key == KEY_PRESS_HAPTIC_FEEDBACK_KEY) {
         Q_EMIT keyPressHapticFeedbackChanged(keyPressHapticFeedback());
-        return;
     } else if (key == KEY_PRESS_AUDIO_FEEDBACK_SOUND_KEY) {
         Q_EMIT keyPressAudioFeedbackSoundChanged(keyPressAudioFeedbackSound());
-        return;
     } else if (key == DOUBLE_SPACE_FULL_STOP_KEY) {
         Q_EMIT doubleSpaceFullStopChanged(doubleSpaceFullStop());
-        return;
     } else if (key == STAY_HIDDEN_KEY) {
         Q_EMIT stayHiddenChanged(stayHidden());
-        return;
     } else if (key == DISABLE_HEIGHT_KEY) {
         Q_EMIT disableHeightChanged(disableHeight());
-        return;
     } else if (key == PLUGIN_PATHS_KEY) {
         Q_EMIT pluginPathsChanged(pluginPaths());
     } else if (key == OPACITY_KEY) {
         Q_EMIT opacityChanged(opacity());
+    } else if (key == ENGINE_MEMORY_BUDGET_KEY) {
+        Q_EMIT engineMemoryBudgetChanged(engineMemoryBudget());
     }
-
-    qWarning() << Q_FUNC_INFO << "unknown settings key:" << key;
-    return;
 }
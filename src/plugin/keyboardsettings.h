@@ -30,8 +30,11 @@
 #ifndef KEYBOARDSETTINGS_H
 #define KEYBOARDSETTINGS_H
 
+#include <QHash>
 #include <QObject>
 #include <QStringList>
+#include <QTimer>
+#include <QVariant>
 
 class QGSettings;
 
@@ -42,7 +45,8 @@ class KeyboardSettings : public QObject
     Q_OBJECT
 public:
     explicit KeyboardSettings(QObject *parent = 0);
-    
+    ~KeyboardSettings();
+
     QString activeLanguage() const;
     void setActiveLanguage(const QString& id);
     QString previousLanguage() const;
@@ -60,6 +64,7 @@ public:
     bool disableHeight() const;
     QStringList pluginPaths() const;
     double opacity() const;
+    int engineMemoryBudget() const;
 
 Q_SIGNALS:
     void activeLanguageChanged(QString);
@@ -77,12 +82,40 @@ Q_SIGNALS:
     void disableHeightChanged(bool);
     void pluginPathsChanged(QStringList);
     void opacityChanged(double);
+    void engineMemoryBudgetChanged(int);
+
+public Q_SLOTS:
+    void flush();
 
 private:
     Q_SLOT void settingUpdated(const QString &key);
+    bool refresh(const QString &key);
+    void write(const QString &key, const QVariant &value);
 
     QGSettings *m_settings;
 
+    // Snapshot of the settings backend, only updated from its changed()
+    // signal and by our own writes.
+    QString m_activeLanguage;
+    QString m_previousLanguage;
+    QStringList m_enabledLanguages;
+    bool m_autoCapitalization;
+    bool m_autoCompletion;
+    bool m_predictiveText;
+    bool m_spellchecking;
+    bool m_keyPressAudioFeedback;
+    QString m_keyPressAudioFeedbackSound;
+    bool m_keyPressHapticFeedback;
+    bool m_doubleSpaceFullStop;
+    bool m_stayHidden;
+    bool m_disableHeight;
+    QStringList m_pluginPaths;
+    double m_opacity;
+    int m_engineMemoryBudget;
+
+    QHash<QString, QVariant> m_pendingWrites;
+    QTimer m_writeTimer;
+
     friend class TestKeyboardSettings;
 };
 
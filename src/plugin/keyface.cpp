@@ -0,0 +1,257 @@
+/*
+ * Copyright (C) 2016 Canonical, Ltd.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this list
+ * of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice, this list
+ * of conditions and the following disclaimer in the documentation and/or other materials
+ * provided with the distribution.
+ * Neither the name of Nokia Corporation nor the names of its contributors may be
+ * used to endorse or promote products derived from this software without specific
+ * prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL
+ * THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#include "keyface.h"
+#include "keypadrenderer.h"
+
+KeyFace::KeyFace(QQuickItem *parent)
+    : QQuickItem(parent)
+    , m_label()
+    , m_shiftedLabel()
+    , m_annotation()
+    , m_shiftedAnnotation()
+    , m_fontSize(0)
+    , m_labelOffset(0)
+    , m_color(Qt::white)
+    , m_pressedColor(Qt::white)
+    , m_pressed(false)
+    , m_selfDrawn(false)
+    , m_renderer()
+{
+}
+
+QString KeyFace::label() const
+{
+    return m_label;
+}
+
+void KeyFace::setLabel(const QString &label)
+{
+    if (label == m_label)
+        return;
+
+    m_label = label;
+    labelsChanged();
+    Q_EMIT labelChanged();
+}
+
+QString KeyFace::shiftedLabel() const
+{
+    return m_shiftedLabel;
+}
+
+void KeyFace::setShiftedLabel(const QString &label)
+{
+    if (label == m_shiftedLabel)
+        return;
+
+    m_shiftedLabel = label;
+    labelsChanged();
+    Q_EMIT shiftedLabelChanged();
+}
+
+QString KeyFace::annotation() const
+{
+    return m_annotation;
+}
+
+void KeyFace::setAnnotation(const QString &annotation)
+{
+    if (annotation == m_annotation)
+        return;
+
+    m_annotation = annotation;
+    labelsChanged();
+    Q_EMIT annotationChanged();
+}
+
+QString KeyFace::shiftedAnnotation() const
+{
+    return m_shiftedAnnotation;
+}
+
+void KeyFace::setShiftedAnnotation(const QString &annotation)
+{
+    if (annotation == m_shiftedAnnotation)
+        return;
+
+    m_shiftedAnnotation = annotation;
+    labelsChanged();
+    Q_EMIT shiftedAnnotationChanged();
+}
+
+//! \brief KeyFace::fontSize pixel size of the label, annotations are a
+//! third of it
+int KeyFace::fontSize() const
+{
+    return m_fontSize;
+}
+
+void KeyFace::setFontSize(int size)
+{
+    if (size == m_fontSize)
+        return;
+
+    m_fontSize = size;
+    labelsChanged();
+    Q_EMIT fontSizeChanged();
+}
+
+//! \brief KeyFace::labelOffset vertical offset of the label from the center
+qreal KeyFace::labelOffset() const
+{
+    return m_labelOffset;
+}
+
+void KeyFace::setLabelOffset(qreal offset)
+{
+    if (offset == m_labelOffset)
+        return;
+
+    m_labelOffset = offset;
+    appearanceChanged();
+    Q_EMIT labelOffsetChanged();
+}
+
+QColor KeyFace::color() const
+{
+    return m_color;
+}
+
+void KeyFace::setColor(const QColor &color)
+{
+    if (color == m_color)
+        return;
+
+    m_color = color;
+    appearanceChanged();
+    Q_EMIT colorChanged();
+}
+
+QColor KeyFace::pressedColor() const
+{
+    return m_pressedColor;
+}
+
+void KeyFace::setPressedColor(const QColor &color)
+{
+    if (color == m_pressedColor)
+        return;
+
+    m_pressedColor = color;
+    appearanceChanged();
+    Q_EMIT pressedColorChanged();
+}
+
+bool KeyFace::pressed() const
+{
+    return m_pressed;
+}
+
+void KeyFace::setPressed(bool pressed)
+{
+    if (pressed == m_pressed)
+        return;
+
+    m_pressed = pressed;
+    appearanceChanged();
+    Q_EMIT pressedChanged();
+}
+
+//! \brief KeyFace::selfDrawn is true inside a Flickable, whose content
+//! scrolls and is clipped without the KeypadRenderer noticing. The key has
+//! to draw the face itself then.
+bool KeyFace::selfDrawn() const
+{
+    return m_selfDrawn;
+}
+
+//! \brief KeyFace::setRenderer is called by the KeypadRenderer drawing
+//! this face, which is told about every change from then on
+void KeyFace::setRenderer(KeypadRenderer *renderer)
+{
+    m_renderer = renderer;
+}
+
+void KeyFace::geometryChanged(const QRectF &newGeometry,
+                              const QRectF &oldGeometry)
+{
+    QQuickItem::geometryChanged(newGeometry, oldGeometry);
+    appearanceChanged();
+}
+
+void KeyFace::itemChange(ItemChange change, const ItemChangeData &value)
+{
+    QQuickItem::itemChange(change, value);
+
+    switch (change) {
+    case ItemSceneChange:
+    case ItemParentHasChanged:
+    case ItemVisibleHasChanged:
+        updateRegistration();
+        break;
+    default:
+        break;
+    }
+}
+
+void KeyFace::labelsChanged()
+{
+    if (m_renderer)
+        m_renderer->markDirty(KeypadRenderer::AtlasDirty);
+}
+
+void KeyFace::appearanceChanged()
+{
+    if (m_renderer)
+        m_renderer->markDirty(KeypadRenderer::VerticesDirty);
+}
+
+//! Faces are loaded and shown after the renderer looked its keypad up, e.g.
+//! by Loaders or delegates, so every face announces itself
+void KeyFace::updateRegistration()
+{
+    KeypadRenderer *renderer = 0;
+    bool flickable = false;
+
+    for (QQuickItem *item = parentItem(); item && !renderer && !flickable; item = item->parentItem()) {
+        if (item->inherits("QQuickFlickable"))
+            flickable = true;
+        else
+            renderer = KeypadRenderer::drawing(item);
+    }
+
+    if (m_renderer && m_renderer != renderer)
+        m_renderer->invalidate();
+    if (renderer)
+        renderer->invalidate();
+
+    if (flickable != m_selfDrawn) {
+        m_selfDrawn = flickable;
+        Q_EMIT selfDrawnChanged();
+    }
+}
@@ -0,0 +1,128 @@
+/*
+ * Copyright (C) 2016 Canonical, Ltd.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this list
+ * of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice, this list
+ * of conditions and the following disclaimer in the documentation and/or other materials
+ * provided with the distribution.
+ * Neither the name of Nokia Corporation nor the names of its contributors may be
+ * used to endorse or promote products derived from this software without specific
+ * prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL
+ * THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#ifndef KEYFACE_H
+#define KEYFACE_H
+
+#include <QQuickItem>
+#include <QColor>
+#include <QPointer>
+
+class KeypadRenderer;
+
+//! \brief The KeyFace class describes the visible part of a key
+//!
+//! It has no content of its own, the KeypadRenderer of the keypad draws all
+//! key faces together. Its geometry is the key's background rectangle. A
+//! face registers with the renderer of the keypad it is shown in whenever it
+//! is added, moved to another parent or shown, so keys created later are
+//! drawn as well. Faces inside a Flickable are not drawn by the renderer,
+//! the key shows its own items for them instead.
+class KeyFace : public QQuickItem
+{
+    Q_OBJECT
+    Q_PROPERTY(QString label READ label WRITE setLabel NOTIFY labelChanged)
+    Q_PROPERTY(QString shiftedLabel READ shiftedLabel WRITE setShiftedLabel NOTIFY shiftedLabelChanged)
+    Q_PROPERTY(QString annotation READ annotation WRITE setAnnotation NOTIFY annotationChanged)
+    Q_PROPERTY(QString shiftedAnnotation READ shiftedAnnotation WRITE setShiftedAnnotation NOTIFY shiftedAnnotationChanged)
+    Q_PROPERTY(int fontSize READ fontSize WRITE setFontSize NOTIFY fontSizeChanged)
+    Q_PROPERTY(qreal labelOffset READ labelOffset WRITE setLabelOffset NOTIFY labelOffsetChanged)
+    Q_PROPERTY(QColor color READ color WRITE setColor NOTIFY colorChanged)
+    Q_PROPERTY(QColor pressedColor READ pressedColor WRITE setPressedColor NOTIFY pressedColorChanged)
+    Q_PROPERTY(bool pressed READ pressed WRITE setPressed NOTIFY pressedChanged)
+    Q_PROPERTY(bool selfDrawn READ selfDrawn NOTIFY selfDrawnChanged)
+
+public:
+    explicit KeyFace(QQuickItem *parent = 0);
+
+    QString label() const;
+    void setLabel(const QString &label);
+
+    QString shiftedLabel() const;
+    void setShiftedLabel(const QString &label);
+
+    QString annotation() const;
+    void setAnnotation(const QString &annotation);
+
+    QString shiftedAnnotation() const;
+    void setShiftedAnnotation(const QString &annotation);
+
+    int fontSize() const;
+    void setFontSize(int size);
+
+    qreal labelOffset() const;
+    void setLabelOffset(qreal offset);
+
+    QColor color() const;
+    void setColor(const QColor &color);
+
+    QColor pressedColor() const;
+    void setPressedColor(const QColor &color);
+
+    bool pressed() const;
+    void setPressed(bool pressed);
+
+    bool selfDrawn() const;
+
+    void setRenderer(KeypadRenderer *renderer);
+
+Q_SIGNALS:
+    void labelChanged();
+    void shiftedLabelChanged();
+    void annotationChanged();
+    void shiftedAnnotationChanged();
+    void fontSizeChanged();
+    void labelOffsetChanged();
+    void colorChanged();
+    void pressedColorChanged();
+    void pressedChanged();
+    void selfDrawnChanged();
+
+protected:
+    virtual void geometryChanged(const QRectF &newGeometry,
+                                 const QRectF &oldGeometry);
+    virtual void itemChange(ItemChange change, const ItemChangeData &value);
+
+private:
+    void labelsChanged();
+    void appearanceChanged();
+    void updateRegistration();
+
+    QString m_label;
+    QString m_shiftedLabel;
+    QString m_annotation;
+    QString m_shiftedAnnotation;
+    int m_fontSize;
+    qreal m_labelOffset;
+    QColor m_color;
+    QColor m_pressedColor;
+    bool m_pressed;
+    bool m_selfDrawn;
+    QPointer<KeypadRenderer> m_renderer;
+};
+
+#endif // KEYFACE_H
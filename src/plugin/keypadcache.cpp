@@ -0,0 +1,477 @@
+/*
+ * Copyright (C) 2016 Canonical, Ltd.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this list
+ * of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice, this list
+ * of conditions and the following disclaimer in the documentation and/or other materials
+ * provided with the distribution.
+ * Neither the name of Nokia Corporation nor the names of its contributors may be
+ * used to endorse or promote products derived from this software without specific
+ * prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL
+ * THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#include "keypadcache.h"
+
+#include <QDebug>
+#include <QQmlComponent>
+#include <QQmlContext>
+#include <QQmlEngine>
+#include <QQmlIncubator>
+
+namespace {
+const QLatin1String KEYPAD_STATE_PROPERTY("maliit_keypad_state");
+}
+
+class KeypadCache::Incubator : public QQmlIncubator
+{
+public:
+    Incubator(KeypadCache *cache, const QString &key, bool emitLoaded,
+              IncubationMode mode, QQmlComponent *component, QQmlContext *context)
+        : QQmlIncubator(mode)
+        , key(key)
+        , emitLoaded(emitLoaded)
+        , component(component)
+        , context(context)
+        , m_cache(cache)
+    {}
+
+    ~Incubator()
+    {
+        // Aborts a running incubation while its context is still alive
+        clear();
+        delete context;
+        delete component;
+    }
+
+    QString key;
+    bool emitLoaded;
+    QQmlComponent *component;
+    //! Owned until the keypad enters the cache
+    QQmlContext *context;
+
+protected:
+    virtual void setInitialState(QObject *object)
+    {
+        QQuickItem *item = qobject_cast<QQuickItem *>(object);
+        if (item) {
+            QQmlEngine::setObjectOwnership(item, QQmlEngine::CppOwnership);
+            item->setParent(m_cache);
+            item->setParentItem(m_cache);
+            m_cache->hide(item);
+        }
+    }
+
+    virtual void statusChanged(Status status)
+    {
+        if (status != Loading)
+            m_cache->onIncubatorStatusChanged();
+    }
+
+private:
+    KeypadCache *m_cache;
+};
+
+KeypadCache::Entry::Entry(const QString &key, QQuickItem *item, QQmlContext *context)
+    : key(key)
+    , item(item)
+    , context(context)
+{}
+
+KeypadCache::KeypadCache(QQuickItem *parent)
+    : QQuickItem(parent)
+    , m_source()
+    , m_orientation(Qt::PrimaryOrientation)
+    , m_capacity(4)
+    , m_item(0)
+    , m_entries()
+    , m_asynchronous(false)
+    , m_status(Null)
+    , m_keypadState()
+    , m_incubator(0)
+    , m_retired()
+{
+}
+
+KeypadCache::~KeypadCache()
+{
+    delete m_incubator;
+    releaseIncubators();
+
+    Q_FOREACH (const Entry &entry, m_entries) {
+        delete entry.item;
+        delete entry.context;
+    }
+}
+
+//! \brief KeypadCache::source returns the layout file of the shown keypad
+QUrl KeypadCache::source() const
+{
+    return m_source;
+}
+
+//! \brief KeypadCache::setSource shows the keypad of the given layout file,
+//! re-using a cached instance if there is one
+//! \param source layout file, relative urls are resolved like in a Loader
+void KeypadCache::setSource(const QUrl &source)
+{
+    if (source == m_source)
+        return;
+
+    m_source = source;
+    Q_EMIT sourceChanged();
+
+    if (isComponentComplete())
+        activate(true);
+}
+
+Qt::ScreenOrientation KeypadCache::orientation() const
+{
+    return m_orientation;
+}
+
+//! \brief KeypadCache::setOrientation keypads are cached per orientation, so
+//! a rotation swaps to an instance that is already laid out for it
+void KeypadCache::setOrientation(Qt::ScreenOrientation orientation)
+{
+    if (orientation == m_orientation)
+        return;
+
+    m_orientation = orientation;
+    Q_EMIT orientationChanged();
+
+    if (isComponentComplete())
+        activate(false);
+}
+
+//! \brief KeypadCache::capacity the maximum number of keypads kept alive,
+//! including the shown one
+int KeypadCache::capacity() const
+{
+    return m_capacity;
+}
+
+void KeypadCache::setCapacity(int capacity)
+{
+    capacity = qMax(1, capacity);
+    if (capacity == m_capacity)
+        return;
+
+    m_capacity = capacity;
+    Q_EMIT capacityChanged();
+
+    const int oldCount = m_entries.count();
+    evict();
+
+    if (m_entries.count() != oldCount)
+        Q_EMIT countChanged();
+}
+
+//! \brief KeypadCache::item returns the shown keypad, or 0 if none could be
+//! loaded
+QQuickItem *KeypadCache::item() const
+{
+    return m_item;
+}
+
+//! \brief KeypadCache::count returns the number of keypads alive, including
+//! the shown one
+int KeypadCache::count() const
+{
+    return m_entries.count();
+}
+
+//! \brief KeypadCache::asynchronous whether keypads that are not cached are
+//! incubated asynchronously
+bool KeypadCache::asynchronous() const
+{
+    return m_asynchronous;
+}
+
+void KeypadCache::setAsynchronous(bool asynchronous)
+{
+    if (asynchronous == m_asynchronous)
+        return;
+
+    m_asynchronous = asynchronous;
+    Q_EMIT asynchronousChanged();
+
+    if (!m_asynchronous && m_incubator && m_incubator->isLoading())
+        m_incubator->forceCompletion();
+}
+
+//! \brief KeypadCache::status returns Loading while a keypad is incubated,
+//! Ready once it is shown
+KeypadCache::Status KeypadCache::status() const
+{
+    return m_status;
+}
+
+//! \brief KeypadCache::keypadState the state of the keyboard (e.g. "SHIFTED")
+//! the keys of the shown keypad see as maliit_keypad_state
+QString KeypadCache::keypadState() const
+{
+    return m_keypadState;
+}
+
+void KeypadCache::setKeypadState(const QString &keypadState)
+{
+    if (keypadState == m_keypadState)
+        return;
+
+    m_keypadState = keypadState;
+    Q_EMIT keypadStateChanged();
+
+    // Only the shown keypad and the one about to replace it follow
+    Q_FOREACH (const Entry &entry, m_entries) {
+        if (entry.item == m_item) {
+            publishKeypadState(entry.context);
+            break;
+        }
+    }
+
+    if (m_incubator)
+        publishKeypadState(m_incubator->context);
+}
+
+//! \brief KeypadCache::clear destroys all hidden keypads
+void KeypadCache::clear()
+{
+    const int oldCount = m_entries.count();
+
+    for (int index = m_entries.count() - 1; index >= 0; --index) {
+        if (m_entries.at(index).item != m_item) {
+            destroy(m_entries.takeAt(index));
+        }
+    }
+
+    if (m_entries.count() != oldCount)
+        Q_EMIT countChanged();
+}
+
+void KeypadCache::componentComplete()
+{
+    QQuickItem::componentComplete();
+    activate(true);
+}
+
+void KeypadCache::geometryChanged(const QRectF &newGeometry,
+                                  const QRectF &oldGeometry)
+{
+    QQuickItem::geometryChanged(newGeometry, oldGeometry);
+
+    if (m_item)
+        m_item->setSize(newGeometry.size());
+}
+
+QString KeypadCache::cacheKey() const
+{
+    return m_source.toString() + QLatin1Char('@') + QString::number(m_orientation);
+}
+
+//! \brief KeypadCache::activate shows the keypad for the current source and
+//! orientation, creating it if it is not cached yet
+//! \param sourceChanged whether loaded() is emitted, like a Loader does when
+//! a new source was loaded
+void KeypadCache::activate(bool sourceChanged)
+{
+    if (m_source.isEmpty()) {
+        cancelIncubation();
+        setCurrent(0);
+        setStatus(Null);
+        return;
+    }
+
+    const QString key(cacheKey());
+
+    for (int index = 0; index < m_entries.count(); ++index) {
+        if (m_entries.at(index).key == key) {
+            cancelIncubation();
+            m_entries.move(index, 0);
+            publishKeypadState(m_entries.first().context);
+            setCurrent(m_entries.first().item);
+            setStatus(Ready);
+
+            if (sourceChanged)
+                Q_EMIT loaded();
+            return;
+        }
+    }
+
+    if (m_incubator && m_incubator->key == key) {
+        m_incubator->emitLoaded |= sourceChanged;
+        return;
+    }
+
+    incubate(key, sourceChanged);
+}
+
+void KeypadCache::incubate(const QString &key, bool sourceChanged)
+{
+    cancelIncubation();
+
+    QQmlContext *parentContext = qmlContext(this);
+    if (!parentContext) {
+        qWarning() << __PRETTY_FUNCTION__ << "has no QML context, cannot load" << m_source;
+        setCurrent(0);
+        setStatus(Error);
+        return;
+    }
+
+    QQmlComponent *component = new QQmlComponent(parentContext->engine(),
+                                                 parentContext->resolvedUrl(m_source),
+                                                 QQmlComponent::PreferSynchronous);
+    if (!component->isReady()) {
+        qWarning() << __PRETTY_FUNCTION__ << "cannot load" << m_source << component->errors();
+        delete component;
+        setCurrent(0);
+        setStatus(Error);
+        return;
+    }
+
+    m_incubator = new Incubator(this, key, sourceChanged,
+                                m_asynchronous ? QQmlIncubator::Asynchronous
+                                               : QQmlIncubator::AsynchronousIfNested,
+                                component, new QQmlContext(parentContext));
+    publishKeypadState(m_incubator->context);
+
+    // The previous keypad stays on screen as a placeholder, but must not
+    // take input meant for the new one.
+    if (m_item)
+        m_item->setEnabled(false);
+
+    setStatus(Loading);
+    component->create(*m_incubator, m_incubator->context);
+}
+
+void KeypadCache::onIncubatorStatusChanged()
+{
+    Incubator *incubator = m_incubator;
+    m_incubator = 0;
+
+    // Bindings reacting to the signals below may start the next incubation,
+    // so this one is only deleted once its callback has returned.
+    m_retired.append(incubator);
+    QMetaObject::invokeMethod(this, "releaseIncubators", Qt::QueuedConnection);
+
+    QQuickItem *item = qobject_cast<QQuickItem *>(incubator->object());
+
+    if (incubator->isError() || !item) {
+        qWarning() << __PRETTY_FUNCTION__ << "cannot create" << m_source << incubator->errors();
+        delete incubator->object();
+        setCurrent(0);
+        setStatus(Error);
+        return;
+    }
+
+    const int oldCount = m_entries.count();
+    m_entries.prepend(Entry(incubator->key, item, incubator->context));
+    incubator->context = 0;
+
+    setCurrent(item);
+    evict();
+    setStatus(Ready);
+
+    if (m_entries.count() != oldCount)
+        Q_EMIT countChanged();
+
+    if (incubator->emitLoaded)
+        Q_EMIT loaded();
+}
+
+void KeypadCache::cancelIncubation()
+{
+    if (!m_incubator)
+        return;
+
+    delete m_incubator;
+    m_incubator = 0;
+
+    if (m_item)
+        m_item->setEnabled(true);
+}
+
+void KeypadCache::releaseIncubators()
+{
+    qDeleteAll(m_retired);
+    m_retired.clear();
+}
+
+void KeypadCache::setCurrent(QQuickItem *item)
+{
+    if (item == m_item) {
+        if (m_item)
+            show(m_item);
+        return;
+    }
+
+    if (m_item)
+        hide(m_item);
+
+    m_item = item;
+
+    if (m_item)
+        show(m_item);
+
+    Q_EMIT itemChanged();
+}
+
+void KeypadCache::setStatus(Status status)
+{
+    if (status == m_status)
+        return;
+
+    m_status = status;
+    Q_EMIT statusChanged();
+}
+
+void KeypadCache::publishKeypadState(QQmlContext *context)
+{
+    const QVariant published(context->contextProperty(KEYPAD_STATE_PROPERTY));
+    if (!published.isValid() || published.toString() != m_keypadState)
+        context->setContextProperty(KEYPAD_STATE_PROPERTY, m_keypadState);
+}
+
+void KeypadCache::show(QQuickItem *item)
+{
+    item->setSize(QSizeF(width(), height()));
+    item->setEnabled(true);
+    item->setVisible(true);
+}
+
+void KeypadCache::hide(QQuickItem *item)
+{
+    item->setVisible(false);
+    item->setEnabled(false);
+}
+
+//! \brief KeypadCache::evict destroys the least recently used keypads beyond
+//! the capacity. The shown keypad is always the most recently used one.
+void KeypadCache::evict()
+{
+    while (m_entries.count() > m_capacity && m_entries.last().item != m_item) {
+        destroy(m_entries.takeLast());
+    }
+}
+
+void KeypadCache::destroy(const Entry &entry)
+{
+    // The context has to outlive the item's bindings, so it goes second.
+    entry.item->setParentItem(0);
+    entry.item->deleteLater();
+    entry.context->deleteLater();
+}
@@ -0,0 +1,159 @@
+/*
+ * Copyright (C) 2016 Canonical, Ltd.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this list
+ * of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice, this list
+ * of conditions and the following disclaimer in the documentation and/or other materials
+ * provided with the distribution.
+ * Neither the name of Nokia Corporation nor the names of its contributors may be
+ * used to endorse or promote products derived from this software without specific
+ * prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL
+ * THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#ifndef KEYPADCACHE_H
+#define KEYPADCACHE_H
+
+#include <QQuickItem>
+#include <QList>
+#include <QUrl>
+
+class QQmlContext;
+
+//! \brief The KeypadCache class keeps recently used keypads alive
+//!
+//! It is used in place of a Loader for the keypad. Every keypad that was
+//! shown is kept as a hidden child, keyed by its layout file and the
+//! screen orientation, so switching back to it only toggles visibility
+//! instead of instantiating the QML again. The least recently used keypads
+//! are destroyed once more than \a capacity are cached.
+//!
+//! With \a asynchronous set, keypads that are not cached yet are incubated
+//! in slices by the engine's incubation controller. The previous keypad,
+//! if any, stays visible but disabled until the new one is complete. Keys
+//! only take input once the whole keypad is: a QQmlIncubator completes the
+//! object tree at once, and until then rows are neither laid out nor
+//! bound to the keyboard's state.
+//!
+//! Hidden keypads are disabled and should not react to the keyboard's
+//! state either: \a keypadState is handed to the keys as the context
+//! property maliit_keypad_state of the shown keypad only, so bindings of
+//! hidden keypads stay as they were until they are shown again.
+class KeypadCache : public QQuickItem
+{
+    Q_OBJECT
+    Q_ENUMS(Status)
+    Q_PROPERTY(QUrl source READ source WRITE setSource NOTIFY sourceChanged)
+    Q_PROPERTY(Qt::ScreenOrientation orientation READ orientation WRITE setOrientation NOTIFY orientationChanged)
+    Q_PROPERTY(int capacity READ capacity WRITE setCapacity NOTIFY capacityChanged)
+    Q_PROPERTY(QQuickItem *item READ item NOTIFY itemChanged)
+    Q_PROPERTY(int count READ count NOTIFY countChanged)
+    Q_PROPERTY(bool asynchronous READ asynchronous WRITE setAsynchronous NOTIFY asynchronousChanged)
+    Q_PROPERTY(Status status READ status NOTIFY statusChanged)
+    Q_PROPERTY(QString keypadState READ keypadState WRITE setKeypadState NOTIFY keypadStateChanged)
+
+public:
+    enum Status {
+        Null,
+        Ready,
+        Loading,
+        Error
+    };
+
+    explicit KeypadCache(QQuickItem *parent = 0);
+    virtual ~KeypadCache();
+
+    QUrl source() const;
+    void setSource(const QUrl &source);
+
+    Qt::ScreenOrientation orientation() const;
+    void setOrientation(Qt::ScreenOrientation orientation);
+
+    int capacity() const;
+    void setCapacity(int capacity);
+
+    QQuickItem *item() const;
+    int count() const;
+
+    bool asynchronous() const;
+    void setAsynchronous(bool asynchronous);
+
+    Status status() const;
+
+    QString keypadState() const;
+    void setKeypadState(const QString &keypadState);
+
+    Q_INVOKABLE void clear();
+
+Q_SIGNALS:
+    void sourceChanged();
+    void orientationChanged();
+    void capacityChanged();
+    void itemChanged();
+    void countChanged();
+    void asynchronousChanged();
+    void statusChanged();
+    void keypadStateChanged();
+    void loaded();
+
+protected:
+    virtual void componentComplete();
+    virtual void geometryChanged(const QRectF &newGeometry,
+                                 const QRectF &oldGeometry);
+
+private:
+    class Incubator;
+    friend class Incubator;
+
+    struct Entry
+    {
+        Entry(const QString &key, QQuickItem *item, QQmlContext *context);
+
+        QString key;
+        QQuickItem *item;
+        QQmlContext *context;
+    };
+
+    QString cacheKey() const;
+    void activate(bool sourceChanged);
+    void incubate(const QString &key, bool sourceChanged);
+    void onIncubatorStatusChanged();
+    void cancelIncubation();
+    Q_SLOT void releaseIncubators();
+    void setCurrent(QQuickItem *item);
+    void setStatus(Status status);
+    void publishKeypadState(QQmlContext *context);
+    void show(QQuickItem *item);
+    void hide(QQuickItem *item);
+    void evict();
+    void destroy(const Entry &entry);
+
+    QUrl m_source;
+    Qt::ScreenOrientation m_orientation;
+    int m_capacity;
+    QQuickItem *m_item;
+    //! Most recently used first
+    QList<Entry> m_entries;
+    bool m_asynchronous;
+    Status m_status;
+    QString m_keypadState;
+    Incubator *m_incubator;
+    //! Finished incubators, deleted once their callbacks have returned
+    QList<Incubator *> m_retired;
+};
+
+#endif // KEYPADCACHE_H
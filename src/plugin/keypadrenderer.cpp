@@ -0,0 +1,658 @@
+/*
+ * Copyright (C) 2016 Canonical, Ltd.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this list
+ * of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice, this list
+ * of conditions and the following disclaimer in the documentation and/or other materials
+ * provided with the distribution.
+ * Neither the name of Nokia Corporation nor the names of its contributors may be
+ * used to endorse or promote products derived from this software without specific
+ * prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL
+ * THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#include "keypadrenderer.h"
+#include "keyface.h"
+#include "glyphatlas.h"
+
+#include <QQuickWindow>
+#include <QSGGeometryNode>
+#include <QSGMaterial>
+#include <QSGTexture>
+#include <QOpenGLShaderProgram>
+
+namespace {
+
+const int VerticesPerFace = 16 + 4 + 4; // frame grid, label, annotation
+const int IndicesPerFace = 9 * 6 + 6 + 6;
+
+const QSGGeometry::AttributeSet &vertexAttributes()
+{
+    static QSGGeometry::Attribute attributes[] = {
+        QSGGeometry::Attribute::create(0, 2, GL_FLOAT, true),
+        QSGGeometry::Attribute::create(1, 2, GL_FLOAT),
+        QSGGeometry::Attribute::create(2, 4, GL_UNSIGNED_BYTE)
+    };
+    static QSGGeometry::AttributeSet set = { 3, 4 * sizeof(float) + 4 * sizeof(unsigned char), attributes };
+    return set;
+}
+
+//! Atlas texels modulated by the premultiplied vertex color. White texels
+//! take the color as a tint, color glyphs get a white vertex color.
+class AtlasMaterial : public QSGMaterial
+{
+public:
+    AtlasMaterial()
+        : m_texture(0)
+    {
+        setFlag(Blending);
+    }
+
+    ~AtlasMaterial()
+    {
+        delete m_texture;
+    }
+
+    QSGTexture *texture() const
+    {
+        return m_texture;
+    }
+
+    void setTexture(QSGTexture *texture)
+    {
+        delete m_texture;
+        m_texture = texture;
+    }
+
+    virtual QSGMaterialType *type() const
+    {
+        static QSGMaterialType type;
+        return &type;
+    }
+
+    virtual QSGMaterialShader *createShader() const;
+
+    virtual int compare(const QSGMaterial *other) const
+    {
+        const AtlasMaterial *material(static_cast<const AtlasMaterial *>(other));
+        return m_texture->textureId() - material->m_texture->textureId();
+    }
+
+private:
+    QSGTexture *m_texture;
+};
+
+class AtlasShader : public QSGMaterialShader
+{
+public:
+    AtlasShader()
+        : m_matrix(-1)
+        , m_opacity(-1)
+    {}
+
+    virtual const char *vertexShader() const
+    {
+        return "uniform highp mat4 qt_Matrix;\n"
+               "attribute highp vec4 position;\n"
+               "attribute highp vec2 texCoord;\n"
+               "attribute lowp vec4 color;\n"
+               "varying highp vec2 vTexCoord;\n"
+               "varying lowp vec4 vColor;\n"
+               "void main() {\n"
+               "    vTexCoord = texCoord;\n"
+               "    vColor = color;\n"
+               "    gl_Position = qt_Matrix * position;\n"
+               "}\n";
+    }
+
+    virtual const char *fragmentShader() const
+    {
+        return "uniform sampler2D atlas;\n"
+               "uniform lowp float qt_Opacity;\n"
+               "varying highp vec2 vTexCoord;\n"
+               "varying lowp vec4 vColor;\n"
+               "void main() {\n"
+               "    gl_FragColor = texture2D(atlas, vTexCoord) * vColor * qt_Opacity;\n"
+               "}\n";
+    }
+
+    virtual char const *const *attributeNames() const
+    {
+        static const char *const names[] = { "position", "texCoord", "color", 0 };
+        return names;
+    }
+
+    virtual void updateState(const RenderState &state, QSGMaterial *newMaterial,
+                             QSGMaterial *oldMaterial)
+    {
+        Q_UNUSED(oldMaterial);
+
+        if (state.isMatrixDirty())
+            program()->setUniformValue(m_matrix, state.combinedMatrix());
+        if (state.isOpacityDirty())
+            program()->setUniformValue(m_opacity, state.opacity());
+
+        static_cast<AtlasMaterial *>(newMaterial)->texture()->bind();
+    }
+
+protected:
+    virtual void initialize()
+    {
+        m_matrix = program()->uniformLocation("qt_Matrix");
+        m_opacity = program()->uniformLocation("qt_Opacity");
+    }
+
+private:
+    int m_matrix;
+    int m_opacity;
+};
+
+QSGMaterialShader *AtlasMaterial::createShader() const
+{
+    return new AtlasShader;
+}
+
+class KeypadNode : public QSGGeometryNode
+{
+public:
+    KeypadNode()
+        : m_material(new AtlasMaterial)
+    {
+        QSGGeometry *geometry = new QSGGeometry(vertexAttributes(), 0, 0, GL_UNSIGNED_SHORT);
+        geometry->setDrawingMode(GL_TRIANGLES);
+        setGeometry(geometry);
+        setMaterial(m_material);
+        setFlags(OwnsGeometry | OwnsMaterial);
+    }
+
+    AtlasMaterial *atlasMaterial() const
+    {
+        return m_material;
+    }
+
+private:
+    AtlasMaterial *m_material;
+};
+
+QList<KeypadRenderer *> &renderers()
+{
+    static QList<KeypadRenderer *> list;
+    return list;
+}
+
+void addQuadIndices(quint16 *indices, int topLeft, int topRight, int bottomLeft, int bottomRight)
+{
+    indices[0] = topLeft;
+    indices[1] = topRight;
+    indices[2] = bottomLeft;
+    indices[3] = topRight;
+    indices[4] = bottomRight;
+    indices[5] = bottomLeft;
+}
+
+} // unnamed namespace
+
+void KeypadRenderer::Vertex::set(qreal x, qreal y, qreal u, qreal v, const QColor &color)
+{
+    this->x = x;
+    this->y = y;
+    this->u = u;
+    this->v = v;
+
+    // Premultiplied, like the atlas
+    const int alpha = color.alpha();
+    r = color.red() * alpha / 255;
+    g = color.green() * alpha / 255;
+    b = color.blue() * alpha / 255;
+    a = alpha;
+}
+
+KeypadRenderer::KeypadRenderer(QQuickItem *parent)
+    : QQuickItem(parent)
+    , m_keypad()
+    , m_shifted(false)
+    , m_labelsVisible(true)
+    , m_font()
+    , m_fontColor(Qt::black)
+    , m_annotationColor(Qt::black)
+    , m_radius(0)
+    , m_labelMargin(0)
+    , m_annotationMargins()
+    , m_dirty(FacesDirty)
+    , m_faces()
+    , m_atlas()
+    , m_atlasChanged(false)
+    , m_vertices()
+    , m_indices()
+    , m_indicesChanged(false)
+{
+    setFlag(ItemHasContents);
+    renderers().append(this);
+}
+
+KeypadRenderer::~KeypadRenderer()
+{
+    renderers().removeOne(this);
+}
+
+//! \brief KeypadRenderer::keypad returns the item whose key faces are drawn
+QQuickItem *KeypadRenderer::keypad() const
+{
+    return m_keypad;
+}
+
+void KeypadRenderer::setKeypad(QQuickItem *keypad)
+{
+    if (keypad == m_keypad)
+        return;
+
+    if (m_keypad)
+        disconnect(m_keypad, 0, this, 0);
+
+    m_keypad = keypad;
+
+    // Keys move along with the keypad's size, and not all of them resize
+    if (m_keypad) {
+        connect(m_keypad, SIGNAL(widthChanged()), this, SLOT(invalidate()));
+        connect(m_keypad, SIGNAL(heightChanged()), this, SLOT(invalidate()));
+    }
+
+    invalidate();
+    Q_EMIT keypadChanged();
+}
+
+//! \brief KeypadRenderer::shifted whether the shifted labels are shown
+bool KeypadRenderer::shifted() const
+{
+    return m_shifted;
+}
+
+void KeypadRenderer::setShifted(bool shifted)
+{
+    if (shifted == m_shifted)
+        return;
+
+    m_shifted = shifted;
+    markDirty(VerticesDirty);
+    Q_EMIT shiftedChanged();
+}
+
+bool KeypadRenderer::labelsVisible() const
+{
+    return m_labelsVisible;
+}
+
+void KeypadRenderer::setLabelsVisible(bool visible)
+{
+    if (visible == m_labelsVisible)
+        return;
+
+    m_labelsVisible = visible;
+    markDirty(VerticesDirty);
+    Q_EMIT labelsVisibleChanged();
+}
+
+//! \brief KeypadRenderer::font the font of labels and annotations, the
+//! pixel size comes from each key face
+QFont KeypadRenderer::font() const
+{
+    return m_font;
+}
+
+void KeypadRenderer::setFont(const QFont &font)
+{
+    if (font == m_font)
+        return;
+
+    m_font = font;
+    markDirty(AtlasDirty);
+    Q_EMIT fontChanged();
+}
+
+QColor KeypadRenderer::fontColor() const
+{
+    return m_fontColor;
+}
+
+void KeypadRenderer::setFontColor(const QColor &color)
+{
+    if (color == m_fontColor)
+        return;
+
+    m_fontColor = color;
+    markDirty(VerticesDirty);
+    Q_EMIT fontColorChanged();
+}
+
+QColor KeypadRenderer::annotationColor() const
+{
+    return m_annotationColor;
+}
+
+void KeypadRenderer::setAnnotationColor(const QColor &color)
+{
+    if (color == m_annotationColor)
+        return;
+
+    m_annotationColor = color;
+    markDirty(VerticesDirty);
+    Q_EMIT annotationColorChanged();
+}
+
+//! \brief KeypadRenderer::radius corner radius of the key backgrounds
+qreal KeypadRenderer::radius() const
+{
+    return m_radius;
+}
+
+void KeypadRenderer::setRadius(qreal radius)
+{
+    if (radius == m_radius)
+        return;
+
+    m_radius = radius;
+    markDirty(AtlasDirty);
+    Q_EMIT radiusChanged();
+}
+
+//! \brief KeypadRenderer::labelMargin horizontal space kept free left and
+//! right of a label
+qreal KeypadRenderer::labelMargin() const
+{
+    return m_labelMargin;
+}
+
+void KeypadRenderer::setLabelMargin(qreal margin)
+{
+    if (margin == m_labelMargin)
+        return;
+
+    m_labelMargin = margin;
+    markDirty(VerticesDirty);
+    Q_EMIT labelMarginChanged();
+}
+
+//! \brief KeypadRenderer::annotationMargins distance of the annotation from
+//! the right (x) and top (y) edge of the key
+QPointF KeypadRenderer::annotationMargins() const
+{
+    return m_annotationMargins;
+}
+
+void KeypadRenderer::setAnnotationMargins(const QPointF &margins)
+{
+    if (margins == m_annotationMargins)
+        return;
+
+    m_annotationMargins = margins;
+    markDirty(VerticesDirty);
+    Q_EMIT annotationMarginsChanged();
+}
+
+//! \brief KeypadRenderer::invalidate looks up the key faces again, to be
+//! called when keys were added or removed
+void KeypadRenderer::invalidate()
+{
+    markDirty(FacesDirty);
+}
+
+//! \brief KeypadRenderer::drawing returns the renderer drawing the faces of
+//! \a keypad, or 0 if there is none
+KeypadRenderer *KeypadRenderer::drawing(const QQuickItem *keypad)
+{
+    Q_FOREACH (KeypadRenderer *renderer, renderers()) {
+        if (renderer->m_keypad == keypad)
+            return renderer;
+    }
+
+    return 0;
+}
+
+void KeypadRenderer::updatePolish()
+{
+    if (m_dirty & FacesDirty) {
+        QList<QPointer<KeyFace> > faces;
+        faces.swap(m_faces);
+
+        if (m_keypad)
+            collect(m_keypad);
+
+        Q_FOREACH (const QPointer<KeyFace> &face, faces) {
+            if (face && !m_faces.contains(face))
+                face->setRenderer(0);
+        }
+
+        buildIndices();
+        m_dirty |= AtlasDirty;
+    }
+
+    if (m_dirty & AtlasDirty) {
+        buildAtlas();
+        m_dirty |= VerticesDirty;
+    }
+
+    if (m_dirty & VerticesDirty)
+        buildVertices();
+
+    m_dirty = 0;
+    update();
+}
+
+QSGNode *KeypadRenderer::updatePaintNode(QSGNode *oldNode, UpdatePaintNodeData *data)
+{
+    Q_UNUSED(data);
+
+    KeypadNode *node = static_cast<KeypadNode *>(oldNode);
+
+    if (m_vertices.isEmpty() || !m_atlas) {
+        delete node;
+        return 0;
+    }
+
+    if (!node)
+        node = new KeypadNode;
+
+    QSGNode::DirtyState dirty = QSGNode::DirtyGeometry;
+
+    if (m_atlasChanged || !node->atlasMaterial()->texture()) {
+        QSGTexture *texture = window()->createTextureFromImage(m_atlas->image());
+        texture->setFiltering(QSGTexture::Linear);
+        node->atlasMaterial()->setTexture(texture);
+        m_atlasChanged = false;
+        dirty |= QSGNode::DirtyMaterial;
+    }
+
+    QSGGeometry *geometry = node->geometry();
+    if (m_indicesChanged || geometry->vertexCount() != m_vertices.count()) {
+        geometry->allocate(m_vertices.count(), m_indices.count());
+        memcpy(geometry->indexDataAsUShort(), m_indices.constData(),
+               m_indices.count() * sizeof(quint16));
+        m_indicesChanged = false;
+    }
+
+    memcpy(geometry->vertexData(), m_vertices.constData(),
+           m_vertices.count() * sizeof(Vertex));
+    node->markDirty(dirty);
+
+    return node;
+}
+
+void KeypadRenderer::markDirty(int flags)
+{
+    m_dirty |= flags;
+    polish();
+}
+
+void KeypadRenderer::collect(QQuickItem *item)
+{
+    if (!item->isVisible())
+        return;
+
+    // Flickable content scrolls without the faces moving, see KeyFace
+    if (item->inherits("QQuickFlickable"))
+        return;
+
+    KeyFace *face = qobject_cast<KeyFace *>(item);
+    if (face) {
+        face->setRenderer(this);
+        m_faces.append(face);
+    }
+
+    Q_FOREACH (QQuickItem *child, item->childItems()) {
+        collect(child);
+    }
+}
+
+void KeypadRenderer::buildAtlas()
+{
+    QSet<QString> labels;
+
+    Q_FOREACH (const QPointer<KeyFace> &face, m_faces) {
+        if (!face || face->fontSize() <= 0)
+            continue;
+
+        const QString texts[] = { face->label(), face->shiftedLabel(),
+                                  face->annotation(), face->shiftedAnnotation() };
+        for (int index = 0; index < 4; ++index) {
+            if (texts[index].trimmed().isEmpty())
+                continue;
+
+            const int pixelSize = index < 2 ? face->fontSize() : face->fontSize() / 3;
+            labels.insert(GlyphAtlas::labelKey(texts[index], pixelSize));
+        }
+    }
+
+    const qreal devicePixelRatio = window() ? window()->devicePixelRatio() : 1;
+    QSharedPointer<GlyphAtlas> atlas(GlyphAtlas::get(m_font, m_radius, devicePixelRatio, labels));
+
+    if (atlas != m_atlas) {
+        m_atlas = atlas;
+        m_atlasChanged = true;
+    }
+}
+
+void KeypadRenderer::buildIndices()
+{
+    m_indices.resize(m_faces.count() * IndicesPerFace);
+    quint16 *indices = m_indices.data();
+
+    for (int face = 0; face < m_faces.count(); ++face) {
+        const int base = face * VerticesPerFace;
+
+        // The frame is a 4x4 grid of vertices, stretched in the middle
+        for (int row = 0; row < 3; ++row) {
+            for (int column = 0; column < 3; ++column) {
+                const int topLeft = base + row * 4 + column;
+                addQuadIndices(indices, topLeft, topLeft + 1, topLeft + 4, topLeft + 5);
+                indices += 6;
+            }
+        }
+
+        for (int quad = 0; quad < 2; ++quad) {
+            const int topLeft = base + 16 + quad * 4;
+            addQuadIndices(indices, topLeft, topLeft + 1, topLeft + 2, topLeft + 3);
+            indices += 6;
+        }
+    }
+
+    m_indicesChanged = true;
+}
+
+void KeypadRenderer::buildVertices()
+{
+    m_vertices.resize(m_faces.count() * VerticesPerFace);
+    if (!m_atlas)
+        return;
+
+    Vertex *vertices = m_vertices.data();
+
+    Q_FOREACH (const QPointer<KeyFace> &face, m_faces) {
+        if (!face) {
+            // Collapsed until the faces are looked up again
+            memset(vertices, 0, VerticesPerFace * sizeof(Vertex));
+            vertices += VerticesPerFace;
+            continue;
+        }
+
+        const QRectF rect(mapRectFromItem(face, QRectF(0, 0, face->width(), face->height())));
+        vertices = addFrame(vertices, rect, face->pressed() ? face->pressedColor() : face->color());
+
+        const QString label(m_shifted ? face->shiftedLabel() : face->label());
+        vertices = addLabel(vertices, GlyphAtlas::labelKey(label, face->fontSize()),
+                            rect.adjusted(m_labelMargin, 0, -m_labelMargin, 0)
+                                .translated(0, face->labelOffset()),
+                            Qt::AlignCenter, m_fontColor);
+
+        const QString annotation(m_shifted ? face->shiftedAnnotation() : face->annotation());
+        vertices = addLabel(vertices, GlyphAtlas::labelKey(annotation, face->fontSize() / 3),
+                            rect.adjusted(0, m_annotationMargins.y(), -m_annotationMargins.x(), 0),
+                            Qt::AlignRight | Qt::AlignTop, m_annotationColor);
+    }
+}
+
+KeypadRenderer::Vertex *KeypadRenderer::addFrame(Vertex *vertices, const QRectF &rect,
+                                                 const QColor &color) const
+{
+    const qreal radius = qMin(m_atlas->radius(), qMin(rect.width(), rect.height()) / 2);
+    const QRectF &texCoords(m_atlas->frame().texCoords);
+
+    const qreal xs[] = { rect.left(), rect.left() + radius, rect.right() - radius, rect.right() };
+    const qreal ys[] = { rect.top(), rect.top() + radius, rect.bottom() - radius, rect.bottom() };
+    const qreal us[] = { texCoords.left(), texCoords.center().x(), texCoords.center().x(), texCoords.right() };
+    const qreal vs[] = { texCoords.top(), texCoords.center().y(), texCoords.center().y(), texCoords.bottom() };
+
+    for (int row = 0; row < 4; ++row) {
+        for (int column = 0; column < 4; ++column) {
+            vertices[row * 4 + column].set(xs[column], ys[row], us[column], vs[row], color);
+        }
+    }
+
+    return vertices + 16;
+}
+
+KeypadRenderer::Vertex *KeypadRenderer::addLabel(Vertex *vertices, const QString &labelKey,
+                                                 const QRectF &bounds, Qt::Alignment alignment,
+                                                 const QColor &color) const
+{
+    const GlyphAtlas::Glyph glyph(m_atlas->glyph(labelKey));
+
+    if (!m_labelsVisible || glyph.size.isEmpty()) {
+        memset(vertices, 0, 4 * sizeof(Vertex));
+        return vertices + 4;
+    }
+
+    // Labels too wide for the key are scaled down instead of elided
+    QSizeF size(glyph.size);
+    if (size.width() > bounds.width() && bounds.width() > 0)
+        size *= bounds.width() / size.width();
+
+    const qreal x = (alignment & Qt::AlignRight) ? bounds.right() - size.width()
+                                                 : bounds.center().x() - size.width() / 2;
+    const qreal y = (alignment & Qt::AlignTop) ? bounds.top()
+                                               : bounds.center().y() - size.height() / 2;
+    const QRectF &texCoords(glyph.texCoords);
+
+    // Color glyphs such as emoji keep their own colors
+    const QColor tint(glyph.color ? QColor(255, 255, 255, color.alpha()) : color);
+
+    vertices[0].set(x, y, texCoords.left(), texCoords.top(), tint);
+    vertices[1].set(x + size.width(), y, texCoords.right(), texCoords.top(), tint);
+    vertices[2].set(x, y + size.height(), texCoords.left(), texCoords.bottom(), tint);
+    vertices[3].set(x + size.width(), y + size.height(), texCoords.right(), texCoords.bottom(), tint);
+
+    return vertices + 4;
+}
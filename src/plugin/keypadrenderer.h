@@ -0,0 +1,164 @@
+/*
+ * Copyright (C) 2016 Canonical, Ltd.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this list
+ * of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice, this list
+ * of conditions and the following disclaimer in the documentation and/or other materials
+ * provided with the distribution.
+ * Neither the name of Nokia Corporation nor the names of its contributors may be
+ * used to endorse or promote products derived from this software without specific
+ * prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL
+ * THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#ifndef KEYPADRENDERER_H
+#define KEYPADRENDERER_H
+
+#include <QQuickItem>
+#include <QColor>
+#include <QFont>
+#include <QList>
+#include <QPointer>
+#include <QSharedPointer>
+#include <QVector>
+
+class GlyphAtlas;
+class KeyFace;
+
+//! \brief The KeypadRenderer class draws all key faces of a keypad
+//!
+//! Backgrounds, labels and annotations of every KeyFace are drawn as one
+//! scene graph geometry node, textured from a GlyphAtlas holding both the
+//! normal and the shifted labels. Toggling shift or pressing a key only
+//! rewrites vertices, no text is laid out again and no nodes are created.
+//! Key faces inside a Flickable scroll and are clipped with it, so they are
+//! left to draw themselves, see KeyFace::selfDrawn.
+class KeypadRenderer : public QQuickItem
+{
+    Q_OBJECT
+    Q_PROPERTY(QQuickItem *keypad READ keypad WRITE setKeypad NOTIFY keypadChanged)
+    Q_PROPERTY(bool shifted READ shifted WRITE setShifted NOTIFY shiftedChanged)
+    Q_PROPERTY(bool labelsVisible READ labelsVisible WRITE setLabelsVisible NOTIFY labelsVisibleChanged)
+    Q_PROPERTY(QFont font READ font WRITE setFont NOTIFY fontChanged)
+    Q_PROPERTY(QColor fontColor READ fontColor WRITE setFontColor NOTIFY fontColorChanged)
+    Q_PROPERTY(QColor annotationColor READ annotationColor WRITE setAnnotationColor NOTIFY annotationColorChanged)
+    Q_PROPERTY(qreal radius READ radius WRITE setRadius NOTIFY radiusChanged)
+    Q_PROPERTY(qreal labelMargin READ labelMargin WRITE setLabelMargin NOTIFY labelMarginChanged)
+    Q_PROPERTY(QPointF annotationMargins READ annotationMargins WRITE setAnnotationMargins NOTIFY annotationMarginsChanged)
+
+public:
+    explicit KeypadRenderer(QQuickItem *parent = 0);
+    virtual ~KeypadRenderer();
+
+    QQuickItem *keypad() const;
+    void setKeypad(QQuickItem *keypad);
+
+    bool shifted() const;
+    void setShifted(bool shifted);
+
+    bool labelsVisible() const;
+    void setLabelsVisible(bool visible);
+
+    QFont font() const;
+    void setFont(const QFont &font);
+
+    QColor fontColor() const;
+    void setFontColor(const QColor &color);
+
+    QColor annotationColor() const;
+    void setAnnotationColor(const QColor &color);
+
+    qreal radius() const;
+    void setRadius(qreal radius);
+
+    qreal labelMargin() const;
+    void setLabelMargin(qreal margin);
+
+    QPointF annotationMargins() const;
+    void setAnnotationMargins(const QPointF &margins);
+
+    Q_SLOT void invalidate();
+
+    static KeypadRenderer *drawing(const QQuickItem *keypad);
+
+Q_SIGNALS:
+    void keypadChanged();
+    void shiftedChanged();
+    void labelsVisibleChanged();
+    void fontChanged();
+    void fontColorChanged();
+    void annotationColorChanged();
+    void radiusChanged();
+    void labelMarginChanged();
+    void annotationMarginsChanged();
+
+protected:
+    virtual void updatePolish();
+    virtual QSGNode *updatePaintNode(QSGNode *node, UpdatePaintNodeData *data);
+
+private:
+    friend class KeyFace;
+
+    enum DirtyFlag {
+        FacesDirty = 0x1,
+        AtlasDirty = 0x2,
+        VerticesDirty = 0x4
+    };
+
+    struct Vertex
+    {
+        void set(qreal x, qreal y, qreal u, qreal v, const QColor &color);
+
+        float x;
+        float y;
+        float u;
+        float v;
+        unsigned char r;
+        unsigned char g;
+        unsigned char b;
+        unsigned char a;
+    };
+
+    void markDirty(int flags);
+    void collect(QQuickItem *item);
+    void buildAtlas();
+    void buildIndices();
+    void buildVertices();
+    Vertex *addFrame(Vertex *vertices, const QRectF &rect, const QColor &color) const;
+    Vertex *addLabel(Vertex *vertices, const QString &labelKey, const QRectF &bounds,
+                     Qt::Alignment alignment, const QColor &color) const;
+
+    QPointer<QQuickItem> m_keypad;
+    bool m_shifted;
+    bool m_labelsVisible;
+    QFont m_font;
+    QColor m_fontColor;
+    QColor m_annotationColor;
+    qreal m_radius;
+    qreal m_labelMargin;
+    QPointF m_annotationMargins;
+
+    int m_dirty;
+    QList<QPointer<KeyFace> > m_faces;
+    QSharedPointer<GlyphAtlas> m_atlas;
+    bool m_atlasChanged;
+    QVector<Vertex> m_vertices;
+    QVector<quint16> m_indices;
+    bool m_indicesChanged;
+};
+
+#endif // KEYPADRENDERER_H
@@ -0,0 +1,219 @@
+/*
+ * Copyright (C) 2016 Canonical, Ltd.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this list
+ * of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice, this list
+ * of conditions and the following disclaimer in the documentation and/or other materials
+ * provided with the distribution.
+ * Neither the name of Nokia Corporation nor the names of its contributors may be
+ * used to endorse or promote products derived from this software without specific
+ * prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL
+ * THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#include "keytoucharea.h"
+
+#include <QTimerEvent>
+#include <QMouseEvent>
+
+namespace {
+
+const int HoldInterval = 300;
+const int DoubleClickInterval = 400; // Default Qt double click interval
+
+} // unnamed namespace
+
+KeyTouchArea::KeyTouchArea(QQuickItem *parent)
+    : QQuickItem(parent)
+    , m_acceptDoubleClick(false)
+    , m_held(false)
+    , m_touched(false)
+    , m_pos()
+    , m_startY(0)
+    , m_holdTimer()
+    , m_doubleClickTimer()
+{
+    setAcceptedMouseButtons(Qt::LeftButton);
+}
+
+bool KeyTouchArea::acceptDoubleClick() const
+{
+    return m_acceptDoubleClick;
+}
+
+void KeyTouchArea::setAcceptDoubleClick(bool accept)
+{
+    if (accept == m_acceptDoubleClick)
+        return;
+
+    m_acceptDoubleClick = accept;
+    Q_EMIT acceptDoubleClickChanged();
+}
+
+//! \brief KeyTouchArea::held is true once pressAndHold() was emitted, until
+//! the touch point is released
+bool KeyTouchArea::held() const
+{
+    return m_held;
+}
+
+qreal KeyTouchArea::mouseX() const
+{
+    return m_pos.x();
+}
+
+qreal KeyTouchArea::mouseY() const
+{
+    return m_pos.y();
+}
+
+//! \brief KeyTouchArea::startY the vertical position the touch started at
+qreal KeyTouchArea::startY() const
+{
+    return m_startY;
+}
+
+//! \brief KeyTouchArea::isTouched returns whether a touch point is assigned
+//! to this area
+bool KeyTouchArea::isTouched() const
+{
+    return m_touched;
+}
+
+//! \brief KeyTouchArea::press starts a touch on this area
+//! \param lastPressed the area that was pressed before. Quickly tapping a
+//! key, then another, then the first again is not a double click.
+//! \return whether this area now counts as the last pressed one
+bool KeyTouchArea::press(const QPointF &pos, const KeyTouchArea *lastPressed)
+{
+    m_touched = true;
+    setPosition(pos);
+    setHeld(false);
+
+    if (m_startY != pos.y()) {
+        m_startY = pos.y();
+        Q_EMIT startYChanged();
+    }
+
+    m_holdTimer.start(HoldInterval, this);
+    Q_EMIT pressed();
+
+    if (m_doubleClickTimer.isValid()
+            && !m_doubleClickTimer.hasExpired(DoubleClickInterval)) {
+        if (lastPressed == this)
+            Q_EMIT doubleClicked();
+        return false;
+    }
+
+    if (m_acceptDoubleClick)
+        m_doubleClickTimer.start();
+    return true;
+}
+
+void KeyTouchArea::move(const QPointF &pos)
+{
+    setPosition(pos);
+}
+
+void KeyTouchArea::release()
+{
+    m_touched = false;
+    m_holdTimer.stop();
+
+    // Handlers of released() still see whether the key was held
+    Q_EMIT released();
+    setHeld(false);
+}
+
+//! \brief KeyTouchArea::ungrab is called when the touch point was taken
+//! away, e.g. by a flick of a parent
+void KeyTouchArea::ungrab()
+{
+    m_touched = false;
+    m_holdTimer.stop();
+    setHeld(false);
+    Q_EMIT canceled();
+}
+
+//! \brief KeyTouchArea::cancelHold stops the pending press and hold, e.g.
+//! when a drag of the surface takes over
+void KeyTouchArea::cancelHold()
+{
+    m_holdTimer.stop();
+}
+
+void KeyTouchArea::timerEvent(QTimerEvent *event)
+{
+    if (event->timerId() != m_holdTimer.timerId()) {
+        QQuickItem::timerEvent(event);
+        return;
+    }
+
+    m_holdTimer.stop();
+    setHeld(true);
+    Q_EMIT pressAndHold();
+}
+
+// Only reached by the keys TouchDispatcher::collect() leaves out
+void KeyTouchArea::mousePressEvent(QMouseEvent *event)
+{
+    if (m_touched) {
+        event->ignore();
+        return;
+    }
+
+    press(event->localPos(), this);
+}
+
+void KeyTouchArea::mouseMoveEvent(QMouseEvent *event)
+{
+    if (m_touched)
+        move(event->localPos());
+}
+
+void KeyTouchArea::mouseReleaseEvent(QMouseEvent *event)
+{
+    Q_UNUSED(event);
+    if (m_touched)
+        release();
+}
+
+void KeyTouchArea::mouseUngrabEvent()
+{
+    if (m_touched)
+        ungrab();
+}
+
+void KeyTouchArea::setPosition(const QPointF &pos)
+{
+    const QPointF old(m_pos);
+    m_pos = pos;
+
+    if (old.x() != pos.x())
+        Q_EMIT mouseXChanged();
+    if (old.y() != pos.y())
+        Q_EMIT mouseYChanged();
+}
+
+void KeyTouchArea::setHeld(bool held)
+{
+    if (held == m_held)
+        return;
+
+    m_held = held;
+    Q_EMIT heldChanged();
+}
@@ -0,0 +1,105 @@
+/*
+ * Copyright (C) 2016 Canonical, Ltd.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this list
+ * of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice, this list
+ * of conditions and the following disclaimer in the documentation and/or other materials
+ * provided with the distribution.
+ * Neither the name of Nokia Corporation nor the names of its contributors may be
+ * used to endorse or promote products derived from this software without specific
+ * prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL
+ * THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#ifndef KEYTOUCHAREA_H
+#define KEYTOUCHAREA_H
+
+#include <QQuickItem>
+#include <QBasicTimer>
+#include <QElapsedTimer>
+
+//! \brief The KeyTouchArea class is the touch target of a single key
+//!
+//! The TouchDispatcher of the keypad resolves touch points to key touch
+//! areas and drives their press, hold, double click and movement state, the
+//! QML keys only react to the resulting signals. Keys inside a Flickable are
+//! left out of the dispatch and take their presses as mouse events, so the
+//! Flickable can still steal them to flick.
+class KeyTouchArea : public QQuickItem
+{
+    Q_OBJECT
+    Q_PROPERTY(bool acceptDoubleClick READ acceptDoubleClick WRITE setAcceptDoubleClick NOTIFY acceptDoubleClickChanged)
+    Q_PROPERTY(bool held READ held NOTIFY heldChanged)
+    Q_PROPERTY(qreal mouseX READ mouseX NOTIFY mouseXChanged)
+    Q_PROPERTY(qreal mouseY READ mouseY NOTIFY mouseYChanged)
+    Q_PROPERTY(qreal startY READ startY NOTIFY startYChanged)
+
+public:
+    explicit KeyTouchArea(QQuickItem *parent = 0);
+
+    bool acceptDoubleClick() const;
+    void setAcceptDoubleClick(bool accept);
+
+    bool held() const;
+    qreal mouseX() const;
+    qreal mouseY() const;
+    qreal startY() const;
+
+    bool isTouched() const;
+
+    //! Called by TouchDispatcher, \a pos is in local coordinates
+    bool press(const QPointF &pos, const KeyTouchArea *lastPressed);
+    void move(const QPointF &pos);
+    void release();
+    void ungrab();
+
+    Q_INVOKABLE void cancelHold();
+
+Q_SIGNALS:
+    void acceptDoubleClickChanged();
+    void heldChanged();
+    void mouseXChanged();
+    void mouseYChanged();
+    void startYChanged();
+
+    void pressed();
+    void released();
+    void canceled();
+    void pressAndHold();
+    void doubleClicked();
+
+protected:
+    virtual void timerEvent(QTimerEvent *event);
+    virtual void mousePressEvent(QMouseEvent *event);
+    virtual void mouseMoveEvent(QMouseEvent *event);
+    virtual void mouseReleaseEvent(QMouseEvent *event);
+    virtual void mouseUngrabEvent();
+
+private:
+    void setPosition(const QPointF &pos);
+    void setHeld(bool held);
+
+    bool m_acceptDoubleClick;
+    bool m_held;
+    bool m_touched;
+    QPointF m_pos;
+    qreal m_startY;
+    QBasicTimer m_holdTimer;
+    QElapsedTimer m_doubleClickTimer;
+};
+
+#endif // KEYTOUCHAREA_H
@@ -31,10 +31,29 @@
 
 #include "plugin.h"
 #include "inputmethod.h"
+#include "keyface.h"
+#include "keypadcache.h"
+#include "keypadrenderer.h"
+#include "keytoucharea.h"
+#include "touchdispatcher.h"
+#include "logic/emojimodel.h"
+#include "logic/hangulcomposer.h"
 
 #include <QtQml>
 #include <libintl.h>
 
+namespace {
+
+QObject *createHangulComposer(QQmlEngine *engine, QJSEngine *scriptEngine)
+{
+    Q_UNUSED(engine)
+    Q_UNUSED(scriptEngine)
+
+    return new HangulComposer;
+}
+
+} // unnamed namespace
+
 MaliitKeyboardPlugin::MaliitKeyboardPlugin(QObject *parent)
     : QObject(parent)
     , Maliit::Plugins::InputMethodPlugin()
@@ -44,6 +63,13 @@ MaliitKeyboardPlugin::MaliitKeyboardPlugin(QObject *parent)
 
     qmlRegisterUncreatableType<InputMethod>("UbuntuKeyboard", 1, 0, "InputMethod",
                                             QString("InputMethod can't be created in QML"));
+    qmlRegisterType<EmojiModel>("UbuntuKeyboard", 1, 0, "EmojiModel");
+    qmlRegisterSingletonType<HangulComposer>("UbuntuKeyboard", 1, 0, "Hangul", createHangulComposer);
+    qmlRegisterType<KeypadCache>("UbuntuKeyboard", 1, 0, "KeypadCache");
+    qmlRegisterType<KeyTouchArea>("UbuntuKeyboard", 1, 0, "KeyTouchArea");
+    qmlRegisterType<KeyFace>("UbuntuKeyboard", 1, 0, "KeyFace");
+    qmlRegisterType<KeypadRenderer>("UbuntuKeyboard", 1, 0, "KeypadRenderer");
+    qmlRegisterType<TouchDispatcher>("UbuntuKeyboard", 1, 0, "TouchDispatcher");
 }
 
 QString MaliitKeyboardPlugin::name() const
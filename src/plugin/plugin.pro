@@ -11,6 +11,7 @@ LIBS += \
 PRE_TARGETDEPS += $${TOP_BUILDDIR}/$${UBUNTU_KEYBOARD_VIEW_LIB} $${TOP_BUILDDIR}/$${UBUNTU_KEYBOARD_LIB}
 INCLUDEPATH += ../lib ../
 DEFINES += MALIIT_DEFAULT_PROFILE=\\\"$$MALIIT_DEFAULT_PROFILE\\\"
+DEFINES += HUNSPELL_DICT_PATH=\\\"$$HUNSPELL_DICT_PATH\\\"
 
 contains(QT_MAJOR_VERSION, 4) {
     QT = core gui dbus
@@ -26,19 +27,35 @@ HEADERS += \
     inputmethod.h \
     inputmethod_p.h \
     editor.h \
+    glyphatlas.h \
     greeterstatus.h \
+    idletrimmer.h \
+    incubationcontroller.h \
     keyboardgeometry.h \
     keyboardsettings.h \
-#    updatenotifier.h \
+    keyface.h \
+    keypadcache.h \
+    keypadrenderer.h \
+    keytoucharea.h \
+    touchdispatcher.h \
+    updatenotifier.h \
 
 SOURCES += \
     plugin.cpp \
     inputmethod.cpp \
     editor.cpp \
+    glyphatlas.cpp \
     greeterstatus.cpp \
+    idletrimmer.cpp \
+    incubationcontroller.cpp \
     keyboardgeometry.cpp \
     keyboardsettings.cpp \
-#    updatenotifier.cpp \
+    keyface.cpp \
+    keypadcache.cpp \
+    keypadrenderer.cpp \
+    keytoucharea.cpp \
+    touchdispatcher.cpp \
+    updatenotifier.cpp \
 
 target.path += $${MALIIT_PLUGINS_DIR}
 INSTALLS += target
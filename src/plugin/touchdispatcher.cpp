@@ -0,0 +1,319 @@
+/*
+ * Copyright (C) 2016 Canonical, Ltd.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this list
+ * of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice, this list
+ * of conditions and the following disclaimer in the documentation and/or other materials
+ * provided with the distribution.
+ * Neither the name of Nokia Corporation nor the names of its contributors may be
+ * used to endorse or promote products derived from this software without specific
+ * prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL
+ * THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#include "touchdispatcher.h"
+#include "keytoucharea.h"
+
+#include <QTouchEvent>
+#include <QMouseEvent>
+
+namespace {
+
+// Keypads have about four rows of ten keys, so most cells hold one key
+const int GridColumns = 16;
+const int GridRows = 8;
+
+const int MouseId = -1;
+
+} // unnamed namespace
+
+TouchDispatcher::IndexedKey::IndexedKey()
+    : rect()
+    , area()
+{}
+
+TouchDispatcher::IndexedKey::IndexedKey(const QRectF &rect, KeyTouchArea *area)
+    : rect(rect)
+    , area(area)
+{}
+
+TouchDispatcher::TouchDispatcher(QQuickItem *parent)
+    : QQuickItem(parent)
+    , m_keypad()
+    , m_dirty(true)
+    , m_keys()
+    , m_cells()
+    , m_bounds()
+    , m_points()
+    , m_lastPressed()
+{
+    setAcceptedMouseButtons(Qt::LeftButton);
+}
+
+//! \brief TouchDispatcher::keypad returns the item whose key touch areas
+//! are dispatched to
+QQuickItem *TouchDispatcher::keypad() const
+{
+    return m_keypad;
+}
+
+void TouchDispatcher::setKeypad(QQuickItem *keypad)
+{
+    if (keypad == m_keypad)
+        return;
+
+    ungrabAll();
+
+    if (m_keypad)
+        disconnect(m_keypad, 0, this, 0);
+
+    m_keypad = keypad;
+
+    if (m_keypad) {
+        connect(m_keypad, SIGNAL(widthChanged()), this, SLOT(invalidate()));
+        connect(m_keypad, SIGNAL(heightChanged()), this, SLOT(invalidate()));
+        connect(m_keypad, SIGNAL(childrenChanged()), this, SLOT(invalidate()));
+    }
+
+    invalidate();
+    Q_EMIT keypadChanged();
+}
+
+//! \brief TouchDispatcher::keyAt returns the key touch area at \a pos, in
+//! local coordinates, or 0 if there is none
+KeyTouchArea *TouchDispatcher::keyAt(const QPointF &pos)
+{
+    const bool rebuilt = m_dirty;
+    if (m_dirty)
+        rebuild();
+
+    KeyTouchArea *area = lookup(pos);
+    if (rebuilt)
+        return area;
+
+    // Keys can move, appear or be destroyed without the index noticing, e.g.
+    // when a row is laid out again or a Loader finishes. The index is only
+    // rebuilt when a hit turns out stale, or on a miss where a key could be.
+    if (area) {
+        if (area->isVisible() && area->contains(area->mapFromItem(this, pos)))
+            return area;
+    } else if (!m_bounds.isEmpty() && !m_bounds.contains(pos)) {
+        return 0;
+    }
+
+    rebuild();
+    return lookup(pos);
+}
+
+//! \brief TouchDispatcher::invalidate rebuilds the key index on the next
+//! touch, to be called when keys were added or moved
+void TouchDispatcher::invalidate()
+{
+    m_dirty = true;
+}
+
+void TouchDispatcher::touchEvent(QTouchEvent *event)
+{
+    bool handled = false;
+
+    Q_FOREACH (const QTouchEvent::TouchPoint &point, event->touchPoints()) {
+        switch (point.state()) {
+        case Qt::TouchPointPressed:
+            handled |= pressPoint(point.id(), point.pos());
+            break;
+        case Qt::TouchPointMoved:
+            if (m_points.contains(point.id())) {
+                movePoint(point.id(), point.pos());
+                handled = true;
+            }
+            break;
+        case Qt::TouchPointReleased:
+            if (m_points.contains(point.id())) {
+                releasePoint(point.id());
+                handled = true;
+            }
+            break;
+        default:
+            handled |= m_points.contains(point.id());
+            break;
+        }
+    }
+
+    if (event->type() == QEvent::TouchCancel)
+        ungrabAll();
+
+    // Touches next to the keys belong to the items below
+    event->setAccepted(handled);
+}
+
+void TouchDispatcher::touchUngrabEvent()
+{
+    ungrabAll();
+}
+
+void TouchDispatcher::mousePressEvent(QMouseEvent *event)
+{
+    event->setAccepted(pressPoint(MouseId, event->localPos()));
+}
+
+void TouchDispatcher::mouseMoveEvent(QMouseEvent *event)
+{
+    movePoint(MouseId, event->localPos());
+}
+
+void TouchDispatcher::mouseReleaseEvent(QMouseEvent *event)
+{
+    Q_UNUSED(event);
+    releasePoint(MouseId);
+}
+
+void TouchDispatcher::mouseUngrabEvent()
+{
+    KeyTouchArea *area = m_points.take(MouseId);
+    if (area)
+        area->ungrab();
+}
+
+void TouchDispatcher::geometryChanged(const QRectF &newGeometry,
+                                      const QRectF &oldGeometry)
+{
+    QQuickItem::geometryChanged(newGeometry, oldGeometry);
+    invalidate();
+}
+
+void TouchDispatcher::rebuild()
+{
+    m_dirty = false;
+    m_keys.clear();
+    m_cells.fill(QVector<int>(), GridColumns * GridRows);
+    m_bounds = QRectF();
+
+    if (!m_keypad)
+        return;
+
+    collect(m_keypad);
+
+    for (int index = 0; index < m_keys.count(); ++index) {
+        m_bounds |= m_keys.at(index).rect;
+    }
+
+    for (int index = 0; index < m_keys.count(); ++index) {
+        const QRectF &rect(m_keys.at(index).rect);
+        const int first = cellAt(rect.topLeft());
+        // Right and bottom edges are exclusive
+        const int last = cellAt(rect.bottomRight() - QPointF(0.001, 0.001));
+
+        if (first < 0 || last < 0)
+            continue;
+
+        for (int row = first / GridColumns; row <= last / GridColumns; ++row) {
+            for (int column = first % GridColumns; column <= last % GridColumns; ++column) {
+                m_cells[row * GridColumns + column].append(index);
+            }
+        }
+    }
+}
+
+void TouchDispatcher::collect(QQuickItem *item)
+{
+    if (!item->isVisible())
+        return;
+
+    // Keys in a GridView or ListView take their own presses, so the view
+    // still gets the drags it needs to flick
+    if (item->inherits("QQuickFlickable"))
+        return;
+
+    KeyTouchArea *area = qobject_cast<KeyTouchArea *>(item);
+    if (area && area->isEnabled()) {
+        m_keys.append(IndexedKey(mapRectFromItem(area, area->boundingRect()), area));
+    }
+
+    Q_FOREACH (QQuickItem *child, item->childItems()) {
+        collect(child);
+    }
+}
+
+KeyTouchArea *TouchDispatcher::lookup(const QPointF &pos) const
+{
+    const int cell = cellAt(pos);
+    if (cell < 0)
+        return 0;
+
+    const QVector<int> &candidates(m_cells.at(cell));
+
+    // Later keys are stacked on top of earlier ones
+    for (int index = candidates.count() - 1; index >= 0; --index) {
+        const IndexedKey &key(m_keys.at(candidates.at(index)));
+        if (key.area && key.rect.contains(pos))
+            return key.area;
+    }
+
+    return 0;
+}
+
+int TouchDispatcher::cellAt(const QPointF &pos) const
+{
+    if (!m_bounds.contains(pos))
+        return -1;
+
+    const int column = qBound(0, int((pos.x() - m_bounds.x()) * GridColumns / m_bounds.width()),
+                              GridColumns - 1);
+    const int row = qBound(0, int((pos.y() - m_bounds.y()) * GridRows / m_bounds.height()),
+                           GridRows - 1);
+
+    return row * GridColumns + column;
+}
+
+bool TouchDispatcher::pressPoint(int id, const QPointF &pos)
+{
+    KeyTouchArea *area = keyAt(pos);
+    if (!area || area->isTouched())
+        return false;
+
+    m_points.insert(id, area);
+
+    if (area->press(area->mapFromItem(this, pos), m_lastPressed.data()))
+        m_lastPressed = area;
+
+    return true;
+}
+
+void TouchDispatcher::movePoint(int id, const QPointF &pos)
+{
+    KeyTouchArea *area = m_points.value(id);
+    if (area)
+        area->move(area->mapFromItem(this, pos));
+}
+
+void TouchDispatcher::releasePoint(int id)
+{
+    KeyTouchArea *area = m_points.take(id);
+    if (area)
+        area->release();
+}
+
+void TouchDispatcher::ungrabAll()
+{
+    QHash<int, QPointer<KeyTouchArea> > points;
+    points.swap(m_points);
+
+    Q_FOREACH (const QPointer<KeyTouchArea> &area, points) {
+        if (area)
+            area->ungrab();
+    }
+}
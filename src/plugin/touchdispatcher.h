@@ -0,0 +1,104 @@
+/*
+ * Copyright (C) 2016 Canonical, Ltd.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this list
+ * of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice, this list
+ * of conditions and the following disclaimer in the documentation and/or other materials
+ * provided with the distribution.
+ * Neither the name of Nokia Corporation nor the names of its contributors may be
+ * used to endorse or promote products derived from this software without specific
+ * prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL
+ * THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#ifndef TOUCHDISPATCHER_H
+#define TOUCHDISPATCHER_H
+
+#include <QQuickItem>
+#include <QHash>
+#include <QPointer>
+#include <QVector>
+
+class KeyTouchArea;
+
+//! \brief The TouchDispatcher class receives the touch points of a keypad
+//!
+//! It lies on top of the keypad and resolves each touch point against an
+//! index of the keypad's KeyTouchArea rectangles, the way Glass resolved
+//! them with keyHit() for the C++ keyboard view. Every touch point is
+//! tracked on its own, so a key can be pressed while another one is still
+//! down. Touches that do not hit a key are left to the items below, and so
+//! are the keys inside a Flickable, which handle their presses themselves.
+class TouchDispatcher : public QQuickItem
+{
+    Q_OBJECT
+    Q_PROPERTY(QQuickItem *keypad READ keypad WRITE setKeypad NOTIFY keypadChanged)
+
+public:
+    explicit TouchDispatcher(QQuickItem *parent = 0);
+
+    QQuickItem *keypad() const;
+    void setKeypad(QQuickItem *keypad);
+
+    KeyTouchArea *keyAt(const QPointF &pos);
+
+    Q_SLOT void invalidate();
+
+Q_SIGNALS:
+    void keypadChanged();
+
+protected:
+    virtual void touchEvent(QTouchEvent *event);
+    virtual void touchUngrabEvent();
+    virtual void mousePressEvent(QMouseEvent *event);
+    virtual void mouseMoveEvent(QMouseEvent *event);
+    virtual void mouseReleaseEvent(QMouseEvent *event);
+    virtual void mouseUngrabEvent();
+    virtual void geometryChanged(const QRectF &newGeometry,
+                                 const QRectF &oldGeometry);
+
+private:
+    struct IndexedKey
+    {
+        IndexedKey();
+        IndexedKey(const QRectF &rect, KeyTouchArea *area);
+
+        QRectF rect;
+        QPointer<KeyTouchArea> area;
+    };
+
+    void rebuild();
+    void collect(QQuickItem *item);
+    KeyTouchArea *lookup(const QPointF &pos) const;
+    int cellAt(const QPointF &pos) const;
+
+    bool pressPoint(int id, const QPointF &pos);
+    void movePoint(int id, const QPointF &pos);
+    void releasePoint(int id);
+    void ungrabAll();
+
+    QPointer<QQuickItem> m_keypad;
+    bool m_dirty;
+    QVector<IndexedKey> m_keys;
+    //! Indices into m_keys, for each cell of a uniform grid over the keypad
+    QVector<QVector<int> > m_cells;
+    QRectF m_bounds;
+    QHash<int, QPointer<KeyTouchArea> > m_points;
+    QPointer<KeyTouchArea> m_lastPressed;
+};
+
+#endif // TOUCHDISPATCHER_H
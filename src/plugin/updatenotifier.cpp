@@ -42,6 +42,9 @@ const char* const g_surrounding_text_property("surroundingText");
 const char* const g_cursor_position_property("cursorPosition");
 const char* const g_anchor_position_property("anchorPosition");
 const char* const g_has_selection("hasSelection");
+const char* const g_content_type("contentType");
+const char* const g_prediction_enabled("predictionEnabled");
+const char* const g_auto_capitalization_enabled("autocapitalizationEnabled");
 
 } // unnamed namespace
 
@@ -75,6 +78,31 @@ void UpdateNotifier::notify(MImUpdateEvent* event)
         const bool has_selection(event->value(g_has_selection).toBool());
 
         d->has_selection = has_selection;
+        Q_EMIT hasSelectionChanged(has_selection);
+    }
+
+    // Content type goes first, it decides whether the word engine may be
+    // enabled at all.
+    if (properties_changed.contains(g_content_type)) {
+        Q_EMIT contentTypeChanged(event->value(g_content_type).toInt());
+    }
+
+    if (properties_changed.contains(g_prediction_enabled)) {
+        const QVariant prediction_enabled(event->value(g_prediction_enabled));
+
+        // Like MAbstractInputMethodHost, default to enabled if unknown.
+        Q_EMIT predictionEnabledChanged(not prediction_enabled.isValid()
+                                        or prediction_enabled.toBool());
+    }
+
+    if (properties_changed.contains(g_auto_capitalization_enabled)) {
+        Q_EMIT autoCapitalizationEnabledChanged(event->value(g_auto_capitalization_enabled).toBool());
+    }
+
+    if (properties_changed.contains(g_surrounding_text_property)
+        or properties_changed.contains(g_cursor_position_property)) {
+        Q_EMIT surroundingTextChanged(event->value(g_surrounding_text_property).toString(),
+                                      event->value(g_cursor_position_property).toInt());
     }
 
     if (not d->has_selection and properties_changed.contains(g_cursor_position_property)) {
@@ -94,10 +122,4 @@ void UpdateNotifier::notify(MImUpdateEvent* event)
     }
 }
 
-void UpdateNotifier::notifyOverride(const Logic::KeyOverrides &overriden_keys,
-                                    bool update /* = false */)
-{
-    Q_EMIT keysOverriden(overriden_keys, update);
-}
-
 } // namespace MaliitKeyboard
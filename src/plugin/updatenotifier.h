@@ -33,16 +33,12 @@
 #define MALIIT_KEYBOARD_UPDATENOTIFIER_H
 
 #include <QtCore>
-#include <maliit/plugins/keyoverride.h>
-
-#include "logic/layouthelper.h"
 
 class MImUpdateEvent;
 
 namespace MaliitKeyboard {
 
 class UpdateNotifierPrivate;
-class Key;
 
 class UpdateNotifier
     : public QObject
@@ -56,13 +52,15 @@ public:
     virtual ~UpdateNotifier();
 
     void notify(MImUpdateEvent *event);
-    void notifyOverride(const Logic::KeyOverrides &overriden_keys,
-                        bool update = false);
 
     Q_SIGNAL void cursorPositionChanged(int cursor_position,
                                         const QString &surrounding_text);
-    Q_SIGNAL void keysOverriden(const Logic::KeyOverrides &overriden_keys,
-                                bool update);
+    Q_SIGNAL void hasSelectionChanged(bool has_selection);
+    Q_SIGNAL void contentTypeChanged(int content_type);
+    Q_SIGNAL void predictionEnabledChanged(bool prediction_enabled);
+    Q_SIGNAL void autoCapitalizationEnabledChanged(bool auto_capitalization_enabled);
+    Q_SIGNAL void surroundingTextChanged(const QString &surrounding_text,
+                                         int cursor_position);
 
 private:
     const QScopedPointer<UpdateNotifierPrivate> d_ptr;
@@ -32,11 +32,51 @@
 #include "abstracttexteditor.h"
 #include "models/wordribbon.h"
 #include "logic/abstractlanguagefeatures.h"
+#include "logic/sentencestate.h"
 
 #include <QElapsedTimer>
 
 namespace MaliitKeyboard {
 
+namespace {
+
+//! Whether the space separated word left of the cursor, preedit included,
+//! contains \a c, leaving out its last \a chopped characters.
+bool wordLeftOfCursorContains(const Model::Text &text, QChar c, int chopped)
+{
+    const QString preedit(text.preedit());
+    const int preedit_chopped = qMin(chopped, preedit.length());
+    const int preedit_length = preedit.length() - preedit_chopped;
+
+    const int space = preedit_length > 0 ? preedit.lastIndexOf(QLatin1Char(' '), preedit_length - 1) : -1;
+    if (space >= 0) {
+        return preedit.midRef(space + 1, preedit_length - space - 1).contains(c);
+    }
+
+    return preedit.leftRef(preedit_length).contains(c)
+            || text.wordBefore(text.surroundingOffset() - (chopped - preedit_chopped)).contains(c);
+}
+
+//! Whether the rest of the line right of the cursor is only whitespace.
+bool lineRightOfCursorIsBlank(const Model::Text &text)
+{
+    const QString surrounding(text.surrounding());
+
+    for (int i = text.surroundingOffset(); i < surrounding.length(); ++i) {
+        const QChar c = surrounding.at(i);
+        if (Model::Text::isLineBreak(c)) {
+            break;
+        }
+        if (not c.isSpace()) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+} // unnamed namespace
+
 //! \class EditorOptions
 //! \brief Plain struct implementing editor options.
 
@@ -199,6 +239,7 @@ public:
     EditorOptions options;
     QScopedPointer<Model::Text> text;
     QScopedPointer<Logic::AbstractWordEngine> word_engine;
+    Logic::SentenceState sentence_state;
     bool preedit_enabled;
     bool auto_correct_enabled;
     bool auto_caps_enabled;
@@ -231,6 +272,7 @@ AbstractTextEditorPrivate::AbstractTextEditorPrivate(const EditorOptions &new_op
     , options(new_options)
     , text(new_text)
     , word_engine(new_word_engine)
+    , sentence_state()
     , preedit_enabled(false)
     , auto_correct_enabled(false)
     , auto_caps_enabled(false)
@@ -265,6 +307,26 @@ bool AbstractTextEditorPrivate::valid() const
     return (not is_invalid);
 }
 
+//! Brackets everything sent to the host while handling one input event,
+//! so that subclasses can batch it, see beginHostTransaction().
+class AbstractTextEditor::HostTransaction
+{
+public:
+    explicit HostTransaction(AbstractTextEditor *editor)
+        : m_editor(editor)
+    {
+        m_editor->beginHostTransaction();
+    }
+
+    ~HostTransaction()
+    {
+        m_editor->endHostTransaction();
+    }
+
+private:
+    AbstractTextEditor *const m_editor;
+};
+
 //! \brief Constructor.
 //! \param options Editor options.
 //! \param text Text model.
@@ -326,6 +388,7 @@ Logic::AbstractWordEngine * AbstractTextEditor::wordEngine() const
 void AbstractTextEditor::onKeyPressed(const Key &key)
 {
     Q_D(AbstractTextEditor);
+    HostTransaction transaction(this);
 
     if (not d->valid()) {
         return;
@@ -349,6 +412,7 @@ void AbstractTextEditor::onKeyPressed(const Key &key)
 void AbstractTextEditor::onKeyReleased(const Key &key)
 {
     Q_D(AbstractTextEditor);
+    HostTransaction transaction(this);
 
     if (not d->valid()) {
         return;
@@ -362,12 +426,8 @@ void AbstractTextEditor::onKeyReleased(const Key &key)
     bool email_detected = false;
 
     // Detect if the user is entering an email address and avoid spacing, autocaps and autocomplete changes
-    QString textOnLeft = d->text->surroundingLeft() + d->text->preedit();
-    if (key.action() == Key::ActionBackspace) {
-        textOnLeft.chop(1);
-    }
-    QStringList leftHandWords = textOnLeft.split(" ");
-    if (!d->word_engine->languageFeature()->alwaysShowSuggestions() && !leftHandWords.isEmpty() && leftHandWords.last().contains("@")) {
+    if (!d->word_engine->languageFeature()->alwaysShowSuggestions()
+        && wordLeftOfCursorContains(*d->text, QLatin1Char('@'), key.action() == Key::ActionBackspace ? 1 : 0)) {
         email_detected = true;
     }
 
@@ -393,7 +453,7 @@ void AbstractTextEditor::onKeyReleased(const Key &key)
 
         if (d->preedit_enabled) {
             if (!enablePreeditAtInsertion &&
-                    (d->text->surroundingRight().left(1).contains(QRegExp("[\\w]")) || email_detected)) {
+                    (charRightOfCursorIsWordChar() || email_detected)) {
                 // We're editing in the middle of a word or entering an email address, so just insert characters directly
                 d->text->appendToPreedit(text);
                 commitPreedit();
@@ -404,7 +464,7 @@ void AbstractTextEditor::onKeyReleased(const Key &key)
                 d->text->appendToPreedit(text);
                 commitPreedit();
                 if (!email_detected) {
-                    auto_caps_activated = d->word_engine->languageFeature()->activateAutoCaps(d->text->surroundingLeft() + d->text->preedit() + text);
+                    auto_caps_activated = autoCapsActive();
                 }
                 alreadyAppended = true;
             }
@@ -415,10 +475,10 @@ void AbstractTextEditor::onKeyReleased(const Key &key)
                 }
 
                 d->text->appendToPreedit(text);
+                commitPreedit();
                 if (!email_detected) {
-                    auto_caps_activated = d->word_engine->languageFeature()->activateAutoCaps(d->text->surroundingLeft() + d->text->preedit());
+                    auto_caps_activated = autoCapsActive();
                 }
-                commitPreedit();
                 alreadyAppended = true;
             }
         }
@@ -469,14 +529,18 @@ void AbstractTextEditor::onKeyReleased(const Key &key)
 
     case Key::ActionSpace: {
         QString space = " ";
-        QString textOnLeft = d->text->surroundingLeft() + d->text->preedit();
-        QString textOnLeftTrimmed = textOnLeft.trimmed();
-        QStringList textOnRightList = d->text->surroundingRight().split("\n");
-        QString textOnRight;
-        if (!textOnRightList.isEmpty()) {
-            textOnRight = textOnRightList.first().trimmed();
+        // The few characters left of the cursor the full stop depends on,
+        // as they were before the key
+        const QChar lastChar = d->text->charBeforeCursor(1);
+        const QChar secondLastChar = d->text->charBeforeCursor(2);
+        int trailingSpaces = 0;
+        while (d->text->charBeforeCursor(trailingSpaces + 1).isSpace()) {
+            ++trailingSpaces;
         }
-        bool auto_caps_activated = d->word_engine->languageFeature()->activateAutoCaps(textOnLeft);
+        const QChar lastNonSpaceChar = d->text->charBeforeCursor(trailingSpaces + 1);
+        const QChar secondLastNonSpaceChar = d->text->charBeforeCursor(trailingSpaces + 2);
+        const bool textOnRight = not lineRightOfCursorIsBlank(*d->text);
+        bool auto_caps_activated = autoCapsActive();
         const bool replace_preedit = d->auto_correct_enabled
                                      && not d->text->primaryCandidate().isEmpty()
                                      && not d->text->preedit().isEmpty()
@@ -501,7 +565,7 @@ void AbstractTextEditor::onKeyReleased(const Key &key)
         }
 
         if (replace_preedit) {
-            if (!textOnRight.isEmpty() && d->editing_middle_of_text) {
+            if (textOnRight && d->editing_middle_of_text) {
                 // Don't insert a space if we are correcting a word in the middle of a sentence
                 space = "";
                 d->look_for_a_double_space = false;
@@ -531,14 +595,13 @@ void AbstractTextEditor::onKeyReleased(const Key &key)
         // a separator, and there isn't a separator immediately prior to a ')'
         else if (look_for_a_double_space
                  && not stopSequence.isEmpty()
-                 && textOnLeft.count() >= 2
-                 && textOnLeft.at(textOnLeft.count() - 1).isSpace()
-                 && !textOnLeft.at(textOnLeft.count() - 2).isSpace()
-                 && textOnLeftTrimmed.count() > 0
-                 && !d->word_engine->languageFeature()->isSeparator(textOnLeftTrimmed.at(textOnLeftTrimmed.count() - 1))
-                 && !(textOnLeftTrimmed.endsWith(")") 
-                      && textOnLeftTrimmed.count() > 1
-                      && d->word_engine->languageFeature()->isSeparator(textOnLeftTrimmed.at(textOnLeftTrimmed.count() - 2)))) {
+                 && lastChar.isSpace()
+                 && !secondLastChar.isNull()
+                 && !secondLastChar.isSpace()
+                 && !lastNonSpaceChar.isNull()
+                 && !d->word_engine->languageFeature()->isSeparatorChar(lastNonSpaceChar)
+                 && !(lastNonSpaceChar == QLatin1Char(')')
+                      && d->word_engine->languageFeature()->isSeparatorChar(secondLastNonSpaceChar))) {
             removeTrailingWhitespaces();
             if (!d->word_engine->languageFeature()->commitOnSpace()) {
                 // Commit when inserting a fullstop if we don't insert on spaces
@@ -552,8 +615,7 @@ void AbstractTextEditor::onKeyReleased(const Key &key)
             }
 
             // we need to re-evaluate autocaps after our changes to the preedit
-            textOnLeft = d->text->surroundingLeft() + d->text->preedit();
-            auto_caps_activated = d->word_engine->languageFeature()->activateAutoCaps(textOnLeft);
+            auto_caps_activated = autoCapsActive();
             full_stop_inserted = true;
             d->look_for_a_triple_space = true;
         }
@@ -639,6 +701,7 @@ void AbstractTextEditor::onKeyReleased(const Key &key)
     if (event_key != Qt::Key_unknown) {
         commitPreedit();
         sendKeyPressAndReleaseEvents(event_key, Qt::NoModifier, keyText);
+        d->sentence_state.commit(keyText);
 
         Q_EMIT preeditChanged(d->text->preedit());
         Q_EMIT cursorPositionChanged(d->text->cursorPosition());
@@ -653,6 +716,7 @@ void AbstractTextEditor::onKeyReleased(const Key &key)
 void AbstractTextEditor::onKeyEntered(const Key &key)
 {
     Q_D(AbstractTextEditor);
+    HostTransaction transaction(this);
 
     if (key.action() == Key::ActionBackspace) {
         d->backspace_sent = false;
@@ -668,6 +732,7 @@ void AbstractTextEditor::onKeyEntered(const Key &key)
 void AbstractTextEditor::onKeyExited(const Key &key)
 {
     Q_D(AbstractTextEditor);
+    HostTransaction transaction(this);
 
     if (key.action() == Key::ActionBackspace) {
         d->auto_repeat_backspace_timer.stop();
@@ -681,6 +746,7 @@ void AbstractTextEditor::onKeyExited(const Key &key)
 void AbstractTextEditor::replacePreedit(const QString &replacement)
 {
     Q_D(AbstractTextEditor);
+    HostTransaction transaction(this);
 
     if (not d->valid()) {
         return;
@@ -703,6 +769,7 @@ void AbstractTextEditor::replacePreedit(const QString &replacement)
 void AbstractTextEditor::replaceTextWithPreedit(const QString &replacement, int start, int len, int pos)
 {
     Q_D(AbstractTextEditor);
+    HostTransaction transaction(this);
 
     if (not d->valid()) {
         return;
@@ -724,16 +791,16 @@ void AbstractTextEditor::replaceTextWithPreedit(const QString &replacement, int
 void AbstractTextEditor::replaceAndCommitPreedit(const QString &replacement)
 {
     Q_D(AbstractTextEditor);
+    HostTransaction transaction(this);
 
     if (not d->valid()) {
         return;
     }
 
     d->text->setPreedit(replacement);
-    const bool auto_caps_activated = d->word_engine->languageFeature()->activateAutoCaps(d->text->preedit());
     d->appendix_for_previous_preedit = d->word_engine->languageFeature()->appendixForReplacedPreedit(d->text->preedit());
     if (d->auto_correct_enabled) {
-        if ((!d->text->surroundingRight().trimmed().isEmpty() && d->editing_middle_of_text) || d->word_engine->languageFeature()->contentType() == Maliit::UrlContentType) {
+        if ((!d->text->isBlankAfterCursor() && d->editing_middle_of_text) || d->word_engine->languageFeature()->contentType() == Maliit::UrlContentType) {
             // Don't insert a space if we are correcting a word in the middle of a sentence or if we're in a Url field
             d->appendix_for_previous_preedit = "";
             d->editing_middle_of_text = false;
@@ -743,7 +810,7 @@ void AbstractTextEditor::replaceAndCommitPreedit(const QString &replacement)
     commitPreedit();
 
     if (d->auto_caps_enabled) {
-        if (auto_caps_activated) {
+        if (autoCapsActive()) {
             Q_EMIT autoCapsActivated();
         } else {
             Q_EMIT autoCapsDeactivated();
@@ -850,6 +917,31 @@ void AbstractTextEditor::setAutoCapsEnabled(bool enabled)
     }
 }
 
+//! \brief Returns whether the text left of the cursor asks for a capital
+//! letter next, according to the current language.
+bool AbstractTextEditor::autoCapsActive() const
+{
+    Q_D(const AbstractTextEditor);
+    return d->sentence_state.autoCapsActive(d->word_engine->languageFeature(),
+                                            d->text->preedit());
+}
+
+//! \brief Replaces what the editor assumes to be left of the cursor with
+//! the surrounding text reported by the host.
+//!
+//! Needs to be called whenever the host updated the surrounding text, in
+//! between the editor keeps track of its own commits and deletions.
+void AbstractTextEditor::resyncSentenceState()
+{
+    Q_D(AbstractTextEditor);
+
+    const QString &surrounding = d->text->surrounding();
+    const int offset = qMin<int>(d->text->surroundingOffset(), surrounding.length());
+    const int start = qMax(0, offset - Logic::SentenceState::contextLength());
+
+    d->sentence_state.resync(surrounding.mid(start, offset - start), start == 0);
+}
+
 //! \brief Returns whether double space full-stop is enabled
 //! \sa doubleSpaceFullStopEnabled
 bool AbstractTextEditor::isDoubleSpaceFullStopEnabled() const
@@ -880,6 +972,7 @@ void AbstractTextEditor::commitPreedit()
         return;
     }
 
+    d->sentence_state.commit(d->text->preedit());
     sendCommitString(d->text->preedit());
     d->text->commitPreedit();
     d->word_engine->clearCandidates();
@@ -889,13 +982,12 @@ void AbstractTextEditor::removeTrailingWhitespaces()
 {
     Q_D(AbstractTextEditor);
 
-    const QString textOnLeft = d->text->surroundingLeft() + d->text->preedit();
+    int trailingSpaces = 0;
+    while (d->text->charBeforeCursor(trailingSpaces + 1).isSpace()) {
+        ++trailingSpaces;
+    }
 
-    QString::const_iterator begin = textOnLeft.cbegin();
-    QString::const_iterator i = textOnLeft.cend();
-    while (i != begin) {
-        --i;
-        if (!i->isSpace()) break;
+    for (; trailingSpaces > 0; --trailingSpaces) {
         singleBackspace();
     }
 }
@@ -913,6 +1005,7 @@ void AbstractTextEditor::removeTrailingWhitespaces()
 void AbstractTextEditor::autoRepeatBackspace()
 {
     Q_D(AbstractTextEditor);
+    HostTransaction transaction(this);
 
     d->repeating_backspace = true;
 
@@ -939,10 +1032,9 @@ void AbstractTextEditor::autoRepeatWordBackspace()
 {
     Q_D(AbstractTextEditor);
 
-    if (d->text->surroundingOffset() > 0) {
-        QString word = wordLeftOfCursor();
-        for (int i=0; i<word.length(); ++i)
-            singleBackspace();
+    if (d->text->preedit().isEmpty() && d->text->surroundingOffset() > 0) {
+        deleteLeftOfCursor(wordLeftOfCursor().length());
+        d->deleted_words++;
     } else {
         singleBackspace();
     }
@@ -955,6 +1047,45 @@ void AbstractTextEditor::autoRepeatWordBackspace()
     d->auto_repeat_backspace_timer.start(d->options.backspace_word_interval - d->backspace_word_acceleration);
 }
 
+/*!
+ * \brief AbstractTextEditor::deleteLeftOfCursor deletes \a length committed
+ * characters left of the cursor with a single replacement, instead of one
+ * key event pair per character.
+ * \param length Number of characters to delete.
+ */
+void AbstractTextEditor::deleteLeftOfCursor(int length)
+{
+    Q_D(AbstractTextEditor);
+
+    if (length <= 0) {
+        return;
+    }
+
+    if (length == 1) {
+        singleBackspace();
+        return;
+    }
+
+    sendPreeditString(QString(), Model::Text::PreeditDefault,
+                      Replacement(-length, length, 0));
+    // Like singleBackspace(), keep the local view in sync until the host
+    // reports the new surrounding text.
+    d->sentence_state.erase(length);
+
+    if (d->auto_caps_enabled) {
+        if (autoCapsActive()) {
+            Q_EMIT autoCapsActivated();
+        } else {
+            Q_EMIT autoCapsDeactivated();
+        }
+    }
+
+    if(!d->text->isBlankAfterCursor()) {
+        d->editing_middle_of_text = true;
+    }
+    d->backspace_sent = true;
+}
+
 /*!
  * \brief AbstractTextEditor::wordLeftOfCursor returns the word that is left to
  * to the cursor
@@ -964,14 +1095,19 @@ QString AbstractTextEditor::wordLeftOfCursor() const
 {
     Q_D(const AbstractTextEditor);
 
-    const QString leftSurrounding = d->text->surroundingLeft();
-    int idx = leftSurrounding.length() - 1;
-    while (idx >= 0 && !d->word_engine->languageFeature()->isSeparator(leftSurrounding.at(idx))) {
+    // Every language separates at line breaks, so only the current line
+    // needs to be looked at.
+    const QString surrounding(d->text->surrounding());
+    const int offset = qMin<int>(d->text->surroundingOffset(), surrounding.length());
+    const int lineStart = d->text->lineStart();
+
+    int idx = offset - 1;
+    while (idx >= lineStart && !d->word_engine->languageFeature()->isSeparatorChar(surrounding.at(idx))) {
         --idx;
     }
-    int length = d->text->surroundingOffset() - idx;
+    idx = qMax(idx, lineStart - 1);
 
-    return leftSurrounding.right(length);
+    return surrounding.mid(qMax(idx, 0), offset - qMax(idx, 0));
 }
 
 //! \brief Adds \a word to user dictionary.
@@ -1001,18 +1137,16 @@ void AbstractTextEditor::singleBackspace()
 {
     Q_D(AbstractTextEditor);
     bool in_word = false;
-    QString textOnLeft = d->text->surroundingLeft();
 
     if (d->text->preedit().isEmpty()) {
-        in_word = textOnLeft.right(1) != " ";
+        in_word = d->sentence_state.lastChar() != QLatin1Char(' ');
         sendKeyPressAndReleaseEvents(Qt::Key_Backspace, Qt::NoModifier);
         // Deletion of surrounding text isn't updated in the model until later
         // Update it locally here for autocaps detection
-        textOnLeft.chop(1);
+        d->sentence_state.erase(1);
     } else {
         in_word = true;
         d->text->removeFromPreedit(1);
-        textOnLeft += d->text->preedit();
         
         // Clear previous word candidates
         Q_EMIT wordCandidatesChanged(WordCandidateList());
@@ -1033,23 +1167,20 @@ void AbstractTextEditor::singleBackspace()
         }
     }
 
-    if (in_word && textOnLeft.right(1) == " ") {
+    if (in_word && d->sentence_state.lastChar(d->text->preedit()) == QLatin1Char(' ')) {
         // We were in a word, but now we're not, so we've just finished deleting a word
         d->deleted_words++;
     }
 
-    textOnLeft = textOnLeft.trimmed();
-
-    const bool auto_caps_activated = d->word_engine->languageFeature()->activateAutoCaps(textOnLeft);
     if (d->auto_caps_enabled) {
-        if (auto_caps_activated) {
+        if (autoCapsActive()) {
             Q_EMIT autoCapsActivated();
-        } else if(!textOnLeft.isEmpty()) {
+        } else {
             Q_EMIT autoCapsDeactivated();
         }
     }
 
-    if(!d->text->surroundingRight().trimmed().isEmpty()) {
+    if(!d->text->isBlankAfterCursor()) {
         d->editing_middle_of_text = true;
     }
     d->backspace_sent = true;
@@ -1061,6 +1192,20 @@ void AbstractTextEditor::onKeyboardStateChanged(QString state) {
     d->keyboardState = state;
 }
 
+//! \brief Called before the editor starts handling an input event.
+//!
+//! Everything sent until the matching endHostTransaction() results from
+//! the same event, so implementations may hold it back and send a
+//! shorter equivalent sequence at the end. Transactions can nest; only
+//! the outermost one counts. The default implementation does nothing.
+void AbstractTextEditor::beginHostTransaction()
+{}
+
+//! \brief Called when the editor is done handling an input event.
+//! \sa beginHostTransaction()
+void AbstractTextEditor::endHostTransaction()
+{}
+
 void AbstractTextEditor::sendKeyPressAndReleaseEvents(
     int key, Qt::KeyboardModifiers modifiers, const QString& text) {
     QKeyEvent press(QEvent::KeyPress, key, modifiers, text);
@@ -1072,6 +1217,7 @@ void AbstractTextEditor::sendKeyPressAndReleaseEvents(
 void AbstractTextEditor::setPreeditFace(Model::Text::PreeditFace face)
 {
     Q_D(AbstractTextEditor);
+    HostTransaction transaction(this);
 
     text()->setPreeditFace(face);
     sendPreeditString(d->text->preedit(), face);
@@ -1080,6 +1226,8 @@ void AbstractTextEditor::setPreeditFace(Model::Text::PreeditFace face)
 void AbstractTextEditor::setPrimaryCandidate(QString candidate)
 {
     Q_D(AbstractTextEditor);
+    HostTransaction transaction(this);
+
     text()->setPrimaryCandidate(candidate);
 
     if (d->word_engine->languageFeature()->showPrimaryInPreedit()) {
@@ -1106,37 +1254,55 @@ void AbstractTextEditor::checkPreeditReentry(bool uncommittedDelete)
         return;
     }
 
-    int currentOffset = text()->surroundingOffset();
-    if(currentOffset > 1 && currentOffset <= text()->surrounding().size()) {
-        QString lastChar;
+    const QString &surrounding = text()->surrounding();
+    const int currentOffset = text()->surroundingOffset();
+    if(currentOffset > 1 && currentOffset <= surrounding.size()) {
+        QChar lastChar;
         if(uncommittedDelete) {
             // -2 for just deleted character that hasn't been committed and to reach character before cursor
-            lastChar = text()->surrounding().at(currentOffset-2);
+            lastChar = surrounding.at(currentOffset-2);
         } else {
-            lastChar = text()->surrounding().at(currentOffset-1);
+            lastChar = surrounding.at(currentOffset-1);
         }
-        if(!QRegExp("\\W+").exactMatch(lastChar) && !d->word_engine->languageFeature()->isSymbol(lastChar)) {
-            QStringList leftWords = text()->surroundingLeft().trimmed().split(QRegExp("[\\s\\d]+"));
-            int trimDiff = text()->surroundingLeft().size() - text()->surroundingLeft().trimmed().size();
-            if(leftWords.last().isEmpty()) {
+        if(CharacterClasses::isWordChar(lastChar) && !d->word_engine->languageFeature()->isSymbolChar(lastChar)) {
+            if(charRightOfCursorIsWordChar()) {
+                // Don't enter pre-edit in the middle of a word
+                return;
+            }
+
+            // Find the last word left of the cursor, skipping surrounding
+            // whitespace and a trailing run of whitespace and digits.
+            int begin = 0;
+            while (begin < currentOffset && surrounding.at(begin).isSpace()) {
+                ++begin;
+            }
+            int end = currentOffset;
+            while (end > begin && surrounding.at(end-1).isSpace()) {
+                --end;
+            }
+            int trimDiff = currentOffset - (end - begin);
+            if(end > begin && (surrounding.at(end-1).isSpace() || surrounding.at(end-1).isDigit())) {
                 // If removed char was punctuation trimming will result in an empty entry
-                leftWords.removeLast();
+                while (end > begin && (surrounding.at(end-1).isSpace() || surrounding.at(end-1).isDigit())) {
+                    --end;
+                }
                 trimDiff += 1;
             }
-            if(d->text->surroundingRight().left(1).contains(QRegExp("[\\w]"))) {
-                // Don't enter pre-edit in the middle of a word
-                return;
+            int start = end;
+            while (start > begin && !surrounding.at(start-1).isSpace() && !surrounding.at(start-1).isDigit()) {
+                --start;
             }
-            QString recreatedPreedit = leftWords.last();
+
+            QString recreatedPreedit = surrounding.mid(start, end - start);
             if(trimDiff == 0 && uncommittedDelete) {
                 // Remove the last character from the word if we weren't just deleting a space
                 // as the last backspace hasn't been committed yet.
                 recreatedPreedit.chop(1);
             }
 
-            for(int i = 0; i < recreatedPreedit.size(); i++) {
-                singleBackspace();
-            }
+            // The word is replaced by the preedit in one go, see below.
+            const int wordLength = recreatedPreedit.size();
+            d->sentence_state.erase(wordLength);
 
             if (!d->previous_preedit.isEmpty()) {
                 int deletePos = d->text->surroundingOffset() - d->previous_preedit_position - recreatedPreedit.size();
@@ -1146,13 +1312,26 @@ void AbstractTextEditor::checkPreeditReentry(bool uncommittedDelete)
                 }
                 d->previous_preedit = "";
             }
-            replaceTextWithPreedit(recreatedPreedit, 0, 0, recreatedPreedit.size());
+            replaceTextWithPreedit(recreatedPreedit, -wordLength, wordLength, recreatedPreedit.size());
         }
     }
 
     d->word_engine->computeCandidates(d->text.data());
 }
 
+//! \brief Returns whether the character right of the cursor belongs to a
+//! word, in which case the cursor is in the middle of that word.
+bool AbstractTextEditor::charRightOfCursorIsWordChar() const
+{
+    Q_D(const AbstractTextEditor);
+
+    const QString &surrounding = d->text->surrounding();
+    const int offset = d->text->surroundingOffset();
+
+    return offset >= 0 && offset < surrounding.size()
+            && CharacterClasses::isWordChar(surrounding.at(offset));
+}
+
 void AbstractTextEditor::onHasSelectionChanged(bool hasSelection) {
     m_hasSelection = hasSelection;
 }
@@ -140,6 +140,8 @@ public:
     bool isAutoCapsEnabled() const;
     Q_SLOT void setAutoCapsEnabled(bool enabled);
     Q_SIGNAL void autoCapsEnabledChanged(bool enabled);
+    bool autoCapsActive() const;
+    void resyncSentenceState();
 
     bool isDoubleSpaceFullStopEnabled() const;
     Q_SLOT void setDoubleSpaceFullStopEnabled(bool enabled);
@@ -169,13 +171,19 @@ private:
     virtual void sendCommitString(const QString &commit) = 0;
     virtual void sendKeyEvent(const QKeyEvent &ev) = 0;
     virtual void invokeAction(const QString &action, const QKeySequence &sequence) = 0;
+    virtual void beginHostTransaction();
+    virtual void endHostTransaction();
+
+    class HostTransaction;
 
     virtual void singleBackspace();
 
     void removeTrailingWhitespaces();
     Q_SLOT void autoRepeatBackspace();
     void autoRepeatWordBackspace();
+    void deleteLeftOfCursor(int length);
     QString wordLeftOfCursor() const;
+    bool charRightOfCursorIsWordChar() const;
 
     void sendKeyPressAndReleaseEvents(int key, Qt::KeyboardModifiers modifiers,
                                       const QString& text = QString());
@@ -275,7 +275,7 @@ class Keyboard(object):
     @property
     def _keypad_loader(self):
         return self.maliit.select_single(
-            "QQuickLoader", objectName='characterKeyPadLoader')
+            "KeypadCache", objectName='characterKeyPadLoader')
 
     @property
     def _plugin_source(self):
@@ -3,12 +3,20 @@ CONFIG += ordered
 SUBDIRS = \
     common \
     ut_editor \
+    ut_emojiindex \
+    ut_glyphatlas \
+    ut_emojimodel \
+    ut_hangulcomposer \
+    ut_idletrimmer \
     ut_keyboardgeometry \
     ut_keyboardsettings \
+    ut_keypadcache \
     ut_languagefeatures \
+    ut_languageregistry \
 #    ut_preedit-string \
     ut_repeat-backspace \
     ut_text \
+    ut_touchdispatcher \
     ut_word-candidates \
 ##    ut_wordengine \
 
@@ -233,6 +233,38 @@ private:
         Q_UNUSED(expected_auto_caps_activated_count)
         QCOMPARE(auto_caps_activated_spy.count(), expected_auto_caps_activated_count);
     }
+
+    Q_SLOT void testHostTransaction()
+    {
+        Logic::WordEngineProbe *word_engine = new Logic::WordEngineProbe;
+        Editor editor(EditorOptions(), new Model::Text, word_engine);
+
+        InputMethodHostProbe host;
+        editor.setHost(&host);
+
+        initializeWordEngine(word_engine);
+
+        editor.wordEngine()->setWordPredictionEnabled(true);
+        editor.wordEngine()->setEnabled(true);
+        editor.setPreeditEnabled(true);
+
+        // Each key results in a single preedit update, whatever the word
+        // engine does with the preedit face in between.
+        Q_FOREACH (const QString &input, QStringList() << "H" << "He" << "Hel") {
+            appendInput(&editor, input.right(1));
+            QCOMPARE(editor.lastTransactionMessageCount(), 1);
+            QCOMPARE(host.lastPreeditString(), input);
+        }
+
+        Key backspace;
+        backspace.setAction(Key::ActionBackspace);
+        editor.onKeyPressed(backspace);
+        editor.onKeyReleased(backspace);
+
+        QCOMPARE(editor.lastTransactionMessageCount(), 1);
+        QCOMPARE(host.lastPreeditString(), QString("He"));
+        QCOMPARE(host.keyEventCount(), 0);
+    }
 };
 
 QTEST_MAIN(TestEditor)
@@ -33,6 +33,12 @@
 
 // To properly mock language features, we need to realistically determine separators and autoCaps
 // Since unittests use latin letters, we simply use the same methods as in WesternLanguageFeatures
+MockLanguageFeatures::MockLanguageFeatures()
+{
+    static const CharacterClasses classes(QString::fromUtf8(",.!?:;\r\n"));
+    setCharacterClasses(&classes);
+}
+
 bool MockLanguageFeatures::activateAutoCaps(const QString &preedit) const
 {
     static const QString sentenceBreak = QString::fromUtf8("!.?:\r\n");
@@ -48,21 +54,6 @@ bool MockLanguageFeatures::activateAutoCaps(const QString &preedit) const
     return false;
 }
 
-bool MockLanguageFeatures::isSeparator(const QString &text) const
-{
-    static const QString separators = QString::fromUtf8(",.!?:;\r\n");
-
-    if (text.isEmpty()) {
-        return false;
-    }
-
-    if (separators.contains(text.right(1))) {
-        return true;
-    }
-
-    return false;
-}
-
 namespace MaliitKeyboard {
 namespace Logic {
 
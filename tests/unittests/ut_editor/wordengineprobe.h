@@ -40,10 +40,9 @@
 class MockLanguageFeatures : public AbstractLanguageFeatures
 {
 public:
-    explicit MockLanguageFeatures() {}
+    explicit MockLanguageFeatures();
     virtual ~MockLanguageFeatures() {}
 
-    virtual bool isSeparator(const QString &text) const;
     virtual bool alwaysShowSuggestions() const { return false; }
     virtual bool autoCapsAvailable() const { return true; }
     virtual bool activateAutoCaps(const QString &preedit) const;
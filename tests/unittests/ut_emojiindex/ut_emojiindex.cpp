@@ -0,0 +1,114 @@
+/*
+ * Copyright (C) 2016 Canonical, Ltd.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this list
+ * of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice, this list
+ * of conditions and the following disclaimer in the documentation and/or other materials
+ * provided with the distribution.
+ * Neither the name of Nokia Corporation nor the names of its contributors may be
+ * used to endorse or promote products derived from this software without specific
+ * prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL
+ * THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#include "emojiindex.h"
+
+#include <QtCore>
+#include <QtTest>
+
+class TestEmojiIndex : public QObject
+{
+    Q_OBJECT
+
+private:
+    Q_SLOT void testLookup_data()
+    {
+        QTest::addColumn<QString>("word");
+        QTest::addColumn<int>("mode");
+        QTest::addColumn<QString>("expectedFirst");
+
+        QTest::newRow("keyword") << QString("pizza") << int(EmojiIndex::ExactMatch) << QString::fromUtf8("🍕");
+        QTest::newRow("prefix") << QString("pizz") << int(EmojiIndex::PrefixMatch) << QString::fromUtf8("🍕");
+        QTest::newRow("prefix, exact only") << QString("pizz") << int(EmojiIndex::ExactMatch) << QString();
+        QTest::newRow("capitalized") << QString("Coffee") << int(EmojiIndex::PrefixMatch) << QString::fromUtf8("☕");
+        QTest::newRow("short name first") << QString("ok") << int(EmojiIndex::ExactMatch) << QString::fromUtf8("👌");
+        QTest::newRow("word of a name") << QString("ice") << int(EmojiIndex::ExactMatch) << QString::fromUtf8("🍦");
+        QTest::newRow("unknown") << QString("xyzzy") << int(EmojiIndex::PrefixMatch) << QString();
+        QTest::newRow("empty") << QString() << int(EmojiIndex::PrefixMatch) << QString();
+    }
+
+    Q_SLOT void testLookup()
+    {
+        QFETCH(QString, word);
+        QFETCH(int, mode);
+        QFETCH(QString, expectedFirst);
+
+        EmojiIndex index(EMOJI_INDEX);
+        QVERIFY(index.isValid());
+
+        QStringList result(index.lookup(word, 4, EmojiIndex::MatchMode(mode)));
+        QCOMPARE(result.value(0), expectedFirst);
+        QVERIFY(result.size() <= 4);
+        QCOMPARE(result.removeDuplicates(), 0);
+    }
+
+    Q_SLOT void testLimit()
+    {
+        EmojiIndex index(EMOJI_INDEX);
+
+        QCOMPARE(index.lookup("love", 3).size(), 3);
+        QCOMPARE(index.lookup("love", 1), index.lookup("love", 3).mid(0, 1));
+        QVERIFY(index.lookup("love", 0).isEmpty());
+    }
+
+    Q_SLOT void testInvalidFiles()
+    {
+        EmojiIndex missing("/nonexistent/emoji.idx");
+        QVERIFY(!missing.isValid());
+        QVERIFY(missing.lookup("pizza", 2).isEmpty());
+
+        QFile original(EMOJI_INDEX);
+        QVERIFY(original.open(QIODevice::ReadOnly));
+        const QByteArray data(original.readAll());
+
+        QTemporaryFile truncated;
+        QVERIFY(truncated.open());
+        truncated.write(data.left(data.size() / 2));
+        truncated.close();
+        QVERIFY(!EmojiIndex(truncated.fileName()).isValid());
+
+        QTemporaryFile garbage;
+        QVERIFY(garbage.open());
+        garbage.write(QByteArray(data.size(), 'x'));
+        garbage.close();
+        QVERIFY(!EmojiIndex(garbage.fileName()).isValid());
+    }
+
+    Q_SLOT void benchmarkLookup()
+    {
+        EmojiIndex index(EMOJI_INDEX);
+        QVERIFY(index.isValid());
+
+        QBENCHMARK {
+            index.lookup("pizza", 2);
+            index.lookup("hap", 2);
+        }
+    }
+};
+
+QTEST_MAIN(TestEmojiIndex)
+#include "ut_emojiindex.moc"
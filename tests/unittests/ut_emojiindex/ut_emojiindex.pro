@@ -0,0 +1,25 @@
+TOP_BUILDDIR = $$OUT_PWD/../../..
+TOP_SRCDIR = $$PWD/../../..
+
+include($${TOP_SRCDIR}/config.pri)
+include(../common-check.pri)
+
+CONFIG += testcase
+TARGET = ut_emojiindex
+QT = core testlib
+
+# Index compiled when building the emoji plugin.
+DEFINES += EMOJI_INDEX=\\\"$${TOP_BUILDDIR}/plugins/emoji/src/emoji_en.idx\\\"
+
+INCLUDEPATH    += \
+    $${TOP_SRCDIR}/src/lib/ \
+    $${TOP_SRCDIR}/src/lib/logic/
+
+HEADERS += $${TOP_SRCDIR}/src/lib/logic/emojiindex.h
+
+SOURCES += \
+    $${TOP_SRCDIR}/src/lib/logic/emojiindex.cpp \
+    ut_emojiindex.cpp
+
+target.path = $$INSTALL_BIN
+INSTALLS += target
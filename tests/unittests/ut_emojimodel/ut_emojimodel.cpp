@@ -0,0 +1,150 @@
+/*
+ * Copyright (C) 2016 Canonical, Ltd.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this list
+ * of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice, this list
+ * of conditions and the following disclaimer in the documentation and/or other materials
+ * provided with the distribution.
+ * Neither the name of Nokia Corporation nor the names of its contributors may be
+ * used to endorse or promote products derived from this software without specific
+ * prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL
+ * THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#include "emojimodel.h"
+
+#include <QtCore>
+#include <QtTest>
+
+class TestEmojiModel : public QObject
+{
+    Q_OBJECT
+
+private:
+    Q_SLOT void initTestCase()
+    {
+        QStandardPaths::setTestModeEnabled(true);
+    }
+
+    Q_SLOT void init()
+    {
+        QFile::remove(EmojiModel::storagePath());
+    }
+
+    Q_SLOT void testCategoriesLoadOnDemand()
+    {
+        EmojiModel model;
+
+        QVERIFY(!model.isStored());
+        QCOMPARE(model.recentCount(), 0);
+        QCOMPARE(model.categoryStart(EmojiModel::People), 0);
+        QVERIFY(model.rowCount() > model.categoryStart(EmojiModel::Flags));
+        QVERIFY(!model.isLoaded(EmojiModel::People));
+        QVERIFY(!model.isLoaded(EmojiModel::Nature));
+
+        const QModelIndex first(model.index(0));
+        QCOMPARE(first.data(EmojiModel::CharRole).toString(), QString::fromUtf8("😀"));
+        QCOMPARE(first.data(EmojiModel::CategoryRole).toInt(), int(EmojiModel::People));
+        QVERIFY(model.isLoaded(EmojiModel::People));
+        QVERIFY(!model.isLoaded(EmojiModel::Nature));
+
+        const QModelIndex nature(model.index(model.categoryStart(EmojiModel::Nature)));
+        QCOMPARE(nature.data(EmojiModel::CharRole).toString(), QString::fromUtf8("🐶"));
+        QVERIFY(model.isLoaded(EmojiModel::Nature));
+        QVERIFY(!model.isLoaded(EmojiModel::Flags));
+
+        QCOMPARE(model.categoryAt(model.categoryStart(EmojiModel::Food) - 1), int(EmojiModel::Nature));
+        QCOMPARE(model.categoryAt(model.rowCount() - 1), int(EmojiModel::Flags));
+        QCOMPARE(model.categoryAt(model.rowCount()), -1);
+        QCOMPARE(model.categoryAt(-1), -1);
+    }
+
+    Q_SLOT void testRecentIsPaddedToColumns()
+    {
+        EmojiModel model;
+        model.setRowsPerColumn(4);
+        const int rows = model.rowCount();
+
+        QSignalSpy inserted(&model, SIGNAL(rowsInserted(QModelIndex, int, int)));
+        QSignalSpy changed(&model, SIGNAL(dataChanged(QModelIndex, QModelIndex)));
+
+        model.addRecent(QString::fromUtf8("🐶"));
+        QCOMPARE(model.recentCount(), 4);
+        QCOMPARE(model.rowCount(), rows + 4);
+        QCOMPARE(model.categoryStart(EmojiModel::People), 4);
+        QCOMPARE(inserted.count(), 1);
+        QCOMPARE(inserted.at(0).at(1).toInt(), 0);
+        QCOMPARE(inserted.at(0).at(2).toInt(), 3);
+        QCOMPARE(model.index(0).data(EmojiModel::CharRole).toString(), QString::fromUtf8("🐶"));
+        QCOMPARE(model.index(1).data(EmojiModel::CharRole).toString(), QString());
+        QCOMPARE(model.index(3).data(EmojiModel::CategoryRole).toInt(), int(EmojiModel::Recent));
+
+        model.addRecent(QString::fromUtf8("🍏"));
+        QCOMPARE(model.recentCount(), 4);
+        QCOMPARE(inserted.count(), 1);
+        QCOMPARE(changed.count(), 1);
+        QCOMPARE(model.recent(), QStringList() << QString::fromUtf8("🍏") << QString::fromUtf8("🐶"));
+
+        // Already recent emoji stay where they are.
+        model.addRecent(QString::fromUtf8("🐶"));
+        QCOMPARE(model.recent(), QStringList() << QString::fromUtf8("🍏") << QString::fromUtf8("🐶"));
+    }
+
+    Q_SLOT void testMaxRecent()
+    {
+        EmojiModel model;
+        model.setMaxRecent(2);
+
+        model.addRecent("a");
+        model.addRecent("b");
+        model.addRecent("c");
+        QCOMPARE(model.recent(), QStringList() << "c" << "b");
+
+        QSignalSpy removed(&model, SIGNAL(rowsRemoved(QModelIndex, int, int)));
+        model.setMaxRecent(1);
+        QCOMPARE(model.recent(), QStringList() << "c");
+        QCOMPARE(removed.count(), 1);
+        QCOMPARE(model.recentCount(), 1);
+    }
+
+    Q_SLOT void testPersistence()
+    {
+        {
+            EmojiModel model;
+            model.setRecent(QStringList() << "b" << "a" << "" << "b");
+            model.setPosition(42);
+            // Pending changes are written when the model goes away.
+        }
+
+        {
+            EmojiModel model;
+            QVERIFY(model.isStored());
+            QCOMPARE(model.recent(), QStringList() << "b" << "a");
+            QCOMPARE(model.position(), 42);
+
+            model.addRecent("c");
+            model.save();
+            QThreadPool::globalInstance()->waitForDone();
+        }
+
+        EmojiModel model;
+        QCOMPARE(model.recent(), QStringList() << "c" << "b" << "a");
+    }
+};
+
+QTEST_MAIN(TestEmojiModel)
+#include "ut_emojimodel.moc"
@@ -0,0 +1,25 @@
+TOP_BUILDDIR = $$OUT_PWD/../../..
+TOP_SRCDIR = $$PWD/../../..
+
+include($${TOP_SRCDIR}/config.pri)
+include(../common-check.pri)
+
+CONFIG += testcase
+TARGET = ut_emojimodel
+QT = core testlib
+
+INCLUDEPATH    += \
+    $${TOP_SRCDIR}/src/lib/ \
+    $${TOP_SRCDIR}/src/lib/logic/
+
+HEADERS += \
+    $${TOP_SRCDIR}/src/lib/logic/emojimodel.h \
+    $${TOP_SRCDIR}/src/lib/logic/emojitable.h
+
+SOURCES += \
+    $${TOP_SRCDIR}/src/lib/logic/emojimodel.cpp \
+    $${TOP_SRCDIR}/src/lib/logic/emojitable.cpp \
+    ut_emojimodel.cpp
+
+target.path = $$INSTALL_BIN
+INSTALLS += target
@@ -0,0 +1,135 @@
+/*
+ * Copyright (C) 2016 Canonical, Ltd.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this list
+ * of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice, this list
+ * of conditions and the following disclaimer in the documentation and/or other materials
+ * provided with the distribution.
+ * Neither the name of Nokia Corporation nor the names of its contributors may be
+ * used to endorse or promote products derived from this software without specific
+ * prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL
+ * THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#include "plugin/glyphatlas.h"
+
+#include <QtCore>
+#include <QtGui>
+#include <QtTest>
+
+class TestGlyphAtlas
+    : public QObject
+{
+    Q_OBJECT
+
+private:
+    QSet<QString> labels(const QStringList &texts, int pixelSize)
+    {
+        QSet<QString> keys;
+        Q_FOREACH (const QString &text, texts) {
+            keys.insert(GlyphAtlas::labelKey(text, pixelSize));
+        }
+        return keys;
+    }
+
+    QRectF pixelRect(const QSharedPointer<GlyphAtlas> &atlas, const GlyphAtlas::Glyph &glyph)
+    {
+        const QSizeF size(atlas->image().size());
+        return QRectF(glyph.texCoords.x() * size.width(), glyph.texCoords.y() * size.height(),
+                      glyph.texCoords.width() * size.width(), glyph.texCoords.height() * size.height());
+    }
+
+    Q_SLOT void testLabelKey()
+    {
+        QCOMPARE(GlyphAtlas::labelKey("a", 12), QString("12 a"));
+        QCOMPARE(GlyphAtlas::labelKey("a b", 8), QString("8 a b"));
+        QVERIFY(GlyphAtlas::labelKey("a", 12) != GlyphAtlas::labelKey("a", 13));
+    }
+
+    Q_SLOT void testPacking()
+    {
+        const QStringList texts(QStringList() << "q" << "w" << "e" << "Shift" << "123" << "a b");
+        QSharedPointer<GlyphAtlas> atlas(GlyphAtlas::get(QFont(), 4, 2, labels(texts, 20)));
+        const QRectF bounds(QPointF(0, 0), QSizeF(atlas->image().size()));
+
+        QList<QRectF> rects;
+        rects.append(pixelRect(atlas, atlas->frame()));
+        Q_FOREACH (const QString &text, texts) {
+            const GlyphAtlas::Glyph glyph(atlas->glyph(GlyphAtlas::labelKey(text, 20)));
+            QVERIFY(!glyph.size.isEmpty());
+            QVERIFY(!glyph.color);
+            rects.append(pixelRect(atlas, glyph));
+
+            // sizes are in logical pixels
+            QCOMPARE(glyph.size * 2, rects.last().size());
+        }
+
+        for (int i = 0; i < rects.count(); ++i) {
+            QVERIFY(bounds.contains(rects.at(i)));
+            for (int j = i + 1; j < rects.count(); ++j) {
+                QVERIFY(!rects.at(i).intersects(rects.at(j)));
+            }
+        }
+
+        QVERIFY(atlas->glyph(GlyphAtlas::labelKey("q", 10)).size.isEmpty());
+        QCOMPARE(atlas->radius(), qreal(4));
+    }
+
+    Q_SLOT void testWideLabel()
+    {
+        const QString text(200, QLatin1Char('W'));
+        QSharedPointer<GlyphAtlas> atlas(GlyphAtlas::get(QFont(), 4, 3, labels(QStringList() << text, 40)));
+        const QRectF rect(pixelRect(atlas, atlas->glyph(GlyphAtlas::labelKey(text, 40))));
+
+        QVERIFY(rect.width() > 512);
+        QVERIFY(QRectF(QPointF(0, 0), QSizeF(atlas->image().size())).contains(rect));
+    }
+
+    Q_SLOT void testSharedAtlases()
+    {
+        const QSet<QString> keys(labels(QStringList() << "a" << "b", 16));
+
+        QSharedPointer<GlyphAtlas> atlas(GlyphAtlas::get(QFont(), 4, 1, keys));
+        QCOMPARE(GlyphAtlas::get(QFont(), 4, 1, keys), atlas);
+        QVERIFY(GlyphAtlas::get(QFont(), 4, 2, keys) != atlas);
+        QVERIFY(GlyphAtlas::get(QFont(), 4, 1, labels(QStringList() << "a", 16)) != atlas);
+
+        // the cache does not keep atlases alive
+        QWeakPointer<GlyphAtlas> weak(atlas);
+        atlas.clear();
+        QVERIFY(weak.isNull());
+    }
+
+    Q_SLOT void testHasColors()
+    {
+        QImage image(8, 8, QImage::Format_ARGB32_Premultiplied);
+        image.fill(Qt::transparent);
+        image.setPixel(1, 1, qRgba(255, 255, 255, 255));
+        image.setPixel(2, 2, qRgba(128, 128, 128, 128));
+        QVERIFY(!GlyphAtlas::hasColors(image, image.rect()));
+
+        image.setPixel(6, 6, qRgba(200, 0, 0, 255));
+        QVERIFY(GlyphAtlas::hasColors(image, image.rect()));
+        QVERIFY(!GlyphAtlas::hasColors(image, QRect(0, 0, 4, 4)));
+
+        // rectangles reaching past the image are cut off
+        QVERIFY(GlyphAtlas::hasColors(image, QRect(4, 4, 100, 100)));
+    }
+};
+
+QTEST_MAIN(TestGlyphAtlas)
+#include "ut_glyphatlas.moc"
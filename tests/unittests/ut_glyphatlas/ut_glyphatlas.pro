@@ -0,0 +1,20 @@
+TOP_BUILDDIR = $${OUT_PWD}/../../..
+TOP_SRCDIR = $$PWD/../../..
+
+include($${TOP_SRCDIR}/config.pri)
+include(../common-check.pri)
+
+CONFIG += testcase
+TARGET = ut_glyphatlas
+
+QT = core gui testlib
+
+QMAKE_LFLAGS_RPATH=$${TOP_BUILDDIR}/src/plugin
+
+LIBS += -L$${TOP_BUILDDIR}/src/plugin -lubuntu-keyboard-plugin -lgsettings-qt
+
+SOURCES += \
+    ut_glyphatlas.cpp \
+
+target.path = $$INSTALL_BIN
+INSTALLS += target
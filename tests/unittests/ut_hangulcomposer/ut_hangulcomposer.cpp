@@ -0,0 +1,102 @@
+/*
+ * Copyright (C) 2016 Canonical, Ltd.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this list
+ * of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice, this list
+ * of conditions and the following disclaimer in the documentation and/or other materials
+ * provided with the distribution.
+ * Neither the name of Nokia Corporation nor the names of its contributors may be
+ * used to endorse or promote products derived from this software without specific
+ * prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL
+ * THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+
+#include "hangulcomposer.h"
+
+#include <QtCore>
+#include <QtTest>
+
+class TestHangulComposer : public QObject
+{
+    Q_OBJECT
+
+private:
+    HangulComposer m_composer;
+
+    Q_SLOT void testAddJamo_data()
+    {
+        QTest::addColumn<QString>("preedit");
+        QTest::addColumn<QString>("jamo");
+        QTest::addColumn<QString>("expectedResult");
+
+        QTest::newRow("empty preedit") << QString() << QString::fromUtf8("ㅎ") << QString::fromUtf8("ㅎ");
+        QTest::newRow("lead and vowel") << QString::fromUtf8("ㅎ") << QString::fromUtf8("ㅏ") << QString::fromUtf8("하");
+        QTest::newRow("final consonant") << QString::fromUtf8("하") << QString::fromUtf8("ㄴ") << QString::fromUtf8("한");
+        QTest::newRow("final moves on") << QString::fromUtf8("한그") << QString::fromUtf8("ㄹ") << QString::fromUtf8("한글");
+        QTest::newRow("final starts next syllable") << QString::fromUtf8("핝") << QString::fromUtf8("ㅏ") << QString::fromUtf8("한자");
+        QTest::newRow("compound final splits") << QString::fromUtf8("닭") << QString::fromUtf8("ㅏ") << QString::fromUtf8("달가");
+        QTest::newRow("diphthong") << QString::fromUtf8("고") << QString::fromUtf8("ㅏ") << QString::fromUtf8("과");
+        QTest::newRow("compound final") << QString::fromUtf8("갈") << QString::fromUtf8("ㄱ") << QString::fromUtf8("갉");
+        QTest::newRow("no compound final") << QString::fromUtf8("갉") << QString::fromUtf8("ㄱ") << QString::fromUtf8("갉ㄱ");
+        QTest::newRow("not a final") << QString::fromUtf8("가") << QString::fromUtf8("ㄸ") << QString::fromUtf8("가ㄸ");
+        QTest::newRow("two vowels") << QString::fromUtf8("ㅏ") << QString::fromUtf8("ㅏ") << QString::fromUtf8("ㅏㅏ");
+        QTest::newRow("latin") << QString("a") << QString::fromUtf8("ㄱ") << QString::fromUtf8("aㄱ");
+    }
+
+    Q_SLOT void testAddJamo()
+    {
+        QFETCH(QString, preedit);
+        QFETCH(QString, jamo);
+        QFETCH(QString, expectedResult);
+
+        QCOMPARE(m_composer.addJamo(preedit, jamo), expectedResult);
+    }
+
+    Q_SLOT void testEraseJamo_data()
+    {
+        QTest::addColumn<QString>("preedit");
+        QTest::addColumn<QString>("expectedResult");
+
+        QTest::newRow("empty preedit") << QString() << QString();
+        QTest::newRow("lone jamo") << QString::fromUtf8("한ㄱ") << QString::fromUtf8("한");
+        QTest::newRow("final consonant") << QString::fromUtf8("한") << QString::fromUtf8("하");
+        QTest::newRow("compound final") << QString::fromUtf8("갉") << QString::fromUtf8("갈");
+        QTest::newRow("diphthong") << QString::fromUtf8("과") << QString::fromUtf8("고");
+        QTest::newRow("vowel") << QString::fromUtf8("하") << QString::fromUtf8("ㅎ");
+    }
+
+    Q_SLOT void testEraseJamo()
+    {
+        QFETCH(QString, preedit);
+        QFETCH(QString, expectedResult);
+
+        QCOMPARE(m_composer.eraseJamo(preedit), expectedResult);
+    }
+
+    Q_SLOT void testJoinAndSplit()
+    {
+        QCOMPARE(m_composer.join(QString::fromUtf8("ㄷ"), QString::fromUtf8("ㅏ"), QString::fromUtf8("ㄺ")),
+                 QString::fromUtf8("닭"));
+        QCOMPARE(m_composer.join(QString::fromUtf8("ㄳ"), QString::fromUtf8("ㅏ"), QString()), QString());
+        QCOMPARE(m_composer.split(QString::fromUtf8("닭")),
+                 QStringList() << QString::fromUtf8("ㄷ") << QString::fromUtf8("ㅏ") << QString::fromUtf8("ㄺ"));
+        QCOMPARE(m_composer.split(QString::fromUtf8("과")),
+                 QStringList() << QString::fromUtf8("ㄱ") << QString::fromUtf8("ㅘ") << QString());
+    }
+};
+
+QTEST_MAIN(TestHangulComposer)
+#include "ut_hangulcomposer.moc"
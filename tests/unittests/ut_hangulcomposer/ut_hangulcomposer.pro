@@ -0,0 +1,22 @@
+TOP_BUILDDIR = $$OUT_PWD/../../..
+TOP_SRCDIR = $$PWD/../../..
+
+include($${TOP_SRCDIR}/config.pri)
+include(../common-check.pri)
+
+CONFIG += testcase
+TARGET = ut_hangulcomposer
+QT = core testlib
+
+INCLUDEPATH    += \
+    $${TOP_SRCDIR}/src/lib/ \
+    $${TOP_SRCDIR}/src/lib/logic/
+
+HEADERS += $${TOP_SRCDIR}/src/lib/logic/hangulcomposer.h
+
+SOURCES += \
+    $${TOP_SRCDIR}/src/lib/logic/hangulcomposer.cpp \
+    ut_hangulcomposer.cpp
+
+target.path = $$INSTALL_BIN
+INSTALLS += target
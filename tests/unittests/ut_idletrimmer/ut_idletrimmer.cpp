@@ -0,0 +1,122 @@
+/*
+ * Copyright (C) 2016 Canonical, Ltd.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this list
+ * of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice, this list
+ * of conditions and the following disclaimer in the documentation and/or other materials
+ * provided with the distribution.
+ * Neither the name of Nokia Corporation nor the names of its contributors may be
+ * used to endorse or promote products derived from this software without specific
+ * prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL
+ * THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+
+#include "plugin/idletrimmer.h"
+
+#include <QtCore>
+#include <QtTest>
+
+namespace MaliitKeyboard {
+
+class TestIdleTrimmer
+    : public QObject
+{
+    Q_OBJECT
+
+private:
+    IdleTrimmer *m_trimmer;
+
+    Q_SLOT void init()
+    {
+        m_trimmer = new IdleTrimmer(this);
+        m_trimmer->setCacheDelay(20);
+        m_trimmer->setEngineDelay(60);
+    }
+
+    Q_SLOT void cleanup()
+    {
+        delete m_trimmer;
+    }
+
+    Q_SLOT void testStagesRunInOrder()
+    {
+        QSignalSpy caches(m_trimmer, SIGNAL(trimCaches()));
+        QSignalSpy engines(m_trimmer, SIGNAL(trimEngines()));
+
+        m_trimmer->setHidden(true);
+
+        QTRY_COMPARE(caches.count(), 1);
+        QCOMPARE(engines.count(), 0);
+        QCOMPARE(m_trimmer->stage(), IdleTrimmer::CacheStage);
+
+        QTRY_COMPARE(engines.count(), 1);
+        QCOMPARE(m_trimmer->stage(), IdleTrimmer::EngineStage);
+
+        // Nothing is left to trim until shown again
+        QTest::qWait(100);
+        QCOMPARE(caches.count(), 1);
+        QCOMPARE(engines.count(), 1);
+
+        const QVariantMap metrics(m_trimmer->metrics());
+        QCOMPARE(metrics["cache"].toMap()["runs"].toInt(), 1);
+        QCOMPARE(metrics["engine"].toMap()["runs"].toInt(), 1);
+        QVERIFY(metrics["engine"].toMap()["lastMsecs"].toLongLong() >= 0);
+    }
+
+    Q_SLOT void testShowingCancelsTrimming()
+    {
+        QSignalSpy caches(m_trimmer, SIGNAL(trimCaches()));
+
+        m_trimmer->setHidden(true);
+        m_trimmer->setHidden(false);
+
+        QTest::qWait(100);
+        QCOMPARE(caches.count(), 0);
+        QCOMPARE(m_trimmer->stage(), IdleTrimmer::NoStage);
+    }
+
+    Q_SLOT void testWarmUpIsMeasured()
+    {
+        QSignalSpy caches(m_trimmer, SIGNAL(trimCaches()));
+
+        // Frames without a preceding trim are no warm-up
+        m_trimmer->finishWarmUp();
+        QCOMPARE(m_trimmer->metrics()["warmUp"].toMap()["lastMsecs"].toLongLong(), qint64(-1));
+
+        m_trimmer->setEngineDelay(60 * 1000);
+        m_trimmer->setHidden(true);
+        QTRY_COMPARE(caches.count(), 1);
+
+        m_trimmer->setHidden(false);
+        QCOMPARE(m_trimmer->stage(), IdleTrimmer::NoStage);
+        m_trimmer->finishWarmUp();
+
+        const QVariantMap warmUp(m_trimmer->metrics()["warmUp"].toMap());
+        QVERIFY(warmUp["lastMsecs"].toLongLong() >= 0);
+        QCOMPARE(warmUp["lastStage"].toInt(), int(IdleTrimmer::CacheStage));
+
+        // Hiding again starts over with the first stage
+        m_trimmer->setHidden(true);
+        QTRY_COMPARE(caches.count(), 2);
+    }
+};
+
+} // namespace
+
+QTEST_MAIN(MaliitKeyboard::TestIdleTrimmer)
+#include "ut_idletrimmer.moc"
@@ -0,0 +1,19 @@
+TOP_BUILDDIR = $${OUT_PWD}/../../..
+TOP_SRCDIR = $$PWD/../../..
+
+include($${TOP_SRCDIR}/config.pri)
+include(../common-check.pri)
+
+CONFIG += testcase
+TARGET = ut_idletrimmer
+QT = core testlib
+
+HEADERS += \
+    $${TOP_SRCDIR}/src/plugin/idletrimmer.h
+
+SOURCES += \
+    ut_idletrimmer.cpp \
+    $${TOP_SRCDIR}/src/plugin/idletrimmer.cpp
+
+target.path = $$INSTALL_BIN
+INSTALLS += target
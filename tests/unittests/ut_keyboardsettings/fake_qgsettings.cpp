@@ -31,6 +31,11 @@
 
 #include <QVariant>
 
+// Backend shared by all fake instances, inspected by the tests.
+QVariantHash fakeSettingsValues;
+int fakeSettingsReads = 0;
+QStringList fakeSettingsWrites;
+
 QGSettings::QGSettings(const QByteArray &schema_id, const QByteArray &path, QObject *parent) :
     QObject(parent)
 {
@@ -44,15 +49,15 @@ QGSettings::~QGSettings()
 
 QVariant QGSettings::get(const QString &key) const
 {
-    Q_UNUSED(key);
-    QVariant var;
-    return var;
+    ++fakeSettingsReads;
+    return fakeSettingsValues.value(key);
 }
 
 void QGSettings::set(const QString &key, const QVariant &value)
 {
-    Q_UNUSED(key);
-    Q_UNUSED(value);
+    fakeSettingsValues.insert(key, value);
+    fakeSettingsWrites.append(key);
+    Q_EMIT changed(key);
 }
 
 QStringList QGSettings::keys() const
@@ -32,6 +32,10 @@
 #include <QtCore>
 #include <QtTest>
 
+extern QVariantHash fakeSettingsValues;
+extern int fakeSettingsReads;
+extern QStringList fakeSettingsWrites;
+
 namespace MaliitKeyboard {
 
 class TestKeyboardSettings
@@ -47,6 +51,9 @@ private:
 
     Q_SLOT void init()
     {
+        fakeSettingsValues.clear();
+        fakeSettingsReads = 0;
+        fakeSettingsWrites.clear();
         m_settings = new KeyboardSettings(this);
     }
 
@@ -126,6 +133,50 @@ private:
         QCOMPARE(doubleSpaceFullStopSpy.count(), doubleSpaceFullStopSpyCount);
         QCOMPARE(stayHiddenSpy.count(), stayHiddenSpyCount);
     }
+
+    Q_SLOT void testGettersUseSnapshot()
+    {
+        delete m_settings;
+        fakeSettingsValues.insert("keyPressFeedback", true);
+        fakeSettingsValues.insert("enabledLanguages", QStringList() << "en" << "zh");
+        fakeSettingsValues.insert("opacity", 0.5);
+        m_settings = new KeyboardSettings(this);
+
+        fakeSettingsReads = 0;
+        QCOMPARE(m_settings->keyPressAudioFeedback(), true);
+        QCOMPARE(m_settings->keyPressHapticFeedback(), false);
+        QCOMPARE(m_settings->enabledLanguages(), QStringList() << "en" << "zh-hans");
+        QCOMPARE(m_settings->opacity(), 0.5);
+        QCOMPARE(fakeSettingsReads, 0);
+
+        fakeSettingsValues.insert("keyPressFeedback", false);
+        QCOMPARE(m_settings->keyPressAudioFeedback(), true);
+        m_settings->settingUpdated("keyPressFeedback");
+        QCOMPARE(m_settings->keyPressAudioFeedback(), false);
+    }
+
+    Q_SLOT void testWritesAreBatched()
+    {
+        QSignalSpy activeSpy(m_settings, SIGNAL(activeLanguageChanged(QString)));
+
+        m_settings->setActiveLanguage("de");
+        m_settings->setPreviousLanguage("en");
+        m_settings->setActiveLanguage("fr");
+        QCOMPARE(m_settings->activeLanguage(), QString("fr"));
+        QCOMPARE(m_settings->previousLanguage(), QString("en"));
+        QVERIFY(fakeSettingsWrites.isEmpty());
+
+        // the backend may not overwrite what is still to be written
+        fakeSettingsValues.insert("activeLanguage", "es");
+        m_settings->settingUpdated("activeLanguage");
+        QCOMPARE(m_settings->activeLanguage(), QString("fr"));
+        QCOMPARE(activeSpy.count(), 0);
+
+        QTRY_COMPARE(fakeSettingsWrites.count(), 2);
+        QCOMPARE(fakeSettingsValues.value("activeLanguage").toString(), QString("fr"));
+        QCOMPARE(fakeSettingsValues.value("previousLanguage").toString(), QString("en"));
+        QCOMPARE(activeSpy.count(), 1);
+    }
 };
 
 } // namespace
@@ -0,0 +1,212 @@
+/*
+ * Copyright (C) 2016 Canonical, Ltd.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this list
+ * of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice, this list
+ * of conditions and the following disclaimer in the documentation and/or other materials
+ * provided with the distribution.
+ * Neither the name of Nokia Corporation nor the names of its contributors may be
+ * used to endorse or promote products derived from this software without specific
+ * prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL
+ * THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#include "plugin/incubationcontroller.h"
+#include "plugin/keypadcache.h"
+
+#include <QtCore>
+#include <QtTest>
+#include <QtQml>
+
+namespace {
+
+const char *const KeypadQml = "import QtQuick 2.0\n"
+                               "Item { property string keypadState: maliit_keypad_state }\n";
+
+} // unnamed namespace
+
+class TestKeypadCache
+    : public QObject
+{
+    Q_OBJECT
+
+private:
+    QTemporaryDir m_dir;
+    QQmlEngine *m_engine;
+    KeypadCache *m_cache;
+
+    void writeKeypad(const QString &name)
+    {
+        QFile file(m_dir.path() + QDir::separator() + name);
+        QVERIFY(file.open(QIODevice::WriteOnly));
+        file.write(KeypadQml);
+    }
+
+    Q_SLOT void initTestCase()
+    {
+        QVERIFY(m_dir.isValid());
+        qmlRegisterType<KeypadCache>("UbuntuKeyboard", 1, 0, "KeypadCache");
+
+        writeKeypad("a.qml");
+        writeKeypad("b.qml");
+        writeKeypad("c.qml");
+    }
+
+    Q_SLOT void init()
+    {
+        m_engine = new QQmlEngine;
+        QQmlComponent component(m_engine);
+        component.setData("import UbuntuKeyboard 1.0\n"
+                          "KeypadCache { width: 100; height: 50; capacity: 2 }\n",
+                          QUrl::fromLocalFile(m_dir.path() + QDir::separator() + "container.qml"));
+        m_cache = qobject_cast<KeypadCache *>(component.create());
+        QVERIFY(m_cache);
+    }
+
+    Q_SLOT void cleanup()
+    {
+        delete m_cache;
+        m_cache = 0;
+        delete m_engine;
+        m_engine = 0;
+    }
+
+    Q_SLOT void testReuse()
+    {
+        QSignalSpy loadedSpy(m_cache, SIGNAL(loaded()));
+
+        m_cache->setSource(QUrl("a.qml"));
+        QPointer<QQuickItem> a(m_cache->item());
+        QVERIFY(a);
+        QVERIFY(a->isVisible());
+        QCOMPARE(a->size(), QSizeF(100, 50));
+
+        m_cache->setSource(QUrl("b.qml"));
+        QPointer<QQuickItem> b(m_cache->item());
+        QVERIFY(b);
+        QVERIFY(b != a);
+        QVERIFY(!a->isVisible());
+        QCOMPARE(m_cache->count(), 2);
+
+        // switching back shows the cached instance
+        m_cache->setSource(QUrl("a.qml"));
+        QCOMPARE(m_cache->item(), a.data());
+        QVERIFY(a->isVisible());
+        QVERIFY(!b->isVisible());
+        QCOMPARE(loadedSpy.count(), 3);
+    }
+
+    Q_SLOT void testEviction()
+    {
+        m_cache->setSource(QUrl("a.qml"));
+        QPointer<QQuickItem> a(m_cache->item());
+        m_cache->setSource(QUrl("b.qml"));
+        QPointer<QQuickItem> b(m_cache->item());
+        m_cache->setSource(QUrl("a.qml"));
+
+        // b is the least recently used one
+        m_cache->setSource(QUrl("c.qml"));
+        QCOMPARE(m_cache->count(), 2);
+        QCoreApplication::sendPostedEvents(0, QEvent::DeferredDelete);
+        QVERIFY(a);
+        QVERIFY(!b);
+
+        m_cache->clear();
+        QCoreApplication::sendPostedEvents(0, QEvent::DeferredDelete);
+        QCOMPARE(m_cache->count(), 1);
+        QVERIFY(!a);
+        QVERIFY(m_cache->item());
+    }
+
+    Q_SLOT void testOrientation()
+    {
+        QSignalSpy loadedSpy(m_cache, SIGNAL(loaded()));
+
+        m_cache->setSource(QUrl("a.qml"));
+        QQuickItem *portrait = m_cache->item();
+
+        m_cache->setOrientation(Qt::LandscapeOrientation);
+        QVERIFY(m_cache->item() != portrait);
+        QCOMPARE(m_cache->count(), 2);
+
+        m_cache->setOrientation(Qt::PrimaryOrientation);
+        QCOMPARE(m_cache->item(), portrait);
+
+        // a rotation does not count as loading a new layout
+        QCOMPARE(loadedSpy.count(), 1);
+    }
+
+    Q_SLOT void testKeypadState()
+    {
+        m_cache->setKeypadState("NORMAL");
+        m_cache->setSource(QUrl("a.qml"));
+        QQuickItem *a = m_cache->item();
+        QCOMPARE(a->property("keypadState").toString(), QString("NORMAL"));
+
+        m_cache->setSource(QUrl("b.qml"));
+        QQuickItem *b = m_cache->item();
+        m_cache->setKeypadState("SHIFTED");
+        QCOMPARE(b->property("keypadState").toString(), QString("SHIFTED"));
+
+        // the hidden keypad keeps its bindings as they were
+        QCOMPARE(a->property("keypadState").toString(), QString("NORMAL"));
+
+        // and catches up once it is shown again
+        m_cache->setSource(QUrl("a.qml"));
+        QCOMPARE(m_cache->item(), a);
+        QCOMPARE(a->property("keypadState").toString(), QString("SHIFTED"));
+        QCOMPARE(b->property("keypadState").toString(), QString("SHIFTED"));
+    }
+
+    Q_SLOT void testAsynchronous()
+    {
+        IncubationController controller;
+        m_engine->setIncubationController(&controller);
+        m_cache->setAsynchronous(true);
+
+        QSignalSpy loadedSpy(m_cache, SIGNAL(loaded()));
+
+        m_cache->setSource(QUrl("a.qml"));
+        QCOMPARE(m_cache->status(), KeypadCache::Loading);
+        QVERIFY(!m_cache->item());
+        QTRY_VERIFY(m_cache->item());
+        QCOMPARE(m_cache->status(), KeypadCache::Ready);
+        QCOMPARE(loadedSpy.count(), 1);
+
+        // the previous keypad stays, disabled, until the next one is ready
+        QQuickItem *a = m_cache->item();
+        m_cache->setSource(QUrl("b.qml"));
+        QCOMPARE(m_cache->status(), KeypadCache::Loading);
+        QCOMPARE(m_cache->item(), a);
+        QVERIFY(a->isVisible());
+        QVERIFY(!a->isEnabled());
+        QTRY_VERIFY(m_cache->item() != a);
+        QVERIFY(!a->isVisible());
+
+        // cached keypads are shown right away
+        m_cache->setSource(QUrl("a.qml"));
+        QCOMPARE(m_cache->status(), KeypadCache::Ready);
+        QCOMPARE(m_cache->item(), a);
+        QCOMPARE(loadedSpy.count(), 3);
+
+        // the engine must not outlive the controller
+        cleanup();
+    }
+};
+
+QTEST_MAIN(TestKeypadCache)
+#include "ut_keypadcache.moc"
@@ -0,0 +1,144 @@
+/*
+ * Copyright (C) 2016 Canonical, Ltd.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this list
+ * of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice, this list
+ * of conditions and the following disclaimer in the documentation and/or other materials
+ * provided with the distribution.
+ * Neither the name of Nokia Corporation nor the names of its contributors may be
+ * used to endorse or promote products derived from this software without specific
+ * prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL
+ * THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#include "logic/languageregistry.h"
+
+#include <QtCore>
+#include <QtTest>
+
+using namespace MaliitKeyboard::Logic;
+
+namespace {
+
+void touch(const QString &fileName)
+{
+    QDir().mkpath(QFileInfo(fileName).absolutePath());
+    QFile file(fileName);
+    file.open(QIODevice::WriteOnly);
+}
+
+} // unnamed namespace
+
+class TestLanguageRegistry
+    : public QObject
+{
+    Q_OBJECT
+
+private:
+    QTemporaryDir *m_dir;
+    QString m_plugins;
+    QString m_morePlugins;
+    QString m_dictionaries;
+
+    Q_SLOT void init()
+    {
+        m_dir = new QTemporaryDir;
+        m_plugins = m_dir->path() + "/lib";
+        m_morePlugins = m_dir->path() + "/more";
+        m_dictionaries = m_dir->path() + "/hunspell";
+
+        touch(m_plugins + "/en/libenplugin.so");
+        touch(m_plugins + "/en/Keyboard_en.qml");
+        touch(m_plugins + "/en/Keyboard_en_email.qml");
+        touch(m_plugins + "/en/Keyboard_en_url_search.qml");
+        touch(m_plugins + "/en/database_en.db");
+        touch(m_plugins + "/en/overrides.csv");
+        touch(m_plugins + "/de/Keyboard_de.qml");
+        touch(m_plugins + "/pt-br/libpt-brplugin.so");
+        touch(m_morePlugins + "/de/libdeplugin.so");
+        touch(m_morePlugins + "/en/libenplugin.so");
+        touch(m_dictionaries + "/en_GB.aff");
+        touch(m_dictionaries + "/en_GB.dic");
+        touch(m_dictionaries + "/en_US.aff");
+        touch(m_dictionaries + "/en_US.dic");
+        touch(m_dictionaries + "/pt_BR.aff");
+        touch(m_dictionaries + "/pt_BR.dic");
+        touch(m_dictionaries + "/de_DE.aff");
+    }
+
+    Q_SLOT void cleanup()
+    {
+        delete m_dir;
+        m_dir = 0;
+    }
+
+    Q_SLOT void testResources()
+    {
+        LanguageRegistry registry;
+        registry.setSearchPaths(QStringList() << m_plugins << m_morePlugins, m_dictionaries);
+
+        QCOMPARE(registry.languages(), QStringList() << "de" << "en" << "pt-br");
+        QVERIFY(registry.contains("en"));
+        QVERIFY(!registry.contains("fr"));
+
+        const LanguageResources en(registry.resources("en"));
+        QCOMPARE(en.id, QString("en"));
+        QCOMPARE(en.path, m_plugins + "/en");
+        QCOMPARE(en.plugin, m_plugins + "/en/libenplugin.so");
+        QCOMPARE(en.layouts.value(""), m_plugins + "/en/Keyboard_en.qml");
+        QCOMPARE(en.layouts.value("email"), m_plugins + "/en/Keyboard_en_email.qml");
+        QCOMPARE(en.layouts.value("url_search"), m_plugins + "/en/Keyboard_en_url_search.qml");
+        QCOMPARE(en.database, m_plugins + "/en/database_en.db");
+        QCOMPARE(en.overrides, m_plugins + "/en/overrides.csv");
+        QCOMPARE(en.affFile, m_dictionaries + "/en_GB.aff");
+        QCOMPARE(en.dicFile, m_dictionaries + "/en_GB.dic");
+
+        // The plugin comes from the second path, and a dictionary without
+        // .dic is no dictionary.
+        const LanguageResources de(registry.resources("de"));
+        QCOMPARE(de.path, m_plugins + "/de");
+        QCOMPARE(de.plugin, m_morePlugins + "/de/libdeplugin.so");
+        QVERIFY(de.layouts.value("email").isEmpty());
+        QVERIFY(de.affFile.isEmpty());
+        QVERIFY(de.overrides.isEmpty());
+
+        // Same fallback to the language without region as SpellChecker.
+        QCOMPARE(registry.resources("pt-br").affFile, m_dictionaries + "/pt_BR.aff");
+    }
+
+    Q_SLOT void testRescanOnChange()
+    {
+        LanguageRegistry registry;
+        registry.setSearchPaths(QStringList() << m_plugins, m_dictionaries);
+        QSignalSpy changedSpy(&registry, SIGNAL(changed()));
+
+        touch(m_plugins + "/fr/libfrplugin.so");
+        QTRY_VERIFY(registry.contains("fr"));
+        QVERIFY(registry.resources("fr").affFile.isEmpty());
+
+        touch(m_dictionaries + "/fr_FR.aff");
+        touch(m_dictionaries + "/fr_FR.dic");
+        QTRY_COMPARE(registry.resources("fr").affFile, m_dictionaries + "/fr_FR.aff");
+
+        QVERIFY(QDir(m_plugins + "/de").removeRecursively());
+        QTRY_VERIFY(!registry.contains("de"));
+        QVERIFY(changedSpy.count() >= 3);
+    }
+};
+
+QTEST_MAIN(TestLanguageRegistry)
+#include "ut_languageregistry.moc"
@@ -0,0 +1,24 @@
+TOP_BUILDDIR = $$OUT_PWD/../../..
+TOP_SRCDIR = $$PWD/../../..
+
+include($${TOP_SRCDIR}/config.pri)
+include(../common-check.pri)
+
+CONFIG += testcase
+TARGET = ut_languageregistry
+QT = core testlib
+
+INCLUDEPATH    += \
+    $${TOP_SRCDIR}/src/lib/ \
+    $${TOP_SRCDIR}/src/lib/logic/
+
+HEADERS += \
+    $${TOP_SRCDIR}/src/lib/logic/languageregistry.h \
+    $${TOP_SRCDIR}/src/lib/logic/languageresources.h
+
+SOURCES += \
+    $${TOP_SRCDIR}/src/lib/logic/languageregistry.cpp \
+    ut_languageregistry.cpp
+
+target.path = $$INSTALL_BIN
+INSTALLS += target
@@ -238,7 +238,34 @@ private:
         QCOMPARE(host->keyEventCount(), 2);
     }
 
+    /*
+     * Verifies that once auto-repeat deletes whole words, each word is
+     * removed with a single replacement instead of one key event pair per
+     * character.
+     */
+    Q_SLOT void testWordRepeat()
+    {
+        EditorOptions word_options(options);
+        word_options.backspace_word_switch_threshold = 0;
+        editor.reset(new Editor(word_options, new Model::Text, new Logic::WordEngineProbe));
+        editor->setHost(host.data());
 
+        editor->text()->setSurrounding("foo bar baz");
+        editor->text()->setSurroundingOffset(11);
+
+        Key backspace;
+        backspace.setAction(Key::ActionBackspace);
+
+        editor->onKeyPressed(backspace);
+        QTRY_VERIFY(host->preeditStringSent());
+
+        QCOMPARE(host->keyEventCount(), 0);
+        QCOMPARE(host->lastPreeditString(), QString());
+        QCOMPARE(host->lastReplaceStart(), -4);
+        QCOMPARE(host->lastReplaceLength(), 4);
+
+        editor->onKeyExited(backspace);
+    }
 };
 
 QTEST_MAIN(TestRepeatBackspace)
@@ -90,6 +90,103 @@ private:
         QCOMPARE(text.surrounding(), surrounding);
         QCOMPARE(ok, returnValue);
     }
+
+    Q_SLOT void testBoundaries_data()
+    {
+        QTest::addColumn<QStringList>("edits");
+        QTest::addColumn<int>("offset");
+        QTest::addColumn<QString>("lastWord");
+        QTest::addColumn<int>("sentenceStart");
+        QTest::addColumn<int>("lineStart");
+
+        QTest::newRow("empty") << (QStringList() << "")
+                               << 0 << QString() << 0 << 0;
+        QTest::newRow("one word") << (QStringList() << "Hello")
+                                  << 5 << QString("Hello") << 0 << 0;
+        QTest::newRow("typing words") << (QStringList() << "Hello" << "Hello " << "Hello wo" << "Hello world")
+                                      << 11 << QString("world") << 0 << 0;
+        QTest::newRow("after space") << (QStringList() << "Hello world ")
+                                     << 12 << QString() << 0 << 0;
+        QTest::newRow("new sentence") << (QStringList() << "Hello." << "Hello. ")
+                                      << 7 << QString() << 7 << 0;
+        QTest::newRow("no space after stop") << (QStringList() << "Hello.")
+                                             << 6 << QString("Hello.") << 0 << 0;
+        QTest::newRow("second sentence") << (QStringList() << "Hi. There" << "Hi! There")
+                                         << 9 << QString("There") << 4 << 0;
+        QTest::newRow("second line") << (QStringList() << "Hi. Foo\nbar baz")
+                                     << 15 << QString("baz") << 8 << 8;
+        QTest::newRow("cursor in middle") << (QStringList() << "Hi. Foo\nbar baz")
+                                          << 7 << QString("Foo") << 4 << 0;
+        QTest::newRow("edited in middle") << (QStringList() << "Hi. Foo\nbar baz" << "Hi Foo bar baz")
+                                          << 14 << QString("baz") << 0 << 0;
+        QTest::newRow("line inserted before") << (QStringList() << "Hi. Foo\nbar baz" << "Hi. Foo bar\nbar baz")
+                                              << 19 << QString("baz") << 12 << 12;
+        QTest::newRow("sentence deleted before") << (QStringList() << "Hi. Foo\nbar baz" << "Foo\nbar baz")
+                                                 << 11 << QString("baz") << 4 << 4;
+    }
+
+    Q_SLOT void testBoundaries()
+    {
+        QFETCH(QStringList, edits);
+        QFETCH(int, offset);
+        QFETCH(QString, lastWord);
+        QFETCH(int, sentenceStart);
+        QFETCH(int, lineStart);
+
+        Model::Text text;
+        Q_FOREACH (const QString &edit, edits) {
+            text.setSurrounding(edit);
+        }
+        text.setSurroundingOffset(offset);
+
+        QCOMPARE(text.lastWord(), lastWord);
+        QCOMPARE(text.sentenceStart(), sentenceStart);
+        QCOMPARE(text.lineStart(), lineStart);
+    }
+
+    Q_SLOT void testCharBeforeCursor()
+    {
+        Model::Text text;
+        QCOMPARE(text.charBeforeCursor(), QChar());
+
+        text.setSurrounding("ab");
+        text.setSurroundingOffset(1);
+        QCOMPARE(text.charBeforeCursor(), QChar('a'));
+
+        text.setPreedit("xy", 1);
+        QCOMPARE(text.charBeforeCursor(), QChar('x'));
+        QCOMPARE(text.charBeforeCursor(2), QChar('a'));
+        QCOMPARE(text.charBeforeCursor(3), QChar());
+    }
+
+    Q_SLOT void testWordBefore()
+    {
+        Model::Text text;
+        text.setSurrounding("mail me@example. now");
+        text.setSurroundingOffset(20);
+
+        QCOMPARE(text.wordBefore(16), QString("me@example."));
+        QCOMPARE(text.wordBefore(10), QString("me@ex"));
+        QCOMPARE(text.wordBefore(5), QString());
+        QCOMPARE(text.wordBefore(99), QString("now"));
+        QCOMPARE(text.wordBefore(-1), QString());
+    }
+
+    Q_SLOT void testIsBlankAfterCursor()
+    {
+        Model::Text text;
+        QVERIFY(text.isBlankAfterCursor());
+
+        text.setSurrounding("foo \n bar");
+        text.setSurroundingOffset(3);
+        QVERIFY(!text.isBlankAfterCursor());
+
+        text.setSurroundingOffset(7);
+        QVERIFY(!text.isBlankAfterCursor());
+
+        text.setSurroundingOffset(9);
+        QVERIFY(text.isBlankAfterCursor());
+    }
 };
 
 } // namespace
@@ -0,0 +1,165 @@
+/*
+ * Copyright (C) 2016 Canonical, Ltd.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this list
+ * of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice, this list
+ * of conditions and the following disclaimer in the documentation and/or other materials
+ * provided with the distribution.
+ * Neither the name of Nokia Corporation nor the names of its contributors may be
+ * used to endorse or promote products derived from this software without specific
+ * prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL
+ * THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#include "plugin/keytoucharea.h"
+#include "plugin/touchdispatcher.h"
+
+#include <QtCore>
+#include <QtTest>
+#include <QtQml>
+
+class TestTouchDispatcher
+    : public QObject
+{
+    Q_OBJECT
+
+private:
+    QQuickItem *m_root;
+    QQuickItem *m_keypad;
+    TouchDispatcher *m_dispatcher;
+
+    KeyTouchArea *addKey(QQuickItem *row, qreal x, qreal width)
+    {
+        KeyTouchArea *area = new KeyTouchArea(row);
+        area->setPosition(QPointF(x, 0));
+        area->setSize(QSizeF(width, row->height()));
+        return area;
+    }
+
+    QQuickItem *addRow(qreal y, qreal height)
+    {
+        QQuickItem *row = new QQuickItem(m_keypad);
+        row->setPosition(QPointF(0, y));
+        row->setSize(QSizeF(m_keypad->width(), height));
+        return row;
+    }
+
+    Q_SLOT void init()
+    {
+        m_root = new QQuickItem;
+        m_root->setSize(QSizeF(400, 200));
+
+        m_keypad = new QQuickItem(m_root);
+        m_keypad->setSize(m_root->size());
+
+        m_dispatcher = new TouchDispatcher(m_root);
+        m_dispatcher->setSize(m_root->size());
+        m_dispatcher->setKeypad(m_keypad);
+    }
+
+    Q_SLOT void cleanup()
+    {
+        delete m_root;
+        m_root = 0;
+    }
+
+    Q_SLOT void testKeyAt()
+    {
+        QQuickItem *top = addRow(0, 100);
+        KeyTouchArea *q = addKey(top, 0, 40);
+        KeyTouchArea *w = addKey(top, 40, 40);
+        QQuickItem *bottom = addRow(100, 100);
+        KeyTouchArea *space = addKey(bottom, 100, 200);
+
+        QCOMPARE(m_dispatcher->keyAt(QPointF(10, 10)), q);
+        QCOMPARE(m_dispatcher->keyAt(QPointF(45, 99)), w);
+        QCOMPARE(m_dispatcher->keyAt(QPointF(250, 150)), space);
+
+        // gaps are left to the items below
+        QVERIFY(!m_dispatcher->keyAt(QPointF(90, 10)));
+        QVERIFY(!m_dispatcher->keyAt(QPointF(50, 150)));
+    }
+
+    Q_SLOT void testSkipsHiddenAndDisabledKeys()
+    {
+        QQuickItem *row = addRow(0, 100);
+        KeyTouchArea *hidden = addKey(row, 0, 40);
+        KeyTouchArea *disabled = addKey(row, 40, 40);
+        hidden->setVisible(false);
+        disabled->setEnabled(false);
+
+        QVERIFY(!m_dispatcher->keyAt(QPointF(10, 10)));
+        QVERIFY(!m_dispatcher->keyAt(QPointF(50, 10)));
+    }
+
+    Q_SLOT void testMovedKeys()
+    {
+        QQuickItem *row = addRow(0, 100);
+        KeyTouchArea *a = addKey(row, 0, 40);
+        KeyTouchArea *b = addKey(row, 40, 40);
+        QCOMPARE(m_dispatcher->keyAt(QPointF(10, 10)), a);
+
+        // the row is laid out again without the index being invalidated
+        a->setX(40);
+        b->setX(0);
+        QCOMPARE(m_dispatcher->keyAt(QPointF(10, 10)), b);
+        QCOMPARE(m_dispatcher->keyAt(QPointF(50, 10)), a);
+
+        // new keys are found once invalidated
+        KeyTouchArea *c = addKey(row, 80, 40);
+        m_dispatcher->invalidate();
+        QCOMPARE(m_dispatcher->keyAt(QPointF(90, 10)), c);
+    }
+
+    Q_SLOT void testAddedAndDestroyedKeys()
+    {
+        QQuickItem *row = addRow(0, 100);
+        KeyTouchArea *a = addKey(row, 0, 40);
+        QCOMPARE(m_dispatcher->keyAt(QPointF(10, 10)), a);
+
+        // keys loaded later are found on the first miss, without invalidating
+        KeyTouchArea *b = addKey(row, 40, 40);
+        QCOMPARE(m_dispatcher->keyAt(QPointF(50, 10)), b);
+
+        delete a;
+        KeyTouchArea *c = addKey(row, 0, 40);
+        QCOMPARE(m_dispatcher->keyAt(QPointF(10, 10)), c);
+    }
+
+    Q_SLOT void testSkipsFlickableContent()
+    {
+        QQmlEngine engine;
+        QQmlComponent component(&engine);
+        component.setData("import QtQuick 2.0\nFlickable { width: 400; height: 100 }", QUrl());
+        QQuickItem *flickable = qobject_cast<QQuickItem *>(component.create());
+        QVERIFY(flickable);
+        flickable->setParentItem(m_keypad);
+
+        QQuickItem *row = addRow(100, 100);
+        KeyTouchArea *key = addKey(row, 0, 40);
+        addKey(flickable, 0, 40);
+
+        // the Flickable's keys take their own presses so that it can flick
+        QVERIFY(!m_dispatcher->keyAt(QPointF(10, 10)));
+        QCOMPARE(m_dispatcher->keyAt(QPointF(10, 110)), key);
+
+        delete flickable;
+    }
+};
+
+QTEST_MAIN(TestTouchDispatcher)
+#include "ut_touchdispatcher.moc"
@@ -72,6 +72,22 @@ private:
     // later
     QCOMPARE( wr.valid(), false );
 
+    // the engine announces further candidates, the view pulls them once
+    QSignalSpy moreCandidatesSpy(&wr, SIGNAL( moreCandidatesAvailableChanged(bool) ));
+    QSignalSpy moreCandidatesRequestedSpy(&wr, SIGNAL( moreCandidatesRequested() ));
+
+    QCOMPARE( wr.canFetchMore(QModelIndex()), false );
+    wr.setMoreCandidatesAvailable(true);
+    wr.setMoreCandidatesAvailable(true);
+    QCOMPARE( moreCandidatesSpy.count(), 1 );
+    QCOMPARE( wr.canFetchMore(QModelIndex()), true );
+
+    wr.fetchMore(QModelIndex());
+    wr.fetchMore(QModelIndex());
+    QCOMPARE( moreCandidatesRequestedSpy.count(), 1 );
+    QCOMPARE( moreCandidatesSpy.count(), 2 );
+    QCOMPARE( wr.moreCandidatesAvailable(), false );
+
     WordCandidate w4(WordCandidate::SourceUnknown, "another_word");
 
     // make sure model-related signals work
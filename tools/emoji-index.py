@@ -0,0 +1,143 @@
+#!/usr/bin/python3
+#
+# Compiles CLDR style emoji annotations into the keyword index that is
+# mapped by EmojiIndex (src/lib/logic/emojiindex.h) to suggest emoji on the
+# word ribbon.
+#
+# The index is a trie over the UTF-8 bytes of the lower case keywords. Each
+# node lists the best emoji of all keywords below it, emoji whose keyword
+# ends exactly at the node first, so that a lookup only has to walk the
+# typed word. All numbers are 32 bit little endian:
+#
+#   header   "UKEI", version, node count, edge count, posting count,
+#            emoji count, size of the strings, reserved
+#   nodes    first edge, edge count, first posting,
+#            posting count (16 bit), exact posting count (16 bit)
+#   edges    byte, node; sorted by byte within a node
+#   postings emoji number
+#   emoji    offset of the emoji in the strings
+#   strings  NUL terminated UTF-8
+
+import struct
+import sys
+import xml.etree.ElementTree as ElementTree
+
+VERSION = 1
+# Emoji kept per node.
+MAX_POSTINGS = 8
+# Added to the weight of single words taken out of longer keywords.
+WORD_PENALTY = 10
+
+
+class Node:
+    def __init__(self):
+        self.children = {}
+        self.entries = []
+        self.postings = []
+        self.exact = 0
+
+
+def read_annotations(path):
+    """Returns (emoji, keyword, weight) in document order, the short name
+    of an emoji weighing least."""
+    entries = []
+    order = []
+    for annotation in ElementTree.parse(path).iter("annotation"):
+        emoji = annotation.get("cp")
+        if emoji not in order:
+            order.append(emoji)
+        if annotation.get("type") == "tts":
+            keywords = [annotation.text]
+        else:
+            keywords = annotation.text.split("|")
+        for position, keyword in enumerate(keywords):
+            keyword = keyword.strip().lower()
+            if not keyword:
+                continue
+            weight = 0 if annotation.get("type") == "tts" else position + 1
+            entries.append((emoji, keyword, weight))
+            words = keyword.replace("-", " ").split()
+            if len(words) > 1:
+                for word in words:
+                    entries.append((emoji, word, weight + WORD_PENALTY))
+    return entries, order
+
+
+def build_trie(entries, order):
+    root = Node()
+    for emoji, keyword, weight in entries:
+        node = root
+        for byte in keyword.encode("utf-8"):
+            node = node.children.setdefault(byte, Node())
+        node.entries.append((emoji, keyword, weight))
+
+    def rank(node):
+        candidates = [(False, entry) for entry in node.entries]
+        for child in node.children.values():
+            candidates += [(True, entry) for entry in rank(child)]
+        candidates.sort(key=lambda c: (c[0], c[1][2], len(c[1][1]),
+                                       order.index(c[1][0])))
+        for below, entry in candidates:
+            emoji = entry[0]
+            if emoji in node.postings:
+                continue
+            if len(node.postings) == MAX_POSTINGS:
+                break
+            node.postings.append(emoji)
+            if not below:
+                node.exact += 1
+        return [entry for below, entry in candidates]
+
+    rank(root)
+    return root
+
+
+def write_index(root, order, path):
+    nodes = [root]
+    for node in nodes:
+        for byte in sorted(node.children):
+            nodes.append(node.children[byte])
+    numbers = dict((id(node), number) for number, node in enumerate(nodes))
+
+    strings = b""
+    offsets = []
+    for emoji in order:
+        offsets.append(len(strings))
+        strings += emoji.encode("utf-8") + b"\0"
+    emoji_numbers = dict((emoji, number) for number, emoji in enumerate(order))
+
+    node_data = b""
+    edge_data = b""
+    posting_data = b""
+    edge_count = 0
+    posting_count = 0
+    for node in nodes:
+        node_data += struct.pack("<IIIHH", edge_count, len(node.children),
+                                 posting_count, len(node.postings),
+                                 node.exact)
+        for byte in sorted(node.children):
+            edge_data += struct.pack("<II", byte,
+                                     numbers[id(node.children[byte])])
+            edge_count += 1
+        for emoji in node.postings:
+            posting_data += struct.pack("<I", emoji_numbers[emoji])
+            posting_count += 1
+
+    with open(path, "wb") as index:
+        index.write(b"UKEI")
+        index.write(struct.pack("<IIIIIII", VERSION, len(nodes), edge_count,
+                                posting_count, len(order), len(strings), 0))
+        index.write(node_data)
+        index.write(edge_data)
+        index.write(posting_data)
+        index.write(b"".join(struct.pack("<I", o) for o in offsets))
+        index.write(strings)
+
+
+if __name__ == "__main__":
+    if len(sys.argv) != 3:
+        print("Usage: ./emoji-index.py annotations/en.xml emoji_en.idx")
+        sys.exit(1)
+
+    entries, order = read_annotations(sys.argv[1])
+    write_index(build_trie(entries, order), order, sys.argv[2])
@@ -14,6 +14,7 @@ include(config.pri)
         \\n\\t enable-hunspell: Use hunspell for error correction \
         \\n\\t enable-pinyin: Use libpinyin as chinese input method \
         \\n\\t notests: Do not attempt to build tests \
+        \\n\\t nobenchmarks: Do not build the benchmarks \
         \\n\\t nodoc: Do not build documentation \
         \\nInfluential environment variables: \
         \\n\\t QMAKEFEATURES A mkspecs/features directory list to look for features. \
@@ -93,15 +94,26 @@ SUBDIRS = \
     src \
     data \
     qml \
-#    benchmark \
     plugins \
     po \
 
 !notests {
     SUBDIRS += tests
+    # the benchmarks drive the keyboard through the host of the unit tests
+    !nobenchmarks: SUBDIRS += benchmark
 }
 
 
+# Runs the benchmarks, see benchmark/benchmark.pri
+QMAKE_EXTRA_TARGETS += bench
+bench.target = bench
+bench.commands = cd benchmark && $(MAKE) bench
+
+# Compares the benchmarks with their baseline, see benchmark/perfgate.py
+QMAKE_EXTRA_TARGETS += perfgate
+perfgate.target = perfgate
+perfgate.commands = cd benchmark && $(MAKE) perfgate
+
 tests.target = test
 tests.command = cd tests/editor
 QMAKE_EXTRA_TARGETS += tests